@@ -101,3 +101,80 @@ TEST_CASE("benchmark_copy","[benchmark_copy]")
 
 }
 
+
+TEST_CASE("benchmark_eval_simd","[benchmark_copy]")
+{
+    using benchmark_copy_::bench_copy;
+
+    auto make_eval_seq = [](const auto& t){
+        auto res = t.eval();
+        return *res.begin();
+    };
+    //scalar loop over trivial iterator, the way trivial expression is evaluated if not vectorized
+    auto make_eval_scalar = [](const auto& t){
+        using tensor_type = std::decay_t<decltype(t)>;
+        using order = typename tensor_type::order;
+        gtensor::tensor<typename tensor_type::value_type,order> res(t.shape());
+        auto a = t.traverse_order_adapter(order{});
+        auto a_res = res.traverse_order_adapter(order{});
+        std::copy(a.begin_trivial(),a.end_trivial(),a_res.begin());
+        return *res.begin();
+    };
+
+    const auto n_iters = 10;
+    //last shapes fit in cache
+    const std::vector<std::vector<int>> shapes{
+        std::vector<int>{10000000,3,1,2},
+        std::vector<int>{1000,3,100,200},
+        std::vector<int>{100,10,100},
+        std::vector<int>{10,10,10}
+    };
+
+    bench_copy("eval trivial expression t*2+t-1 scalar",n_iters,shapes,[](auto&& t){return t*2+t-1;},make_eval_scalar);
+    bench_copy("eval trivial expression t*2+t-1 simd",n_iters,shapes,[](auto&& t){return t*2+t-1;},make_eval_seq);
+
+    bench_copy("eval trivial expression (t+t)*(t-1)/(t+2) scalar",n_iters,shapes,[](auto&& t){return (t+t)*(t-1)/(t+2);},make_eval_scalar);
+    bench_copy("eval trivial expression (t+t)*(t-1)/(t+2) simd",n_iters,shapes,[](auto&& t){return (t+t)*(t-1)/(t+2);},make_eval_seq);
+
+    bench_copy("eval trivial expression t<t*t-1 scalar",n_iters,shapes,[](auto&& t){return t<t*t-1;},make_eval_scalar);
+    bench_copy("eval trivial expression t<t*t-1 simd",n_iters,shapes,[](auto&& t){return t<t*t-1;},make_eval_seq);
+}
+
+TEST_CASE("benchmark_eval_transpose","[benchmark_copy]")
+{
+    using benchmark_copy_::bench_copy;
+    using gtensor::config::c_order;
+    using gtensor::config::f_order;
+
+    //elementwise copy using walker iterator, the way transpose view is copied if not blocked
+    auto make_copy_elementwise = [](const auto& t){
+        gtensor::tensor<typename std::decay_t<decltype(t)>::value_type> res(t.shape(),t.begin(),t.end());
+        return *res.begin();
+    };
+    auto make_eval_seq = [](const auto& t){
+        auto res = t.eval();
+        return *res.begin();
+    };
+    auto make_eval_par_8 = [](const auto& t){
+        auto res = t.eval(multithreading::exec_pol<8>{});
+        return *res.begin();
+    };
+    auto make_copy_other_layout = [](const auto& t){
+        using order = typename std::decay_t<decltype(t)>::order;
+        auto res = t.copy(std::conditional_t<std::is_same_v<order,c_order>,f_order,c_order>{});
+        return *res.begin();
+    };
+
+    const auto n_iters = 10;
+    const std::vector<std::vector<int>> shapes{
+        std::vector<int>{4000,4000},
+        std::vector<int>{1000,3000},
+        std::vector<int>{20,300,500},
+        std::vector<int>{300,300}
+    };
+
+    bench_copy("copy transpose elementwise",n_iters,shapes,[](auto&& t){return t.transpose();},make_copy_elementwise);
+    bench_copy("eval transpose blocked",n_iters,shapes,[](auto&& t){return t.transpose();},make_eval_seq);
+    bench_copy("eval transpose blocked exec_pol<8>",n_iters,shapes,[](auto&& t){return t.transpose();},make_eval_par_8);
+    bench_copy("copy to other layout blocked",n_iters,shapes,[](auto&& t){return t;},make_copy_other_layout);
+}
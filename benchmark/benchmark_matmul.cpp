@@ -91,4 +91,41 @@ TEST_CASE("benchmark_matmul","[benchmark_tensor]")
     bench_matmul<std::int64_t>("bench matmul_par int64",n_iters,shapes,builder,command_matmul_par);
     bench_matmul<std::complex<double>>("bench matmul_par std::complex<double>",n_iters,shapes,builder,command_matmul_par);
     bench_matmul<std::complex<float>>("bench matmul_par std::complex<float>",n_iters,shapes,builder,command_matmul_par);
-}
\ No newline at end of file
+}
+
+TEST_CASE("benchmark_matmul_isa","[benchmark_tensor]")
+{
+    using helpers_for_testing::generate_lehmer;
+    using benchmark_matmul_::bench_matmul;
+    using gtensor::isa;
+
+    auto builder = [](auto&& t_){
+        generate_lehmer(t_.begin(),t_.end(),[](const auto& e){return e%5;},123);
+        return t_.clone_shallow();
+    };
+
+    auto shapes = std::vector<std::pair<std::vector<int>,std::vector<int>>>{
+        std::make_pair(std::vector<int>{1000,1000},std::vector<int>{1000,1000}),
+        std::make_pair(std::vector<int>{2000,2000},std::vector<int>{2000,2000})
+    };
+    const auto n_iters = 3;
+
+    auto command_matmul = [](const auto& t1, const auto& t2){
+        auto r = matmul(t1,t2);
+        return std::abs(*r.begin());
+    };
+
+    const auto max_isa = gtensor::max_isa();
+    for (const auto level : {isa::generic,isa::avx2,isa::avx512}){
+        if (level>gtensor::cpu_isa()){
+            break;
+        }
+        gtensor::set_max_isa(level);
+        const auto mes = std::string{"isa "}+std::to_string(static_cast<int>(level));
+        bench_matmul<double>("bench matmul double "+mes,n_iters,shapes,builder,command_matmul);
+        bench_matmul<float>("bench matmul float "+mes,n_iters,shapes,builder,command_matmul);
+        bench_matmul<std::complex<double>>("bench matmul std::complex<double> "+mes,n_iters,shapes,builder,command_matmul);
+        bench_matmul<std::complex<float>>("bench matmul std::complex<float> "+mes,n_iters,shapes,builder,command_matmul);
+    }
+    gtensor::set_max_isa(max_isa);
+}
@@ -0,0 +1,120 @@
+/*
+* GTensor - computation library
+* Copyright (c) 2022 Ivan Malezhyk <ivanmzk@gmail.com>
+*
+* Distributed under the Boost Software License, Version 1.0.
+* The full license is in the file LICENSE.txt, distributed with this software.
+*/
+
+#include <thread>
+#include <vector>
+#include "catch.hpp"
+#include "benchmark_helpers.hpp"
+#include "multithreading.hpp"
+
+namespace benchmark_multithreading_{
+
+using benchmark_helpers::cpu_interval;
+using benchmark_helpers::statistic;
+
+inline auto pool_to_str(const multithreading::thread_pool_v3&){return std::string{"thread_pool_v3"};}
+inline auto pool_to_str(const multithreading::thread_pool_v4&){return std::string{"thread_pool_v4"};}
+
+//n_producers threads concurrently push groups of small tasks and wait for group completion, like reduce_range, slide do
+template<typename Pool>
+auto bench_push_group(std::size_t n_iters, std::size_t n_workers, std::size_t n_producers, std::size_t n_groups, std::size_t group_size, std::size_t task_work){
+    Pool pool(n_workers, 256);
+    std::cout<<std::endl<<pool_to_str(pool)<<" workers "<<n_workers<<" producers "<<n_producers<<" groups "<<n_groups<<" group_size "<<group_size<<" task_work "<<task_work;
+    std::vector<double> intervals{};
+    for (auto n=n_iters; n!=0; --n){
+        std::atomic<std::size_t> sum{0};
+        auto task = [&sum](std::size_t work){
+            std::size_t res{0};
+            for (std::size_t i=0; i!=work; ++i){
+                res+=i*i;
+            }
+            sum.fetch_add(res,std::memory_order_relaxed);
+        };
+        auto producer = [&pool,&task,n_groups,group_size,task_work]{
+            for (std::size_t i=0; i!=n_groups; ++i){
+                multithreading::task_group group{};
+                for (std::size_t j=0; j!=group_size; ++j){
+                    pool.push_group(group,task,task_work);
+                }
+                group.wait();
+            }
+        };
+        cpu_interval dt{};
+        dt.start();
+        std::vector<std::thread> producers{};
+        for (std::size_t i=0; i!=n_producers; ++i){
+            producers.emplace_back(producer);
+        }
+        std::for_each(producers.begin(),producers.end(),[](auto& t){t.join();});
+        dt.stop();
+        benchmark_helpers::fake_use(sum);
+        intervals.push_back(dt);
+    }
+    std::cout<<std::endl<<statistic(intervals);
+}
+
+template<typename Pool>
+auto bench_push(std::size_t n_iters, std::size_t n_workers, std::size_t n_producers, std::size_t n_tasks){
+    Pool pool(n_workers, 256);
+    std::cout<<std::endl<<pool_to_str(pool)<<" push futures, workers "<<n_workers<<" producers "<<n_producers<<" tasks "<<n_tasks;
+    std::vector<double> intervals{};
+    for (auto n=n_iters; n!=0; --n){
+        auto producer = [&pool,n_tasks]{
+            auto task = [](std::size_t i){return i+1;};
+            using future_type = decltype(pool.push(task,std::size_t{0}));
+            std::vector<future_type> futures{};
+            futures.reserve(n_tasks);
+            for (std::size_t i=0; i!=n_tasks; ++i){
+                futures.push_back(pool.push(task,i));
+            }
+            std::size_t res{0};
+            for (auto& f : futures){
+                res+=f.get();
+            }
+            benchmark_helpers::fake_use(res);
+        };
+        cpu_interval dt{};
+        dt.start();
+        std::vector<std::thread> producers{};
+        for (std::size_t i=0; i!=n_producers; ++i){
+            producers.emplace_back(producer);
+        }
+        std::for_each(producers.begin(),producers.end(),[](auto& t){t.join();});
+        dt.stop();
+        intervals.push_back(dt);
+    }
+    std::cout<<std::endl<<statistic(intervals);
+}
+
+}   //end of namespace benchmark_multithreading_
+
+TEST_CASE("benchmark_multithreading_pool_contention","[benchmark_multithreading]")
+{
+    using benchmark_multithreading_::bench_push_group;
+    using benchmark_multithreading_::bench_push;
+    using multithreading::thread_pool_v3;
+    using multithreading::thread_pool_v4;
+
+    const std::size_t n_iters = 10;
+    const std::size_t n_workers = std::max(std::thread::hardware_concurrency(),2u);
+    const std::size_t n_groups = 1000;
+    const std::size_t group_size = 16;
+
+    for (const std::size_t n_producers : {1,2,4,8}){
+        for (const std::size_t task_work : {10,1000,100000}){
+            bench_push_group<thread_pool_v3>(n_iters,n_workers,n_producers,n_groups,group_size,task_work);
+            bench_push_group<thread_pool_v4>(n_iters,n_workers,n_producers,n_groups,group_size,task_work);
+        }
+    }
+
+    const std::size_t n_tasks = 100000;
+    for (const std::size_t n_producers : {1,4,8}){
+        bench_push<thread_pool_v3>(n_iters,n_workers,n_producers,n_tasks);
+        bench_push<thread_pool_v4>(n_iters,n_workers,n_producers,n_tasks);
+    }
+}
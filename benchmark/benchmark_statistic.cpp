@@ -115,6 +115,25 @@ auto bench_statistic_flatten(std::string mes, std::size_t n_iters, Shapes shapes
     bench_statistic_flatten_helper<gtensor::tensor<value_type,f_order>>{}(mes,n_iters,shapes,builder,command);
 }
 
+template<typename SumMode>
+struct config_sum_mode : gtensor::config::default_config{
+    using sum_mode = SumMode;
+};
+
+template<typename SumMode, typename Shapes, typename Axes, typename Builder, typename Command>
+auto bench_sum_mode(std::string mes, std::size_t n_iters, Shapes shapes, Axes axes, Builder builder, Command command){
+    using value_type = float;
+    using config_type = gtensor::config::extend_config_t<config_sum_mode<SumMode>,value_type>;
+    bench_statistic_helper<gtensor::tensor<value_type,c_order,config_type>>{}(mes,n_iters,shapes,axes,builder,command);
+}
+
+template<typename SumMode, typename Shapes, typename Builder, typename Command>
+auto bench_sum_mode_flatten(std::string mes, std::size_t n_iters, Shapes shapes, Builder builder, Command command){
+    using value_type = float;
+    using config_type = gtensor::config::extend_config_t<config_sum_mode<SumMode>,value_type>;
+    bench_statistic_flatten_helper<gtensor::tensor<value_type,c_order,config_type>>{}(mes,n_iters,shapes,builder,command);
+}
+
 }   //end of namespace benchmark_statistic_
 
 TEST_CASE("benchmark_statistic","[benchmark_tensor]")
@@ -158,3 +177,40 @@ TEST_CASE("benchmark_statistic","[benchmark_tensor]")
     bench_statistic("stdev over axes exec_pol<8>",n_iters,shapes,axes,builder,[](const auto& t, const auto& axes){auto res = stdev(multithreading::exec_pol<8>{},t,axes); return *res.begin();});
 }
 
+
+TEST_CASE("benchmark_statistic_sum_modes","[benchmark_tensor]")
+{
+    using benchmark_statistic_::bench_sum_mode;
+    using benchmark_statistic_::bench_sum_mode_flatten;
+    using gtensor::config::mode_sum_naive;
+    using gtensor::config::mode_sum_pairwise;
+    using gtensor::config::mode_sum_kahan;
+    using helpers_for_testing::generate_lehmer;
+
+    auto builder = [](auto& t_){
+        generate_lehmer(t_.begin(),t_.end(),[](const auto& e){return e%5;},123);
+        return t_.clone_shallow();
+    };
+
+    const auto n_iters = 10;
+    const std::vector<std::vector<int>> shapes{
+        std::vector<int>{10000000,3,1,2},
+        std::vector<int>{1000,3,100,200}
+    };
+    const auto axes = std::vector<int>{0,3};
+
+    auto sum_flatten = [](const auto& t){auto res = gtensor::sum(t); return *res.begin();};
+    bench_sum_mode_flatten<mode_sum_naive>("float sum flatten naive",n_iters,shapes,builder,sum_flatten);
+    bench_sum_mode_flatten<mode_sum_pairwise>("float sum flatten pairwise",n_iters,shapes,builder,sum_flatten);
+    bench_sum_mode_flatten<mode_sum_kahan>("float sum flatten kahan",n_iters,shapes,builder,sum_flatten);
+
+    auto sum_axis = [](const auto& t, const auto& axis){auto res = gtensor::sum(t,axis); return *res.begin();};
+    bench_sum_mode<mode_sum_naive>("float sum over axis naive",n_iters,shapes,axes,builder,sum_axis);
+    bench_sum_mode<mode_sum_pairwise>("float sum over axis pairwise",n_iters,shapes,axes,builder,sum_axis);
+    bench_sum_mode<mode_sum_kahan>("float sum over axis kahan",n_iters,shapes,axes,builder,sum_axis);
+
+    auto cumsum_axis = [](const auto& t, const auto& axis){auto res = gtensor::cumsum(t,axis); return *res.begin();};
+    bench_sum_mode<mode_sum_naive>("float cumsum naive",n_iters,shapes,axes,builder,cumsum_axis);
+    bench_sum_mode<mode_sum_pairwise>("float cumsum pairwise",n_iters,shapes,axes,builder,cumsum_axis);
+    bench_sum_mode<mode_sum_kahan>("float cumsum kahan",n_iters,shapes,axes,builder,cumsum_axis);
+}
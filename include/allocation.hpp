@@ -3,6 +3,11 @@
 
 #include <new>
 #include <limits>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
 
 namespace allocation{
 
@@ -80,5 +85,230 @@ bool operator!=(const aligned_allocator<U,A>&, const aligned_allocator<V,A>&){
     return false;
 }
 
+//arena of memory blocks for temporary buffers of single thread
+//memory is bump allocated, deallocation of last allocated buffer returns its memory to arena, other deallocations are deferred until arena is reset
+//arena is reset when all its buffers are deallocated, if it grew to several blocks they are merged into one, so steady state calls don't use heap
+//if capacity exceeds max_retained_capacity on reset, memory is returned to heap
+//release_scratch_arenas() requests all arenas to return memory to heap, arena does it when it is not in use: immediately or on next reset or allocation
+class scratch_arena
+{
+public:
+    static constexpr std::size_t min_block_size = 64*1024;
+    static constexpr std::size_t max_retained_capacity = 256*1024*1024;
+    static constexpr std::size_t max_alignment = 64;
+
+    struct statistics{
+        //number of blocks allocated from heap
+        std::size_t heap_allocations{0};
+        //number of buffers allocated from arena
+        std::size_t allocations{0};
+        //bytes in all blocks
+        std::size_t capacity{0};
+        //number of buffers not deallocated yet
+        std::size_t in_use{0};
+    };
+
+    scratch_arena() = default;
+    scratch_arena(const scratch_arena&) = delete;
+    scratch_arena& operator=(const scratch_arena&) = delete;
+    ~scratch_arena()
+    {
+        free_blocks();
+    }
+
+    void* allocate(std::size_t n, std::size_t alignment){
+        if (alignment > max_alignment){
+            throw std::bad_alloc{};
+        }
+        if (statistics_.in_use == 0){
+            release_if_requested();
+        }
+        for (;; ++current_, offset_ = 0){
+            if (current_ == blocks_.size()){
+                add_block(std::max(n+alignment, std::max(min_block_size, statistics_.capacity)));
+            }
+            auto& b = blocks_[current_];
+            const std::size_t first = (offset_+alignment-1)/alignment*alignment;
+            if (first+n <= b.size){
+                offset_ = first+n;
+                ++statistics_.allocations;
+                ++statistics_.in_use;
+                return b.data+first;
+            }
+        }
+    }
+
+    void deallocate(void* p, std::size_t n){
+        if (p == nullptr){
+            return;
+        }
+        --statistics_.in_use;
+        if (statistics_.in_use == 0){
+            reset();
+        }else{
+            auto& b = blocks_[current_];
+            if (static_cast<char*>(p)+n == b.data+offset_){
+                offset_ = static_cast<std::size_t>(static_cast<char*>(p)-b.data);
+            }
+        }
+    }
+
+    //returns all blocks to heap, arena must not be in use
+    void release(){
+        if (statistics_.in_use == 0){
+            free_blocks();
+        }
+    }
+    //returns all blocks to heap if release of all arenas was requested after last release of this arena
+    void release_if_requested(){
+        const auto epoch = release_epoch().load(std::memory_order_relaxed);
+        if (epoch != epoch_ && statistics_.in_use == 0){
+            free_blocks();
+            epoch_ = epoch;
+        }
+    }
+
+    const statistics& stats()const{
+        return statistics_;
+    }
+
+private:
+    struct block{
+        char* data;
+        std::size_t size;
+    };
+
+    void reset(){
+        current_ = 0;
+        offset_ = 0;
+        release_if_requested();
+        if (statistics_.capacity > max_retained_capacity){
+            free_blocks();
+        }else if (blocks_.size() > 1){
+            const auto capacity = statistics_.capacity;
+            free_blocks();
+            add_block(capacity);
+        }
+    }
+
+    void add_block(std::size_t size){
+        blocks_.push_back(block{static_cast<char*>(::operator new(size,std::align_val_t{max_alignment})),size});
+        statistics_.capacity+=size;
+        ++statistics_.heap_allocations;
+        heap_allocations_counter().fetch_add(1,std::memory_order_relaxed);
+    }
+
+    void free_blocks(){
+        for (const auto& b : blocks_){
+            ::operator delete(b.data,std::align_val_t{max_alignment});
+        }
+        blocks_.clear();
+        statistics_.capacity = 0;
+        current_ = 0;
+        offset_ = 0;
+    }
+
+public:
+    //heap allocations of arenas of all threads
+    static std::atomic<std::size_t>& heap_allocations_counter(){
+        static std::atomic<std::size_t> counter{0};
+        return counter;
+    }
+    //incremented to request release of all arenas
+    static std::atomic<std::size_t>& release_epoch(){
+        static std::atomic<std::size_t> epoch{0};
+        return epoch;
+    }
+
+private:
+    std::vector<block> blocks_{};
+    std::size_t current_{0};
+    std::size_t offset_{0};
+    std::size_t epoch_{release_epoch().load(std::memory_order_relaxed)};
+    statistics statistics_{};
+};
+
+//scratch arena of calling thread
+inline scratch_arena& get_scratch_arena(){
+    thread_local scratch_arena arena{};
+    return arena;
+}
+//statistics of scratch arena of calling thread
+inline scratch_arena::statistics scratch_statistics(){
+    return get_scratch_arena().stats();
+}
+//number of heap allocations made by scratch arenas of all threads
+inline std::size_t scratch_heap_allocations(){
+    return scratch_arena::heap_allocations_counter().load(std::memory_order_relaxed);
+}
+//return memory of scratch arenas of all threads to heap
+//arena of calling thread is released immediately if not in use, arenas of other threads are released on their next use
+inline void release_scratch_arenas(){
+    scratch_arena::release_epoch().fetch_add(1,std::memory_order_relaxed);
+    get_scratch_arena().release_if_requested();
+}
+
+//allocator of temporary buffers from scratch arena of thread it is constructed on
+//buffers must be deallocated on the same thread and must not outlive routine they are used in
+//buffers are aligned to Alignment, that must not exceed scratch_arena::max_alignment
+template<typename T, std::size_t Alignment = alignof(T)>
+class scratch_allocator
+{
+    static_assert(!std::is_const_v<T>);
+    static_assert((Alignment&(Alignment-1)) == 0);
+    static_assert(Alignment >= alignof(T));
+    static_assert(Alignment <= scratch_arena::max_alignment);
+    template<typename, std::size_t> friend class scratch_allocator;
+    scratch_arena* arena_;
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::false_type;
+    using propagate_on_container_swap = std::true_type;
+    using propagate_on_container_copy_assignment = std::false_type;
+
+    template<typename U> struct rebind{using other = scratch_allocator<U,(alignof(U)>Alignment ? alignof(U) : Alignment)>;};
+
+    scratch_allocator() noexcept:
+        arena_{&get_scratch_arena()}
+    {}
+    scratch_allocator(const scratch_allocator&) noexcept = default;
+    template<typename U, std::size_t A>
+    scratch_allocator(const scratch_allocator<U,A>& other) noexcept:
+        arena_{other.arena_}
+    {}
+
+    T* allocate(const std::size_t n){
+        if constexpr (sizeof(T)>1){
+            if (n > std::numeric_limits<std::size_t>::max()/sizeof(T)){
+                throw std::bad_array_new_length{};
+            }
+        }
+        if (n==0){
+            return nullptr;
+        }
+        return static_cast<T*>(arena_->allocate(n*sizeof(T),Alignment));
+    }
+
+    void deallocate(T* const p, std::size_t n){
+        arena_->deallocate(p,n*sizeof(T));
+    }
+
+    template<typename U, std::size_t A, typename V, std::size_t B>
+    friend bool operator==(const scratch_allocator<U,A>& lhs, const scratch_allocator<V,B>& rhs);
+};
+
+template<typename U, std::size_t A, typename V, std::size_t B>
+bool operator==(const scratch_allocator<U,A>& lhs, const scratch_allocator<V,B>& rhs){
+    return lhs.arena_ == rhs.arena_;
+}
+template<typename U, std::size_t A, typename V, std::size_t B>
+bool operator!=(const scratch_allocator<U,A>& lhs, const scratch_allocator<V,B>& rhs){
+    return !(lhs==rhs);
+}
+
 }   //end of namespace allocation
 #endif
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <complex>
 #include <immintrin.h>
 #include "common.hpp"
+#include "cpu_features.hpp"
 
 #if defined(__clang__) || defined(__GNUC__) || defined(__GNUG__)
     #if defined(__AVX__)
@@ -39,12 +40,23 @@
     #define HAS_AVX2 0
     #define HAS_FMA 0
 #endif
+#if defined(__AVX512F__)
+    #define HAS_AVX512F 1
+#else
+    #define HAS_AVX512F 0
+#endif
+#if defined(__AVX512DQ__)
+    #define HAS_AVX512DQ 1
+#else
+    #define HAS_AVX512DQ 0
+#endif
 
 namespace gtensor{
 namespace detail{
 
+//256-bit vector operations of matmul and gemv kernels, compiled for AVX2,FMA target, should be called only if kernel_isa() is not less than isa::avx2
 template<typename U>
-ALWAYS_INLINE auto avx_zero(){
+ALWAYS_INLINE GTENSOR_TARGET_AVX2 auto avx_zero(){
     if constexpr (std::is_same_v<U,double>){
         return _mm256_setzero_pd();
     }else if constexpr (std::is_same_v<U,float>){
@@ -58,7 +70,7 @@ ALWAYS_INLINE auto avx_zero(){
     }
 }
 template<typename U>
-ALWAYS_INLINE auto avx_broadcast(const U* const buf){
+ALWAYS_INLINE GTENSOR_TARGET_AVX2 auto avx_broadcast(const U* const buf){
     if constexpr (std::is_same_v<U,double>){
         return _mm256_broadcast_sd(buf);
     }else if constexpr (std::is_same_v<U,float>){
@@ -72,7 +84,7 @@ ALWAYS_INLINE auto avx_broadcast(const U* const buf){
     }
 }
 template<typename U>
-ALWAYS_INLINE auto avx_load(const U* const buf){
+ALWAYS_INLINE GTENSOR_TARGET_AVX2 auto avx_load(const U* const buf){
     if constexpr (std::is_same_v<U,double>){
         return _mm256_load_pd(buf);
     }else if constexpr (std::is_same_v<U,float>){
@@ -86,7 +98,7 @@ ALWAYS_INLINE auto avx_load(const U* const buf){
     }
 }
 template<typename U>
-ALWAYS_INLINE auto avx_loadu(const U* const buf){
+ALWAYS_INLINE GTENSOR_TARGET_AVX2 auto avx_loadu(const U* const buf){
     if constexpr (std::is_same_v<U,double>){
         return _mm256_loadu_pd(buf);
     }else if constexpr (std::is_same_v<U,float>){
@@ -100,7 +112,7 @@ ALWAYS_INLINE auto avx_loadu(const U* const buf){
     }
 }
 template<typename U, typename Y>
-ALWAYS_INLINE auto avx_store(U* const buf, Y y){
+ALWAYS_INLINE GTENSOR_TARGET_AVX2 auto avx_store(U* const buf, Y y){
     if constexpr (std::is_same_v<U,double>){
         return _mm256_store_pd(buf,y);
     }else if constexpr (std::is_same_v<U,float>){
@@ -114,7 +126,21 @@ ALWAYS_INLINE auto avx_store(U* const buf, Y y){
     }
 }
 template<typename U, typename Y>
-ALWAYS_INLINE auto avx_mul(Y a, Y b){
+ALWAYS_INLINE GTENSOR_TARGET_AVX2 auto avx_storeu(U* const buf, Y y){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm256_storeu_pd(buf,y);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm256_storeu_ps(buf,y);
+    }else if constexpr (std::is_same_v<U,std::complex<double>>){
+        return _mm256_storeu_pd(reinterpret_cast<double*>(buf),y);
+    }else if constexpr (std::is_same_v<U,std::complex<float>>){
+        return _mm256_storeu_ps(reinterpret_cast<float*>(buf),y);
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U, typename Y>
+ALWAYS_INLINE GTENSOR_TARGET_AVX2 auto avx_mul(Y a, Y b){
     if constexpr (std::is_same_v<U,double>){
         return _mm256_mul_pd(a,b);
     }else if constexpr (std::is_same_v<U,float>){
@@ -138,19 +164,11 @@ ALWAYS_INLINE auto avx_mul(Y a, Y b){
     }
 }
 template<typename U, typename Y>
-ALWAYS_INLINE auto avx_madd(Y a, Y b, Y c){
+ALWAYS_INLINE GTENSOR_TARGET_AVX2 auto avx_madd(Y a, Y b, Y c){
     if constexpr (std::is_same_v<U,double>){
-        if constexpr (HAS_FMA){
-            return _mm256_fmadd_pd(a,b,c);
-        }else{
-            return _mm256_add_pd(_mm256_mul_pd(a,b),c);
-        }
+        return _mm256_fmadd_pd(a,b,c);
     }else if constexpr (std::is_same_v<U,float>){
-        if constexpr (HAS_FMA){
-            return _mm256_fmadd_ps(a,b,c);
-        }else{
-            return _mm256_add_ps(_mm256_mul_ps(a,b),c);
-        }
+        return _mm256_fmadd_ps(a,b,c);
     }else if constexpr (std::is_same_v<U,std::complex<double>>){
         return _mm256_add_pd(c,avx_mul<std::complex<double>>(a,b));
     }else if constexpr (std::is_same_v<U,std::complex<float>>){
@@ -160,6 +178,543 @@ ALWAYS_INLINE auto avx_madd(Y a, Y b, Y c){
     }
 }
 
+//512-bit vector operations of matmul and gemv kernels, compiled for AVX-512F,DQ,BW target, should be called only if kernel_isa() is isa::avx512
+//n is number of elements of U, masked operations don't touch memory beyond buf+n
+template<typename U>
+ALWAYS_INLINE GTENSOR_TARGET_AVX512 auto avx512_zero(){
+    if constexpr (std::is_same_v<U,double> || std::is_same_v<U,std::complex<double>>){
+        return _mm512_setzero_pd();
+    }else if constexpr (std::is_same_v<U,float> || std::is_same_v<U,std::complex<float>>){
+        return _mm512_setzero_ps();
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+//unmasked forms of broadcast, permute and dup intrinsics start from _mm512_undefined_*, that makes gcc report -Wmaybe-uninitialized when inlined,
+//zero masked forms with full mask compile to the same instructions
+inline constexpr __mmask8 avx512_full_mask_pd = 0xff;
+inline constexpr __mmask16 avx512_full_mask_ps = 0xffff;
+template<typename U>
+ALWAYS_INLINE GTENSOR_TARGET_AVX512 auto avx512_broadcast(const U* const buf){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm512_set1_pd(*buf);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm512_set1_ps(*buf);
+    }else if constexpr (std::is_same_v<U,std::complex<double>>){
+        return _mm512_maskz_broadcast_f64x2(avx512_full_mask_pd,_mm_loadu_pd(reinterpret_cast<const double*>(buf)));
+    }else if constexpr (std::is_same_v<U,std::complex<float>>){
+        return _mm512_castpd_ps(_mm512_set1_pd(*reinterpret_cast<const double*>(reinterpret_cast<const float*>(buf))));
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U>
+ALWAYS_INLINE GTENSOR_TARGET_AVX512 auto avx512_load(const U* const buf){
+    if constexpr (std::is_same_v<U,double> || std::is_same_v<U,std::complex<double>>){
+        return _mm512_load_pd(reinterpret_cast<const double*>(buf));
+    }else if constexpr (std::is_same_v<U,float> || std::is_same_v<U,std::complex<float>>){
+        return _mm512_load_ps(reinterpret_cast<const float*>(buf));
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U>
+ALWAYS_INLINE GTENSOR_TARGET_AVX512 auto avx512_loadu(const U* const buf){
+    if constexpr (std::is_same_v<U,double> || std::is_same_v<U,std::complex<double>>){
+        return _mm512_loadu_pd(reinterpret_cast<const double*>(buf));
+    }else if constexpr (std::is_same_v<U,float> || std::is_same_v<U,std::complex<float>>){
+        return _mm512_loadu_ps(reinterpret_cast<const float*>(buf));
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U>
+ALWAYS_INLINE GTENSOR_TARGET_AVX512 auto avx512_maskz_loadu(const U* const buf, const std::size_t& n){
+    if constexpr (std::is_same_v<U,double> || std::is_same_v<U,std::complex<double>>){
+        const auto k = static_cast<__mmask8>((1u<<(n*sizeof(U)/sizeof(double)))-1);
+        return _mm512_maskz_loadu_pd(k,reinterpret_cast<const double*>(buf));
+    }else if constexpr (std::is_same_v<U,float> || std::is_same_v<U,std::complex<float>>){
+        const auto k = static_cast<__mmask16>((1u<<(n*sizeof(U)/sizeof(float)))-1);
+        return _mm512_maskz_loadu_ps(k,reinterpret_cast<const float*>(buf));
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U, typename Z>
+ALWAYS_INLINE GTENSOR_TARGET_AVX512 void avx512_store(U* const buf, Z z){
+    if constexpr (std::is_same_v<U,double> || std::is_same_v<U,std::complex<double>>){
+        _mm512_store_pd(reinterpret_cast<double*>(buf),z);
+    }else if constexpr (std::is_same_v<U,float> || std::is_same_v<U,std::complex<float>>){
+        _mm512_store_ps(reinterpret_cast<float*>(buf),z);
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U, typename Z>
+ALWAYS_INLINE GTENSOR_TARGET_AVX512 void avx512_storeu(U* const buf, Z z){
+    if constexpr (std::is_same_v<U,double> || std::is_same_v<U,std::complex<double>>){
+        _mm512_storeu_pd(reinterpret_cast<double*>(buf),z);
+    }else if constexpr (std::is_same_v<U,float> || std::is_same_v<U,std::complex<float>>){
+        _mm512_storeu_ps(reinterpret_cast<float*>(buf),z);
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U, typename Z>
+ALWAYS_INLINE GTENSOR_TARGET_AVX512 void avx512_mask_storeu(U* const buf, Z z, const std::size_t& n){
+    if constexpr (std::is_same_v<U,double> || std::is_same_v<U,std::complex<double>>){
+        const auto k = static_cast<__mmask8>((1u<<(n*sizeof(U)/sizeof(double)))-1);
+        _mm512_mask_storeu_pd(reinterpret_cast<double*>(buf),k,z);
+    }else if constexpr (std::is_same_v<U,float> || std::is_same_v<U,std::complex<float>>){
+        const auto k = static_cast<__mmask16>((1u<<(n*sizeof(U)/sizeof(float)))-1);
+        _mm512_mask_storeu_ps(reinterpret_cast<float*>(buf),k,z);
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+//complex: a*b = (a.re*b.re - a.im*b.im, a.re*b.im + a.im*b.re)
+template<typename U, typename Z>
+ALWAYS_INLINE GTENSOR_TARGET_AVX512 auto avx512_mul(Z a, Z b){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm512_mul_pd(a,b);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm512_mul_ps(a,b);
+    }else if constexpr (std::is_same_v<U,std::complex<double>>){
+        const auto z0 = _mm512_maskz_movedup_pd(avx512_full_mask_pd,a);
+        const auto z1 = _mm512_mul_pd(_mm512_maskz_permute_pd(avx512_full_mask_pd,a,0b11111111),_mm512_maskz_permute_pd(avx512_full_mask_pd,b,0b01010101));
+        return _mm512_fmaddsub_pd(z0,b,z1);
+    }else if constexpr (std::is_same_v<U,std::complex<float>>){
+        const auto z0 = _mm512_maskz_moveldup_ps(avx512_full_mask_ps,a);
+        const auto z1 = _mm512_mul_ps(_mm512_maskz_movehdup_ps(avx512_full_mask_ps,a),_mm512_maskz_permute_ps(avx512_full_mask_ps,b,0b10'11'00'01));
+        return _mm512_fmaddsub_ps(z0,b,z1);
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U, typename Z>
+ALWAYS_INLINE GTENSOR_TARGET_AVX512 auto avx512_madd(Z a, Z b, Z c){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm512_fmadd_pd(a,b,c);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm512_fmadd_ps(a,b,c);
+    }else if constexpr (std::is_same_v<U,std::complex<double>>){
+        return _mm512_add_pd(c,avx512_mul<std::complex<double>>(a,b));
+    }else if constexpr (std::is_same_v<U,std::complex<float>>){
+        return _mm512_add_ps(c,avx512_mul<std::complex<float>>(a,b));
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+
+//elementwise vector operations, widest available instruction set is used: AVX-512 if HAS_AVX512F, otherwise AVX,AVX2
+//U is element type: double, float, signed 32 or 64 bit integer
+//simd_width_v<U> is number of elements in register, zero if there is no vector support for U
+template<typename U> inline constexpr bool is_simd_float_v = std::is_same_v<U,double> || std::is_same_v<U,float>;
+template<typename U> inline constexpr bool is_simd_int_v = std::is_integral_v<U> && std::is_signed_v<U> && (sizeof(U)==4 || sizeof(U)==8);
+#if HAS_AVX512F
+template<typename U> inline constexpr std::size_t simd_width_v = is_simd_float_v<U> || is_simd_int_v<U> ? 64/sizeof(U) : 0;
+template<typename U> inline constexpr bool simd_has_mul_v = is_simd_float_v<U> || (is_simd_int_v<U> && (sizeof(U)==4 || HAS_AVX512DQ));
+template<typename U> inline constexpr bool simd_has_fma_v = is_simd_float_v<U>;
+#elif HAS_AVX
+template<typename U> inline constexpr std::size_t simd_width_v = is_simd_float_v<U> || (HAS_AVX2 && is_simd_int_v<U>) ? 32/sizeof(U) : 0;
+template<typename U> inline constexpr bool simd_has_mul_v = is_simd_float_v<U> || (HAS_AVX2 && is_simd_int_v<U> && sizeof(U)==4);
+template<typename U> inline constexpr bool simd_has_fma_v = is_simd_float_v<U> && HAS_FMA;
+#else
+template<typename U> inline constexpr std::size_t simd_width_v = 0;
+template<typename U> inline constexpr bool simd_has_mul_v = false;
+template<typename U> inline constexpr bool simd_has_fma_v = false;
+#endif
+template<typename U> inline constexpr bool simd_has_div_v = simd_width_v<U>!=0 && is_simd_float_v<U>;
+template<typename U> inline constexpr bool simd_has_minmax_v = simd_width_v<U>!=0 && is_simd_float_v<U>;
+
+enum class simd_predicate : int {eq,ne,gt,ge,lt,le};
+
+#if HAS_AVX512F
+template<typename U>
+ALWAYS_INLINE auto simd_loadu(const U* const buf){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm512_loadu_pd(buf);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm512_loadu_ps(buf);
+    }else if constexpr (is_simd_int_v<U>){
+        return _mm512_loadu_si512(buf);
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U, typename Y>
+ALWAYS_INLINE void simd_storeu(U* const buf, Y y){
+    if constexpr (std::is_same_v<U,double>){
+        _mm512_storeu_pd(buf,y);
+    }else if constexpr (std::is_same_v<U,float>){
+        _mm512_storeu_ps(buf,y);
+    }else if constexpr (is_simd_int_v<U>){
+        _mm512_storeu_si512(buf,y);
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U>
+ALWAYS_INLINE auto simd_broadcast(const U& v){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm512_set1_pd(v);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm512_set1_ps(v);
+    }else if constexpr (is_simd_int_v<U> && sizeof(U)==4){
+        return _mm512_set1_epi32(v);
+    }else if constexpr (is_simd_int_v<U> && sizeof(U)==8){
+        return _mm512_set1_epi64(v);
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U, typename Y>
+ALWAYS_INLINE auto simd_add(Y a, Y b){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm512_add_pd(a,b);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm512_add_ps(a,b);
+    }else if constexpr (is_simd_int_v<U> && sizeof(U)==4){
+        return _mm512_add_epi32(a,b);
+    }else if constexpr (is_simd_int_v<U> && sizeof(U)==8){
+        return _mm512_add_epi64(a,b);
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U, typename Y>
+ALWAYS_INLINE auto simd_sub(Y a, Y b){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm512_sub_pd(a,b);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm512_sub_ps(a,b);
+    }else if constexpr (is_simd_int_v<U> && sizeof(U)==4){
+        return _mm512_sub_epi32(a,b);
+    }else if constexpr (is_simd_int_v<U> && sizeof(U)==8){
+        return _mm512_sub_epi64(a,b);
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U, typename Y>
+ALWAYS_INLINE auto simd_mul(Y a, Y b){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm512_mul_pd(a,b);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm512_mul_ps(a,b);
+    }else if constexpr (is_simd_int_v<U> && sizeof(U)==4){
+        return _mm512_mullo_epi32(a,b);
+#if HAS_AVX512DQ
+    }else if constexpr (is_simd_int_v<U> && sizeof(U)==8){
+        return _mm512_mullo_epi64(a,b);
+#endif
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U, typename Y>
+ALWAYS_INLINE auto simd_div(Y a, Y b){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm512_div_pd(a,b);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm512_div_ps(a,b);
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U, typename Y>
+ALWAYS_INLINE auto simd_fma(Y a, Y b, Y c){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm512_fmadd_pd(a,b,c);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm512_fmadd_ps(a,b,c);
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+//std::fmax, std::fmin semantic: if one of arguments is NaN, other is returned
+template<typename U, typename Y>
+ALWAYS_INLINE auto simd_fmax(Y a, Y b){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm512_mask_max_pd(a,_mm512_cmp_pd_mask(b,b,_CMP_ORD_Q),a,b);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm512_mask_max_ps(a,_mm512_cmp_ps_mask(b,b,_CMP_ORD_Q),a,b);
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U, typename Y>
+ALWAYS_INLINE auto simd_fmin(Y a, Y b){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm512_mask_min_pd(a,_mm512_cmp_pd_mask(b,b,_CMP_ORD_Q),a,b);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm512_mask_min_ps(a,_mm512_cmp_ps_mask(b,b,_CMP_ORD_Q),a,b);
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+//returns bit mask of elementwise comparison results, bit i corresponds to element i
+template<typename U, simd_predicate P, typename Y>
+ALWAYS_INLINE unsigned simd_cmp(Y a, Y b){
+    if constexpr (is_simd_float_v<U>){
+        constexpr int imm = P==simd_predicate::eq ? _CMP_EQ_OQ : P==simd_predicate::ne ? _CMP_NEQ_UQ : P==simd_predicate::gt ? _CMP_GT_OQ :
+            P==simd_predicate::ge ? _CMP_GE_OQ : P==simd_predicate::lt ? _CMP_LT_OQ : _CMP_LE_OQ;
+        if constexpr (std::is_same_v<U,double>){
+            return _mm512_cmp_pd_mask(a,b,imm);
+        }else{
+            return _mm512_cmp_ps_mask(a,b,imm);
+        }
+    }else if constexpr (is_simd_int_v<U>){
+        constexpr int imm = P==simd_predicate::eq ? _MM_CMPINT_EQ : P==simd_predicate::ne ? _MM_CMPINT_NE : P==simd_predicate::gt ? _MM_CMPINT_NLE :
+            P==simd_predicate::ge ? _MM_CMPINT_NLT : P==simd_predicate::lt ? _MM_CMPINT_LT : _MM_CMPINT_LE;
+        if constexpr (sizeof(U)==4){
+            return _mm512_cmp_epi32_mask(a,b,imm);
+        }else{
+            return _mm512_cmp_epi64_mask(a,b,imm);
+        }
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+#elif HAS_AVX
+template<typename U>
+ALWAYS_INLINE auto simd_loadu(const U* const buf){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm256_loadu_pd(buf);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm256_loadu_ps(buf);
+    }else if constexpr (is_simd_int_v<U>){
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buf));
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U, typename Y>
+ALWAYS_INLINE void simd_storeu(U* const buf, Y y){
+    if constexpr (std::is_same_v<U,double>){
+        _mm256_storeu_pd(buf,y);
+    }else if constexpr (std::is_same_v<U,float>){
+        _mm256_storeu_ps(buf,y);
+    }else if constexpr (is_simd_int_v<U>){
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(buf),y);
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U>
+ALWAYS_INLINE auto simd_broadcast(const U& v){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm256_set1_pd(v);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm256_set1_ps(v);
+    }else if constexpr (is_simd_int_v<U> && sizeof(U)==4){
+        return _mm256_set1_epi32(v);
+    }else if constexpr (is_simd_int_v<U> && sizeof(U)==8){
+        return _mm256_set1_epi64x(v);
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U, typename Y>
+ALWAYS_INLINE auto simd_add(Y a, Y b){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm256_add_pd(a,b);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm256_add_ps(a,b);
+#if HAS_AVX2
+    }else if constexpr (is_simd_int_v<U> && sizeof(U)==4){
+        return _mm256_add_epi32(a,b);
+    }else if constexpr (is_simd_int_v<U> && sizeof(U)==8){
+        return _mm256_add_epi64(a,b);
+#endif
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U, typename Y>
+ALWAYS_INLINE auto simd_sub(Y a, Y b){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm256_sub_pd(a,b);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm256_sub_ps(a,b);
+#if HAS_AVX2
+    }else if constexpr (is_simd_int_v<U> && sizeof(U)==4){
+        return _mm256_sub_epi32(a,b);
+    }else if constexpr (is_simd_int_v<U> && sizeof(U)==8){
+        return _mm256_sub_epi64(a,b);
+#endif
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U, typename Y>
+ALWAYS_INLINE auto simd_mul(Y a, Y b){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm256_mul_pd(a,b);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm256_mul_ps(a,b);
+#if HAS_AVX2
+    }else if constexpr (is_simd_int_v<U> && sizeof(U)==4){
+        return _mm256_mullo_epi32(a,b);
+#endif
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U, typename Y>
+ALWAYS_INLINE auto simd_div(Y a, Y b){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm256_div_pd(a,b);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm256_div_ps(a,b);
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U, typename Y>
+ALWAYS_INLINE auto simd_fma(Y a, Y b, Y c){
+#if HAS_FMA
+    if constexpr (std::is_same_v<U,double>){
+        return _mm256_fmadd_pd(a,b,c);
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm256_fmadd_ps(a,b,c);
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+#else
+    static_assert(detail::always_false<U>);
+#endif
+}
+//std::fmax, std::fmin semantic: if one of arguments is NaN, other is returned
+template<typename U, typename Y>
+ALWAYS_INLINE auto simd_fmax(Y a, Y b){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm256_blendv_pd(_mm256_max_pd(a,b),a,_mm256_cmp_pd(b,b,_CMP_UNORD_Q));
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm256_blendv_ps(_mm256_max_ps(a,b),a,_mm256_cmp_ps(b,b,_CMP_UNORD_Q));
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+template<typename U, typename Y>
+ALWAYS_INLINE auto simd_fmin(Y a, Y b){
+    if constexpr (std::is_same_v<U,double>){
+        return _mm256_blendv_pd(_mm256_min_pd(a,b),a,_mm256_cmp_pd(b,b,_CMP_UNORD_Q));
+    }else if constexpr (std::is_same_v<U,float>){
+        return _mm256_blendv_ps(_mm256_min_ps(a,b),a,_mm256_cmp_ps(b,b,_CMP_UNORD_Q));
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+//returns bit mask of elementwise comparison results, bit i corresponds to element i
+template<typename U, simd_predicate P, typename Y>
+ALWAYS_INLINE unsigned simd_cmp(Y a, Y b){
+    if constexpr (is_simd_float_v<U>){
+        constexpr int imm = P==simd_predicate::eq ? _CMP_EQ_OQ : P==simd_predicate::ne ? _CMP_NEQ_UQ : P==simd_predicate::gt ? _CMP_GT_OQ :
+            P==simd_predicate::ge ? _CMP_GE_OQ : P==simd_predicate::lt ? _CMP_LT_OQ : _CMP_LE_OQ;
+        if constexpr (std::is_same_v<U,double>){
+            return _mm256_movemask_pd(_mm256_cmp_pd(a,b,imm));
+        }else{
+            return _mm256_movemask_ps(_mm256_cmp_ps(a,b,imm));
+        }
+#if HAS_AVX2
+    }else if constexpr (is_simd_int_v<U>){
+        //AVX2 has only eq and gt integer comparisons, other predicates are expressed using them
+        constexpr unsigned all = (1u<<simd_width_v<U>)-1u;
+        auto eq = [](auto a_, auto b_){
+            if constexpr (sizeof(U)==4){
+                return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a_,b_))));
+            }else{
+                return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a_,b_))));
+            }
+        };
+        auto gt = [](auto a_, auto b_){
+            if constexpr (sizeof(U)==4){
+                return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(a_,b_))));
+            }else{
+                return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(a_,b_))));
+            }
+        };
+        if constexpr (P==simd_predicate::eq){
+            return eq(a,b);
+        }else if constexpr (P==simd_predicate::ne){
+            return ~eq(a,b)&all;
+        }else if constexpr (P==simd_predicate::gt){
+            return gt(a,b);
+        }else if constexpr (P==simd_predicate::ge){
+            return ~gt(b,a)&all;
+        }else if constexpr (P==simd_predicate::lt){
+            return gt(b,a);
+        }else{
+            return ~gt(a,b)&all;
+        }
+#endif
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+#else
+template<typename U> auto simd_loadu(const U* const);
+template<typename U, typename Y> void simd_storeu(U* const, Y);
+template<typename U> auto simd_broadcast(const U&);
+template<typename U, typename Y> auto simd_add(Y, Y);
+template<typename U, typename Y> auto simd_sub(Y, Y);
+template<typename U, typename Y> auto simd_mul(Y, Y);
+template<typename U, typename Y> auto simd_div(Y, Y);
+template<typename U, typename Y> auto simd_fma(Y, Y, Y);
+template<typename U, typename Y> auto simd_fmax(Y, Y);
+template<typename U, typename Y> auto simd_fmin(Y, Y);
+template<typename U, simd_predicate P, typename Y> unsigned simd_cmp(Y, Y);
+#endif
+
+//in register transpose of square block of avx_transpose_width_v<U> rows
+//rows of src block are contiguous and src_stride apart, rows of transposed block are stored contiguous and dst_stride apart
+#if HAS_AVX
+template<typename U> inline constexpr std::size_t avx_transpose_width_v = std::is_same_v<U,double> ? 4 : std::is_same_v<U,float> ? 8 : 0;
+template<typename U, typename IdxT>
+ALWAYS_INLINE void avx_transpose_block(const U* const src, const IdxT& src_stride, U* const dst, const IdxT& dst_stride){
+    if constexpr (std::is_same_v<U,double>){
+        const auto r0 = _mm256_loadu_pd(src);
+        const auto r1 = _mm256_loadu_pd(src+src_stride);
+        const auto r2 = _mm256_loadu_pd(src+2*src_stride);
+        const auto r3 = _mm256_loadu_pd(src+3*src_stride);
+        const auto t0 = _mm256_unpacklo_pd(r0,r1);
+        const auto t1 = _mm256_unpackhi_pd(r0,r1);
+        const auto t2 = _mm256_unpacklo_pd(r2,r3);
+        const auto t3 = _mm256_unpackhi_pd(r2,r3);
+        _mm256_storeu_pd(dst,_mm256_permute2f128_pd(t0,t2,0x20));
+        _mm256_storeu_pd(dst+dst_stride,_mm256_permute2f128_pd(t1,t3,0x20));
+        _mm256_storeu_pd(dst+2*dst_stride,_mm256_permute2f128_pd(t0,t2,0x31));
+        _mm256_storeu_pd(dst+3*dst_stride,_mm256_permute2f128_pd(t1,t3,0x31));
+    }else if constexpr (std::is_same_v<U,float>){
+        __m256 r[8];
+        __m256 t[8];
+        for (IdxT i=0; i!=8; ++i){
+            r[i] = _mm256_loadu_ps(src+i*src_stride);
+        }
+        for (IdxT i=0; i!=8; i+=2){
+            t[i] = _mm256_unpacklo_ps(r[i],r[i+1]);
+            t[i+1] = _mm256_unpackhi_ps(r[i],r[i+1]);
+        }
+        for (IdxT i=0; i!=8; i+=4){
+            r[i] = _mm256_shuffle_ps(t[i],t[i+2],_MM_SHUFFLE(1,0,1,0));
+            r[i+1] = _mm256_shuffle_ps(t[i],t[i+2],_MM_SHUFFLE(3,2,3,2));
+            r[i+2] = _mm256_shuffle_ps(t[i+1],t[i+3],_MM_SHUFFLE(1,0,1,0));
+            r[i+3] = _mm256_shuffle_ps(t[i+1],t[i+3],_MM_SHUFFLE(3,2,3,2));
+        }
+        for (IdxT i=0; i!=4; ++i){
+            _mm256_storeu_ps(dst+i*dst_stride,_mm256_permute2f128_ps(r[i],r[i+4],0x20));
+            _mm256_storeu_ps(dst+(i+4)*dst_stride,_mm256_permute2f128_ps(r[i],r[i+4],0x31));
+        }
+    }else{
+        static_assert(detail::always_false<U>);
+    }
+}
+#else
+template<typename U> inline constexpr std::size_t avx_transpose_width_v = 0;
+template<typename U, typename IdxT> void avx_transpose_block(const U* const, const IdxT&, U* const, const IdxT&);
+#endif
+
 }   //end of namespace detail
 }   //end of namespace gtensor
 #endif
\ No newline at end of file
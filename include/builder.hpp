@@ -13,6 +13,7 @@
 #include "common.hpp"
 #include "math.hpp"
 #include "indexing.hpp"
+#include "multithreading.hpp"
 
 namespace gtensor{
 
@@ -69,6 +70,53 @@ struct builder
         return eye<T,Order,Config>(n,n,IdxT{0});
     }
 
+    //build from shape and value in parallel
+    //result is constructed without initialization of elements and then filled by parallel tasks according to policy,
+    //so pages of big result are first touched by threads that fill them
+    template<typename T, typename Order, typename Config, typename Policy, typename ShT>
+    static auto empty(Policy policy, ShT&& shape){
+        ASSERT_ORDER(Order);
+        using tensor_type = tensor<T,Order,config::extend_config_t<Config,T>>;
+        using shape_type = typename tensor_type::shape_type;
+        detail::unused_args{policy};
+        return tensor_type(detail::make_shape_of_type<shape_type>(std::forward<ShT>(shape)),no_init_t{});
+    }
+
+    template<typename T, typename Order, typename Config, typename Policy, typename ShT, typename U>
+    static auto full(Policy policy, ShT&& shape, const U& v){
+        auto res = empty<T,Order,Config>(policy,std::forward<ShT>(shape));
+        const auto& v_ = static_cast<const T&>(v);
+        auto a = res.traverse_order_adapter(Order{});
+        generate(policy,a.begin_trivial(),a.end_trivial(),[&v_](const auto&){return v_;});
+        return res;
+    }
+
+    template<typename T, typename Order, typename Config, typename Policy, typename ShT>
+    static auto zeros(Policy policy, ShT&& shape){
+        return full<T,Order,Config>(policy,std::forward<ShT>(shape),T{0});
+    }
+
+    template<typename T, typename Order, typename Config, typename Policy, typename ShT>
+    static auto ones(Policy policy, ShT&& shape){
+        return full<T,Order,Config>(policy,std::forward<ShT>(shape),T{1});
+    }
+
+    template<typename T, typename Order, typename Config, typename Policy, typename IdxT>
+    static auto eye(Policy policy, const IdxT& n_, const IdxT& m_, const IdxT& k_){
+        ASSERT_ORDER(Order);
+        auto res = zeros<T,Order,Config>(policy,std::initializer_list<IdxT>{n_,m_});
+        if (!res.empty()){
+            traverse_diagonal<Order>(
+                res.traverse_order_adapter(Order{}).begin(),
+                [](auto& e){e=T{1};},
+                n_,
+                m_,
+                k_
+            );
+        }
+        return res;
+    }
+
     template<typename ShT = detail::no_value, typename...Ts>
     static auto empty_like(const basic_tensor<Ts...>& t, ShT&& shape=ShT{}){
         using tensor_type = basic_tensor<Ts...>;
@@ -141,6 +189,28 @@ struct builder
         return res;
     }
 
+    //elements are calculated as start+i*step by parallel tasks according to policy
+    template<typename T, typename Order, typename Config, typename Policy, typename Start, typename Stop, typename Step>
+    static auto arange(Policy policy, const Start& start, const Stop& stop, const Step& step){
+        ASSERT_ORDER(Order);
+        using common_value_type = std::common_type_t<Start,Stop,Step>;
+        static_assert(math::numeric_traits<common_value_type>::is_integral() || math::numeric_traits<common_value_type>::is_floating_point(),"arange arguments must be of numeric type");
+        using value_type = std::conditional_t<std::is_same_v<T,detail::no_value>,common_value_type,T>;
+        using tensor_type = tensor<value_type,Order,config::extend_config_t<Config,value_type>>;
+        using index_type = typename tensor_type::index_type;
+        using shape_type = typename tensor_type::shape_type;
+        using integral_type = math::make_integral_t<common_value_type>;
+        using fp_type = math::make_floating_point_like_t<common_value_type>;
+        auto n = static_cast<index_type>(static_cast<integral_type>(math::ceil((stop-start)/static_cast<fp_type>(step))));
+        n = n > 0 ? n : index_type{0};
+        tensor_type res(shape_type{n},no_init_t{});
+        const auto step_ = static_cast<value_type>(step);
+        const auto start_ = static_cast<value_type>(start);
+        auto a = res.traverse_order_adapter(Order{});
+        generate(policy,a.begin_trivial(),a.end_trivial(),[&start_,&step_](const auto& i){return static_cast<value_type>(start_+static_cast<value_type>(i)*step_);});
+        return res;
+    }
+
     template<typename T, typename Order, typename Config, typename Start, typename Stop, typename Num, typename DimT>
     static auto linspace(const Start& start, const Stop& stop, const Num& num, bool end_point, const DimT& axis){
         auto generator = [end_point](auto first, auto last, const auto& start, const auto& stop, const auto& num){
@@ -155,6 +225,33 @@ struct builder
         return make_space<T,Order,Config>(start,stop,num,axis,generator);
     }
 
+    //if start and stop are numeric, elements are calculated as start+i*step by parallel tasks according to policy,
+    //otherwise samples are generated sequentially
+    template<typename T, typename Order, typename Config, typename Policy, typename Start, typename Stop, typename Num, typename DimT>
+    static auto linspace(Policy policy, const Start& start, const Stop& stop, const Num& num, bool end_point, const DimT& axis){
+        if constexpr (detail::is_tensor_v<Start> || detail::is_tensor_v<Stop>){
+            detail::unused_args{policy};
+            return linspace<T,Order,Config>(start,stop,num,end_point,axis);
+        }else{
+            ASSERT_ORDER(Order);
+            static_assert(math::numeric_traits<Num>::is_integral(),"num must be of integral type");
+            using common_value_type = std::common_type_t<Start,Stop,Num>;
+            static_assert(math::numeric_traits<common_value_type>::is_integral() || math::numeric_traits<common_value_type>::is_floating_point(),"linspace arguments must be of numeric type");
+            using value_type = std::conditional_t<std::is_same_v<T,detail::no_value>,math::make_floating_point_like_t<common_value_type>,math::make_floating_point_like_t<T>>;
+            using tensor_type = tensor<value_type,Order,config::extend_config_t<Config,value_type>>;
+            using index_type = typename tensor_type::index_type;
+            using shape_type = typename tensor_type::shape_type;
+            check_make_space_args(num);
+            tensor_type res(shape_type{static_cast<index_type>(num)},no_init_t{});
+            const auto intervals_n = end_point ?  static_cast<value_type>(num-1) : static_cast<value_type>(num);
+            const auto start_ = static_cast<value_type>(start);
+            const auto step = intervals_n == value_type{0} ? value_type{0} : (static_cast<value_type>(stop)-start_)/intervals_n;
+            auto a = res.traverse_order_adapter(Order{});
+            generate(policy,a.begin_trivial(),a.end_trivial(),[&start_,&step](const auto& i){return start_+static_cast<value_type>(i)*step;});
+            return res;
+        }
+    }
+
     template<typename T, typename Order, typename Config, typename Start, typename Stop, typename Num, typename Base, typename DimT>
     static auto logspace(const Start& start, const Stop& stop, const Num& num, bool end_point, const Base& base, const DimT& axis){
         auto generator = [end_point,base](auto first, auto last, const auto& start, const auto& stop, const auto& num){
@@ -247,6 +344,36 @@ private:
         }
     }
 
+    //assign f(i) to ith element of range, range is split into chunks that are processed by parallel tasks according to policy
+    template<typename Policy, typename It, typename F>
+    static void generate(Policy policy, It first, It last, F f){
+        using difference_type = typename std::iterator_traits<It>::difference_type;
+        auto body = [f](It first_, It last_, difference_type i){
+            for (;first_!=last_; ++first_,++i){
+                *first_ = f(i);
+            }
+        };
+        if constexpr (multithreading::exec_policy_traits<Policy>::is_seq::value){
+            detail::unused_args{policy};
+            body(first,last,difference_type{0});
+        }else{
+            const auto par_sizes = multithreading::make_par_task_size(policy,last-first);
+            if (par_sizes.size()<2){
+                body(first,last,difference_type{0});
+                return;
+            }
+            multithreading::task_group group{};
+            difference_type pos{0};
+            for (std::size_t i{0}; i!=par_sizes.size(); ++i){
+                const auto par_task_size = par_sizes[i];
+                multithreading::get_pool().push_group(group,body,first,first+par_task_size,pos);
+                first+=par_task_size;
+                pos+=par_task_size;
+            }
+            group.wait();
+        }
+    }
+
     template<typename IdxT>
     static auto make_diagonal_size(const IdxT& n, const IdxT& m, const IdxT& k){
         return n!=0 && m!=0 && k>-n && k<m ? (k>=0 ? std::min(n,m-k) : std::min(n+k,m)) : IdxT{0};
@@ -363,6 +490,17 @@ auto empty(std::initializer_list<U> shape){
     return builder_selector_t<Config>::template empty<T,Order,Config>(shape);
 }
 
+//make tensor of given shape, elements are default initialized: not initialized if value_type is trivial, default constructed otherwise
+//policy overloads of empty, full, zeros, ones, eye, arange, linspace fill result by parallel tasks according to policy
+template<typename T, typename Order = config::c_order, typename Config = config::default_config, typename Policy, typename ShT, std::enable_if_t<multithreading::is_policy_v<Policy>,int> =0>
+auto empty(Policy policy, ShT&& shape){
+    return builder_selector_t<Config>::template empty<T,Order,Config>(policy,std::forward<ShT>(shape));
+}
+template<typename T, typename Order = config::c_order, typename Config = config::default_config, typename Policy, typename U, std::enable_if_t<multithreading::is_policy_v<Policy>,int> =0>
+auto empty(Policy policy, std::initializer_list<U> shape){
+    return builder_selector_t<Config>::template empty<T,Order,Config>(policy,shape);
+}
+
 //make tensor of given shape, initialized with v
 template<typename T, typename Order = config::c_order, typename Config = config::default_config, typename ShT, typename V>
 auto full(ShT&& shape, const V& v){
@@ -373,6 +511,15 @@ auto full(std::initializer_list<U> shape, const V& v){
     return builder_selector_t<Config>::template full<T,Order,Config>(shape, v);
 }
 
+template<typename T, typename Order = config::c_order, typename Config = config::default_config, typename Policy, typename ShT, typename V, std::enable_if_t<multithreading::is_policy_v<Policy>,int> =0>
+auto full(Policy policy, ShT&& shape, const V& v){
+    return builder_selector_t<Config>::template full<T,Order,Config>(policy, std::forward<ShT>(shape), v);
+}
+template<typename T, typename Order = config::c_order, typename Config = config::default_config, typename Policy, typename U, typename V, std::enable_if_t<multithreading::is_policy_v<Policy>,int> =0>
+auto full(Policy policy, std::initializer_list<U> shape, const V& v){
+    return builder_selector_t<Config>::template full<T,Order,Config>(policy, shape, v);
+}
+
 //make tensor of given shape, initialized with zeros
 template<typename T, typename Order = config::c_order, typename Config = config::default_config, typename ShT>
 auto zeros(ShT&& shape){
@@ -383,6 +530,15 @@ auto zeros(std::initializer_list<U> shape){
     return builder_selector_t<Config>::template zeros<T,Order,Config>(shape);
 }
 
+template<typename T, typename Order = config::c_order, typename Config = config::default_config, typename Policy, typename ShT, std::enable_if_t<multithreading::is_policy_v<Policy>,int> =0>
+auto zeros(Policy policy, ShT&& shape){
+    return builder_selector_t<Config>::template zeros<T,Order,Config>(policy,std::forward<ShT>(shape));
+}
+template<typename T, typename Order = config::c_order, typename Config = config::default_config, typename Policy, typename U, std::enable_if_t<multithreading::is_policy_v<Policy>,int> =0>
+auto zeros(Policy policy, std::initializer_list<U> shape){
+    return builder_selector_t<Config>::template zeros<T,Order,Config>(policy,shape);
+}
+
 //make tensor of given shape, initialized with ones
 template<typename T, typename Order = config::c_order, typename Config = config::default_config, typename ShT>
 auto ones(ShT&& shape){
@@ -393,6 +549,15 @@ auto ones(std::initializer_list<U> shape){
     return builder_selector_t<Config>::template ones<T,Order,Config>(shape);
 }
 
+template<typename T, typename Order = config::c_order, typename Config = config::default_config, typename Policy, typename ShT, std::enable_if_t<multithreading::is_policy_v<Policy>,int> =0>
+auto ones(Policy policy, ShT&& shape){
+    return builder_selector_t<Config>::template ones<T,Order,Config>(policy,std::forward<ShT>(shape));
+}
+template<typename T, typename Order = config::c_order, typename Config = config::default_config, typename Policy, typename U, std::enable_if_t<multithreading::is_policy_v<Policy>,int> =0>
+auto ones(Policy policy, std::initializer_list<U> shape){
+    return builder_selector_t<Config>::template ones<T,Order,Config>(policy,shape);
+}
+
 //make tensor of shape (n,n) with ones on main diagonal
 template<typename T, typename Order = config::c_order, typename Config = config::default_config, typename IdxT>
 auto identity(const IdxT& n){
@@ -405,6 +570,10 @@ template<typename T, typename Order = config::c_order, typename Config = config:
 auto eye(const IdxT& n, const IdxT& m, const IdxT& k=0){
     return builder_selector_t<Config>::template eye<T,Order,Config>(n,m,k);
 }
+template<typename T, typename Order = config::c_order, typename Config = config::default_config, typename Policy, typename IdxT = int, std::enable_if_t<multithreading::is_policy_v<Policy>,int> =0>
+auto eye(Policy policy, const IdxT& n, const IdxT& m, const IdxT& k=0){
+    return builder_selector_t<Config>::template eye<T,Order,Config>(policy,n,m,k);
+}
 
 //make tensor of the same layout,value_type,config_type as t
 //elements initialization depends on underlaying storage implementation
@@ -462,7 +631,7 @@ auto ones_like(const basic_tensor<Ts...>& t){
 //make 1d tensor of evenly spaced values whithin a given interval
 //result's value_type, layout and config may be specified by explicit specialization of T,Order,Config template's parameters
 //T is not specialized explicitly result value_type is infered from Start,Stop,Step types
-template<typename T=detail::no_value, typename Order = config::c_order, typename Config = config::default_config, typename Start, typename Stop, typename Step=int>
+template<typename T=detail::no_value, typename Order = config::c_order, typename Config = config::default_config, typename Start, typename Stop, typename Step=int, std::enable_if_t<!multithreading::is_policy_v<Start>,int> =0>
 auto arange(const Start& start, const Stop& stop, const Step& step=Step{1}){
     return builder_selector_t<Config>::template arange<T,Order,Config>(start,stop,step);
 }
@@ -470,15 +639,27 @@ template<typename T=detail::no_value, typename Order = config::c_order, typename
 auto arange(const Stop& stop){
     return builder_selector_t<Config>::template arange<T,Order,Config>(Stop{0},stop,Stop{1});
 }
+template<typename T=detail::no_value, typename Order = config::c_order, typename Config = config::default_config, typename Policy, typename Start, typename Stop, typename Step=int, std::enable_if_t<multithreading::is_policy_v<Policy>,int> =0>
+auto arange(Policy policy, const Start& start, const Stop& stop, const Step& step=Step{1}){
+    return builder_selector_t<Config>::template arange<T,Order,Config>(policy,start,stop,step);
+}
+template<typename T=detail::no_value, typename Order = config::c_order, typename Config = config::default_config, typename Policy, typename Stop, std::enable_if_t<multithreading::is_policy_v<Policy>,int> =0>
+auto arange(Policy policy, const Stop& stop){
+    return builder_selector_t<Config>::template arange<T,Order,Config>(policy,Stop{0},stop,Stop{1});
+}
 
 //make tensor of num evenly spaced samples, calculated over the interval start, stop
 //start, stop may be scalar or tensor, if either is tensor samples will be along axis
 //result's value_type, layout and config may be specified by explicit specialization of T,Order,Config template's parameters
 //T is not specialized explicitly result value_type is infered from Start,Stop,Num types
-template<typename T=detail::no_value, typename Order = config::c_order, typename Config = config::default_config, typename Start, typename Stop, typename Num=int, typename DimT=int>
+template<typename T=detail::no_value, typename Order = config::c_order, typename Config = config::default_config, typename Start, typename Stop, typename Num=int, typename DimT=int, std::enable_if_t<!multithreading::is_policy_v<Start>,int> =0>
 auto linspace(const Start& start, const Stop& stop, const Num& num=50, bool end_point=true, const DimT& axis=0){
     return builder_selector_t<Config>::template linspace<T,Order,Config>(start,stop,num,end_point,axis);
 }
+template<typename T=detail::no_value, typename Order = config::c_order, typename Config = config::default_config, typename Policy, typename Start, typename Stop, typename Num=int, typename DimT=int, std::enable_if_t<multithreading::is_policy_v<Policy>,int> =0>
+auto linspace(Policy policy, const Start& start, const Stop& stop, const Num& num=50, bool end_point=true, const DimT& axis=0){
+    return builder_selector_t<Config>::template linspace<T,Order,Config>(policy,start,stop,num,end_point,axis);
+}
 
 //make tensor of numbers spaced evenly on a log scale
 template<typename T=detail::no_value, typename Order = config::c_order, typename Config = config::default_config, typename Start, typename Stop, typename Num=int, typename Base=double, typename DimT=int>
@@ -63,6 +63,7 @@ GENERATE_HAS_CALLABLE_METHOD(rend_trivial(), has_callable_rend_trivial);
 GENERATE_HAS_CALLABLE_METHOD(create_trivial_indexer(), has_callable_create_trivial_indexer);
 GENERATE_HAS_CALLABLE_METHOD(is_trivial(), has_callable_is_trivial);
 GENERATE_HAS_CALLABLE_METHOD(element(std::declval<typename T::index_type>()), has_callable_element);
+GENERATE_HAS_CALLABLE_METHOD(size(), has_callable_size);
 
 template<typename T> using has_callable_subscript_operator = std::disjunction<
     has_callable_subscript_operator_difference_type<T>,
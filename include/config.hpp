@@ -11,17 +11,22 @@
 
 #include <vector>
 #include "storage.hpp"
+#include "allocation.hpp"
 
 namespace gtensor{
 namespace config{
 
 enum class div_modes {native, libdivide};
+enum class sum_modes {naive, pairwise, kahan};
 enum class engines {expression_template};
 enum class orders {c,f};
 enum class cloning_semantics {deep,shallow};
 
 using mode_div_native = std::integral_constant<div_modes, div_modes::native>;
 using mode_div_libdivide = std::integral_constant<div_modes, div_modes::libdivide>;
+using mode_sum_naive = std::integral_constant<sum_modes, sum_modes::naive>;
+using mode_sum_pairwise = std::integral_constant<sum_modes, sum_modes::pairwise>;
+using mode_sum_kahan = std::integral_constant<sum_modes, sum_modes::kahan>;
 using engine_expression_template = std::integral_constant<engines, engines::expression_template>;
 using c_order = std::integral_constant<orders, orders::c>;
 using f_order = std::integral_constant<orders, orders::f>;
@@ -36,6 +41,15 @@ struct default_config
     using div_mode = mode_div_libdivide;
     //using div_mode = mode_div_native;
 
+    //specify summation algorithm of sum, nansum, mean, var, stdev for floating point and complex elements
+    //pairwise - blocked pairwise summation, error grows as O(log(n)), faster than naive summation of long contiguous ranges, slower along short axes
+    //kahan - second order Kahan-Babuska compensated summation, error doesn't grow with n, slower
+    //naive - left fold, error grows as O(n)
+    //cumsum, nancumsum add left fold of blocks to compensated sum in pairwise mode and use compensated running sum in kahan mode
+    using sum_mode = mode_sum_pairwise;
+    //using sum_mode = mode_sum_kahan;
+    //using sum_mode = mode_sum_naive;
+
     //specify default traverse order of iterators
     using order = c_order;
     //using order = f_order;
@@ -57,6 +71,12 @@ struct default_config
     //must provide std::vector like interface
     template<typename T> using container = std::vector<T>;
 
+    //container of temporary buffers used inside routines e.g. quantile, argsort, unique
+    //buffers never leave routine and thread they are allocated on
+    //default allocates from per thread scratch arena that is reused between calls, std::vector<T> may be used to allocate from heap
+    //must provide std::vector like interface
+    template<typename T> using scratch_container = std::vector<T,allocation::scratch_allocator<T>>;
+
     //index_map specialization is used in mapping_descriptor that is descriptor type of mapping_view
     //it is natural to use storage as index_map in general, but if storage is specific e.g. map to file system or network, these should differ
     template<typename T> using index_map = storage<T>;
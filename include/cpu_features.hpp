@@ -0,0 +1,287 @@
+/*
+* GTensor - computation library
+* Copyright (c) 2022 Ivan Malezhyk <ivanmzk@gmail.com>
+*
+* Distributed under the Boost Software License, Version 1.0.
+* The full license is in the file LICENSE.txt, distributed with this software.
+*/
+
+#ifndef CPU_FEATURES_HPP_
+#define CPU_FEATURES_HPP_
+
+#include <atomic>
+#include <string>
+#include <fstream>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define GTENSOR_X86 1
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#else
+    #define GTENSOR_X86 0
+#endif
+
+//kernels for instruction sets wider than compiler's target are compiled using function target attributes,
+//such kernels are called only after runtime check of cpu features, so single binary may be built for lowest common instruction set
+//msvc allows intrinsics of any instruction set without attributes
+//GTENSOR_HAS_ISA_DISPATCH is 0 if compiler can't do it, in this case only instruction sets enabled at compile time are used
+#if GTENSOR_X86 && (defined(__GNUC__) || defined(__clang__))
+    #define GTENSOR_HAS_ISA_DISPATCH 1
+    #define GTENSOR_TARGET_AVX2 __attribute__((target("avx,avx2,fma")))
+    #define GTENSOR_TARGET_AVX512 __attribute__((target("avx,avx2,fma,avx512f,avx512dq,avx512bw")))
+#elif GTENSOR_X86 && defined(_MSC_VER)
+    #define GTENSOR_HAS_ISA_DISPATCH 1
+    #define GTENSOR_TARGET_AVX2
+    #define GTENSOR_TARGET_AVX512
+#else
+    #define GTENSOR_HAS_ISA_DISPATCH 0
+    #define GTENSOR_TARGET_AVX2
+    #define GTENSOR_TARGET_AVX512
+#endif
+
+namespace gtensor{
+
+//instruction set levels of kernels, ordered
+//avx2 means AVX2 and FMA, avx512 means AVX-512F, AVX-512DQ and AVX-512BW
+enum class isa : int {generic, avx2, avx512};
+
+namespace detail{
+
+#if GTENSOR_X86 && defined(_MSC_VER) && !defined(__clang__)
+inline isa detect_isa(){
+    int regs[4]{};
+    __cpuid(regs,0);
+    const int max_leaf = regs[0];
+    __cpuid(regs,1);
+    const bool osxsave = (regs[2]&(1<<27)) != 0;
+    const bool avx = (regs[2]&(1<<28)) != 0;
+    const bool fma = (regs[2]&(1<<12)) != 0;
+    if (!osxsave || !avx || max_leaf < 7){
+        return isa::generic;
+    }
+    const auto xcr0 = _xgetbv(0);
+    __cpuidex(regs,7,0);
+    const bool avx2 = (regs[1]&(1<<5)) != 0;
+    const bool avx512f = (regs[1]&(1<<16)) != 0;
+    const bool avx512dq = (regs[1]&(1<<17)) != 0;
+    const bool avx512bw = (regs[1]&(1<<30)) != 0;
+    if (avx512f && avx512dq && avx512bw && fma && (xcr0&0xe6) == 0xe6){
+        return isa::avx512;
+    }
+    if (avx2 && fma && (xcr0&0x6) == 0x6){
+        return isa::avx2;
+    }
+    return isa::generic;
+}
+#elif GTENSOR_X86 && (defined(__GNUC__) || defined(__clang__))
+//__builtin_cpu_supports checks os support of extended registers too
+inline isa detect_isa(){
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("fma")){
+        return isa::avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")){
+        return isa::avx2;
+    }
+    return isa::generic;
+}
+#else
+inline isa detect_isa(){
+    return isa::generic;
+}
+#endif
+
+//widest instruction set that compiler can target
+inline constexpr isa compile_isa(){
+#if GTENSOR_HAS_ISA_DISPATCH
+    return isa::avx512;
+#elif defined(__AVX512F__) && defined(__AVX512DQ__) && defined(__AVX512BW__) && defined(__FMA__)
+    return isa::avx512;
+#elif defined(__AVX2__) && defined(__FMA__)
+    return isa::avx2;
+#else
+    return isa::generic;
+#endif
+}
+
+inline std::atomic<isa>& max_isa_(){
+    static std::atomic<isa> max_isa{isa::avx512};
+    return max_isa;
+}
+
+}   //end of namespace detail
+
+//sizes of data caches in bytes, zero means unknown
+struct cache_sizes
+{
+    std::size_t l1d;
+    std::size_t l2;
+    std::size_t l3;
+};
+
+namespace detail{
+
+//used if cache size can't be detected
+inline constexpr cache_sizes default_cache_sizes{32768,262144,8388608};
+
+//sysfs cache description of cpu0, size is like "48K"
+inline cache_sizes detect_cache_sizes_sysfs(){
+    cache_sizes res{0,0,0};
+    const std::string dir{"/sys/devices/system/cpu/cpu0/cache/index"};
+    for (int i=0; i!=8; ++i){
+        std::ifstream level_f(dir+std::to_string(i)+"/level");
+        std::ifstream type_f(dir+std::to_string(i)+"/type");
+        std::ifstream size_f(dir+std::to_string(i)+"/size");
+        int level{0};
+        std::string type{};
+        std::string size{};
+        if (!(level_f>>level) || !(type_f>>type) || !(size_f>>size) || type=="Instruction" || size.empty()){
+            continue;
+        }
+        std::size_t n{0};
+        std::size_t pos{0};
+        for (;pos!=size.size() && size[pos]>='0' && size[pos]<='9'; ++pos){
+            n = n*10+static_cast<std::size_t>(size[pos]-'0');
+        }
+        if (pos!=size.size()){
+            if (size[pos]=='K'){
+                n*=1024;
+            }else if (size[pos]=='M'){
+                n*=1024*1024;
+            }
+        }
+        if (level==1){
+            res.l1d = n;
+        }else if (level==2){
+            res.l2 = n;
+        }else if (level==3){
+            res.l3 = n;
+        }
+    }
+    return res;
+}
+
+//deterministic cache parameters, leaf 4 on Intel, leaf 0x8000001d on AMD
+inline cache_sizes detect_cache_sizes_cpuid(){
+    cache_sizes res{0,0,0};
+#if GTENSOR_X86
+    auto cpuid = [](unsigned leaf, unsigned subleaf, unsigned* regs){
+    #if defined(_MSC_VER) && !defined(__clang__)
+        int regs_[4]{};
+        __cpuidex(regs_,static_cast<int>(leaf),static_cast<int>(subleaf));
+        for (int i=0; i!=4; ++i){
+            regs[i] = static_cast<unsigned>(regs_[i]);
+        }
+    #else
+        __cpuid_count(leaf,subleaf,regs[0],regs[1],regs[2],regs[3]);
+    #endif
+    };
+    unsigned regs[4]{};
+    cpuid(0,0,regs);
+    const unsigned max_leaf = regs[0];
+    cpuid(0x80000000,0,regs);
+    const unsigned max_ext_leaf = regs[0];
+    unsigned leaf{0};
+    if (max_leaf>=4){
+        cpuid(4,0,regs);
+        leaf = (regs[0]&0x1f)!=0 ? 4 : 0;
+    }
+    if (leaf==0 && max_ext_leaf>=0x8000001d){
+        leaf = 0x8000001d;
+    }
+    for (unsigned i=0; leaf!=0 && i!=16; ++i){
+        cpuid(leaf,i,regs);
+        const unsigned type = regs[0]&0x1f;
+        if (type==0){
+            break;
+        }
+        if (type==2){   //instruction cache
+            continue;
+        }
+        const unsigned level = (regs[0]>>5)&0x7;
+        const std::size_t ways = ((regs[1]>>22)&0x3ff)+1;
+        const std::size_t partitions = ((regs[1]>>12)&0x3ff)+1;
+        const std::size_t line_size = (regs[1]&0xfff)+1;
+        const std::size_t sets = std::size_t{regs[2]}+1;
+        const std::size_t n = ways*partitions*line_size*sets;
+        if (level==1){
+            res.l1d = n;
+        }else if (level==2){
+            res.l2 = n;
+        }else if (level==3){
+            res.l3 = n;
+        }
+    }
+#endif
+    return res;
+}
+
+inline cache_sizes detect_cache_sizes(){
+    auto res = detect_cache_sizes_sysfs();
+    if (res.l1d==0 || res.l2==0){
+        const auto res_cpuid = detect_cache_sizes_cpuid();
+        res.l1d = res.l1d==0 ? res_cpuid.l1d : res.l1d;
+        res.l2 = res.l2==0 ? res_cpuid.l2 : res.l2;
+        res.l3 = res.l3==0 ? res_cpuid.l3 : res.l3;
+    }
+    res.l1d = res.l1d==0 ? default_cache_sizes.l1d : res.l1d;
+    res.l2 = res.l2==0 ? default_cache_sizes.l2 : res.l2;
+    res.l3 = res.l3==0 ? std::max(res.l2,default_cache_sizes.l3) : res.l3;
+    return res;
+}
+
+inline std::atomic<std::size_t>* cache_sizes_(){
+    static std::atomic<std::size_t> sizes[3]{};
+    return sizes;
+}
+
+}   //end of namespace detail
+
+//cache sizes of cpu, detected once per process from sysfs or cpuid
+inline cache_sizes cpu_cache_sizes(){
+    static const cache_sizes res = detail::detect_cache_sizes();
+    return res;
+}
+
+//override cache sizes used to compute blocking of kernels, zero size means detected size is used
+inline void set_cache_sizes(const cache_sizes& sizes){
+    detail::cache_sizes_()[0].store(sizes.l1d,std::memory_order_relaxed);
+    detail::cache_sizes_()[1].store(sizes.l2,std::memory_order_relaxed);
+    detail::cache_sizes_()[2].store(sizes.l3,std::memory_order_relaxed);
+}
+
+//cache sizes to compute blocking of kernels
+inline cache_sizes kernel_cache_sizes(){
+    const auto detected = cpu_cache_sizes();
+    const std::size_t l1d = detail::cache_sizes_()[0].load(std::memory_order_relaxed);
+    const std::size_t l2 = detail::cache_sizes_()[1].load(std::memory_order_relaxed);
+    const std::size_t l3 = detail::cache_sizes_()[2].load(std::memory_order_relaxed);
+    return cache_sizes{l1d==0 ? detected.l1d : l1d, l2==0 ? detected.l2 : l2, l3==0 ? detected.l3 : l3};
+}
+
+//widest instruction set supported by both cpu and compiler, detected once per process
+inline isa cpu_isa(){
+    static const isa res = std::min(detail::detect_isa(),detail::compile_isa());
+    return res;
+}
+
+//limit instruction set of kernels, e.g. to reproduce results of other hosts
+inline void set_max_isa(isa level){
+    detail::max_isa_().store(level,std::memory_order_relaxed);
+}
+inline isa max_isa(){
+    return detail::max_isa_().load(std::memory_order_relaxed);
+}
+
+//instruction set of kernels to use
+inline isa kernel_isa(){
+    return std::min(cpu_isa(),max_isa());
+}
+
+}   //end of namespace gtensor
+#endif
@@ -178,6 +178,95 @@ ALWAYS_INLINE bool prev_f(Walker& walker, const IdxIt index_first, const ShIt sh
 #undef NEXT_ON_AXIS
 #undef PREV_ON_AXIS
 
+GENERATE_HAS_CALLABLE_METHOD(stride(std::declval<typename T::dim_type>()), has_callable_stride);
+GENERATE_HAS_CALLABLE_METHOD(can_coalesce(std::declval<typename T::dim_type>(),std::declval<typename T::dim_type>(),std::declval<typename T::index_type>()), has_callable_can_coalesce);
+
+//true if walker's outer axis step equals inner_extent steps along inner axis, that is two axes can be traversed as single axis stepping along inner
+//walkers that don't expose strides are never coalesced
+template<typename Walker, typename DimT, typename IdxT>
+ALWAYS_INLINE bool can_coalesce(const Walker& walker, const DimT& outer, const DimT& inner, const IdxT& inner_extent){
+    if constexpr (has_callable_can_coalesce<const Walker>::value){
+        return walker.can_coalesce(outer,inner,inner_extent);
+    }else if constexpr (has_callable_stride<const Walker>::value){
+        return walker.stride(outer) == inner_extent*walker.stride(inner);
+    }else{
+        (void)walker;(void)outer;(void)inner;(void)inner_extent;
+        return false;
+    }
+}
+
+//call f(walker) for every element of shape in Order, walker must be at first element
+//adjacent axes that walker can coalesce are traversed as single axis, unit extent axes are skipped
+//walker is reset to first element on return
+template<typename Order, typename ShT, typename Walker, typename F>
+void walk_coalesced(const ShT& shape, Walker& walker, F&& f){
+    ASSERT_ORDER(Order);
+    using index_type = typename ShT::value_type;
+    using dim_type = typename Walker::dim_type;
+    const dim_type dim = detail::make_dim(shape);
+    if (std::find(shape.begin(),shape.end(),index_type{0}) != shape.end()){
+        return;
+    }
+    //axes from inner to outer, group g consists of axes [axes_first[g],axes_first[g+1]), its first axis is inner
+    ShT axes{};
+    ShT axes_first{};
+    ShT extents{};
+    detail::reserve(axes,dim);
+    detail::reserve(axes_first,dim+1);
+    detail::reserve(extents,dim);
+    for (dim_type i=0; i!=dim; ++i){
+        const dim_type axis = std::is_same_v<Order,gtensor::config::c_order> ? dim-1-i : i;
+        const index_type extent = shape[axis];
+        if (extent == index_type{1}){
+            continue;
+        }
+        if (!axes.empty() && can_coalesce(walker,axis,static_cast<dim_type>(axes.back()),shape[axes.back()])){
+            extents.back()*=extent;
+        }else{
+            axes_first.push_back(static_cast<index_type>(axes.size()));
+            extents.push_back(extent);
+        }
+        axes.push_back(axis);
+    }
+    axes_first.push_back(static_cast<index_type>(axes.size()));
+    const index_type groups_number = static_cast<index_type>(extents.size());
+    if (groups_number == index_type{0}){
+        f(walker);
+        return;
+    }
+    auto reset_group = [&walker,&axes,&axes_first](const index_type& g){
+        for (auto i=axes_first[g], last=axes_first[g+1]; i!=last; ++i){
+            walker.reset_back(static_cast<dim_type>(axes[i]));
+        }
+    };
+    const dim_type inner_axis = static_cast<dim_type>(axes.front());
+    const index_type inner_extent = extents.front();
+    ShT index(groups_number,index_type{0});
+    while(true){
+        for (index_type i=1; i!=inner_extent; ++i){
+            f(walker);
+            walker.step(inner_axis);
+        }
+        f(walker);
+        reset_group(index_type{0});
+        index_type g=1;
+        for (; g!=groups_number; ++g){
+            auto& i = index[g];
+            if (i == extents[g]-1){
+                i = 0;
+                reset_group(g);
+            }else{
+                ++i;
+                walker.step(static_cast<dim_type>(axes[axes_first[g]]));
+                break;
+            }
+        }
+        if (g == groups_number){
+            return;
+        }
+    }
+}
+
 #define TO_LAST_ON_AXIS(axis)\
 auto& i = *(index_first+axis);\
 auto dec_axis_size = *(shape_first+axis)-1;\
@@ -490,6 +579,10 @@ public:
     ALWAYS_INLINE void update_offset(){
         offset_+=(cursor_-offset_);
     }
+    //cursor displacement of single step along axis
+    ALWAYS_INLINE index_type stride(const dim_type& axis)const{
+        return *(adapted_strides_it_+axis);
+    }
     ALWAYS_INLINE reference operator*()const{
         if constexpr (is_cursor_iterator){
             return *cursor_;
@@ -529,6 +622,7 @@ public:
     using base_type::reset;
     using base_type::reset_back;
     using base_type::update_offset;
+    using base_type::stride;
     ALWAYS_INLINE reference operator*()const{
         return indexer[base_type::operator*()];
     }
@@ -568,6 +662,10 @@ public:
     using base_walker_type::reset_back;
     using base_walker_type::operator*;
     using base_walker_type::update_offset;
+    template<typename W=base_walker_type, std::enable_if_t<detail::has_callable_stride<const W>::value,int> =0>
+    ALWAYS_INLINE index_type stride(const dim_type& axis)const{
+        return base_walker_type::stride(axis);
+    }
 };
 
 template<typename BaseWalker>
@@ -612,10 +710,14 @@ public:
     ALWAYS_INLINE void reset_back(){
         base_walker_type::reset_back();
     }
+    template<typename W=base_walker_type, std::enable_if_t<detail::has_callable_stride<const W>::value,int> =0>
+    ALWAYS_INLINE index_type stride(const dim_type& axis)const{
+        return base_walker_type::stride(map_axis(axis));
+    }
     using base_walker_type::operator*;
     using base_walker_type::update_offset;
 private:
-    ALWAYS_INLINE dim_type map_axis(const dim_type& axis){
+    ALWAYS_INLINE dim_type map_axis(const dim_type& axis)const{
         return (*axes_map_)[axis];
     }
     const axes_map_type* axes_map_;
@@ -652,6 +754,10 @@ public:
     ALWAYS_INLINE void step_back(const dim_type& axis){
         base_walker_type::walk_back(axis,step_scale(axis));
     }
+    template<typename W=base_walker_type, std::enable_if_t<detail::has_callable_stride<const W>::value,int> =0>
+    ALWAYS_INLINE index_type stride(const dim_type& axis)const{
+        return base_walker_type::stride(axis)*step_scale(axis);
+    }
     using base_walker_type::reset;
     using base_walker_type::reset_back;
     using base_walker_type::operator*;
@@ -710,6 +816,10 @@ public:
     ALWAYS_INLINE void reset_back(){
         base_walker_type::reset_back();
     }
+    template<typename W=base_walker_type, std::enable_if_t<detail::has_callable_stride<const W>::value,int> =0>
+    ALWAYS_INLINE index_type stride(const dim_type& axis)const{
+        return can_move_on_axis(axis) ? base_walker_type::stride(axis) : index_type{0};
+    }
     using base_walker_type::operator*;
     using base_walker_type::update_offset;
 private:
@@ -773,6 +883,10 @@ public:
     ALWAYS_INLINE void reset_back(){
         base_walker_type::reset_back();
     }
+    template<typename W=base_walker_type, std::enable_if_t<detail::has_callable_stride<const W>::value,int> =0>
+    ALWAYS_INLINE index_type stride(const dim_type& axis)const{
+        return axis>=dim_offset_ ? base_walker_type::stride(axis-dim_offset_) : index_type{0};
+    }
     using base_walker_type::operator*;
     using base_walker_type::update_offset;
 private:
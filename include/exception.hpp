@@ -49,6 +49,14 @@ public:
     {}
 };
 
+//should be raised when file operation fails
+class io_error : public gtensor_error
+{
+public:
+    explicit io_error(const char* what):
+        gtensor_error(what)
+    {}
+};
 
 }   //end of namespace gtensor
 #endif
\ No newline at end of file
@@ -79,6 +79,12 @@ public:
     bool is_trivial()const{
         return is_trivial_helper(sequence_type{});
     }
+    const F& functor()const{
+        return f_;
+    }
+    const auto& operands()const{
+        return operands_;
+    }
 private:
     template<typename U, std::size_t...I>
     static auto create_walker_helper(U& instance, dim_type max_dim, std::index_sequence<I...>){
@@ -214,6 +220,12 @@ public:
     bool is_trivial()const{
         return operand_.is_trivial();
     }
+    const F& functor()const{
+        return f_;
+    }
+    auto operands()const{
+        return std::tie(operand_);
+    }
 private:
     template<typename U>
     static auto begin_helper(U& instance){
@@ -11,6 +11,7 @@
 
 #include <type_traits>
 #include "common.hpp"
+#include "data_accessor.hpp"
 namespace gtensor{
 
 namespace detail{
@@ -84,6 +85,10 @@ public:
         auto f = [](auto& w){w.update_offset();};
         detail::apply_per_element(f,walkers_);
     }
+    //axes can be coalesced only if they can be coalesced for every operand
+    bool can_coalesce(const dim_type& outer, const dim_type& inner, const index_type& inner_extent)const{
+        return can_coalesce_helper(outer,inner,inner_extent,sequence_type{});
+    }
     ALWAYS_INLINE decltype(auto) operator*()const{
         return deref_helper(sequence_type{});
     }
@@ -92,6 +97,10 @@ private:
     ALWAYS_INLINE decltype(auto) deref_helper(std::index_sequence<I...>)const{
         return f_(*std::get<I>(walkers_)...);
     }
+    template<std::size_t...I>
+    bool can_coalesce_helper(const dim_type& outer, const dim_type& inner, const index_type& inner_extent, std::index_sequence<I...>)const{
+        return (detail::can_coalesce(std::get<I>(walkers_),outer,inner,inner_extent)&&...);
+    }
 
     F f_;
     tuple_type<Walkers...> walkers_;
@@ -10,8 +10,10 @@
 #define EXPRESSION_TEMPLATE_OPERATORS_HPP_
 
 #include "common.hpp"
+#include "multithreading.hpp"
 #include "tensor_implementation.hpp"
 #include "expression_template_core.hpp"
+#include "expression_template_simd.hpp"
 
 namespace gtensor{
 
@@ -24,8 +26,8 @@ template<typename F, typename Scalar, typename Order>
 class binary_operation_scalar_wrapper{
     F f_;
     Scalar scalar_;
-    static constexpr bool is_scalar_first = Order::value == binary_operation_scalar_order::scalar_first;
 public:
+    static constexpr bool is_scalar_first = Order::value == binary_operation_scalar_order::scalar_first;
     template<typename F_, typename Scalar_>
     binary_operation_scalar_wrapper(F_&& f__, Scalar_&& scalar__):
         f_{std::forward<F_>(f__)},
@@ -39,6 +41,12 @@ public:
             return f_(std::forward<U>(u),scalar_);
         }
     }
+    const F& functor()const{
+        return f_;
+    }
+    const Scalar& scalar()const{
+        return scalar_;
+    }
 };
 
 template<typename, typename T, std::enable_if_t<is_tensor_v<std::remove_cv_t<std::remove_reference_t<T>>>,int> =0>
@@ -51,6 +59,56 @@ inline auto forward_as_tensor(T&& t){
     return tensor<value_type,gtensor::config::c_order,config::extend_config_t<Config,value_type>>(t);
 }
 
+//traverse elements of t in Order calling f(walker) for each, mergeable axes are traversed as single axis
+//parallel tasks are blocks along outer axis, make_f(pos) should return f for block which first element has flat position pos
+template<typename Order, typename Policy, typename Tensor, typename MakeF>
+void walk_coalesced_tensor(Policy policy, Tensor& t, MakeF make_f){
+    ASSERT_ORDER(Order);
+    using index_type = typename Tensor::index_type;
+    using dim_type = typename Tensor::dim_type;
+    if (t.empty()){
+        return;
+    }
+    const auto& shape = t.shape();
+    const dim_type dim = t.dim();
+    auto walk_all = [&t,&shape,&make_f](){
+        auto walker = t.create_walker();
+        detail::walk_coalesced<Order>(shape,walker,make_f(index_type{0}));
+    };
+    if constexpr (multithreading::exec_policy_traits<Policy>::is_seq::value){
+        detail::unused_args{policy,dim};
+        walk_all();
+    }else{  //parallelize
+        if (dim == dim_type{0}){
+            walk_all();
+            return;
+        }
+        const dim_type outer = std::is_same_v<Order,gtensor::config::c_order> ? dim_type{0} : dim-1;
+        const index_type outer_size = shape[outer];
+        const index_type block_size = t.size()/outer_size;
+        const auto par_sizes = multithreading::make_par_task_size(policy,outer_size);
+        if (par_sizes.size()<2){
+            walk_all();
+            return;
+        }
+        auto body = [&t,&shape,&make_f,outer,block_size](const index_type& first, const index_type& last){
+            auto block_shape = shape;
+            block_shape[outer] = last-first;
+            auto walker = t.create_walker();
+            walker.walk(outer,first);
+            detail::walk_coalesced<Order>(block_shape,walker,make_f(first*block_size));
+        };
+        multithreading::task_group group{};
+        index_type first{0};
+        for (std::size_t i{0}; i!=par_sizes.size(); ++i){
+            const index_type last = first+par_sizes[i];
+            multithreading::get_pool().push_group(group,body,first,last);
+            first = last;
+        }
+        group.wait();
+    }
+}
+
 }   //end of namespace detail
 
 class expression_template_operator{
@@ -86,10 +144,10 @@ public:
         if constexpr (is_operand1_tensor&&is_operand2_tensor){
             return n_operator_(std::forward<F>(f), std::forward<Operand1>(operand1), std::forward<Operand2>(operand2));
         }else if constexpr (is_operand1_tensor){
-            using operation_type = detail::binary_operation_scalar_wrapper<F_,std::remove_reference_t<Operand2>,detail::scalar_second_type>;
+            using operation_type = detail::binary_operation_scalar_wrapper<F_,std::remove_cv_t<std::remove_reference_t<Operand2>>,detail::scalar_second_type>;
             return n_operator_(operation_type{std::forward<F>(f),std::forward<Operand2>(operand2)},std::forward<Operand1>(operand1));
         }else{
-            using operation_type = detail::binary_operation_scalar_wrapper<F_,std::remove_reference_t<Operand1>,detail::scalar_first_type>;
+            using operation_type = detail::binary_operation_scalar_wrapper<F_,std::remove_cv_t<std::remove_reference_t<Operand1>>,detail::scalar_first_type>;
             return n_operator_(operation_type{std::forward<F>(f),std::forward<Operand1>(operand1)},std::forward<Operand2>(operand2));
         }
     }
@@ -109,23 +167,73 @@ public:
     //shapes of lhs and rhs must be broadcastable, scalar rhs is allowed
     //assign operation is defined by F
     //not lazy
-    template<typename F, typename Tensor, typename Rhs>
-    static auto& a_operator(F&& f, Tensor&& lhs, Rhs&& rhs){
+    //policy is specialization of multithreading::exec_pol or multithreading::exec_pol_rt
+    //trivial range is splitted into parallel tasks elementwise, not trivial range is splitted along outer axis
+    //when executed in parallel lhs elements must not alias each other or rhs elements
+    template<typename Policy, typename F, typename Tensor, typename Rhs>
+    static auto& a_operator(Policy policy, F&& f, Tensor&& lhs, Rhs&& rhs){
         using Tensor_ = std::decay_t<Tensor>;
         static_assert(detail::is_tensor_v<Tensor_>,"lhs must be tensor");
         using order = typename Tensor_::order;
-        auto tmp = n_operator(std::forward<F>(f),std::forward<Tensor>(lhs),std::forward<Rhs>(rhs));
-        auto a = tmp.traverse_order_adapter(order{});
-        if (tmp.is_trivial()){
-            for (auto it = a.begin_trivial(), last = a.end_trivial(); it!=last; ++it){
-                (void)*it;
+        if constexpr (!std::is_const_v<std::remove_reference_t<Tensor>>){
+            //storage lhs and trivial rhs of the same shape are evaluated in vector registers if possible
+            if (detail::simd_assign_tensors(policy,f,lhs,rhs)){
+                return lhs;
             }
+        }
+        const auto lhs_size = lhs.size();
+        auto tmp = n_operator(std::forward<F>(f),std::forward<Tensor>(lhs),std::forward<Rhs>(rhs));
+        if (tmp.size() == lhs_size){
+            eval_tensor<order>(policy,tmp);
+        }else{  //lhs is broadcast, some of its elements are assigned multiple times
+            eval_tensor<order>(multithreading::exec_pol<1>{},tmp);
+        }
+        return lhs;
+    }
+    template<typename F, typename Tensor, typename Rhs>
+    static auto& a_operator(F&& f, Tensor&& lhs, Rhs&& rhs){
+        return a_operator(multithreading::exec_pol<1>{},std::forward<F>(f),std::forward<Tensor>(lhs),std::forward<Rhs>(rhs));
+    }
+
+private:
+    template<typename Order, typename Policy, typename...Ts>
+    static void eval_tensor(Policy policy, basic_tensor<Ts...>& t){
+        using index_type = typename basic_tensor<Ts...>::index_type;
+        if (t.empty()){
+            return;
+        }
+        if (t.is_trivial()){
+            auto a = t.traverse_order_adapter(Order{});
+            eval_range(policy,a.begin_trivial(),a.end_trivial(),index_type{1});
         }else{
-            for (auto it = a.begin(), last = a.end(); it!=last; ++it){
-                (void)*it;
+            detail::walk_coalesced_tensor<Order>(policy,t,[](const auto&){return [](const auto& w){(void)*w;};});
+        }
+    }
+    //dereference every element of [first,last), elementary task is block of block_size consecutive elements
+    template<typename Policy, typename It, typename IdxT>
+    static void eval_range(Policy policy, It first, It last, const IdxT& block_size){
+        auto body = [](auto first_, auto last_){
+            for (;first_!=last_; ++first_){
+                (void)*first_;
             }
+        };
+        if constexpr (multithreading::exec_policy_traits<Policy>::is_seq::value){
+            detail::unused_args{policy,block_size};
+            body(first,last);
+        }else{  //parallelize
+            const auto par_sizes = multithreading::make_par_task_size(policy,(last-first)/block_size);
+            if (par_sizes.size()<2){
+                body(first,last);
+                return;
+            }
+            multithreading::task_group group{};
+            for (std::size_t i{0}; i!=par_sizes.size(); ++i){
+                const auto last_ = first+par_sizes[i]*block_size;
+                multithreading::get_pool().push_group(group,body,first,last_);
+                first = last_;
+            }
+            group.wait();
         }
-        return lhs;
     }
 };
 
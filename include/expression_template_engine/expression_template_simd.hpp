@@ -0,0 +1,354 @@
+/*
+* GTensor - computation library
+* Copyright (c) 2022 Ivan Malezhyk <ivanmzk@gmail.com>
+*
+* Distributed under the Boost Software License, Version 1.0.
+* The full license is in the file LICENSE.txt, distributed with this software.
+*/
+
+#ifndef EXPRESSION_TEMPLATE_SIMD_HPP_
+#define EXPRESSION_TEMPLATE_SIMD_HPP_
+
+#include <tuple>
+#include <algorithm>
+#include "common.hpp"
+#include "avx_helper.hpp"
+#include "operations.hpp"
+#include "multithreading.hpp"
+#include "tensor_core.hpp"
+#include "tensor_implementation.hpp"
+#include "expression_template_core.hpp"
+
+namespace gtensor{
+
+namespace detail{
+
+//vectorized evaluation of trivial expressions
+//expression tree is evaluated register by register if every node of tree is supported:
+//leaves are storage tensors of value_type T or arithmetic scalars, T is double, float, signed 32 or 64 bit integer
+//nodes are add,sub,mul,div,fma,fmin,fmax operations which result type is T
+//root node may also be comparison of T operands
+//assign and add,sub,mul,div compound assignment of storage tensor of value_type T is evaluated the same way
+
+template<typename F, typename Scalar, typename Order> class binary_operation_scalar_wrapper;
+
+//operation functor to vector operation map
+template<typename T, typename F> struct simd_operation : std::false_type{};
+template<typename T> struct simd_operation<T,operations::add> : std::bool_constant<simd_width_v<T>!=0>{
+    template<typename Y> ALWAYS_INLINE static auto apply(Y a, Y b){return simd_add<T>(a,b);}
+};
+template<typename T> struct simd_operation<T,operations::sub> : std::bool_constant<simd_width_v<T>!=0>{
+    template<typename Y> ALWAYS_INLINE static auto apply(Y a, Y b){return simd_sub<T>(a,b);}
+};
+template<typename T> struct simd_operation<T,operations::mul> : std::bool_constant<simd_width_v<T>!=0 && simd_has_mul_v<T>>{
+    template<typename Y> ALWAYS_INLINE static auto apply(Y a, Y b){return simd_mul<T>(a,b);}
+};
+template<typename T> struct simd_operation<T,operations::div> : std::bool_constant<simd_has_div_v<T>>{
+    template<typename Y> ALWAYS_INLINE static auto apply(Y a, Y b){return simd_div<T>(a,b);}
+};
+template<typename T> struct simd_operation<T,operations::math_fma> : std::bool_constant<simd_width_v<T>!=0 && simd_has_fma_v<T>>{
+    template<typename Y> ALWAYS_INLINE static auto apply(Y a, Y b, Y c){return simd_fma<T>(a,b,c);}
+};
+template<typename T> struct simd_operation<T,operations::math_fmax> : std::bool_constant<simd_has_minmax_v<T>>{
+    template<typename Y> ALWAYS_INLINE static auto apply(Y a, Y b){return simd_fmax<T>(a,b);}
+};
+template<typename T> struct simd_operation<T,operations::math_fmin> : std::bool_constant<simd_has_minmax_v<T>>{
+    template<typename Y> ALWAYS_INLINE static auto apply(Y a, Y b){return simd_fmin<T>(a,b);}
+};
+
+//comparison functor to vector comparison map, apply returns bit mask
+template<typename T, typename F> struct simd_comparison : std::false_type{};
+template<typename T, simd_predicate P> struct simd_comparison_predicate : std::bool_constant<simd_width_v<T>!=0>{
+    template<typename Y> ALWAYS_INLINE static unsigned apply(Y a, Y b){return simd_cmp<T,P>(a,b);}
+};
+template<typename T> struct simd_comparison<T,operations::equal> : simd_comparison_predicate<T,simd_predicate::eq>{};
+template<typename T> struct simd_comparison<T,operations::not_equal> : simd_comparison_predicate<T,simd_predicate::ne>{};
+template<typename T> struct simd_comparison<T,operations::greater> : simd_comparison_predicate<T,simd_predicate::gt>{};
+template<typename T> struct simd_comparison<T,operations::greater_equal> : simd_comparison_predicate<T,simd_predicate::ge>{};
+template<typename T> struct simd_comparison<T,operations::less> : simd_comparison_predicate<T,simd_predicate::lt>{};
+template<typename T> struct simd_comparison<T,operations::less_equal> : simd_comparison_predicate<T,simd_predicate::le>{};
+
+//assignment functor to vector operation map, apply takes lhs and rhs registers and returns new lhs register
+template<typename T, typename F> struct simd_assign : std::false_type{};
+template<typename T> struct simd_assign<T,operations::assign> : std::bool_constant<simd_width_v<T>!=0>{
+    template<typename Y> ALWAYS_INLINE static auto apply(Y, Y b){return b;}
+};
+template<typename T> struct simd_assign<T,operations::assign_add> : simd_operation<T,operations::add>{};
+template<typename T> struct simd_assign<T,operations::assign_sub> : simd_operation<T,operations::sub>{};
+template<typename T> struct simd_assign<T,operations::assign_mul> : simd_operation<T,operations::mul>{};
+template<typename T> struct simd_assign<T,operations::assign_div> : simd_operation<T,operations::div>{};
+
+//scalar can be broadcasted if operation converts it to T
+template<typename T, typename Scalar> inline constexpr bool is_simd_scalar_v = std::is_arithmetic_v<Scalar> && std::is_same_v<decltype(std::declval<T>()+std::declval<Scalar>()),T>;
+
+//storage elements must be contiguous and accessible using pointer
+template<typename Storage, typename=void> inline constexpr bool has_pointer_data_v = false;
+template<typename Storage> inline constexpr bool has_pointer_data_v<Storage,std::void_t<decltype(std::declval<Storage&>().data())>> = std::is_pointer_v<decltype(std::declval<Storage&>().data())>;
+
+//functor of expression node, operation of binary_operation_scalar_wrapper
+template<typename F> struct simd_functor{using type = F;};
+template<typename F, typename Scalar, typename Order> struct simd_functor<binary_operation_scalar_wrapper<F,Scalar,Order>>{using type = F;};
+template<typename F> using simd_functor_t = typename simd_functor<std::remove_cv_t<F>>::type;
+
+//evaluators, load(i) returns register of elements starting from i
+template<typename T>
+class simd_leaf_evaluator
+{
+    const T* data_;
+public:
+    explicit simd_leaf_evaluator(const T* data__):
+        data_{data__}
+    {}
+    template<typename IdxT>
+    ALWAYS_INLINE auto load(const IdxT& i)const{
+        return simd_loadu<T>(data_+i);
+    }
+};
+template<typename T>
+class simd_scalar_evaluator
+{
+    T scalar_;
+public:
+    explicit simd_scalar_evaluator(const T& scalar__):
+        scalar_{scalar__}
+    {}
+    template<typename IdxT>
+    ALWAYS_INLINE auto load(const IdxT&)const{
+        return simd_broadcast<T>(scalar_);
+    }
+};
+template<typename Operation, typename...Evaluators>
+class simd_node_evaluator
+{
+    std::tuple<Evaluators...> evaluators_;
+    template<typename IdxT, std::size_t...I>
+    ALWAYS_INLINE auto load_helper(const IdxT& i, std::index_sequence<I...>)const{
+        return Operation::apply(std::get<I>(evaluators_).load(i)...);
+    }
+public:
+    explicit simd_node_evaluator(const Evaluators&...evaluators__):
+        evaluators_{evaluators__...}
+    {}
+    template<typename IdxT>
+    ALWAYS_INLINE auto load(const IdxT& i)const{
+        return load_helper(i,std::index_sequence_for<Evaluators...>{});
+    }
+};
+template<typename Operation, typename...Evaluators>
+auto make_simd_node_evaluator(const Evaluators&...evaluators){
+    return simd_node_evaluator<Operation,Evaluators...>{evaluators...};
+}
+
+//simd_tree<T,Tensor>::value is true if Tensor is supported tree of value_type T
+//simd_tree<T,Tensor>::make(t) makes evaluator of tree
+template<typename T, typename Tensor> struct simd_tree : std::false_type{};
+template<typename T, typename Tensor> struct simd_tree<T,const Tensor> : simd_tree<T,Tensor>{};
+
+//node of tree, Operation is simd_operation or simd_comparison specialization
+template<typename T, typename Operation, typename F, typename...Operands>
+struct simd_node
+{
+    static constexpr bool value = Operation::value && (simd_tree<T,Operands>::value&&...);
+    template<typename Core>
+    static auto make(const Core& core){
+        return make_helper(core,std::index_sequence_for<Operands...>{});
+    }
+private:
+    template<typename Core, std::size_t...I>
+    static auto make_helper(const Core& core, std::index_sequence<I...>){
+        return make_simd_node_evaluator<Operation>(simd_tree<T,Operands>::make(std::get<I>(core.operands()))...);
+    }
+};
+template<typename T, typename Operation, typename F, typename Scalar, typename Order, typename Operand>
+struct simd_node<T,Operation,binary_operation_scalar_wrapper<F,Scalar,Order>,Operand>
+{
+    static constexpr bool value = Operation::value && is_simd_scalar_v<T,Scalar> && simd_tree<T,Operand>::value;
+    template<typename Core>
+    static auto make(const Core& core){
+        const auto scalar = simd_scalar_evaluator<T>{static_cast<T>(core.functor().scalar())};
+        const auto operand = simd_tree<T,Operand>::make(std::get<0>(core.operands()));
+        if constexpr (binary_operation_scalar_wrapper<F,Scalar,Order>::is_scalar_first){
+            return make_simd_node_evaluator<Operation>(scalar,operand);
+        }else{
+            return make_simd_node_evaluator<Operation>(operand,scalar);
+        }
+    }
+};
+
+template<typename T, typename Config, typename Layout>
+struct simd_tree<T,basic_tensor<tensor_implementation<storage_core<Config,T,Layout>>>>
+{
+    static constexpr bool value = simd_width_v<T>!=0 && has_pointer_data_v<typename Config::template storage<T>>;
+    template<typename Tensor>
+    static auto make(const Tensor& t){
+        return simd_leaf_evaluator<T>{t.data()};
+    }
+};
+template<typename T, typename Config, typename F, typename...Operands>
+struct simd_tree<T,basic_tensor<tensor_implementation<expression_template_core<Config,F,Operands...>>>>
+{
+    using node_type = simd_node<T,simd_operation<T,simd_functor_t<F>>,std::remove_cv_t<F>,Operands...>;
+    static constexpr bool value = std::is_same_v<typename expression_template_core<Config,F,Operands...>::value_type,T> && node_type::value;
+    template<typename Tensor>
+    static auto make(const Tensor& t){
+        return node_type::make(t.core());
+    }
+};
+
+//simd_root<Tensor>::value is true if Tensor is expression that can be evaluated in vector registers
+//element_type is type of registers elements, result_type is value_type of expression
+template<typename Tensor> struct simd_root : std::false_type{};
+template<typename Config, typename F, typename Operand, typename...Operands>
+struct simd_root<basic_tensor<tensor_implementation<expression_template_core<Config,F,Operand,Operands...>>>>
+{
+    using result_type = typename expression_template_core<Config,F,Operand,Operands...>::value_type;
+    //comparison operands type is value_type of first operand
+    static constexpr bool is_comparison = std::is_same_v<result_type,bool> && simd_comparison<typename Operand::value_type,simd_functor_t<F>>::value;
+    using element_type = std::conditional_t<is_comparison,typename Operand::value_type,result_type>;
+    using operation_type = std::conditional_t<is_comparison,simd_comparison<element_type,simd_functor_t<F>>,simd_operation<element_type,simd_functor_t<F>>>;
+    using node_type = simd_node<element_type,operation_type,std::remove_cv_t<F>,Operand,Operands...>;
+    static constexpr bool value = node_type::value;
+
+    template<typename Tensor>
+    static auto make(const Tensor& t){
+        return node_type::make(t.core());
+    }
+    //evaluates simd_width_v<element_type> elements starting from i and stores them to dst
+    template<typename Evaluator, typename IdxT>
+    ALWAYS_INLINE static void store(const Evaluator& evaluator, const IdxT& i, result_type* dst){
+        if constexpr (is_comparison){
+            const unsigned mask = evaluator.load(i);
+            dst+=i;
+            for (std::size_t k=0; k!=simd_width_v<element_type>; ++k){
+                dst[k] = (mask>>k)&1u;
+            }
+        }else{
+            simd_storeu<element_type>(dst+i,evaluator.load(i));
+        }
+    }
+};
+
+template<typename Tensor> struct is_simd_storage_tensor : std::false_type{};
+template<typename Config, typename T, typename Layout> struct is_simd_storage_tensor<basic_tensor<tensor_implementation<storage_core<Config,T,Layout>>>> :
+    std::bool_constant<has_pointer_data_v<typename Config::template storage<T>>>
+{};
+
+//calls body(first,last) for ranges of [0,n_blocks) according to policy
+template<typename Policy, typename IdxT, typename Body>
+void simd_eval_blocks(Policy policy, const IdxT& n_blocks, Body body){
+    if constexpr (multithreading::exec_policy_traits<Policy>::is_seq::value){
+        detail::unused_args{policy};
+        body(IdxT{0},n_blocks);
+    }else{  //parallelize
+        const auto par_sizes = multithreading::make_par_task_size(policy,n_blocks);
+        if (par_sizes.size()<2){
+            body(IdxT{0},n_blocks);
+        }else{
+            multithreading::task_group group{};
+            IdxT first{0};
+            for (std::size_t i{0}; i!=par_sizes.size(); ++i){
+                const IdxT last = first+par_sizes[i];
+                multithreading::get_pool().push_group(group,body,first,last);
+                first = last;
+            }
+            group.wait();
+        }
+    }
+}
+
+//evaluates trivial expression src into storage tensor dst of the same shape using vector registers
+//returns false if src and dst can't be evaluated this way, dst is not changed in this case
+template<typename Policy, typename Order, typename...Ts, typename...Us>
+bool simd_copy_tensors(Policy policy, Order order, const basic_tensor<Ts...>& src, basic_tensor<Us...>& dst){
+    using src_type = basic_tensor<Ts...>;
+    using dst_type = basic_tensor<Us...>;
+    using root_type = simd_root<src_type>;
+    if constexpr (root_type::value && is_simd_storage_tensor<dst_type>::value){
+        using result_type = typename root_type::result_type;
+        using index_type = typename src_type::index_type;
+        if constexpr (std::is_same_v<typename dst_type::value_type,result_type> && std::is_same_v<typename src_type::order,Order> && std::is_same_v<typename dst_type::order,Order>){
+            constexpr index_type width = simd_width_v<typename root_type::element_type>;
+            const auto evaluator = root_type::make(src);
+            const auto dst_data = dst.data();
+            const index_type n = src.size();
+            const index_type n_blocks = n/width;
+            simd_eval_blocks(policy,n_blocks,[&evaluator,dst_data](index_type first, index_type last){
+                for (first*=width,last*=width; first!=last; first+=width){
+                    root_type::store(evaluator,first,dst_data);
+                }
+            });
+            //tail
+            auto a_src = src.traverse_order_adapter(order);
+            std::copy(a_src.begin_trivial()+n_blocks*width,a_src.end_trivial(),dst_data+n_blocks*width);
+            return true;
+        }else{
+            detail::unused_args{policy,order,src,dst};
+            return false;
+        }
+    }else{
+        detail::unused_args{policy,order,src,dst};
+        return false;
+    }
+}
+
+//evaluates lhs = operation(lhs,rhs) register by register, tail(i) evaluates element i that doesn't fill register
+template<typename Operation, typename Policy, typename...Ts, typename Evaluator, typename Tail>
+void simd_assign_helper(Policy policy, basic_tensor<Ts...>& lhs, const Evaluator& rhs_evaluator, Tail tail){
+    using value_type = typename basic_tensor<Ts...>::value_type;
+    using index_type = typename basic_tensor<Ts...>::index_type;
+    constexpr index_type width = simd_width_v<value_type>;
+    const auto lhs_data = lhs.data();
+    const index_type n = lhs.size();
+    const index_type n_blocks = n/width;
+    const auto evaluator = make_simd_node_evaluator<Operation>(simd_leaf_evaluator<value_type>{lhs_data},rhs_evaluator);
+    simd_eval_blocks(policy,n_blocks,[&evaluator,lhs_data](index_type first, index_type last){
+        for (first*=width,last*=width; first!=last; first+=width){
+            simd_storeu<value_type>(lhs_data+first,evaluator.load(first));
+        }
+    });
+    for (index_type i=n_blocks*width; i!=n; ++i){
+        tail(i);
+    }
+}
+
+//evaluates f(lhs_element,rhs_element) for elements of storage tensor lhs using vector registers, F is assign or add,sub,mul,div compound assignment functor
+//rhs is trivial expression or storage tensor of the same shape and layout as lhs
+//returns false if lhs and rhs can't be evaluated this way, lhs is not changed in this case
+template<typename Policy, typename F, typename...Ts, typename...Us>
+bool simd_assign_tensors(Policy policy, const F& f, basic_tensor<Ts...>& lhs, const basic_tensor<Us...>& rhs){
+    using lhs_type = basic_tensor<Ts...>;
+    using rhs_type = basic_tensor<Us...>;
+    using value_type = typename lhs_type::value_type;
+    using order = typename lhs_type::order;
+    using operation_type = simd_assign<value_type,std::remove_cv_t<F>>;
+    if constexpr (is_simd_storage_tensor<lhs_type>::value && operation_type::value && simd_tree<value_type,rhs_type>::value && std::is_same_v<typename rhs_type::order,order>){
+        if (rhs.shape() == lhs.shape() && rhs.is_trivial()){
+            auto a_rhs = rhs.traverse_order_adapter(order{});
+            auto rhs_first = a_rhs.begin_trivial();
+            const auto lhs_data = lhs.data();
+            simd_assign_helper<operation_type>(policy,lhs,simd_tree<value_type,rhs_type>::make(rhs),[&f,lhs_data,rhs_first](const auto& i){f(lhs_data[i],rhs_first[i]);});
+            return true;
+        }
+    }
+    detail::unused_args{policy,f,lhs,rhs};
+    return false;
+}
+//rhs is scalar that operation converts to lhs value_type
+template<typename Policy, typename F, typename...Ts, typename Rhs, std::enable_if_t<!is_tensor_v<Rhs>,int> =0>
+bool simd_assign_tensors(Policy policy, const F& f, basic_tensor<Ts...>& lhs, const Rhs& rhs){
+    using lhs_type = basic_tensor<Ts...>;
+    using value_type = typename lhs_type::value_type;
+    using operation_type = simd_assign<value_type,std::remove_cv_t<F>>;
+    if constexpr (is_simd_storage_tensor<lhs_type>::value && operation_type::value && is_simd_scalar_v<value_type,Rhs>){
+        const auto lhs_data = lhs.data();
+        simd_assign_helper<operation_type>(policy,lhs,simd_scalar_evaluator<value_type>{static_cast<value_type>(rhs)},[&f,&rhs,lhs_data](const auto& i){f(lhs_data[i],rhs);});
+        return true;
+    }else{
+        detail::unused_args{policy,f,lhs,rhs};
+        return false;
+    }
+}
+
+}   //end of namespace detail
+}   //end of namespace gtensor
+#endif
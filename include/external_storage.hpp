@@ -0,0 +1,230 @@
+/*
+* GTensor - computation library
+* Copyright (c) 2022 Ivan Malezhyk <ivanmzk@gmail.com>
+*
+* Distributed under the Boost Software License, Version 1.0.
+* The full license is in the file LICENSE.txt, distributed with this software.
+*/
+
+#ifndef EXTERNAL_STORAGE_HPP_
+#define EXTERNAL_STORAGE_HPP_
+
+#include <memory>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <initializer_list>
+#include "config.hpp"
+#include "tensor.hpp"
+
+namespace gtensor{
+
+//storage that may adopt elements buffer owned by other system e.g. message queue or shared memory segment
+//adopting constructors don't copy, buffer is either not owned or shared owned through owner, that is released when last storage that refers buffer is destroyed
+//all other constructors allocate own buffer, so it can be used as Config::storage template
+//copy always allocates own buffer, move steals buffer and ownership
+template<typename T>
+class external_storage
+{
+    template<typename> struct is_shared_ptr : std::false_type{};
+    template<typename U> struct is_shared_ptr<std::shared_ptr<U>> : std::true_type{};
+public:
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = pointer;
+    using const_iterator = const_pointer;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using difference_type = std::ptrdiff_t;
+    using size_type = std::size_t;
+
+    external_storage() = default;
+    external_storage(const external_storage& other)
+    {
+        init(other.begin(),other.end());
+    }
+    external_storage(external_storage&& other):
+        begin_{other.begin_},
+        end_{other.end_},
+        owner_{std::move(other.owner_)}
+    {
+        other.begin_ = nullptr;
+        other.end_ = nullptr;
+    }
+    external_storage& operator=(const external_storage& other){
+        if (this != &other){
+            external_storage tmp{other};
+            swap(tmp);
+        }
+        return *this;
+    }
+    external_storage& operator=(external_storage&& other){
+        if (this != &other){
+            external_storage tmp{std::move(other)};
+            swap(tmp);
+        }
+        return *this;
+    }
+    //construct storage of n elements, no initialization is performed for trivially copyable value_type
+    explicit external_storage(const size_type& n)
+    {
+        allocate(n);
+    }
+    //construct storage of n elements initialized to v
+    external_storage(const size_type& n, const value_type& v)
+    {
+        allocate(n);
+        std::fill(begin_,end_,v);
+    }
+
+    template<typename, typename = void> struct is_input_iterator : std::false_type{};
+    template<typename U> struct is_input_iterator<U,std::void_t<typename std::iterator_traits<U>::iterator_category>> : std::is_convertible<typename std::iterator_traits<U>::iterator_category,std::input_iterator_tag>{};
+
+    //construct storage from iterators range
+    template<typename It, std::enable_if_t<is_input_iterator<It>::value,int> =0>
+    external_storage(It first, It last)
+    {
+        init(first,last);
+    }
+    external_storage(std::initializer_list<value_type> init_list)
+    {
+        init(init_list.begin(),init_list.end());
+    }
+    //adopt n elements starting from data, buffer is not owned and must outlive storage
+    external_storage(pointer data, const size_type& n):
+        begin_{data},
+        end_{data+n}
+    {}
+    //adopt n elements starting from data, deleter is called with data when buffer is released
+    template<typename Deleter, std::enable_if_t<!is_shared_ptr<std::remove_cv_t<std::remove_reference_t<Deleter>>>::value,int> =0>
+    external_storage(pointer data, const size_type& n, Deleter&& deleter):
+        begin_{data},
+        end_{data+n},
+        owner_{data,std::forward<Deleter>(deleter)}
+    {}
+    //adopt n elements starting from data, owner keeps buffer alive
+    template<typename U>
+    external_storage(pointer data, const size_type& n, std::shared_ptr<U> owner):
+        begin_{data},
+        end_{data+n},
+        owner_{std::move(owner)}
+    {}
+
+    void swap(external_storage& other){
+        std::swap(begin_,other.begin_);
+        std::swap(end_,other.end_);
+        std::swap(owner_,other.owner_);
+    }
+    //object that keeps buffer alive, empty if buffer is not owned
+    const std::shared_ptr<void>& owner()const{
+        return owner_;
+    }
+    size_type size()const{
+        return end_-begin_;
+    }
+    bool empty()const{
+        return begin()==end();
+    }
+    value_type* data(){
+        return begin_;
+    }
+    const value_type* data()const{
+        return begin_;
+    }
+    iterator begin(){
+        return begin_;
+    }
+    iterator end(){
+        return end_;
+    }
+    reverse_iterator rbegin(){
+        return std::make_reverse_iterator(end());
+    }
+    reverse_iterator rend(){
+        return std::make_reverse_iterator(begin());
+    }
+    const_iterator begin()const{
+        return begin_;
+    }
+    const_iterator end()const{
+        return end_;
+    }
+    const_reverse_iterator rbegin()const{
+        return std::make_reverse_iterator(end());
+    }
+    const_reverse_iterator rend()const{
+        return std::make_reverse_iterator(begin());
+    }
+    reference operator[](const size_type& i){
+        return *(begin_+i);
+    }
+    const_reference operator[](const size_type& i)const{
+        return *(begin_+i);
+    }
+
+private:
+    void allocate(const size_type& n){
+        if (n>0){
+            std::shared_ptr<value_type[]> buffer(new value_type[n]);
+            begin_ = buffer.get();
+            end_ = begin_+n;
+            owner_ = std::move(buffer);
+        }
+    }
+
+    template<typename It>
+    void init(It first, It last){
+        if constexpr (std::is_convertible_v<typename std::iterator_traits<It>::iterator_category,std::forward_iterator_tag>){
+            allocate(static_cast<size_type>(std::distance(first,last)));
+            std::copy(first,last,begin_);
+        }else{
+            std::vector<value_type> tmp(first,last);
+            init(tmp.begin(),tmp.end());
+        }
+    }
+
+    pointer begin_{nullptr};
+    pointer end_{nullptr};
+    std::shared_ptr<void> owner_{};
+};
+
+namespace config{
+
+//config with external_storage as elements storage
+//index_map of Config is kept, so mapping views don't allocate indexes using external_storage
+template<typename Config = default_config>
+struct external_config : public Config
+{
+    template<typename T> using storage = gtensor::external_storage<T>;
+    template<typename T> using index_map = typename Config::template index_map<T>;
+};
+
+}   //end of namespace config
+
+//make tensor of shape over buffer of elements without copying
+//elements are considered to be in Order layout, buffer must have at least shape size elements
+//owner may be omitted (buffer is not owned and must outlive tensor and all its shallow copies), may be deleter or std::shared_ptr that keeps buffer alive
+//tensor deep copies and results of operations allocate own buffers
+template<typename Order = config::c_order, typename Config = config::default_config, typename T, typename ShT, typename...Owner>
+auto from_buffer(T* data, ShT&& shape, Owner&&...owner){
+    static_assert(sizeof...(Owner)<2,"owner must be deleter or std::shared_ptr");
+    ASSERT_ORDER(Order);
+    using tensor_type = tensor<T,Order,config::extend_config_t<config::external_config<Config>,T>>;
+    using shape_type = typename tensor_type::shape_type;
+    using index_type = typename tensor_type::index_type;
+    using storage_type = typename tensor_type::storage_type;
+    auto shape_ = detail::make_shape_of_type<shape_type>(std::forward<ShT>(shape));
+    const auto size = static_cast<std::size_t>(detail::make_size<index_type>(shape_));
+    return tensor_type(std::move(shape_),storage_type(data,size,std::forward<Owner>(owner)...));
+}
+template<typename Order = config::c_order, typename Config = config::default_config, typename T, typename U, typename...Owner>
+auto from_buffer(T* data, std::initializer_list<U> shape, Owner&&...owner){
+    return from_buffer<Order,Config>(data,detail::make_shape_of_type<std::vector<U>>(shape),std::forward<Owner>(owner)...);
+}
+
+}   //end of namespace gtensor
+#endif
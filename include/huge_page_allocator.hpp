@@ -0,0 +1,251 @@
+/*
+* GTensor - computation library
+* Copyright (c) 2022 Ivan Malezhyk <ivanmzk@gmail.com>
+*
+* Distributed under the Boost Software License, Version 1.0.
+* The full license is in the file LICENSE.txt, distributed with this software.
+*/
+
+#ifndef HUGE_PAGE_ALLOCATOR_HPP_
+#define HUGE_PAGE_ALLOCATOR_HPP_
+
+#include <new>
+#include <limits>
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include <type_traits>
+#include "multithreading.hpp"
+#include "storage.hpp"
+#include "config.hpp"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define GTENSOR_HAS_HUGE_PAGES 1
+#else
+#define GTENSOR_HAS_HUGE_PAGES 0
+#endif
+
+namespace allocation{
+
+//first_touch - pages are placed on node of thread that first writes them, allocator touches pages in parallel using pool
+//interleave - pages are interleaved across all online nodes
+enum class numa_policy {first_touch, interleave};
+
+namespace detail{
+
+//buffers smaller than threshold are allocated with operator new
+inline constexpr std::size_t huge_page_threshold = std::size_t{2}*1024*1024;
+inline constexpr std::size_t huge_page_size = std::size_t{2}*1024*1024;
+inline constexpr std::size_t small_page_size = 4096;
+
+inline std::size_t huge_page_round(std::size_t n){
+    return (n+huge_page_size-1)/huge_page_size*huge_page_size;
+}
+
+#if GTENSOR_HAS_HUGE_PAGES
+//mask of online numa nodes from sysfs, e.g. "0-1,4"
+inline unsigned long online_numa_nodes(){
+    static const unsigned long mask = [](){
+        unsigned long res{0};
+        std::ifstream f("/sys/devices/system/node/online");
+        std::string s{};
+        if (!std::getline(f,s)){
+            return res;
+        }
+        constexpr unsigned long max_node = std::numeric_limits<unsigned long>::digits;
+        std::size_t pos{0};
+        while (pos < s.size()){
+            std::size_t last{0};
+            const auto first_node = std::stoul(s.substr(pos),&last);
+            pos+=last;
+            auto last_node = first_node;
+            if (pos < s.size() && s[pos]=='-'){
+                ++pos;
+                last_node = std::stoul(s.substr(pos),&last);
+                pos+=last;
+            }
+            for (auto node=first_node; node<=last_node && node<max_node; ++node){
+                res|=1ul<<node;
+            }
+            if (pos < s.size() && s[pos]==','){
+                ++pos;
+            }else{
+                break;
+            }
+        }
+        return res;
+    }();
+    return mask;
+}
+
+//best effort, memory policy is not changed on failure
+inline void interleave_numa(void* p, std::size_t n){
+#if defined(SYS_mbind)
+    constexpr int mpol_interleave = 3;
+    const unsigned long mask = online_numa_nodes();
+    if (mask != 0 && (mask&(mask-1)) != 0){ //more than one node
+        ::syscall(SYS_mbind,p,n,mpol_interleave,&mask,std::numeric_limits<unsigned long>::digits+1,0);
+    }
+#else
+    (void)p;
+    (void)n;
+#endif
+}
+#endif
+
+//write single byte of every small page, chunks of pages are touched by parallel tasks according to Policy
+template<typename Policy>
+void first_touch(void* p, std::size_t n){
+    auto data = static_cast<volatile char*>(p);
+    const std::size_t pages_n = (n+small_page_size-1)/small_page_size;
+    auto body = [data](std::size_t first, std::size_t last){
+        for (; first!=last; ++first){
+            data[first*small_page_size] = 0;
+        }
+    };
+    if constexpr (multithreading::exec_policy_traits<Policy>::is_seq::value){
+        body(0,pages_n);
+    }else{
+        const auto par_sizes = multithreading::make_par_task_size(Policy{},pages_n);
+        if (par_sizes.size()<2){
+            body(0,pages_n);
+        }else{
+            multithreading::task_group group{};
+            std::size_t first{0};
+            for (std::size_t i{0}; i!=par_sizes.size(); ++i){
+                const std::size_t last = first+par_sizes[i];
+                multithreading::get_pool().push_group(group,body,first,last);
+                first = last;
+            }
+            group.wait();
+        }
+    }
+}
+
+}   //end of namespace detail
+
+//allocator for big buffers
+//buffers not smaller than 2MB are mapped anonymously and rounded to huge page size, transparent huge pages are requested with madvise,
+//if HugeTlb is true explicit huge pages (MAP_HUGETLB) are tried first
+//pages are placed according to Numa and touched in parallel according to Policy,
+//it should be the same policy that is used to process tensor, so chunks of elements are placed on nodes of threads that process them
+//on platforms other than linux it falls back to aligned operator new
+template<typename T, typename Policy = multithreading::exec_pol<0>, numa_policy Numa = numa_policy::first_touch, bool HugeTlb = false>
+class huge_page_allocator
+{
+    static_assert(!std::is_const_v<T>);
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using propagate_on_container_move_assignment = std::true_type;
+    using is_always_equal = std::true_type;
+    using propagate_on_container_swap = std::false_type;
+    using propagate_on_container_copy_assignment = std::false_type;
+
+    template<typename U> struct rebind{using other = huge_page_allocator<U,Policy,Numa,HugeTlb>;};
+
+    static constexpr std::size_t alignment = alignof(T) > 64 ? alignof(T) : 64;
+
+    huge_page_allocator() noexcept
+    {}
+    huge_page_allocator(const huge_page_allocator&) noexcept
+    {}
+    template<typename U>
+    huge_page_allocator(const huge_page_allocator<U,Policy,Numa,HugeTlb>&) noexcept
+    {}
+
+    T* allocate(const std::size_t n){
+        if constexpr (sizeof(T)>1){
+            if (n > std::numeric_limits<std::size_t>::max()/sizeof(T)){
+                throw std::bad_array_new_length{};
+            }
+        }
+        if (n==0){
+            return nullptr;
+        }
+        const std::size_t bytes = n*sizeof(T);
+#if GTENSOR_HAS_HUGE_PAGES
+        if (bytes >= detail::huge_page_threshold){
+            const std::size_t length = detail::huge_page_round(bytes);
+            void* p = MAP_FAILED;
+#if defined(MAP_HUGETLB)
+            if constexpr (HugeTlb){
+                p = ::mmap(nullptr,length,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB,-1,0);
+            }
+#endif
+            if (p == MAP_FAILED){
+                p = ::mmap(nullptr,length,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS,-1,0);
+                if (p == MAP_FAILED){
+                    throw std::bad_alloc{};
+                }
+#if defined(MADV_HUGEPAGE)
+                ::madvise(p,length,MADV_HUGEPAGE);
+#endif
+            }
+            if constexpr (Numa == numa_policy::interleave){
+                detail::interleave_numa(p,length);
+            }else{
+                detail::first_touch<Policy>(p,length);
+            }
+            return static_cast<T*>(p);
+        }
+#endif
+        return static_cast<T*>(::operator new(bytes,std::align_val_t{alignment}));
+    }
+    T* allocate(const std::size_t n, const void*){
+        return allocate(n);
+    }
+
+    void deallocate(T* const p, std::size_t n){
+        const std::size_t bytes = n*sizeof(T);
+#if GTENSOR_HAS_HUGE_PAGES
+        if (bytes >= detail::huge_page_threshold){
+            ::munmap(p,detail::huge_page_round(bytes));
+            return;
+        }
+#endif
+        ::operator delete(p,bytes,std::align_val_t{alignment});
+    }
+
+    template<typename U, typename...Args>
+    void construct(U* const p, Args&&...args){
+        ::new (const_cast<void*>(static_cast<const volatile void*>(p))) U(std::forward<Args>(args)...);
+    }
+
+    template<typename U>
+    void destroy(U* const p){
+        p->~U();
+    }
+};
+
+template<typename U, typename V, typename P, numa_policy N, bool H>
+bool operator==(const huge_page_allocator<U,P,N,H>&, const huge_page_allocator<V,P,N,H>&){
+    return true;
+}
+template<typename U, typename V, typename P, numa_policy N, bool H>
+bool operator!=(const huge_page_allocator<U,P,N,H>&, const huge_page_allocator<V,P,N,H>&){
+    return false;
+}
+
+}   //end of namespace allocation
+
+namespace gtensor{
+namespace config{
+
+//config with basic_storage that uses huge_page_allocator, Policy should be policy that is used to process tensors
+template<typename Config = default_config, typename Policy = multithreading::exec_pol<0>, allocation::numa_policy Numa = allocation::numa_policy::first_touch, bool HugeTlb = false>
+struct huge_page_config : public Config
+{
+    template<typename T> using storage = gtensor::basic_storage<T,allocation::huge_page_allocator<T,Policy,Numa,HugeTlb>>;
+    template<typename T> using index_map = typename Config::template index_map<T>;
+};
+
+}   //end of namespace config
+}   //end of namespace gtensor
+
+#endif
@@ -0,0 +1,850 @@
+/*
+* GTensor - computation library
+* Copyright (c) 2022 Ivan Malezhyk <ivanmzk@gmail.com>
+*
+* Distributed under the Boost Software License, Version 1.0.
+* The full license is in the file LICENSE.txt, distributed with this software.
+*/
+
+#ifndef MATMUL_KERNEL_HPP_
+#define MATMUL_KERNEL_HPP_
+
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+#include "common.hpp"
+#include "cpu_features.hpp"
+#include "avx_helper.hpp"
+
+namespace gtensor{
+namespace detail{
+
+//micro-kernels of blocked matmul
+//micro_kernel computes mr_ x nr_ block of result from packed panels: a_buf is kc_ columns of mr_ elements, b_buf is kc_ rows of nr_ elements,
+//result block is stored in res_buf column by column
+//Mr,Nr is register blocking of kernel, blocks on the edges of result may be smaller
+//Kr is interleaving of packed panels along k: each of Mr rows of a panel and Nr columns of b panel is stored as Kr consecutive elements per step of k,
+//kc_ is padded to multiple of Kr with zeros
+//kernels for extended instruction sets are compiled with target attributes and must be called only if kernel_isa() allows, see cpu_features.hpp
+
+//unpacked kernels of small matrices, a is m x k, b is k x n, res is m x n, all are dense row major
+//operands of all dimensions not greater than matmul_small_max use these kernels instead of packing
+inline constexpr std::size_t matmul_small_max = 16;
+
+//fixed size kernel, loops are unrolled by compiler
+template<std::size_t M, std::size_t N, std::size_t K, typename T>
+ALWAYS_INLINE void matmul_small_kernel(T* res, const T* a, const T* b){
+    for (std::size_t i=0; i!=M; ++i){
+        T* const res_ = res+i*N;
+        const T* const a_ = a+i*K;
+        for (std::size_t j=0; j!=N; ++j){
+            res_[j] = a_[0]*b[j];
+        }
+        for (std::size_t r=1; r!=K; ++r){
+            const T* const b_ = b+r*N;
+            for (std::size_t j=0; j!=N; ++j){
+                res_[j] = res_[j]+a_[r]*b_[j];
+            }
+        }
+    }
+}
+
+template<typename T>
+ALWAYS_INLINE void matmul_small_kernel(T* res, const T* a, const T* b, const std::size_t& m, const std::size_t& n, const std::size_t& k){
+    for (std::size_t i=0; i!=m; ++i){
+        T* const res_ = res+i*n;
+        const T* const a_ = a+i*k;
+        for (std::size_t j=0; j!=n; ++j){
+            res_[j] = T{0};
+        }
+        for (std::size_t r=0; r!=k; ++r){
+            const T* const b_ = b+r*n;
+            for (std::size_t j=0; j!=n; ++j){
+                res_[j] = res_[j]+a_[r]*b_[j];
+            }
+        }
+    }
+}
+
+//square sizes of batched transforms use fixed size kernels
+template<typename T>
+ALWAYS_INLINE void matmul_small(T* res, const T* a, const T* b, const std::size_t& m, const std::size_t& n, const std::size_t& k){
+    if (m==n && n==k){
+        switch (m){
+            case 2:
+                matmul_small_kernel<2,2,2>(res,a,b);
+                return;
+            case 3:
+                matmul_small_kernel<3,3,3>(res,a,b);
+                return;
+            case 4:
+                matmul_small_kernel<4,4,4>(res,a,b);
+                return;
+            case 8:
+                matmul_small_kernel<8,8,8>(res,a,b);
+                return;
+            default:
+                break;
+        }
+    }
+    matmul_small_kernel(res,a,b,m,n,k);
+}
+
+//generic kernel
+template<typename T_, typename T1_, typename T2_>
+ALWAYS_INLINE void matmul_micro_kernel_generic(T_* res_buf, const T1_* const a_buf, const T2_* b_buf, const std::size_t& mr_, const std::size_t& nr_, const std::size_t& kc_){
+    auto res_buf_ = res_buf;
+    for (const auto b_last=b_buf+nr_; b_buf!=b_last; ++b_buf){
+        const auto& b_e = *b_buf;
+        for (std::size_t ir=0; ir!=mr_; ++ir,++res_buf_){
+            *res_buf_=a_buf[ir]*b_e;
+        }
+    }
+    for (std::size_t kk=1; kk!=kc_; ++kk){
+        const auto a_buf_ = a_buf+kk*mr_;
+        res_buf_ = res_buf;
+        for (const auto b_last=b_buf+nr_; b_buf!=b_last; ++b_buf){
+            const auto& b_e = *b_buf;
+            for (std::size_t ir=0; ir!=mr_; ++ir,++res_buf_){
+                *res_buf_=*res_buf_+a_buf_[ir]*b_e;
+            }
+        }
+    }
+}
+
+//generic unrolled kernel, any value types
+template<typename T, typename T1, typename T2>
+struct matmul_kernel_generic
+{
+    static constexpr isa level = isa::generic;
+    static constexpr std::size_t alignment = 32;
+    static constexpr std::size_t Kr = 1;
+    static constexpr std::size_t Nr = 6;
+    static constexpr std::size_t Mr = 2*alignment/sizeof(T1);
+
+    ALWAYS_INLINE static void micro_kernel(T* res_buf, const T1* const a_buf, const T2* b_buf, const std::size_t& mr_, const std::size_t& nr_, const std::size_t& kc_){
+        static constexpr std::size_t unroll_factor = 4;
+        if (mr_==Mr){
+            auto res_buf_ = res_buf;
+            for (const auto b_last=b_buf+nr_; b_buf!=b_last; ++b_buf){
+                const auto& b_e = *b_buf;
+                load_mul_store_n(std::make_index_sequence<Mr>{},res_buf_,a_buf,b_e);
+                res_buf_+=Mr;
+            }
+            for (std::size_t kk=1; kk!=kc_; ++kk){
+                const auto a_buf_ = a_buf+kk*mr_;
+                res_buf_ = res_buf;
+                for (const auto b_last=b_buf+nr_; b_buf!=b_last; ++b_buf){
+                    const auto& b_e = *b_buf;
+                    load_madd_store_n(std::make_index_sequence<Mr>{},res_buf_,a_buf_,b_e);
+                    res_buf_+=Mr;
+                }
+            }
+        }else if (mr_>unroll_factor-1){
+            auto res_buf_ = res_buf;
+            for (const auto b_last=b_buf+nr_; b_buf!=b_last; ++b_buf){
+                const auto& b_e = *b_buf;
+                auto a_buf_=a_buf;
+                const auto a_last = a_buf_+mr_;
+                for (const auto a_last_=a_last-(unroll_factor-1); a_buf_<a_last_; a_buf_+=unroll_factor,res_buf_+=unroll_factor){
+                    load_mul_store_n(std::make_index_sequence<unroll_factor>{},res_buf_,a_buf_,b_e);
+                }
+                for (;a_buf_!=a_last; ++a_buf_,++res_buf_){
+                    load_mul_store(res_buf_,a_buf_,b_e);
+                }
+            }
+            for (std::size_t kk=1; kk!=kc_; ++kk){
+                const auto a_buf_ = a_buf+kk*mr_;
+                res_buf_ = res_buf;
+                for (const auto b_last=b_buf+nr_; b_buf!=b_last; ++b_buf){
+                    const auto& b_e = *b_buf;
+                    auto a_buf__=a_buf_;
+                    const auto a_last = a_buf_+mr_;
+                    for (const auto a_last__=a_last-(unroll_factor-1); a_buf__<a_last__; a_buf__+=unroll_factor,res_buf_+=unroll_factor){
+                        load_madd_store_n(std::make_index_sequence<unroll_factor>{},res_buf_,a_buf__,b_e);
+                    }
+                    for (;a_buf__!=a_last; ++a_buf__,++res_buf_){
+                        load_madd_store(res_buf_,a_buf__,b_e);
+                    }
+                }
+            }
+        }else{
+            matmul_micro_kernel_generic(res_buf,a_buf,b_buf,mr_,nr_,kc_);
+        }
+    }
+
+private:
+    ALWAYS_INLINE static void load_mul_store(T* const res_buf, const T1* const a_buf, const T2& b_e){
+        *(res_buf) = *(a_buf)*b_e;
+    }
+    ALWAYS_INLINE static void load_madd_store(T* const res_buf, const T1* const a_buf, const T2& b_e){
+        *(res_buf) = *(res_buf) + *(a_buf)*b_e;
+    }
+    template<std::size_t...I>
+    ALWAYS_INLINE static void load_mul_store_n(std::index_sequence<I...>, T* const res_buf, const T1* const a_buf, const T2& b_e){
+        (load_mul_store(res_buf+I,a_buf+I,b_e),...);
+    }
+    template<std::size_t...I>
+    ALWAYS_INLINE static void load_madd_store_n(std::index_sequence<I...>, T* const res_buf, const T1* const a_buf, const T2& b_e){
+        (load_madd_store(res_buf+I,a_buf+I,b_e),...);
+    }
+};
+
+//value types that have vectorized kernels, result and operands must be of the same type
+template<typename T> inline constexpr bool is_matmul_simd_type_v = std::is_same_v<T,double> || std::is_same_v<T,float> ||
+    std::is_same_v<T,std::complex<double>> || std::is_same_v<T,std::complex<float>>;
+
+//AVX2,FMA 2rx6 kernel, floating point and complex
+template<typename T>
+struct matmul_kernel_avx2
+{
+    static_assert(is_matmul_simd_type_v<T>);
+    static constexpr isa level = isa::avx2;
+    static constexpr std::size_t alignment = 32;
+    static constexpr std::size_t Kr = 1;
+    static constexpr std::size_t Nr = 6;
+    static constexpr std::size_t Mr = 2*alignment/sizeof(T);
+
+    GTENSOR_TARGET_AVX2 static void micro_kernel(T* res_buf, const T* a_buf, const T* b_buf, const std::size_t& mr_, const std::size_t& nr_, const std::size_t& kc_){
+        static constexpr std::size_t n_packed = alignment/sizeof(T);
+        using gtensor::detail::avx_broadcast;
+        using gtensor::detail::avx_load;
+        using gtensor::detail::avx_loadu;
+        using gtensor::detail::avx_store;
+        using gtensor::detail::avx_madd;
+        using gtensor::detail::avx_mul;
+        if (mr_==Mr && nr_==Nr){
+            micro_kernel_2rx6(res_buf,a_buf,b_buf,kc_);
+        }else if (mr_>n_packed-1){
+            std::size_t mm{0};
+            auto res_buf_ = res_buf;
+            for (const auto b_last=b_buf+nr_; b_buf!=b_last; ++b_buf){
+                auto a_buf_=a_buf;
+                const auto a_last = a_buf_+mr_;
+                const auto& b_e = *b_buf;
+                const auto b_y = avx_broadcast(b_buf);
+                for (;mm!=0; --mm,++a_buf_,++res_buf_){
+                    *res_buf_=*a_buf_*b_e;
+                }
+                for (const auto a_last_=a_last-(n_packed-1); a_buf_<a_last_; a_buf_+=n_packed,res_buf_+=n_packed){
+                    avx_store(res_buf_,avx_mul<T>(avx_loadu(a_buf_),b_y));
+                }
+                for (mm=n_packed; a_buf_!=a_last; ++a_buf_,++res_buf_,--mm){
+                    *res_buf_=*a_buf_*b_e;
+                }
+            }
+            for (std::size_t kk=1; kk!=kc_; ++kk){
+                const auto a_buf_ = a_buf+kk*mr_;
+                res_buf_ = res_buf;
+                mm = 0;
+                for (const auto b_last=b_buf+nr_; b_buf!=b_last; ++b_buf){
+                    auto a_buf__=a_buf_;
+                    const auto a_last = a_buf_+mr_;
+                    const auto& b_e = *b_buf;
+                    const auto b_y = avx_broadcast(b_buf);
+                    for (;mm!=0; --mm,++a_buf__,++res_buf_){
+                        *res_buf_+=*a_buf__*b_e;
+                    }
+                    for (const auto a_last__=a_last-(n_packed-1); a_buf__<a_last__; a_buf__+=n_packed,res_buf_+=n_packed){
+                        avx_store(res_buf_,avx_madd<T>(avx_loadu(a_buf__),b_y,avx_load(res_buf_)));
+                    }
+                    for (mm=n_packed; a_buf__!=a_last; ++a_buf__,++res_buf_,--mm){
+                        *res_buf_+=*a_buf__*b_e;
+                    }
+                }
+            }
+        }else{
+            matmul_micro_kernel_generic(res_buf,a_buf,b_buf,mr_,nr_,kc_);
+        }
+    }
+
+private:
+    ALWAYS_INLINE GTENSOR_TARGET_AVX2 static void micro_kernel_2rx6(T* const res_buf, const T* a_buf, const T* b_buf, const std::size_t& kc_){
+        static_assert(Nr==6);
+        static constexpr std::size_t n_packed = alignment/sizeof(T);
+        using inner_value_type = detail::inner_value_type_t<T>;
+        using gtensor::detail::avx_zero;
+        using gtensor::detail::avx_load;
+        using gtensor::detail::avx_store;
+        using gtensor::detail::avx_madd;
+        using gtensor::detail::avx_broadcast;
+        auto y4 = avx_zero<inner_value_type>();
+        auto y5 = avx_zero<inner_value_type>();
+        auto y6 = avx_zero<inner_value_type>();
+        auto y7 = avx_zero<inner_value_type>();
+        auto y8 = avx_zero<inner_value_type>();
+        auto y9 = avx_zero<inner_value_type>();
+        auto y10 = avx_zero<inner_value_type>();
+        auto y11 = avx_zero<inner_value_type>();
+        auto y12 = avx_zero<inner_value_type>();
+        auto y13 = avx_zero<inner_value_type>();
+        auto y14 = avx_zero<inner_value_type>();
+        auto y15 = avx_zero<inner_value_type>();
+        for (const auto a_last=a_buf+kc_*Mr; a_buf!=a_last; a_buf+=Mr,b_buf+=Nr){
+            const auto y0 = avx_load(a_buf);
+            const auto y1 = avx_load(a_buf+n_packed);
+            auto y2 = avx_broadcast(b_buf);
+            auto y3 = avx_broadcast(b_buf+1);
+            y4 = avx_madd<T>(y0,y2,y4);
+            y5 = avx_madd<T>(y1,y2,y5);
+            y6 = avx_madd<T>(y0,y3,y6);
+            y7 = avx_madd<T>(y1,y3,y7);
+            y2 = avx_broadcast(b_buf+2);
+            y3 = avx_broadcast(b_buf+3);
+            y8 = avx_madd<T>(y0,y2,y8);
+            y9 = avx_madd<T>(y1,y2,y9);
+            y10 = avx_madd<T>(y0,y3,y10);
+            y11 = avx_madd<T>(y1,y3,y11);
+            y2 = avx_broadcast(b_buf+4);
+            y3 = avx_broadcast(b_buf+5);
+            y12 = avx_madd<T>(y0,y2,y12);
+            y13 = avx_madd<T>(y1,y2,y13);
+            y14 = avx_madd<T>(y0,y3,y14);
+            y15 = avx_madd<T>(y1,y3,y15);
+        }
+        avx_store(res_buf,y4);
+        avx_store(res_buf+1*n_packed,y5);
+        avx_store(res_buf+2*n_packed,y6);
+        avx_store(res_buf+3*n_packed,y7);
+        avx_store(res_buf+4*n_packed,y8);
+        avx_store(res_buf+5*n_packed,y9);
+        avx_store(res_buf+6*n_packed,y10);
+        avx_store(res_buf+7*n_packed,y11);
+        avx_store(res_buf+8*n_packed,y12);
+        avx_store(res_buf+9*n_packed,y13);
+        avx_store(res_buf+10*n_packed,y14);
+        avx_store(res_buf+11*n_packed,y15);
+    }
+};
+
+//AVX-512 2rxNr kernel, floating point and complex
+//accumulators of Mr x Nr block take 2*Nr of 32 zmm registers
+template<typename T>
+struct matmul_kernel_avx512
+{
+    static_assert(is_matmul_simd_type_v<T>);
+    static constexpr isa level = isa::avx512;
+    static constexpr std::size_t alignment = 64;
+    static constexpr std::size_t Kr = 1;
+    static constexpr std::size_t Nr = std::is_floating_point_v<T> ? 14 : 12;
+    static constexpr std::size_t Mr = 2*alignment/sizeof(T);
+
+    GTENSOR_TARGET_AVX512 static void micro_kernel(T* res_buf, const T* a_buf, const T* b_buf, const std::size_t& mr_, const std::size_t& nr_, const std::size_t& kc_){
+        static constexpr std::size_t n_packed = alignment/sizeof(T);
+        using gtensor::detail::avx512_broadcast;
+        using gtensor::detail::avx512_maskz_loadu;
+        using gtensor::detail::avx512_mask_storeu;
+        using gtensor::detail::avx512_madd;
+        using gtensor::detail::avx512_mul;
+        if (mr_==Mr && nr_==Nr){
+            micro_kernel_2rxnr(std::make_index_sequence<Nr>{},res_buf,a_buf,b_buf,kc_);
+        }else{
+            //edge block, columns of result are processed by vectors of n_packed elements, last vector of column is masked
+            for (std::size_t kk=0; kk!=kc_; ++kk){
+                const auto a_buf_ = a_buf+kk*mr_;
+                auto res_buf_ = res_buf;
+                for (const auto b_last=b_buf+nr_; b_buf!=b_last; ++b_buf,res_buf_+=mr_){
+                    const auto b_z = avx512_broadcast(b_buf);
+                    for (std::size_t i=0; i<mr_; i+=n_packed){
+                        const auto n = mr_-i<n_packed ? mr_-i : n_packed;
+                        const auto a_z = avx512_maskz_loadu(a_buf_+i,n);
+                        if (kk==0){
+                            avx512_mask_storeu(res_buf_+i,avx512_mul<T>(a_z,b_z),n);
+                        }else{
+                            avx512_mask_storeu(res_buf_+i,avx512_madd<T>(a_z,b_z,avx512_maskz_loadu(res_buf_+i,n)),n);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    template<std::size_t...J>
+    ALWAYS_INLINE GTENSOR_TARGET_AVX512 static void micro_kernel_2rxnr(std::index_sequence<J...>, T* const res_buf, const T* a_buf, const T* b_buf, const std::size_t& kc_){
+        static constexpr std::size_t n_packed = alignment/sizeof(T);
+        using gtensor::detail::avx512_zero;
+        using gtensor::detail::avx512_load;
+        using gtensor::detail::avx512_store;
+        using gtensor::detail::avx512_madd;
+        using gtensor::detail::avx512_broadcast;
+        using z_type = decltype(avx512_zero<T>());
+        //z0[j],z1[j] accumulate upper and lower half of j-th column of block
+        z_type z0[Nr]{((void)J,avx512_zero<T>())...};
+        z_type z1[Nr]{((void)J,avx512_zero<T>())...};
+        for (const auto a_last=a_buf+kc_*Mr; a_buf!=a_last; a_buf+=Mr,b_buf+=Nr){
+            const auto a0 = avx512_load(a_buf);
+            const auto a1 = avx512_load(a_buf+n_packed);
+            ((madd_column<J>(a0,a1,b_buf,z0,z1)),...);
+        }
+        ((avx512_store(res_buf+2*J*n_packed,z0[J]),avx512_store(res_buf+(2*J+1)*n_packed,z1[J])),...);
+    }
+    template<std::size_t J, typename Z>
+    ALWAYS_INLINE GTENSOR_TARGET_AVX512 static void madd_column(const Z& a0, const Z& a1, const T* const b_buf, Z* z0, Z* z1){
+        using gtensor::detail::avx512_madd;
+        using gtensor::detail::avx512_broadcast;
+        const auto b_z = avx512_broadcast(b_buf+J);
+        z0[J] = avx512_madd<T>(a0,b_z,z0[J]);
+        z1[J] = avx512_madd<T>(a1,b_z,z1[J]);
+    }
+};
+
+//integer kernels, int8, int16 and int32 operands, int32 result
+//operands not wider than int16 are packed as int16 and multiplied by pairs along k with vpmaddwd (Kr=2), wider operands are packed as int32 and multiplied with vpmulld (Kr=1)
+//products of int16 and sums of its pairs are exact in int32, so result is exact if it fits int32
+template<typename T> inline constexpr bool is_matmul_int_operand_v = std::is_same_v<T,std::int8_t> || std::is_same_v<T,std::int16_t> || std::is_same_v<T,std::int32_t>;
+template<typename T, typename T1, typename T2> inline constexpr bool is_matmul_int_v = std::is_same_v<T,std::int32_t> && is_matmul_int_operand_v<T1> && is_matmul_int_operand_v<T2>;
+template<typename T1, typename T2> using matmul_int_packed_t = std::conditional_t<(sizeof(T1)<=sizeof(std::int16_t) && sizeof(T2)<=sizeof(std::int16_t)),std::int16_t,std::int32_t>;
+
+//edge blocks of integer kernels
+template<std::size_t Kr, typename T1>
+ALWAYS_INLINE void matmul_micro_kernel_int_generic(std::int32_t* res_buf, const T1* a_buf, const T1* b_buf, const std::size_t& mr_, const std::size_t& nr_, const std::size_t& kc_){
+    for (std::size_t i=0; i!=mr_*nr_; ++i){
+        res_buf[i] = 0;
+    }
+    for (std::size_t kk=0; kk!=kc_; kk+=Kr,a_buf+=mr_*Kr,b_buf+=nr_*Kr){
+        auto res_buf_ = res_buf;
+        for (std::size_t j=0; j!=nr_; ++j){
+            for (std::size_t i=0; i!=mr_; ++i,++res_buf_){
+                for (std::size_t r=0; r!=Kr; ++r){
+                    *res_buf_+=static_cast<std::int32_t>(a_buf[i*Kr+r])*static_cast<std::int32_t>(b_buf[j*Kr+r]);
+                }
+            }
+        }
+    }
+}
+
+//AVX2 2rx6 kernel, T1 is packed operand type
+template<typename T1>
+struct matmul_kernel_int_avx2
+{
+    static_assert(std::is_same_v<T1,std::int16_t> || std::is_same_v<T1,std::int32_t>);
+    using T = std::int32_t;
+    static constexpr isa level = isa::avx2;
+    static constexpr std::size_t alignment = 32;
+    static constexpr std::size_t Kr = sizeof(T)/sizeof(T1);
+    static constexpr std::size_t Nr = 6;
+    static constexpr std::size_t Mr = 2*alignment/sizeof(T);
+
+    GTENSOR_TARGET_AVX2 static void micro_kernel(T* res_buf, const T1* a_buf, const T1* b_buf, const std::size_t& mr_, const std::size_t& nr_, const std::size_t& kc_){
+        if (mr_==Mr && nr_==Nr){
+            micro_kernel_2rxn(std::make_index_sequence<Nr>{},res_buf,a_buf,b_buf,Nr*Kr,kc_);
+        }else if (mr_==Mr){
+            for (std::size_t j=0; j!=nr_; ++j){
+                micro_kernel_2rxn(std::index_sequence<0>{},res_buf+j*Mr,a_buf,b_buf+j*Kr,nr_*Kr,kc_);
+            }
+        }else{
+            matmul_micro_kernel_int_generic<Kr>(res_buf,a_buf,b_buf,mr_,nr_,kc_);
+        }
+    }
+
+private:
+    //b_step is number of packed elements of b per Kr steps of k
+    template<std::size_t...J>
+    ALWAYS_INLINE GTENSOR_TARGET_AVX2 static void micro_kernel_2rxn(std::index_sequence<J...>, T* const res_buf, const T1* a_buf, const T1* b_buf, const std::size_t& b_step, const std::size_t& kc_){
+        static constexpr std::size_t n_packed = alignment/sizeof(T);
+        __m256i y0[sizeof...(J)]{((void)J,_mm256_setzero_si256())...};
+        __m256i y1[sizeof...(J)]{((void)J,_mm256_setzero_si256())...};
+        for (const auto a_last=a_buf+kc_*Mr; a_buf!=a_last; a_buf+=Mr*Kr,b_buf+=b_step){
+            const auto a0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(a_buf));
+            const auto a1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(a_buf)+1);
+            ((madd_column<J>(a0,a1,b_buf,y0,y1)),...);
+        }
+        ((_mm256_store_si256(reinterpret_cast<__m256i*>(res_buf+2*J*n_packed),y0[J]),_mm256_store_si256(reinterpret_cast<__m256i*>(res_buf+(2*J+1)*n_packed),y1[J])),...);
+    }
+    template<std::size_t J>
+    ALWAYS_INLINE GTENSOR_TARGET_AVX2 static void madd_column(const __m256i& a0, const __m256i& a1, const T1* const b_buf, __m256i* y0, __m256i* y1){
+        std::int32_t b_e{};
+        std::memcpy(&b_e,b_buf+J*Kr,sizeof(b_e));
+        const auto b_y = _mm256_set1_epi32(b_e);
+        if constexpr (Kr==2){
+            y0[J] = _mm256_add_epi32(y0[J],_mm256_madd_epi16(a0,b_y));
+            y1[J] = _mm256_add_epi32(y1[J],_mm256_madd_epi16(a1,b_y));
+        }else{
+            y0[J] = _mm256_add_epi32(y0[J],_mm256_mullo_epi32(a0,b_y));
+            y1[J] = _mm256_add_epi32(y1[J],_mm256_mullo_epi32(a1,b_y));
+        }
+    }
+};
+
+//AVX-512 2rx14 kernel, T1 is packed operand type
+template<typename T1>
+struct matmul_kernel_int_avx512
+{
+    static_assert(std::is_same_v<T1,std::int16_t> || std::is_same_v<T1,std::int32_t>);
+    using T = std::int32_t;
+    static constexpr isa level = isa::avx512;
+    static constexpr std::size_t alignment = 64;
+    static constexpr std::size_t Kr = sizeof(T)/sizeof(T1);
+    static constexpr std::size_t Nr = 14;
+    static constexpr std::size_t Mr = 2*alignment/sizeof(T);
+
+    GTENSOR_TARGET_AVX512 static void micro_kernel(T* res_buf, const T1* a_buf, const T1* b_buf, const std::size_t& mr_, const std::size_t& nr_, const std::size_t& kc_){
+        if (mr_==Mr && nr_==Nr){
+            micro_kernel_2rxn(std::make_index_sequence<Nr>{},res_buf,a_buf,b_buf,Nr*Kr,kc_);
+        }else if (mr_==Mr){
+            for (std::size_t j=0; j!=nr_; ++j){
+                micro_kernel_2rxn(std::index_sequence<0>{},res_buf+j*Mr,a_buf,b_buf+j*Kr,nr_*Kr,kc_);
+            }
+        }else{
+            matmul_micro_kernel_int_generic<Kr>(res_buf,a_buf,b_buf,mr_,nr_,kc_);
+        }
+    }
+
+private:
+    template<std::size_t...J>
+    ALWAYS_INLINE GTENSOR_TARGET_AVX512 static void micro_kernel_2rxn(std::index_sequence<J...>, T* const res_buf, const T1* a_buf, const T1* b_buf, const std::size_t& b_step, const std::size_t& kc_){
+        static constexpr std::size_t n_packed = alignment/sizeof(T);
+        __m512i z0[sizeof...(J)]{((void)J,_mm512_setzero_si512())...};
+        __m512i z1[sizeof...(J)]{((void)J,_mm512_setzero_si512())...};
+        for (const auto a_last=a_buf+kc_*Mr; a_buf!=a_last; a_buf+=Mr*Kr,b_buf+=b_step){
+            const auto a0 = _mm512_load_si512(a_buf);
+            const auto a1 = _mm512_load_si512(a_buf+Mr*Kr/2);
+            ((madd_column<J>(a0,a1,b_buf,z0,z1)),...);
+        }
+        ((_mm512_store_si512(res_buf+2*J*n_packed,z0[J]),_mm512_store_si512(res_buf+(2*J+1)*n_packed,z1[J])),...);
+    }
+    template<std::size_t J>
+    ALWAYS_INLINE GTENSOR_TARGET_AVX512 static void madd_column(const __m512i& a0, const __m512i& a1, const T1* const b_buf, __m512i* z0, __m512i* z1){
+        std::int32_t b_e{};
+        std::memcpy(&b_e,b_buf+J*Kr,sizeof(b_e));
+        const auto b_z = _mm512_set1_epi32(b_e);
+        if constexpr (Kr==2){
+            z0[J] = _mm512_add_epi32(z0[J],_mm512_madd_epi16(a0,b_z));
+            z1[J] = _mm512_add_epi32(z1[J],_mm512_madd_epi16(a1,b_z));
+        }else{
+            z0[J] = _mm512_add_epi32(z0[J],_mm512_mullo_epi32(a0,b_z));
+            z1[J] = _mm512_add_epi32(z1[J],_mm512_mullo_epi32(a1,b_z));
+        }
+    }
+};
+
+//matrix-vector kernels, matrix rows are dense and lda elements apart, vectors are dense
+//dot returns sum of a[i]*x[i] for i in [0,n)
+//gemv_dot computes res[r] = dot(a+r*lda,x,n) for r in [0,m), gemv_rows rows share loads of x
+//gemv_axpy computes res[i] += x[r]*a[r*lda+i] for r in [0,m), i in [0,n), gemv_rows rows are accumulated per load and store of res
+inline constexpr std::size_t gemv_rows = 4;
+
+template<typename T, typename T1, typename T2>
+struct gemv_kernel_generic
+{
+    static T dot(const T1* a, const T2* x, const std::size_t& n){
+        T r0{0};
+        T r1{0};
+        T r2{0};
+        T r3{0};
+        std::size_t i{0};
+        for (; i+4<=n; i+=4){
+            r0 = r0+a[i]*x[i];
+            r1 = r1+a[i+1]*x[i+1];
+            r2 = r2+a[i+2]*x[i+2];
+            r3 = r3+a[i+3]*x[i+3];
+        }
+        for (; i!=n; ++i){
+            r0 = r0+a[i]*x[i];
+        }
+        return (r0+r1)+(r2+r3);
+    }
+    static void gemv_dot(T* res, const T1* a, const std::size_t& lda, const T2* x, const std::size_t& m, const std::size_t& n){
+        for (std::size_t r=0; r!=m; ++r,a+=lda){
+            res[r] = dot(a,x,n);
+        }
+    }
+    static void gemv_axpy(T* res, const T1* a, const std::size_t& lda, const T2* x, const std::size_t& m, const std::size_t& n){
+        std::size_t r{0};
+        for (; r+gemv_rows<=m; r+=gemv_rows,a+=gemv_rows*lda){
+            const T1* const a1 = a+lda;
+            const T1* const a2 = a+2*lda;
+            const T1* const a3 = a+3*lda;
+            for (std::size_t i=0; i!=n; ++i){
+                res[i] = res[i]+a[i]*x[r]+a1[i]*x[r+1]+a2[i]*x[r+2]+a3[i]*x[r+3];
+            }
+        }
+        for (; r!=m; ++r,a+=lda){
+            for (std::size_t i=0; i!=n; ++i){
+                res[i] = res[i]+a[i]*x[r];
+            }
+        }
+    }
+};
+
+//AVX2,FMA kernel, floating point and complex
+template<typename T>
+struct gemv_kernel_avx2
+{
+    static_assert(is_matmul_simd_type_v<T>);
+    static constexpr std::size_t n_packed = 32/sizeof(T);
+
+    GTENSOR_TARGET_AVX2 static T dot(const T* a, const T* x, const std::size_t& n){
+        using gtensor::detail::avx_zero;
+        using gtensor::detail::avx_loadu;
+        using gtensor::detail::avx_madd;
+        auto y0 = avx_zero<T>();
+        auto y1 = avx_zero<T>();
+        auto y2 = avx_zero<T>();
+        auto y3 = avx_zero<T>();
+        std::size_t i{0};
+        for (; i+4*n_packed<=n; i+=4*n_packed){
+            y0 = avx_madd<T>(avx_loadu(a+i),avx_loadu(x+i),y0);
+            y1 = avx_madd<T>(avx_loadu(a+i+n_packed),avx_loadu(x+i+n_packed),y1);
+            y2 = avx_madd<T>(avx_loadu(a+i+2*n_packed),avx_loadu(x+i+2*n_packed),y2);
+            y3 = avx_madd<T>(avx_loadu(a+i+3*n_packed),avx_loadu(x+i+3*n_packed),y3);
+        }
+        for (; i+n_packed<=n; i+=n_packed){
+            y0 = avx_madd<T>(avx_loadu(a+i),avx_loadu(x+i),y0);
+        }
+        T res = hsum(y0,y1,y2,y3);
+        for (; i!=n; ++i){
+            res = res+a[i]*x[i];
+        }
+        return res;
+    }
+    GTENSOR_TARGET_AVX2 static void gemv_dot(T* res, const T* a, const std::size_t& lda, const T* x, const std::size_t& m, const std::size_t& n){
+        using gtensor::detail::avx_zero;
+        using gtensor::detail::avx_loadu;
+        using gtensor::detail::avx_madd;
+        std::size_t r{0};
+        for (; r+gemv_rows<=m; r+=gemv_rows,a+=gemv_rows*lda){
+            const T* const a1 = a+lda;
+            const T* const a2 = a+2*lda;
+            const T* const a3 = a+3*lda;
+            auto y0 = avx_zero<T>();
+            auto y1 = avx_zero<T>();
+            auto y2 = avx_zero<T>();
+            auto y3 = avx_zero<T>();
+            std::size_t i{0};
+            for (; i+n_packed<=n; i+=n_packed){
+                const auto x_y = avx_loadu(x+i);
+                y0 = avx_madd<T>(avx_loadu(a+i),x_y,y0);
+                y1 = avx_madd<T>(avx_loadu(a1+i),x_y,y1);
+                y2 = avx_madd<T>(avx_loadu(a2+i),x_y,y2);
+                y3 = avx_madd<T>(avx_loadu(a3+i),x_y,y3);
+            }
+            T r0 = hsum(y0);
+            T r1 = hsum(y1);
+            T r2 = hsum(y2);
+            T r3 = hsum(y3);
+            for (; i!=n; ++i){
+                r0 = r0+a[i]*x[i];
+                r1 = r1+a1[i]*x[i];
+                r2 = r2+a2[i]*x[i];
+                r3 = r3+a3[i]*x[i];
+            }
+            res[r] = r0;
+            res[r+1] = r1;
+            res[r+2] = r2;
+            res[r+3] = r3;
+        }
+        for (; r!=m; ++r,a+=lda){
+            res[r] = dot(a,x,n);
+        }
+    }
+    GTENSOR_TARGET_AVX2 static void gemv_axpy(T* res, const T* a, const std::size_t& lda, const T* x, const std::size_t& m, const std::size_t& n){
+        using gtensor::detail::avx_loadu;
+        using gtensor::detail::avx_storeu;
+        using gtensor::detail::avx_broadcast;
+        using gtensor::detail::avx_madd;
+        std::size_t r{0};
+        for (; r+gemv_rows<=m; r+=gemv_rows,a+=gemv_rows*lda){
+            const T* const a1 = a+lda;
+            const T* const a2 = a+2*lda;
+            const T* const a3 = a+3*lda;
+            const auto x0 = avx_broadcast(x+r);
+            const auto x1 = avx_broadcast(x+r+1);
+            const auto x2 = avx_broadcast(x+r+2);
+            const auto x3 = avx_broadcast(x+r+3);
+            std::size_t i{0};
+            for (; i+n_packed<=n; i+=n_packed){
+                auto y = avx_loadu(res+i);
+                y = avx_madd<T>(avx_loadu(a+i),x0,y);
+                y = avx_madd<T>(avx_loadu(a1+i),x1,y);
+                y = avx_madd<T>(avx_loadu(a2+i),x2,y);
+                y = avx_madd<T>(avx_loadu(a3+i),x3,y);
+                avx_storeu(res+i,y);
+            }
+            for (; i!=n; ++i){
+                res[i] = res[i]+a[i]*x[r]+a1[i]*x[r+1]+a2[i]*x[r+2]+a3[i]*x[r+3];
+            }
+        }
+        for (; r!=m; ++r,a+=lda){
+            const auto x0 = avx_broadcast(x+r);
+            std::size_t i{0};
+            for (; i+n_packed<=n; i+=n_packed){
+                avx_storeu(res+i,avx_madd<T>(avx_loadu(a+i),x0,avx_loadu(res+i)));
+            }
+            for (; i!=n; ++i){
+                res[i] = res[i]+a[i]*x[r];
+            }
+        }
+    }
+
+private:
+    //sum of elements of registers
+    template<typename...Y>
+    ALWAYS_INLINE GTENSOR_TARGET_AVX2 static T hsum(const Y&...y){
+        using gtensor::detail::avx_store;
+        alignas(32) T buf[sizeof...(Y)*n_packed];
+        std::size_t i{0};
+        ((avx_store(buf+i,y),i+=n_packed),...);
+        T res{0};
+        for (const auto& e : buf){
+            res = res+e;
+        }
+        return res;
+    }
+};
+
+//AVX-512 kernel, floating point and complex, tails are processed by masked loads and stores
+template<typename T>
+struct gemv_kernel_avx512
+{
+    static_assert(is_matmul_simd_type_v<T>);
+    static constexpr std::size_t n_packed = 64/sizeof(T);
+
+    GTENSOR_TARGET_AVX512 static T dot(const T* a, const T* x, const std::size_t& n){
+        using gtensor::detail::avx512_zero;
+        using gtensor::detail::avx512_loadu;
+        using gtensor::detail::avx512_maskz_loadu;
+        using gtensor::detail::avx512_madd;
+        auto z0 = avx512_zero<T>();
+        auto z1 = avx512_zero<T>();
+        auto z2 = avx512_zero<T>();
+        auto z3 = avx512_zero<T>();
+        std::size_t i{0};
+        for (; i+4*n_packed<=n; i+=4*n_packed){
+            z0 = avx512_madd<T>(avx512_loadu(a+i),avx512_loadu(x+i),z0);
+            z1 = avx512_madd<T>(avx512_loadu(a+i+n_packed),avx512_loadu(x+i+n_packed),z1);
+            z2 = avx512_madd<T>(avx512_loadu(a+i+2*n_packed),avx512_loadu(x+i+2*n_packed),z2);
+            z3 = avx512_madd<T>(avx512_loadu(a+i+3*n_packed),avx512_loadu(x+i+3*n_packed),z3);
+        }
+        for (; i+n_packed<=n; i+=n_packed){
+            z0 = avx512_madd<T>(avx512_loadu(a+i),avx512_loadu(x+i),z0);
+        }
+        if (i!=n){
+            z1 = avx512_madd<T>(avx512_maskz_loadu(a+i,n-i),avx512_maskz_loadu(x+i,n-i),z1);
+        }
+        return hsum(z0,z1,z2,z3);
+    }
+    GTENSOR_TARGET_AVX512 static void gemv_dot(T* res, const T* a, const std::size_t& lda, const T* x, const std::size_t& m, const std::size_t& n){
+        using gtensor::detail::avx512_zero;
+        using gtensor::detail::avx512_loadu;
+        using gtensor::detail::avx512_maskz_loadu;
+        using gtensor::detail::avx512_madd;
+        std::size_t r{0};
+        for (; r+gemv_rows<=m; r+=gemv_rows,a+=gemv_rows*lda){
+            const T* const a1 = a+lda;
+            const T* const a2 = a+2*lda;
+            const T* const a3 = a+3*lda;
+            auto z0 = avx512_zero<T>();
+            auto z1 = avx512_zero<T>();
+            auto z2 = avx512_zero<T>();
+            auto z3 = avx512_zero<T>();
+            std::size_t i{0};
+            for (; i+n_packed<=n; i+=n_packed){
+                const auto x_z = avx512_loadu(x+i);
+                z0 = avx512_madd<T>(avx512_loadu(a+i),x_z,z0);
+                z1 = avx512_madd<T>(avx512_loadu(a1+i),x_z,z1);
+                z2 = avx512_madd<T>(avx512_loadu(a2+i),x_z,z2);
+                z3 = avx512_madd<T>(avx512_loadu(a3+i),x_z,z3);
+            }
+            if (i!=n){
+                const auto x_z = avx512_maskz_loadu(x+i,n-i);
+                z0 = avx512_madd<T>(avx512_maskz_loadu(a+i,n-i),x_z,z0);
+                z1 = avx512_madd<T>(avx512_maskz_loadu(a1+i,n-i),x_z,z1);
+                z2 = avx512_madd<T>(avx512_maskz_loadu(a2+i,n-i),x_z,z2);
+                z3 = avx512_madd<T>(avx512_maskz_loadu(a3+i,n-i),x_z,z3);
+            }
+            res[r] = hsum(z0);
+            res[r+1] = hsum(z1);
+            res[r+2] = hsum(z2);
+            res[r+3] = hsum(z3);
+        }
+        for (; r!=m; ++r,a+=lda){
+            res[r] = dot(a,x,n);
+        }
+    }
+    GTENSOR_TARGET_AVX512 static void gemv_axpy(T* res, const T* a, const std::size_t& lda, const T* x, const std::size_t& m, const std::size_t& n){
+        using gtensor::detail::avx512_loadu;
+        using gtensor::detail::avx512_storeu;
+        using gtensor::detail::avx512_maskz_loadu;
+        using gtensor::detail::avx512_mask_storeu;
+        using gtensor::detail::avx512_broadcast;
+        using gtensor::detail::avx512_madd;
+        std::size_t r{0};
+        for (; r+gemv_rows<=m; r+=gemv_rows,a+=gemv_rows*lda){
+            const T* const a1 = a+lda;
+            const T* const a2 = a+2*lda;
+            const T* const a3 = a+3*lda;
+            const auto x0 = avx512_broadcast(x+r);
+            const auto x1 = avx512_broadcast(x+r+1);
+            const auto x2 = avx512_broadcast(x+r+2);
+            const auto x3 = avx512_broadcast(x+r+3);
+            std::size_t i{0};
+            for (; i+n_packed<=n; i+=n_packed){
+                auto z = avx512_loadu(res+i);
+                z = avx512_madd<T>(avx512_loadu(a+i),x0,z);
+                z = avx512_madd<T>(avx512_loadu(a1+i),x1,z);
+                z = avx512_madd<T>(avx512_loadu(a2+i),x2,z);
+                z = avx512_madd<T>(avx512_loadu(a3+i),x3,z);
+                avx512_storeu(res+i,z);
+            }
+            if (i!=n){
+                auto z = avx512_maskz_loadu(res+i,n-i);
+                z = avx512_madd<T>(avx512_maskz_loadu(a+i,n-i),x0,z);
+                z = avx512_madd<T>(avx512_maskz_loadu(a1+i,n-i),x1,z);
+                z = avx512_madd<T>(avx512_maskz_loadu(a2+i,n-i),x2,z);
+                z = avx512_madd<T>(avx512_maskz_loadu(a3+i,n-i),x3,z);
+                avx512_mask_storeu(res+i,z,n-i);
+            }
+        }
+        for (; r!=m; ++r,a+=lda){
+            const auto x0 = avx512_broadcast(x+r);
+            std::size_t i{0};
+            for (; i+n_packed<=n; i+=n_packed){
+                avx512_storeu(res+i,avx512_madd<T>(avx512_loadu(a+i),x0,avx512_loadu(res+i)));
+            }
+            if (i!=n){
+                avx512_mask_storeu(res+i,avx512_madd<T>(avx512_maskz_loadu(a+i,n-i),x0,avx512_maskz_loadu(res+i,n-i)),n-i);
+            }
+        }
+    }
+
+private:
+    template<typename...Z>
+    ALWAYS_INLINE GTENSOR_TARGET_AVX512 static T hsum(const Z&...z){
+        using gtensor::detail::avx512_store;
+        alignas(64) T buf[sizeof...(Z)*n_packed];
+        std::size_t i{0};
+        ((avx512_store(buf+i,z),i+=n_packed),...);
+        T res{0};
+        for (const auto& e : buf){
+            res = res+e;
+        }
+        return res;
+    }
+};
+
+//call f with matrix-vector kernel selected by kernel_isa(), vectorized kernels require the same result and operands type
+template<typename T, typename T1, typename T2, typename F>
+ALWAYS_INLINE void gemv_dispatch(F&& f){
+    if constexpr (std::is_same_v<T,T1> && std::is_same_v<T,T2> && is_matmul_simd_type_v<T> && compile_isa()>=isa::avx2){
+        const auto isa_ = kernel_isa();
+        if constexpr (compile_isa()>=isa::avx512){
+            if (isa_==isa::avx512){
+                f(gemv_kernel_avx512<T>{});
+                return;
+            }
+        }
+        if (isa_>=isa::avx2){
+            f(gemv_kernel_avx2<T>{});
+            return;
+        }
+    }
+    f(gemv_kernel_generic<T,T1,T2>{});
+}
+
+}   //end of namespace detail
+}   //end of namespace gtensor
+#endif
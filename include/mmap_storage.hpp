@@ -0,0 +1,317 @@
+/*
+* GTensor - computation library
+* Copyright (c) 2022 Ivan Malezhyk <ivanmzk@gmail.com>
+*
+* Distributed under the Boost Software License, Version 1.0.
+* The full license is in the file LICENSE.txt, distributed with this software.
+*/
+
+#ifndef MMAP_STORAGE_HPP_
+#define MMAP_STORAGE_HPP_
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GTENSOR_HAS_MMAP 1
+#else
+#define GTENSOR_HAS_MMAP 0
+#endif
+
+#if GTENSOR_HAS_MMAP
+
+#include <string>
+#include <new>
+#include <memory>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+#include <initializer_list>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "exception.hpp"
+#include "config.hpp"
+
+namespace gtensor{
+
+//read_only - mapping is not writable
+//copy_on_write - writes are visible only to this mapping, file is never modified
+//read_write - writes are carried to file and visible to other processes that map the same file
+//create - the same as read_write, but file is created if not exists and extended if it is too small
+enum class mmap_mode {read_only, copy_on_write, read_write, create};
+
+//storage of trivially copyable elements that may be backed by memory mapped file
+//file backed storage is constructed using file constructor, elements are paged in on demand and page cache is shared between processes
+//all other constructors allocate elements on heap, so it can be used as Config::storage template
+//copy always allocates on heap, move steals mapping
+template<typename T>
+class mmap_storage
+{
+    static_assert(std::is_trivially_copyable_v<T>,"mmap_storage element type must be trivially copyable");
+public:
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = pointer;
+    using const_iterator = const_pointer;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using difference_type = std::ptrdiff_t;
+    using size_type = std::size_t;
+
+    ~mmap_storage()
+    {
+        free();
+    }
+    mmap_storage() = default;
+    mmap_storage(const mmap_storage& other)
+    {
+        init(other.begin(),other.end());
+    }
+    mmap_storage(mmap_storage&& other)noexcept:
+        begin_{other.begin_},
+        end_{other.end_},
+        map_addr_{other.map_addr_},
+        map_size_{other.map_size_},
+        mode_{other.mode_}
+    {
+        other.reset();
+    }
+    mmap_storage& operator=(const mmap_storage& other){
+        if (this != &other){
+            mmap_storage tmp{other};
+            swap(tmp);
+        }
+        return *this;
+    }
+    mmap_storage& operator=(mmap_storage&& other)noexcept{
+        if (this != &other){
+            free();
+            begin_ = other.begin_;
+            end_ = other.end_;
+            map_addr_ = other.map_addr_;
+            map_size_ = other.map_size_;
+            mode_ = other.mode_;
+            other.reset();
+        }
+        return *this;
+    }
+    //construct storage of n elements, no initialization is performed
+    explicit mmap_storage(const size_type& n)
+    {
+        allocate(n);
+    }
+    //construct storage of n elements initialized to v
+    mmap_storage(const size_type& n, const value_type& v)
+    {
+        allocate(n);
+        std::uninitialized_fill(begin_,end_,v);
+    }
+
+    template<typename, typename = void> struct is_input_iterator : std::false_type{};
+    template<typename U> struct is_input_iterator<U,std::void_t<typename std::iterator_traits<U>::iterator_category>> : std::is_convertible<typename std::iterator_traits<U>::iterator_category,std::input_iterator_tag>{};
+
+    //construct storage from iterators range
+    template<typename It, std::enable_if_t<is_input_iterator<It>::value,int> =0>
+    mmap_storage(It first, It last)
+    {
+        init(first,last);
+    }
+    mmap_storage(std::initializer_list<value_type> init_list)
+    {
+        init(init_list.begin(),init_list.end());
+    }
+    //map n elements of file starting from offset in bytes, offset must be multiple of value_type alignment
+    //file must exist and contain offset+n*sizeof(value_type) bytes, except create mode
+    mmap_storage(const std::string& file_name, mmap_mode mode, const size_type& n, const size_type& offset = 0):
+        mode_{mode}
+    {
+        map(file_name,n,offset);
+    }
+
+    void swap(mmap_storage& other){
+        std::swap(begin_,other.begin_);
+        std::swap(end_,other.end_);
+        std::swap(map_addr_,other.map_addr_);
+        std::swap(map_size_,other.map_size_);
+        std::swap(mode_,other.mode_);
+    }
+    //true if elements are backed by mapped file
+    bool is_mapped()const{
+        return map_addr_ != nullptr;
+    }
+    mmap_mode mode()const{
+        return mode_;
+    }
+    //write dirty pages of read_write or create mapping to file, no effect in other modes
+    void flush(){
+        if (is_mapped() && is_shared()){
+            if (::msync(map_addr_,map_size_,MS_SYNC) != 0){
+                throw io_error("mmap_storage: msync failed");
+            }
+        }
+    }
+    size_type size()const{
+        return end_-begin_;
+    }
+    bool empty()const{
+        return begin()==end();
+    }
+    value_type* data(){
+        return begin_;
+    }
+    const value_type* data()const{
+        return begin_;
+    }
+    iterator begin(){
+        return begin_;
+    }
+    iterator end(){
+        return end_;
+    }
+    reverse_iterator rbegin(){
+        return std::make_reverse_iterator(end());
+    }
+    reverse_iterator rend(){
+        return std::make_reverse_iterator(begin());
+    }
+    const_iterator begin()const{
+        return begin_;
+    }
+    const_iterator end()const{
+        return end_;
+    }
+    const_reverse_iterator rbegin()const{
+        return std::make_reverse_iterator(end());
+    }
+    const_reverse_iterator rend()const{
+        return std::make_reverse_iterator(begin());
+    }
+    reference operator[](const size_type& i){
+        return *(begin_+i);
+    }
+    const_reference operator[](const size_type& i)const{
+        return *(begin_+i);
+    }
+
+private:
+    bool is_shared()const{
+        return mode_ == mmap_mode::read_write || mode_ == mmap_mode::create;
+    }
+    void reset()noexcept{
+        begin_ = nullptr;
+        end_ = nullptr;
+        map_addr_ = nullptr;
+        map_size_ = 0;
+        mode_ = mmap_mode::copy_on_write;
+    }
+
+    void allocate(const size_type& n){
+        if (n>0){
+            begin_ = static_cast<pointer>(::operator new(n*sizeof(value_type), std::align_val_t{alignof(value_type)}));
+            end_ = begin_+n;
+        }
+    }
+
+    template<typename It>
+    void init(It first, It last){
+        if constexpr (std::is_convertible_v<typename std::iterator_traits<It>::iterator_category,std::forward_iterator_tag>){
+            allocate(static_cast<size_type>(std::distance(first,last)));
+            std::uninitialized_copy(first,last,begin_);
+        }else{
+            mmap_storage tmp{};
+            size_type n{0};
+            for (;first!=last; ++first,++n){
+                if (n==tmp.size()){
+                    mmap_storage grown(n==0 ? 1 : 2*n);
+                    std::copy(tmp.begin(),tmp.end(),grown.begin());
+                    tmp.swap(grown);
+                }
+                tmp[n] = *first;
+            }
+            allocate(n);
+            std::copy(tmp.begin(),tmp.begin()+n,begin_);
+        }
+    }
+
+    void map(const std::string& file_name, const size_type& n, const size_type& offset){
+        if (offset%alignof(value_type) != 0){
+            throw value_error("mmap_storage: offset must be multiple of element alignment");
+        }
+        const bool shared = is_shared();
+        const bool create = mode_ == mmap_mode::create;
+        const int fd = create ? ::open(file_name.c_str(), O_RDWR|O_CREAT, 0644) : ::open(file_name.c_str(), shared ? O_RDWR : O_RDONLY);
+        if (fd < 0){
+            throw io_error("mmap_storage: can't open file");
+        }
+        const size_type bytes = n*sizeof(value_type);
+        struct ::stat st;
+        if (::fstat(fd,&st) != 0){
+            ::close(fd);
+            throw io_error("mmap_storage: can't stat file");
+        }
+        const size_type file_size = static_cast<size_type>(st.st_size);
+        if (file_size < offset+bytes){
+            if (!create){
+                ::close(fd);
+                throw value_error("mmap_storage: file is too small");
+            }
+            if (::ftruncate(fd, static_cast<off_t>(offset+bytes)) != 0){
+                ::close(fd);
+                throw io_error("mmap_storage: can't extend file");
+            }
+        }
+        if (n==0){
+            ::close(fd);
+            return;
+        }
+        //mapping offset must be multiple of page size
+        const size_type page_size = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+        const size_type map_offset = offset - offset%page_size;
+        const size_type map_size = bytes + (offset-map_offset);
+        const int prot = mode_ == mmap_mode::read_only ? PROT_READ : PROT_READ|PROT_WRITE;
+        const int flags = shared ? MAP_SHARED : MAP_PRIVATE;
+        void* addr = ::mmap(nullptr, map_size, prot, flags, fd, static_cast<off_t>(map_offset));
+        ::close(fd);    //mapping holds reference to file
+        if (addr == MAP_FAILED){
+            throw io_error("mmap_storage: mmap failed");
+        }
+        map_addr_ = addr;
+        map_size_ = map_size;
+        begin_ = reinterpret_cast<pointer>(static_cast<char*>(addr)+(offset-map_offset));
+        end_ = begin_+n;
+    }
+
+    void free()noexcept{
+        if (is_mapped()){
+            ::munmap(map_addr_,map_size_);
+        }else if (begin_){
+            ::operator delete(begin_, std::align_val_t{alignof(value_type)});
+        }
+        reset();
+    }
+
+    pointer begin_{nullptr};
+    pointer end_{nullptr};
+    void* map_addr_{nullptr};
+    size_type map_size_{0};
+    mmap_mode mode_{mmap_mode::copy_on_write};
+};
+
+namespace config{
+
+//config with mmap_storage as elements storage
+//index_map of Config is kept, so mapping views don't allocate indexes using mmap_storage
+template<typename Config = default_config>
+struct mmap_config : public Config
+{
+    template<typename T> using storage = gtensor::mmap_storage<T>;
+    template<typename T> using index_map = typename Config::template index_map<T>;
+};
+
+}   //end of namespace config
+}   //end of namespace gtensor
+
+#endif
+#endif
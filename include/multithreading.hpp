@@ -17,7 +17,15 @@
 #include <vector>
 #include <numeric>
 #include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
 #include <iostream>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 namespace multithreading{
 
@@ -441,6 +449,384 @@ private:
     std::condition_variable has_slot;
 };
 
+//multiple producer multiple consumer lock-free bounded queue
+//capacity is rounded up to power of 2
+template<typename T>
+class mpmc_bounded_queue
+{
+    static_assert(std::is_nothrow_copy_assignable_v<T> && std::is_trivially_destructible_v<T>);
+    struct cell{
+        std::atomic<std::size_t> seq;
+        T value;
+    };
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    explicit mpmc_bounded_queue(size_type capacity__):
+        capacity_{make_capacity(capacity__)},
+        mask{capacity_-1},
+        elements{std::make_unique<cell[]>(capacity_)}
+    {
+        for (size_type i=0; i!=capacity_; ++i){
+            elements[i].seq.store(i,std::memory_order_relaxed);
+        }
+    }
+
+    bool try_push(const value_type& v){
+        cell* c{nullptr};
+        auto pos = push_index.load(std::memory_order_relaxed);
+        while(true){
+            c = &elements[pos&mask];
+            const auto seq = c->seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff==0){
+                if (push_index.compare_exchange_weak(pos,pos+1,std::memory_order_relaxed)){
+                    break;
+                }
+            }else if (diff<0){  //full
+                return false;
+            }else{
+                pos = push_index.load(std::memory_order_relaxed);
+            }
+        }
+        c->value = v;
+        c->seq.store(pos+1,std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(value_type& v){
+        cell* c{nullptr};
+        auto pos = pop_index.load(std::memory_order_relaxed);
+        while(true){
+            c = &elements[pos&mask];
+            const auto seq = c->seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos+1);
+            if (diff==0){
+                if (pop_index.compare_exchange_weak(pos,pos+1,std::memory_order_relaxed)){
+                    break;
+                }
+            }else if (diff<0){  //empty
+                return false;
+            }else{
+                pos = pop_index.load(std::memory_order_relaxed);
+            }
+        }
+        v = c->value;
+        c->seq.store(pos+mask+1,std::memory_order_release);
+        return true;
+    }
+
+    size_type capacity()const{return capacity_;}
+
+private:
+    static size_type make_capacity(size_type n){
+        if (n == 0){
+            throw std::invalid_argument("queue capacity must be > 0");
+        }
+        size_type res{1};
+        while(res<n){
+            res<<=1;
+        }
+        return res<2 ? 2 : res;
+    }
+
+    size_type capacity_;
+    size_type mask;
+    std::unique_ptr<cell[]> elements;
+    alignas(64) std::atomic<size_type> push_index{0};
+    alignas(64) std::atomic<size_type> pop_index{0};
+};
+
+//Chase-Lev work stealing deque of pointers
+//push_bottom, pop_bottom must be called by owner thread only, steal may be called by any thread
+//capacity is rounded up to power of 2
+template<typename T>
+class ws_deque
+{
+    using index_type = std::ptrdiff_t;
+public:
+    using value_type = T*;
+    using size_type = std::size_t;
+
+    explicit ws_deque(size_type capacity__):
+        capacity_{make_capacity(capacity__)},
+        mask{static_cast<index_type>(capacity_-1)},
+        elements{std::make_unique<std::atomic<value_type>[]>(capacity_)}
+    {}
+
+    //return false if full
+    bool push_bottom(value_type v){
+        const auto b = bottom.load(std::memory_order_relaxed);
+        const auto t = top.load(std::memory_order_acquire);
+        if (b-t > mask){
+            return false;
+        }
+        elements[b&mask].store(v,std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b+1,std::memory_order_relaxed);
+        return true;
+    }
+    //LIFO end, return nullptr if empty
+    value_type pop_bottom(){
+        const auto b = bottom.load(std::memory_order_relaxed)-1;
+        bottom.store(b,std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto t = top.load(std::memory_order_relaxed);
+        value_type res{nullptr};
+        if (t<=b){
+            res = elements[b&mask].load(std::memory_order_relaxed);
+            if (t==b){  //last element, race with stealers
+                if (!top.compare_exchange_strong(t,t+1,std::memory_order_seq_cst,std::memory_order_relaxed)){
+                    res = nullptr;
+                }
+                bottom.store(b+1,std::memory_order_relaxed);
+            }
+        }else{
+            bottom.store(b+1,std::memory_order_relaxed);
+        }
+        return res;
+    }
+    //FIFO end, return nullptr if empty or lost race
+    value_type steal(){
+        auto t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto b = bottom.load(std::memory_order_acquire);
+        if (t<b){
+            auto res = elements[t&mask].load(std::memory_order_relaxed);
+            if (top.compare_exchange_strong(t,t+1,std::memory_order_seq_cst,std::memory_order_relaxed)){
+                return res;
+            }
+        }
+        return nullptr;
+    }
+
+    size_type capacity()const{return capacity_;}
+
+private:
+    static size_type make_capacity(size_type n){
+        if (n == 0){
+            throw std::invalid_argument("deque capacity must be > 0");
+        }
+        size_type res{1};
+        while(res<n){
+            res<<=1;
+        }
+        return res;
+    }
+
+    size_type capacity_;
+    index_type mask;
+    std::unique_ptr<std::atomic<value_type>[]> elements;
+    alignas(64) std::atomic<index_type> top{0};
+    alignas(64) std::atomic<index_type> bottom{0};
+};
+
+namespace detail{
+
+//max cpu id of affinity list
+#if defined(__linux__)
+inline constexpr std::size_t max_cpu_id = CPU_SETSIZE-1;
+#else
+inline constexpr std::size_t max_cpu_id = 1023;
+#endif
+
+//pin thread to cpu, return false if pinning failed or not supported on platform
+inline bool pin_thread(std::thread& t, std::size_t cpu){
+#if defined(__linux__)
+    if (cpu > max_cpu_id){
+        return false;
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+    return pthread_setaffinity_np(t.native_handle(), sizeof(cpu_set_t), &cpu_set) == 0;
+#else
+    static_cast<void>(t);
+    static_cast<void>(cpu);
+    return false;
+#endif
+}
+
+}   //end of namespace detail
+
+//work stealing thread pool
+//each worker has its own deque, tasks pushed from worker thread go to its deque, tasks pushed from other threads go to lock-free injection queue
+//idle worker takes tasks from own deque, then from injection queue, then steals from other workers
+//has the same push interface as thread_pool_v3
+class thread_pool_v4
+{
+    using task_type = detail::task_v3_base;
+    using deque_type = ws_deque<task_type>;
+    using queue_type = mpmc_bounded_queue<task_type*>;
+    using mutex_type = std::mutex;
+
+    struct worker_id{
+        const thread_pool_v4* pool{nullptr};
+        std::size_t index{0};
+    };
+    static worker_id& this_worker(){
+        static thread_local worker_id id_{};
+        return id_;
+    }
+
+public:
+
+    ~thread_pool_v4()
+    {
+        stop();
+    }
+    thread_pool_v4(std::size_t n_workers):
+        thread_pool_v4(n_workers, n_workers)
+    {}
+    thread_pool_v4(std::size_t n_workers, std::size_t n_tasks):
+        thread_pool_v4(n_workers, n_tasks, std::vector<std::size_t>{})
+    {}
+    //i-th worker is pinned to affinity[i%affinity.size()] cpu, empty affinity means no pinning
+    thread_pool_v4(std::size_t n_workers, std::size_t n_tasks, const std::vector<std::size_t>& affinity):
+        injection(n_tasks)
+    {
+        init(n_workers, n_tasks, affinity);
+    }
+
+    //return task_future<R> object, where R is return type of F called with args, future will sync when destroyed
+    //std::reference_wrapper should be used to pass args by ref
+    template<typename F, typename...Args>
+    auto push(F&& f, Args&&...args){return push_<true>(std::forward<F>(f), std::forward<Args>(args)...);}
+    //returned future will not sync when destroyed
+    template<typename F, typename...Args>
+    auto push_async(F&& f, Args&&...args){return push_<false>(std::forward<F>(f), std::forward<Args>(args)...);}
+    //bind task to group
+    template<typename F, typename...Args>
+    void push_group(task_group& group, F&& f, Args&&...args){
+        using impl_type = detail::group_task_v3_impl<std::decay_t<F>, std::decay_t<Args>...>;
+        group.inc();
+        schedule(new impl_type(group, std::forward<F>(f), std::forward<Args>(args)...));
+    }
+
+    std::size_t size()const{return workers.size();}
+
+private:
+
+    template<bool Sync = true, typename F, typename...Args>
+    auto push_(F&& f, Args&&...args){
+        using impl_type = detail::task_v3_impl<std::decay_t<F>, std::decay_t<Args>...>;
+        auto task = std::make_unique<impl_type>(std::forward<F>(f),std::forward<Args>(args)...);
+        auto future = task->get_future(Sync);
+        schedule(task.release());
+        return future;
+    }
+
+    void schedule(task_type* task){
+        const auto& id = this_worker();
+        if (id.pool != this || !deques[id.index]->push_bottom(task)){
+            //injection queue is full - run oldest task on calling thread to make room
+            while(!injection.try_push(task)){
+                task_type* t{nullptr};
+                if (injection.try_pop(t)){
+                    pending.fetch_sub(1);
+                    run(t);
+                }else{
+                    std::this_thread::yield();
+                }
+            }
+        }
+        pending.fetch_add(1);
+        if (sleeping.load()!=0){
+            std::lock_guard<mutex_type> lock{guard};
+            has_task.notify_one();
+        }
+    }
+
+    static void run(task_type* task){
+        std::unique_ptr<task_type> task_{task};
+        task_->call();
+    }
+
+    task_type* find_task(std::size_t index){
+        if (auto t = deques[index]->pop_bottom()){
+            return t;
+        }
+        task_type* t{nullptr};
+        if (injection.try_pop(t)){
+            return t;
+        }
+        const auto n = deques.size();
+        for (std::size_t i=1; i!=n; ++i){
+            if (auto t_ = deques[(index+i)%n]->steal()){
+                return t_;
+            }
+        }
+        return nullptr;
+    }
+
+    void init(std::size_t n_workers, std::size_t n_tasks, const std::vector<std::size_t>& affinity){
+        deques.reserve(n_workers);
+        for (std::size_t i=0; i!=n_workers; ++i){
+            deques.push_back(std::make_unique<deque_type>(n_tasks));
+        }
+        workers.reserve(n_workers);
+        for (std::size_t i=0; i!=n_workers; ++i){
+            workers.emplace_back(&thread_pool_v4::worker_loop, this, i);
+            if (!affinity.empty()){
+                detail::pin_thread(workers.back(), affinity[i%affinity.size()]);
+            }
+        }
+    }
+
+    void stop(){
+        std::unique_lock<mutex_type> lock{guard};
+        finish_workers.store(true);
+        has_task.notify_all();
+        lock.unlock();
+        std::for_each(workers.begin(),workers.end(),[](auto& worker){worker.join();});
+        //destroy not executed tasks
+        task_type* t{nullptr};
+        while(injection.try_pop(t)){
+            delete t;
+        }
+        for (auto& d : deques){
+            while(auto t_ = d->steal()){
+                delete t_;
+            }
+        }
+    }
+
+    void worker_loop(std::size_t index){
+        //spinning before sleep only makes sense when there are free cores
+        static const std::size_t spin_n = std::thread::hardware_concurrency() > 1 ? 64 : 0;
+        this_worker() = worker_id{this,index};
+        std::size_t spin{0};
+        while(!finish_workers.load()){
+            if (auto t = find_task(index)){
+                pending.fetch_sub(1);
+                run(t);
+                spin = 0;
+            }else if (spin!=spin_n){
+                ++spin;
+                std::this_thread::yield();
+            }else{
+                std::unique_lock<mutex_type> lock{guard};
+                sleeping.fetch_add(1);
+                while(!finish_workers.load() && pending.load()<=0){
+                    has_task.wait(lock);
+                }
+                sleeping.fetch_sub(1);
+                spin = 0;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<deque_type>> deques;
+    queue_type injection;
+    std::vector<std::thread> workers;
+    std::atomic<bool> finish_workers{false};
+    std::atomic<std::ptrdiff_t> pending{0};
+    std::atomic<std::size_t> sleeping{0};
+    mutex_type guard;
+    std::condition_variable has_task;
+};
+
 template<typename ParSize>
 class par_task_size
 {
@@ -468,46 +854,286 @@ public:
 };
 
 
-inline constexpr std::size_t pool_workers_n = 16;
+//default global pool queue capacity
 inline constexpr std::size_t pool_queue_size = 256;
-inline auto& get_pool(){
-    static thread_pool_v3 pool_{pool_workers_n, pool_queue_size};
-    return pool_;
+
+inline std::size_t default_pool_workers_n(){
+    const std::size_t n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+//global pool configuration
+//affinity is list of cpu ids, i-th worker is pinned to affinity[i%affinity.size()], empty affinity means no pinning
+struct pool_config{
+    std::size_t workers_n{default_pool_workers_n()};
+    std::size_t queue_size{pool_queue_size};
+    std::vector<std::size_t> affinity{};
+};
+
+//environment variables to configure global pool, read once before first use of pool
+//GTENSOR_POOL_WORKERS - workers number
+//GTENSOR_POOL_QUEUE_SIZE - queue capacity
+//GTENSOR_POOL_AFFINITY - comma separated list of cpu ids or ranges, e.g. "0,2,4-7"
+inline constexpr const char* pool_workers_env = "GTENSOR_POOL_WORKERS";
+inline constexpr const char* pool_queue_size_env = "GTENSOR_POOL_QUEUE_SIZE";
+inline constexpr const char* pool_affinity_env = "GTENSOR_POOL_AFFINITY";
+
+namespace detail{
+
+//return false if str is not positive integer
+inline bool parse_pool_size(const char* str, std::size_t& res){
+    if (str == nullptr || *str<'0' || *str>'9'){
+        return false;
+    }
+    char* end{nullptr};
+    const auto v = std::strtoull(str, &end, 10);
+    if (*end != '\0' || v == 0){
+        return false;
+    }
+    res = static_cast<std::size_t>(v);
+    return true;
+}
+
+//return false if str is not list of cpu ids or ranges, or some id is greater than max_cpu_id
+inline bool parse_cpu_list(const char* str, std::vector<std::size_t>& res){
+    if (str == nullptr || *str == '\0'){
+        return false;
+    }
+    std::vector<std::size_t> cpus{};
+    auto parse_id = [](const char*& p, std::size_t& id){
+        if (*p<'0' || *p>'9'){
+            return false;
+        }
+        char* end{nullptr};
+        const auto v = std::strtoull(p, &end, 10);
+        p = end;
+        if (v > max_cpu_id){
+            return false;
+        }
+        id = static_cast<std::size_t>(v);
+        return true;
+    };
+    for (const char* p=str;;){
+        std::size_t first{0};
+        if (!parse_id(p,first)){
+            return false;
+        }
+        std::size_t last{first};
+        if (*p == '-'){
+            ++p;
+            if (!parse_id(p,last) || last<first){
+                return false;
+            }
+        }
+        for (auto id=first; id<=last; ++id){
+            cpus.push_back(id);
+        }
+        if (*p == '\0'){
+            break;
+        }
+        if (*p != ','){
+            return false;
+        }
+        ++p;
+    }
+    res = std::move(cpus);
+    return true;
+}
+
+//malformed or not set values are replaced with defaults
+inline pool_config make_pool_config(const char* workers_n, const char* queue_size, const char* affinity){
+    pool_config res{};
+    parse_pool_size(workers_n, res.workers_n);
+    parse_pool_size(queue_size, res.queue_size);
+    parse_cpu_list(affinity, res.affinity);
+    return res;
+}
+
+inline void check_pool_config(const pool_config& config){
+    if (config.workers_n == 0){
+        throw std::invalid_argument("pool workers number must be > 0");
+    }
+    if (config.queue_size == 0){
+        throw std::invalid_argument("pool queue size must be > 0");
+    }
+}
+
+class global_pool
+{
+public:
+    using pool_type = thread_pool_v4;
+    using mutex_type = std::mutex;
+
+    static global_pool& instance(){
+        static global_pool instance_{};
+        return instance_;
+    }
+
+    pool_type& get(){
+        if (auto p = pool_ptr.load(std::memory_order_acquire)){
+            return *p;
+        }
+        std::lock_guard<mutex_type> lock{guard};
+        if (!pool){
+            pool = std::make_unique<pool_type>(config.workers_n, config.queue_size, config.affinity);
+            pool_ptr.store(pool.get(), std::memory_order_release);
+        }
+        return *pool;
+    }
+    void reset(){
+        std::lock_guard<mutex_type> lock{guard};
+        pool_ptr.store(nullptr, std::memory_order_release);
+        pool.reset();
+    }
+    void set_config(const pool_config& config__){
+        check_pool_config(config__);
+        std::lock_guard<mutex_type> lock{guard};
+        config = config__;
+    }
+    pool_config get_config(){
+        std::lock_guard<mutex_type> lock{guard};
+        return config;
+    }
+
+private:
+    global_pool():
+        config{make_pool_config(std::getenv(pool_workers_env), std::getenv(pool_queue_size_env), std::getenv(pool_affinity_env))}
+    {}
+
+    pool_config config;
+    std::unique_ptr<pool_type> pool;
+    std::atomic<pool_type*> pool_ptr{nullptr};
+    mutex_type guard;
+};
+
+}   //end of namespace detail
+
+//global pool is created on first use with current config
+inline thread_pool_v4& get_pool(){
+    return detail::global_pool::instance().get();
+}
+//config is initialized from environment variables, or defaults if not set
+inline pool_config get_pool_config(){
+    return detail::global_pool::instance().get_config();
+}
+//config takes effect when pool is created: on first use or after reset_pool()
+inline void set_pool_config(const pool_config& config){
+    detail::global_pool::instance().set_config(config);
+}
+//destroy global pool, next get_pool() call creates new pool with current config
+//must not be called while there are tasks in flight or from pool's worker thread
+inline void reset_pool(){
+    detail::global_pool::instance().reset();
+}
+inline void reset_pool(const pool_config& config){
+    set_pool_config(config);
+    reset_pool();
 }
 
 template<typename...> struct exec_policy_traits;
+//par_tasks is zero for exec_pol<0>, its max parallel tasks number is number of global pool workers
 template<template<std::size_t> typename P, std::size_t V>
 struct exec_policy_traits<P<V>>{
-    using par_tasks = std::conditional_t<V==0, std::integral_constant<std::size_t,pool_workers_n>, std::integral_constant<std::size_t,V>>;
+    using par_tasks = std::integral_constant<std::size_t,V>;
     using is_seq = std::bool_constant<par_tasks::value==1>;
 };
 
+//N is max number of parallel tasks, 0 means number of global pool workers
 template<std::size_t N> struct exec_pol : std::integral_constant<std::size_t,N>{};
+//runtime execution policy
+//par_tasks_n is max number of parallel tasks, 0 means number of global pool workers
+//grain_size is min number of elementary tasks per parallel task
+struct exec_pol_rt{
+    std::size_t par_tasks_n{0};
+    std::size_t grain_size{1};
+};
+//sequential or parallel execution of runtime policy is decided by algorithm using tasks number and grain size
+template<>
+struct exec_policy_traits<exec_pol_rt>{
+    using is_seq = std::false_type;
+};
+
 template<typename> inline constexpr bool is_policy_v = false;
 template<std::size_t N> inline constexpr bool is_policy_v<exec_pol<N>> = true;
+template<> inline constexpr bool is_policy_v<exec_pol_rt> = true;
+
+//max parallel tasks number of policy
+template<typename Policy>
+std::size_t par_tasks_n(const Policy&){
+    if constexpr (exec_policy_traits<Policy>::par_tasks::value == 0){
+        return get_pool().size();
+    }else{
+        return exec_policy_traits<Policy>::par_tasks::value;
+    }
+}
+inline std::size_t par_tasks_n(const exec_pol_rt& policy){
+    return policy.par_tasks_n == 0 ? get_pool().size() : policy.par_tasks_n;
+}
+//min elementary tasks per parallel task of policy, not less than min_n
+template<typename Policy>
+std::size_t grain_size(const Policy&, std::size_t min_n){
+    return min_n;
+}
+inline std::size_t grain_size(const exec_pol_rt& policy, std::size_t min_n){
+    return std::max(min_n, policy.grain_size);
+}
+//split tasks_number elementary tasks into parallel tasks according to policy
+template<typename Policy, typename ParSize>
+auto make_par_task_size(const Policy& policy, const ParSize& tasks_number, std::size_t min_tasks_per_par_task = 1){
+    return par_task_size<ParSize>{tasks_number, par_tasks_n(policy), grain_size(policy,min_tasks_per_par_task)};
+}
+//futures of parallel tasks, std::array for compile time policy, std::vector of n elements for exec_pol<0> and runtime policy
+template<typename Future, typename Policy>
+auto make_futures(const Policy&, std::size_t n){
+    if constexpr (exec_policy_traits<Policy>::par_tasks::value == 0){
+        return std::vector<Future>(n);
+    }else{
+        static_cast<void>(n);
+        return std::array<Future, exec_policy_traits<Policy>::par_tasks::value>{};
+    }
+}
+template<typename Future>
+auto make_futures(const exec_pol_rt&, std::size_t n){
+    return std::vector<Future>(n);
+}
+
+namespace detail{
+
+//BinaryF may provide accumulate(first,last,initial) member that reduces range other than left fold, e.g. using pairwise summation
+template<typename F, typename It, typename Initial, typename=void> constexpr bool has_accumulate_v = false;
+template<typename F, typename It, typename Initial> constexpr bool has_accumulate_v<F,It,Initial,std::void_t<decltype(std::declval<F&>().accumulate(std::declval<It>(),std::declval<It>(),std::declval<const Initial&>()))>> = true;
+
+template<typename It, typename Initial, typename BinaryF>
+auto accumulate(It first, It last, const Initial& initial, BinaryF& f){
+    if constexpr (has_accumulate_v<BinaryF,It,Initial>){
+        return f.accumulate(first,last,initial);
+    }else{
+        return std::accumulate(first,last,initial,f);
+    }
+}
+
+}   //end of namespace detail
 
 template<typename Policy, typename It, typename Initial, typename BinaryF>
-auto reduce(Policy, It first, It last, Initial initial, BinaryF f){
+auto reduce(Policy policy, It first, It last, Initial initial, BinaryF f){
     if constexpr (std::is_convertible_v<typename std::iterator_traits<It>::iterator_category,std::random_access_iterator_tag> && !exec_policy_traits<Policy>::is_seq::value){ //parallelize
-        using difference_type = typename std::iterator_traits<It>::difference_type;
-        static constexpr std::size_t max_par_tasks_n = exec_policy_traits<Policy>::par_tasks::value;
         static constexpr std::size_t min_tasks_per_par_task = 2;
 
-        par_task_size<difference_type> par_sizes{last-first,max_par_tasks_n,min_tasks_per_par_task};
+        auto par_sizes = make_par_task_size(policy,last-first,min_tasks_per_par_task);
 
         if (par_sizes.size()<2){
-            return std::accumulate(first,last,initial,f);
+            return detail::accumulate(first,last,initial,f);
         }
 
         auto body = [](auto first_, auto last_, auto f_){ //last-fist>=2 guaranteed by min_tasks_per_par_task = 2
             const auto& e0 = *first_;
             ++first_;
             const auto& e1 = *first_;
-            return std::accumulate(++first_,last_,Initial(f_(e0,e1)),f_);
+            return detail::accumulate(++first_,last_,Initial(f_(e0,e1)),f_);
         };
 
         using future_type = decltype(get_pool().push(body,first,last,f));
-        std::array<future_type, max_par_tasks_n> futures{};
+        auto futures = make_futures<future_type>(policy,par_sizes.size());
         for (std::size_t i=0; i!=par_sizes.size(); ++i){
             const auto par_task_size = par_sizes[i];
             futures[i] = get_pool().push(body,first,first+par_task_size,f);
@@ -515,25 +1141,23 @@ auto reduce(Policy, It first, It last, Initial initial, BinaryF f){
         }
         return std::accumulate(futures.begin(),futures.begin()+par_sizes.size(),initial,[&f](const auto& init, auto& future){return f(init,future.get());});
     }else{
-        return std::accumulate(first,last,initial,f);
+        return detail::accumulate(first,last,initial,f);
     }
 }
 
 template<typename Policy, typename It1, typename It2, typename DstIt, typename BinaryF>
-auto transform(Policy, It1 first1, It1 last1, It2 first2, DstIt dfirst, BinaryF f){
+auto transform(Policy policy, It1 first1, It1 last1, It2 first2, DstIt dfirst, BinaryF f){
     if constexpr (
         std::is_convertible_v<typename std::iterator_traits<It1>::iterator_category,std::random_access_iterator_tag> &&
         std::is_convertible_v<typename std::iterator_traits<It2>::iterator_category,std::random_access_iterator_tag> &&
         std::is_convertible_v<typename std::iterator_traits<DstIt>::iterator_category,std::random_access_iterator_tag> &&
         !exec_policy_traits<Policy>::is_seq::value)
     { //parallelize
-        using difference_type1 = typename std::iterator_traits<It1>::difference_type;
         using difference_type2 = typename std::iterator_traits<It2>::difference_type;
         using difference_type3 = typename std::iterator_traits<DstIt>::difference_type;
-        static constexpr std::size_t max_par_tasks_n = exec_policy_traits<Policy>::par_tasks::value;
         static constexpr std::size_t min_tasks_per_par_task = 1;
 
-        par_task_size<difference_type1> par_sizes{last1-first1,max_par_tasks_n,min_tasks_per_par_task};
+        auto par_sizes = make_par_task_size(policy,last1-first1,min_tasks_per_par_task);
         if (par_sizes.size()<2){
             return std::transform(first1,last1,first2,dfirst,f);
         }
@@ -543,7 +1167,7 @@ auto transform(Policy, It1 first1, It1 last1, It2 first2, DstIt dfirst, BinaryF
             }
         };
         using future_type = decltype(get_pool().push(body,first1,last1,first2,dfirst,f));
-        std::array<future_type, max_par_tasks_n> futures{};
+        auto futures = make_futures<future_type>(policy,par_sizes.size());
         for (std::size_t i=0; i!=par_sizes.size(); ++i){
             const auto par_task_size = par_sizes[i];
             futures[i] = get_pool().push(body,first1,first1+par_task_size,first2,dfirst,f);
@@ -558,7 +1182,7 @@ auto transform(Policy, It1 first1, It1 last1, It2 first2, DstIt dfirst, BinaryF
 }
 
 template<typename Policy, typename DstIt, typename It, typename UnaryF>
-void transform(Policy, DstIt first1, DstIt last1, It first2, UnaryF f){
+void transform(Policy policy, DstIt first1, DstIt last1, It first2, UnaryF f){
 
     auto body = [](auto first1_, auto last1_, auto first2_, auto f_){
         std::transform(first1_,last1_,first2_,f_);
@@ -570,17 +1194,15 @@ void transform(Policy, DstIt first1, DstIt last1, It first2, UnaryF f){
         !exec_policy_traits<Policy>::is_seq::value
     )
     { //parallelize
-        using difference_type1 = typename std::iterator_traits<DstIt>::difference_type;
         using difference_type2 = typename std::iterator_traits<It>::difference_type;
-        static constexpr std::size_t max_par_tasks_n = exec_policy_traits<Policy>::par_tasks::value;
         static constexpr std::size_t min_tasks_per_par_task = 1;
-        par_task_size<difference_type1> par_sizes{last1-first1,max_par_tasks_n,min_tasks_per_par_task};
+        auto par_sizes = make_par_task_size(policy,last1-first1,min_tasks_per_par_task);
         if (par_sizes.size()<2){
             body(first1,last1,first2,f);
             return;
         }
         using future_type = decltype(get_pool().push(body,first1,last1,first2,f));
-        std::array<future_type, max_par_tasks_n> futures{};
+        auto futures = make_futures<future_type>(policy,par_sizes.size());
         for (std::size_t i=0; i!=par_sizes.size(); ++i){
             const auto par_task_size = par_sizes[i];
             futures[i] = get_pool().push(body,first1,first1+par_task_size,first2,f);
@@ -593,12 +1215,10 @@ void transform(Policy, DstIt first1, DstIt last1, It first2, UnaryF f){
 }
 
 template<typename Policy, typename It, typename DstIt>
-auto copy(Policy, It first, It last, DstIt dfirst){
+auto copy(Policy policy, It first, It last, DstIt dfirst){
     if constexpr (std::is_convertible_v<typename std::iterator_traits<It>::iterator_category,std::random_access_iterator_tag> && !exec_policy_traits<Policy>::is_seq::value){ //parallelize
-        using difference_type = typename std::iterator_traits<It>::difference_type;
-        static constexpr std::size_t max_par_tasks_n = exec_policy_traits<Policy>::par_tasks::value;
         static constexpr std::size_t min_tasks_per_par_task = 1;
-        par_task_size<difference_type> par_sizes{last-first,max_par_tasks_n,min_tasks_per_par_task};
+        auto par_sizes = make_par_task_size(policy,last-first,min_tasks_per_par_task);
 
         if (par_sizes.size()<2){
             return std::copy(first,last,dfirst);
@@ -609,7 +1229,7 @@ auto copy(Policy, It first, It last, DstIt dfirst){
         };
 
         using future_type = decltype(get_pool().push(body,first,last,dfirst));
-        std::array<future_type, max_par_tasks_n> futures{};
+        auto futures = make_futures<future_type>(policy,par_sizes.size());
         for (std::size_t i=0; i!=par_sizes.size(); ++i){
             const auto par_task_size = par_sizes[i];
             futures[i] = get_pool().push(body,first,first+par_task_size,dfirst);
@@ -623,7 +1243,7 @@ auto copy(Policy, It first, It last, DstIt dfirst){
 }
 
 template<typename Policy, typename It1, typename It2, typename Initial>
-auto  inner_product(Policy, It1 first1, It1 last1, It2 first2, Initial initial){
+auto  inner_product(Policy policy, It1 first1, It1 last1, It2 first2, Initial initial){
 
     auto body = [](auto first1_, auto last1_, auto first2_){
         Initial initial_(*first1_**first2_);
@@ -643,16 +1263,14 @@ auto  inner_product(Policy, It1 first1, It1 last1, It2 first2, Initial initial){
         std::is_convertible_v<typename std::iterator_traits<It2>::iterator_category,std::random_access_iterator_tag> &&
         !exec_policy_traits<Policy>::is_seq::value)
     { //parallelize
-        using difference_type1 = typename std::iterator_traits<It1>::difference_type;
         using difference_type2 = typename std::iterator_traits<It2>::difference_type;
-        static constexpr std::size_t max_par_tasks_n = exec_policy_traits<Policy>::par_tasks::value;
         static constexpr std::size_t min_tasks_per_par_task = 1;
-        par_task_size<difference_type1> par_sizes{n,max_par_tasks_n,min_tasks_per_par_task};
+        auto par_sizes = make_par_task_size(policy,n,min_tasks_per_par_task);
         if (par_sizes.size()<2){
             return Initial(initial+body(first1,last1,first2));
         }
         using future_type = decltype(get_pool().push(body,first1,last1,first2));
-        std::array<future_type, max_par_tasks_n> futures{};
+        auto futures = make_futures<future_type>(policy,par_sizes.size());
         for (std::size_t i=0; i!=par_sizes.size(); ++i){
             const auto par_task_size = par_sizes[i];
             futures[i] = get_pool().push(body,first1,first1+par_task_size,first2);
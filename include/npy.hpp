@@ -0,0 +1,658 @@
+/*
+* GTensor - computation library
+* Copyright (c) 2022 Ivan Malezhyk <ivanmzk@gmail.com>
+*
+* Distributed under the Boost Software License, Version 1.0.
+* The full license is in the file LICENSE.txt, distributed with this software.
+*/
+
+#ifndef NPY_HPP_
+#define NPY_HPP_
+
+#include <string>
+#include <vector>
+#include <array>
+#include <memory>
+#include <complex>
+#include <fstream>
+#include <streambuf>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+#include "exception.hpp"
+#include "math.hpp"
+#include "tensor.hpp"
+#include "mmap_storage.hpp"
+
+//NumPy .npy and uncompressed .npz files load and save
+//format description: https://numpy.org/doc/stable/reference/generated/numpy.lib.format.html
+
+namespace gtensor{
+
+namespace detail{
+
+inline bool npy_native_little_endian(){
+    const std::uint16_t x{1};
+    unsigned char c{};
+    std::memcpy(&c,&x,1);
+    return c == 1;
+}
+
+//npy type descriptor of T in native byte order
+template<typename T>
+std::string npy_descr(){
+    const std::string byte_order = sizeof(T)==1 ? "|" : npy_native_little_endian() ? "<" : ">";
+    if constexpr (std::is_same_v<T,bool>){
+        static_assert(sizeof(bool)==1);
+        return "|b1";
+    }else if constexpr (std::is_integral_v<T>){
+        return byte_order+(std::is_signed_v<T> ? "i" : "u")+std::to_string(sizeof(T));
+    }else if constexpr (std::is_floating_point_v<T>){
+        return byte_order+"f"+std::to_string(sizeof(T));
+    }else if constexpr (math::is_complex_v<T>){
+        static_assert(std::is_floating_point_v<typename T::value_type>);
+        return byte_order+"c"+std::to_string(sizeof(T));
+    }else{
+        static_assert(detail::always_false<T>,"type has no npy descriptor");
+    }
+}
+
+//descr may use "=" for native byte order, single byte types may use any byte order character
+template<typename T>
+bool npy_descr_match(const std::string& descr){
+    const auto expected = npy_descr<T>();
+    if (descr == expected){
+        return true;
+    }
+    if (descr.size() == expected.size() && descr.substr(1) == expected.substr(1)){
+        return descr[0] == '=' || sizeof(T)==1;
+    }
+    return false;
+}
+
+struct npy_header
+{
+    std::string descr;
+    bool fortran_order;
+    std::vector<std::size_t> shape;
+    //offset of data from beginning of npy
+    std::size_t data_offset;
+};
+
+inline std::string npy_dict_value(const std::string& dict, const std::string& key){
+    auto pos = dict.find("'"+key+"'");
+    if (pos == std::string::npos){
+        pos = dict.find("\""+key+"\"");
+    }
+    if (pos == std::string::npos){
+        throw value_error("npy header has no required key");
+    }
+    pos = dict.find(':',pos+key.size()+2);
+    if (pos == std::string::npos){
+        throw value_error("invalid npy header");
+    }
+    ++pos;
+    while (pos<dict.size() && dict[pos]==' '){++pos;}
+    if (pos == dict.size()){
+        throw value_error("invalid npy header");
+    }
+    std::size_t last{};
+    if (dict[pos]=='\'' || dict[pos]=='"'){  //string
+        last = dict.find(dict[pos],pos+1);
+        if (last == std::string::npos){
+            throw value_error("invalid npy header");
+        }
+        return dict.substr(pos+1,last-pos-1);
+    }else if (dict[pos]=='('){  //tuple
+        last = dict.find(')',pos);
+        if (last == std::string::npos){
+            throw value_error("invalid npy header");
+        }
+        return dict.substr(pos,last-pos+1);
+    }else{
+        last = dict.find_first_of(",}",pos);
+        if (last == std::string::npos){
+            throw value_error("invalid npy header");
+        }
+        return dict.substr(pos,last-pos);
+    }
+}
+
+//reads npy header, is must be positioned at beginning of npy
+inline npy_header read_npy_header(std::istream& is){
+    std::array<char,8> prefix{};
+    is.read(prefix.data(),prefix.size());
+    if (!is || std::memcmp(prefix.data(),"\x93NUMPY",6) != 0){
+        throw value_error("not npy format");
+    }
+    const unsigned char major = static_cast<unsigned char>(prefix[6]);
+    std::size_t len_size{};
+    if (major == 1){
+        len_size = 2;
+    }else if (major == 2 || major == 3){
+        len_size = 4;
+    }else{
+        throw value_error("unsupported npy format version");
+    }
+    std::array<unsigned char,4> len_bytes{};
+    is.read(reinterpret_cast<char*>(len_bytes.data()),len_size);
+    std::size_t header_len{0};
+    for (std::size_t i=len_size; i!=0; --i){
+        header_len = (header_len<<8)|len_bytes[i-1];
+    }
+    std::string dict(header_len,' ');
+    is.read(dict.data(),header_len);
+    if (!is){
+        throw value_error("invalid npy header");
+    }
+    npy_header res{};
+    res.descr = npy_dict_value(dict,"descr");
+    const auto fortran_order = npy_dict_value(dict,"fortran_order");
+    if (fortran_order.find("True") != std::string::npos){
+        res.fortran_order = true;
+    }else if (fortran_order.find("False") != std::string::npos){
+        res.fortran_order = false;
+    }else{
+        throw value_error("invalid npy header");
+    }
+    const auto shape = npy_dict_value(dict,"shape");
+    for (std::size_t pos=0; pos!=shape.size();){
+        if (shape[pos]>='0' && shape[pos]<='9'){
+            std::size_t last = pos;
+            while (last<shape.size() && shape[last]>='0' && shape[last]<='9'){++last;}
+            res.shape.push_back(static_cast<std::size_t>(std::stoull(shape.substr(pos,last-pos))));
+            pos = last;
+        }else{
+            ++pos;
+        }
+    }
+    res.data_offset = prefix.size()+len_size+header_len;
+    return res;
+}
+
+//makes npy header, version 1.0 is used if header fits, total header size is multiple of 64
+template<typename T, typename ShT>
+std::string make_npy_header(const ShT& shape, bool fortran_order){
+    std::string dict = "{'descr': '"+npy_descr<T>()+"', 'fortran_order': "+(fortran_order ? "True" : "False")+", 'shape': (";
+    for (auto it=shape.begin(); it!=shape.end(); ++it){
+        dict+=std::to_string(*it);
+        if (shape.size()==1 || it+1!=shape.end()){
+            dict+=",";
+        }
+        if (it+1!=shape.end()){
+            dict+=" ";
+        }
+    }
+    dict+="), }";
+    constexpr std::size_t alignment = 64;
+    std::size_t len_size = 2;
+    std::size_t total = 8+len_size+dict.size()+1;
+    if ((total+alignment-1)/alignment*alignment-8-len_size > 0xffff){
+        len_size = 4;
+        total = 8+len_size+dict.size()+1;
+    }
+    total = (total+alignment-1)/alignment*alignment;
+    dict.append(total-8-len_size-dict.size()-1,' ');
+    dict+="\n";
+    const char version = len_size == 2 ? 1 : 2;
+    std::string res{"\x93NUMPY",6};
+    res.push_back(version);
+    res.push_back(0);
+    const std::size_t header_len = dict.size();
+    for (std::size_t i=0; i!=len_size; ++i){
+        res.push_back(static_cast<char>((header_len>>(8*i))&0xff));
+    }
+    return res+dict;
+}
+
+//writes n elements starting from first using buffer
+template<typename T, typename It>
+void write_npy_range(std::ostream& os, It first, std::size_t n){
+    constexpr std::size_t buffer_size = 4096;
+    const auto buffer = std::make_unique<T[]>(std::min(n,buffer_size));
+    while (n!=0){
+        const std::size_t chunk = std::min(n,buffer_size);
+        for (std::size_t i=0; i!=chunk; ++i,++first){
+            buffer[i] = static_cast<T>(*first);
+        }
+        os.write(reinterpret_cast<const char*>(buffer.get()),chunk*sizeof(T));
+        n-=chunk;
+    }
+}
+
+template<typename...Ts>
+std::string make_npy_header(const basic_tensor<Ts...>& t){
+    using tensor_type = basic_tensor<Ts...>;
+    return make_npy_header<typename tensor_type::value_type>(t.shape(),std::is_same_v<typename tensor_type::order,config::f_order>);
+}
+
+//writes elements of tensor in layout of tensor
+template<typename...Ts>
+void write_npy_data(std::ostream& os, const basic_tensor<Ts...>& t){
+    using tensor_type = basic_tensor<Ts...>;
+    using value_type = typename tensor_type::value_type;
+    using order = typename tensor_type::order;
+    const auto n = static_cast<std::size_t>(t.size());
+    if constexpr (is_simd_storage_tensor<tensor_type>::value){  //contiguous storage, single write
+        os.write(reinterpret_cast<const char*>(t.data()),n*sizeof(value_type));
+    }else{
+        auto a = t.traverse_order_adapter(order{});
+        if (t.is_trivial()){
+            write_npy_range<value_type>(os,a.begin_trivial(),n);
+        }else{
+            write_npy_range<value_type>(os,a.begin(),n);
+        }
+    }
+}
+
+//writes tensor as npy, elements are written in layout of tensor
+template<typename...Ts>
+void write_npy(std::ostream& os, const basic_tensor<Ts...>& t){
+    const auto header = make_npy_header(t);
+    os.write(header.data(),header.size());
+    write_npy_data(os,t);
+}
+
+template<typename ShT>
+auto npy_shape(const npy_header& header){
+    using index_type = typename ShT::value_type;
+    ShT res{};
+    for (const auto& i : header.shape){
+        res.push_back(static_cast<index_type>(i));
+    }
+    return res;
+}
+
+//reads npy elements into tensor of Order, is must be positioned at beginning of npy
+template<typename T, typename Order, typename Config>
+auto read_npy(std::istream& is){
+    using res_type = tensor<T,Order,config::extend_config_t<Config,T>>;
+    using shape_type = typename res_type::shape_type;
+    const auto header = read_npy_header(is);
+    if (!npy_descr_match<T>(header.descr)){
+        throw value_error("npy descr doesn't match tensor value_type");
+    }
+    auto read = [&is](auto t){
+        const auto n = static_cast<std::size_t>(t.size())*sizeof(T);
+        is.read(reinterpret_cast<char*>(t.data()),n);
+        if (static_cast<std::size_t>(is.gcount()) != n){
+            throw value_error("npy data is truncated");
+        }
+        return t;
+    };
+    if (header.fortran_order == std::is_same_v<Order,config::f_order>){
+        return read(res_type(npy_shape<shape_type>(header)));
+    }else{  //read in file layout and convert
+        using file_order = std::conditional_t<std::is_same_v<Order,config::f_order>,config::c_order,config::f_order>;
+        using file_tensor_type = tensor<T,file_order,config::extend_config_t<Config,T>>;
+        const auto t = read(file_tensor_type(npy_shape<shape_type>(header)));
+        return res_type(t.copy(Order{}));
+    }
+}
+
+//zip archive helpers to handle npz, only stored (not compressed) entries are supported
+inline std::uint32_t crc32(const char* first, std::size_t n, std::uint32_t crc = 0){
+    static const auto table = [](){
+        std::array<std::uint32_t,256> res{};
+        for (std::uint32_t i=0; i!=256; ++i){
+            std::uint32_t c = i;
+            for (int k=0; k!=8; ++k){
+                c = (c&1) ? 0xedb88320u^(c>>1) : c>>1;
+            }
+            res[i] = c;
+        }
+        return res;
+    }();
+    crc = ~crc;
+    for (std::size_t i=0; i!=n; ++i){
+        crc = table[(crc^static_cast<unsigned char>(first[i]))&0xff]^(crc>>8);
+    }
+    return ~crc;
+}
+
+inline void zip_put(std::ostream& os, std::uint64_t v, std::size_t size){
+    for (std::size_t i=0; i!=size; ++i){
+        os.put(static_cast<char>((v>>(8*i))&0xff));
+    }
+}
+
+inline std::uint64_t zip_get(const char* p, std::size_t size){
+    std::uint64_t res{0};
+    for (std::size_t i=size; i!=0; --i){
+        res = (res<<8)|static_cast<unsigned char>(p[i-1]);
+    }
+    return res;
+}
+
+//output buffer that passes characters to underlying buffer and computes their crc32 and number
+class crc32_streambuf : public std::streambuf
+{
+public:
+    explicit crc32_streambuf(std::streambuf* buf):
+        buf_{buf}
+    {}
+    std::uint32_t crc()const{return crc_;}
+    std::uint64_t size()const{return size_;}
+protected:
+    int_type overflow(int_type c)override{
+        if (traits_type::eq_int_type(c,traits_type::eof())){
+            return traits_type::not_eof(c);
+        }
+        const char ch = traits_type::to_char_type(c);
+        return xsputn(&ch,1) == 1 ? c : traits_type::eof();
+    }
+    std::streamsize xsputn(const char* s, std::streamsize n)override{
+        const auto res = buf_->sputn(s,n);
+        if (res > 0){
+            crc_ = crc32(s,static_cast<std::size_t>(res),crc_);
+            size_+=static_cast<std::uint64_t>(res);
+        }
+        return res;
+    }
+private:
+    std::streambuf* buf_;
+    std::uint32_t crc_{0};
+    std::uint64_t size_{0};
+};
+
+//sizes and offsets not less than zip64_limit are written to zip64 extended information extra field
+inline constexpr std::uint64_t zip64_limit = 0xffffffffu;
+inline constexpr std::uint64_t zip64_entries_limit = 0xffffu;
+
+struct zip_entry
+{
+    std::string name;
+    std::uint32_t crc;
+    std::uint64_t size;
+    std::uint64_t offset;
+};
+
+//writes local header of stored entry of size bytes, crc is written by write_zip_crc after entry data
+inline zip_entry write_zip_local_header(std::ostream& os, const std::string& name, std::uint64_t size){
+    const zip_entry entry{name,0,size,static_cast<std::uint64_t>(os.tellp())};
+    const bool zip64 = size >= zip64_limit;
+    zip_put(os,0x04034b50,4);   //local file header signature
+    zip_put(os,zip64 ? 45 : 20,2);  //version needed
+    zip_put(os,0,2);    //flags
+    zip_put(os,0,2);    //stored
+    zip_put(os,0,2);    //time
+    zip_put(os,0x21,2); //date 1980-01-01
+    zip_put(os,0,4);    //crc
+    zip_put(os,zip64 ? zip64_limit : size,4);
+    zip_put(os,zip64 ? zip64_limit : size,4);
+    zip_put(os,name.size(),2);
+    zip_put(os,zip64 ? 20 : 0,2);   //extra length
+    os.write(name.data(),name.size());
+    if (zip64){
+        zip_put(os,0x0001,2);   //zip64 extended information
+        zip_put(os,16,2);
+        zip_put(os,size,8);
+        zip_put(os,size,8);
+    }
+    return entry;
+}
+
+inline void write_zip_crc(std::ostream& os, const zip_entry& entry){
+    const auto pos = os.tellp();
+    os.seekp(static_cast<std::streamoff>(entry.offset+14));
+    zip_put(os,entry.crc,4);
+    os.seekp(pos);
+}
+
+inline void write_zip_directory(std::ostream& os, const std::vector<zip_entry>& entries){
+    const auto directory_offset = static_cast<std::uint64_t>(os.tellp());
+    for (const auto& entry : entries){
+        const bool size64 = entry.size >= zip64_limit;
+        const bool offset64 = entry.offset >= zip64_limit;
+        const std::uint64_t zip64_size = (size64 ? 16 : 0)+(offset64 ? 8 : 0);
+        const std::uint64_t version = zip64_size == 0 ? 20 : 45;
+        zip_put(os,0x02014b50,4);   //central directory header signature
+        zip_put(os,version,2);  //version made by
+        zip_put(os,version,2);  //version needed
+        zip_put(os,0,2);    //flags
+        zip_put(os,0,2);    //stored
+        zip_put(os,0,2);    //time
+        zip_put(os,0x21,2); //date
+        zip_put(os,entry.crc,4);
+        zip_put(os,size64 ? zip64_limit : entry.size,4);
+        zip_put(os,size64 ? zip64_limit : entry.size,4);
+        zip_put(os,entry.name.size(),2);
+        zip_put(os,zip64_size == 0 ? 0 : 4+zip64_size,2);   //extra length
+        zip_put(os,0,2);    //comment length
+        zip_put(os,0,2);    //disk number
+        zip_put(os,0,2);    //internal attributes
+        zip_put(os,0,4);    //external attributes
+        zip_put(os,offset64 ? zip64_limit : entry.offset,4);
+        os.write(entry.name.data(),entry.name.size());
+        if (zip64_size != 0){
+            zip_put(os,0x0001,2);   //zip64 extended information
+            zip_put(os,zip64_size,2);
+            if (size64){
+                zip_put(os,entry.size,8);
+                zip_put(os,entry.size,8);
+            }
+            if (offset64){
+                zip_put(os,entry.offset,8);
+            }
+        }
+    }
+    const auto directory_end = static_cast<std::uint64_t>(os.tellp());
+    const auto directory_size = directory_end-directory_offset;
+    const std::uint64_t entries_number = entries.size();
+    const bool zip64 = entries_number >= zip64_entries_limit || directory_size >= zip64_limit || directory_offset >= zip64_limit;
+    if (zip64){
+        zip_put(os,0x06064b50,4);   //zip64 end of central directory signature
+        zip_put(os,44,8);   //size of remaining record
+        zip_put(os,45,2);   //version made by
+        zip_put(os,45,2);   //version needed
+        zip_put(os,0,4);
+        zip_put(os,0,4);
+        zip_put(os,entries_number,8);
+        zip_put(os,entries_number,8);
+        zip_put(os,directory_size,8);
+        zip_put(os,directory_offset,8);
+        zip_put(os,0x07064b50,4);   //zip64 end of central directory locator signature
+        zip_put(os,0,4);
+        zip_put(os,directory_end,8);
+        zip_put(os,1,4);    //total number of disks
+    }
+    zip_put(os,0x06054b50,4);   //end of central directory signature
+    zip_put(os,0,2);
+    zip_put(os,0,2);
+    zip_put(os,zip64 ? zip64_entries_limit : entries_number,2);
+    zip_put(os,zip64 ? zip64_entries_limit : entries_number,2);
+    zip_put(os,zip64 ? zip64_limit : directory_size,4);
+    zip_put(os,zip64 ? zip64_limit : directory_offset,4);
+    zip_put(os,0,2);
+}
+
+//finds stored entry with name and returns offset of its data, zip64 records are supported
+inline std::uint64_t find_zip_entry(std::istream& is, const std::string& name){
+    is.seekg(0,std::ios::end);
+    const auto file_size = static_cast<std::uint64_t>(is.tellg());
+    const std::uint64_t tail_size = std::min<std::uint64_t>(file_size,0xffff+22);
+    std::string tail(tail_size,'\0');
+    is.seekg(file_size-tail_size);
+    is.read(tail.data(),tail_size);
+    std::size_t eocd = tail.rfind(std::string{"PK\x05\x06",4});
+    if (eocd == std::string::npos || tail_size-eocd < 22){
+        throw value_error("not npz format");
+    }
+    std::uint64_t entries_number = zip_get(tail.data()+eocd+10,2);
+    std::uint64_t directory_offset = zip_get(tail.data()+eocd+16,4);
+    const std::size_t eocd64_locator = eocd>=20 ? eocd-20 : std::string::npos;
+    if (eocd64_locator != std::string::npos && zip_get(tail.data()+eocd64_locator,4) == 0x07064b50){
+        std::array<char,56> eocd64{};
+        is.seekg(zip_get(tail.data()+eocd64_locator+8,8));
+        is.read(eocd64.data(),eocd64.size());
+        if (!is || zip_get(eocd64.data(),4) != 0x06064b50){
+            throw value_error("invalid npz zip64 directory");
+        }
+        entries_number = zip_get(eocd64.data()+32,8);
+        directory_offset = zip_get(eocd64.data()+48,8);
+    }
+    is.seekg(directory_offset);
+    for (std::uint64_t i=0; i!=entries_number; ++i){
+        std::array<char,46> record{};
+        is.read(record.data(),record.size());
+        if (!is || zip_get(record.data(),4) != 0x02014b50){
+            throw value_error("invalid npz directory");
+        }
+        const auto method = zip_get(record.data()+10,2);
+        const auto name_size = zip_get(record.data()+28,2);
+        const auto extra_size = zip_get(record.data()+30,2);
+        const auto comment_size = zip_get(record.data()+32,2);
+        std::uint64_t size = zip_get(record.data()+24,4);
+        std::uint64_t compressed_size = zip_get(record.data()+20,4);
+        std::uint64_t offset = zip_get(record.data()+42,4);
+        std::string entry_name(name_size,'\0');
+        is.read(entry_name.data(),name_size);
+        std::string extra(extra_size,'\0');
+        is.read(extra.data(),extra_size);
+        is.seekg(comment_size,std::ios::cur);
+        if (entry_name != name){
+            continue;
+        }
+        //zip64 extended information, present values are ones that are 0xffffffff in record
+        for (std::size_t pos=0; pos+4<=extra.size();){
+            const auto id = zip_get(extra.data()+pos,2);
+            const auto field_size = zip_get(extra.data()+pos+2,2);
+            if (id == 0x0001){
+                std::size_t field_pos = pos+4;
+                for (auto* v : {&size,&compressed_size,&offset}){
+                    if (*v == 0xffffffffu && field_pos+8<=extra.size()){
+                        *v = zip_get(extra.data()+field_pos,8);
+                        field_pos+=8;
+                    }
+                }
+            }
+            pos+=4+field_size;
+        }
+        if (method != 0 || size != compressed_size){
+            throw value_error("compressed npz is not supported");
+        }
+        std::array<char,30> local{};
+        is.seekg(offset);
+        is.read(local.data(),local.size());
+        if (!is || zip_get(local.data(),4) != 0x04034b50){
+            throw value_error("invalid npz entry");
+        }
+        return offset+local.size()+zip_get(local.data()+26,2)+zip_get(local.data()+28,2);
+    }
+    throw value_error("npz has no array with given name");
+}
+
+//writes tensor as npy stored entry, npy is written directly to os computing its crc on the fly
+template<typename...Ts>
+zip_entry write_npz_entry(std::ostream& os, const std::string& name, const basic_tensor<Ts...>& t){
+    using value_type = typename basic_tensor<Ts...>::value_type;
+    const auto header = make_npy_header(t);
+    const std::uint64_t size = header.size()+static_cast<std::uint64_t>(t.size())*sizeof(value_type);
+    auto entry = write_zip_local_header(os,name,size);
+    crc32_streambuf buf{os.rdbuf()};
+    std::ostream data{&buf};
+    data.write(header.data(),header.size());
+    write_npy_data(data,t);
+    if (!data || buf.size() != size){
+        throw io_error("can't write file");
+    }
+    entry.crc = buf.crc();
+    write_zip_crc(os,entry);
+    return entry;
+}
+
+inline void save_npz_helper(std::ostream&, std::vector<zip_entry>&){}
+template<typename...Ts, typename...Args>
+void save_npz_helper(std::ostream& os, std::vector<zip_entry>& entries, const std::string& name, const basic_tensor<Ts...>& t, const Args&...args){
+    entries.push_back(write_npz_entry(os,name+".npy",t));
+    save_npz_helper(os,entries,args...);
+}
+
+inline std::ifstream open_npy_input(const std::string& file_name){
+    std::ifstream is(file_name,std::ios::binary);
+    if (!is){
+        throw io_error("can't open file");
+    }
+    return is;
+}
+
+inline std::ofstream open_npy_output(const std::string& file_name){
+    std::ofstream os(file_name,std::ios::binary|std::ios::trunc);
+    if (!os){
+        throw io_error("can't open file");
+    }
+    return os;
+}
+
+}   //end of namespace detail
+
+//save tensor to .npy file, elements are written in layout of tensor
+template<typename...Ts>
+void save_npy(const std::string& file_name, const basic_tensor<Ts...>& t){
+    auto os = detail::open_npy_output(file_name);
+    detail::write_npy(os,t);
+    if (!os.flush()){
+        throw io_error("can't write file");
+    }
+}
+
+//load tensor from .npy file
+//T must match npy descr, if npy fortran_order doesn't match Order elements are converted to Order layout
+template<typename T, typename Order = config::c_order, typename Config = config::default_config>
+auto load_npy(const std::string& file_name){
+    auto is = detail::open_npy_input(file_name);
+    return detail::read_npy<T,Order,Config>(is);
+}
+
+#if GTENSOR_HAS_MMAP
+//map data of .npy file without copying, result's storage is mmap_storage
+//T must match npy descr, Order must match npy fortran_order
+template<typename T, typename Order = config::c_order, typename Config = config::default_config>
+auto load_npy(const std::string& file_name, mmap_mode mode){
+    using config_type = config::extend_config_t<config::mmap_config<Config>,T>;
+    using res_type = tensor<T,Order,config_type>;
+    using storage_type = typename res_type::storage_type;
+    using shape_type = typename res_type::shape_type;
+    detail::npy_header header{};
+    {
+        auto is = detail::open_npy_input(file_name);
+        header = detail::read_npy_header(is);
+    }
+    if (!detail::npy_descr_match<T>(header.descr)){
+        throw value_error("npy descr doesn't match tensor value_type");
+    }
+    if (header.fortran_order != std::is_same_v<Order,config::f_order>){
+        throw value_error("npy fortran_order doesn't match tensor layout");
+    }
+    auto shape = detail::npy_shape<shape_type>(header);
+    const auto size = static_cast<std::size_t>(detail::make_size<typename res_type::index_type>(shape));
+    return res_type(std::move(shape),storage_type(file_name,mode,size,header.data_offset));
+}
+#endif
+
+//save tensors to uncompressed .npz file, arguments are name,tensor pairs, ".npy" is appended to names
+template<typename...Args>
+void save_npz(const std::string& file_name, const Args&...args){
+    static_assert(sizeof...(Args)%2==0,"arguments must be name,tensor pairs");
+    auto os = detail::open_npy_output(file_name);
+    std::vector<detail::zip_entry> entries{};
+    detail::save_npz_helper(os,entries,args...);
+    detail::write_zip_directory(os,entries);
+    if (!os.flush()){
+        throw io_error("can't write file");
+    }
+}
+
+//load tensor with name from uncompressed .npz file, name may be given with or without ".npy"
+template<typename T, typename Order = config::c_order, typename Config = config::default_config>
+auto load_npz(const std::string& file_name, const std::string& name){
+    auto is = detail::open_npy_input(file_name);
+    const std::string suffix{".npy"};
+    const bool has_suffix = name.size()>=suffix.size() && name.compare(name.size()-suffix.size(),suffix.size(),suffix) == 0;
+    is.seekg(detail::find_zip_entry(is,has_suffix ? name : name+suffix));
+    return detail::read_npy<T,Order,Config>(is);
+}
+
+}   //end of namespace gtensor
+#endif
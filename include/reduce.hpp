@@ -292,12 +292,163 @@ ALWAYS_INLINE void transform(DstIt first1, DstIt last1, It&& first2, F f){
 
 template<typename It, typename IdxT, typename Initial, typename F>
 ALWAYS_INLINE auto accumulate_n(It& first, IdxT n, Initial initial, F f){
-    for (;n!=0; --n,++first){
-        initial = f(initial,*first);
+    if constexpr (multithreading::detail::has_accumulate_v<F,It,Initial>){
+        initial = f.accumulate(first,first+n,initial);
+        first+=n;
+    }else{
+        for (;n!=0; --n,++first){
+            initial = f(initial,*first);
+        }
     }
     return initial;
 }
 
+//result type of binary reduce functor F that reduces elements of type T starting from Initial, or from first element if Initial is no_value
+template<typename F, typename Initial, typename T> using binary_reduce_result_t = copy_type_t<
+    std::decay_t<decltype(std::declval<F&>()(std::declval<const std::conditional_t<std::is_same_v<Initial,no_value>,T,Initial>&>(),std::declval<const T&>()))>
+>;
+
+template<typename R, typename Initial>
+R reduce_multi_empty(const Initial& initial){
+    if constexpr (std::is_same_v<Initial,no_value>){
+        throw value_error("cant reduce zero size dimension without initial value");
+    }else{
+        return R(initial);
+    }
+}
+
+template<std::size_t> using indexed_no_value = no_value;
+
+//fold functors that have no accumulate member together in single traversal
+template<typename It, typename ResT, typename...Fs, std::size_t...I>
+void reduce_multi_fold(It first, It last, ResT& res, std::tuple<Fs...>& fs, std::index_sequence<I...>){
+    using multithreading::detail::has_accumulate_v;
+    if constexpr ((!has_accumulate_v<Fs,It,std::tuple_element_t<I,ResT>> || ...)){
+        auto fold = [](auto& f, auto& r, auto&& e){
+            if constexpr (!has_accumulate_v<std::decay_t<decltype(f)>,It,std::decay_t<decltype(r)>>){
+                r = f(r,e);
+            }
+        };
+        for (;first!=last; ++first){
+            auto&& e = *first;
+            (fold(std::get<I>(fs),std::get<I>(res),e),...);
+        }
+    }
+}
+
+//reduce range using accumulate member of functors that have it, the same way as reduce_binary does
+//functor with initial accumulates [first,last), functor without initial accumulates [next,last)
+template<typename It, typename ResT, typename...Fs, typename...Initials, std::size_t...I>
+void reduce_multi_accumulate(It first, It next, It last, ResT& res, std::tuple<Fs...>& fs, const std::tuple<Initials...>& initials, std::index_sequence<I...>){
+    using multithreading::detail::has_accumulate_v;
+    auto accumulate = [&first,&next,&last](auto& f, auto& r, const auto& initial){
+        if constexpr (has_accumulate_v<std::decay_t<decltype(f)>,It,std::decay_t<decltype(r)>>){
+            if constexpr (std::is_same_v<std::decay_t<decltype(initial)>,no_value>){
+                r = f.accumulate(next,last,r);
+            }else{
+                r = f.accumulate(first,last,r);
+            }
+        }else{
+            detail::unused_args{initial};
+        }
+    };
+    (accumulate(std::get<I>(fs),std::get<I>(res),std::get<I>(initials)),...);
+}
+
+//reduce range using several binary functors, result is tuple of reduction results
+//functors without accumulate member are folded together in single traversal, functors with accumulate member reduce range using it
+//functor with initial starts from its initial, functor without initial starts from first element
+template<typename It, typename...Fs, typename...Initials, std::size_t...I>
+auto reduce_multi_range(It first, It last, std::tuple<Fs...>& fs, const std::tuple<Initials...>& initials, std::index_sequence<I...>){
+    using value_type = typename std::iterator_traits<It>::value_type;
+    using res_type = std::tuple<binary_reduce_result_t<Fs,Initials,value_type>...>;
+    if (first == last){
+        return res_type{reduce_multi_empty<std::tuple_element_t<I,res_type>>(std::get<I>(initials))...};
+    }
+    auto make_initial = [&first](auto& f, const auto& initial){
+        using initial_type = std::decay_t<decltype(initial)>;
+        using f_type = std::decay_t<decltype(f)>;
+        using result_type = binary_reduce_result_t<f_type,initial_type,value_type>;
+        if constexpr (std::is_same_v<initial_type,no_value>){
+            detail::unused_args{f};
+            return result_type(make_copy(*first));
+        }else if constexpr (multithreading::detail::has_accumulate_v<f_type,It,result_type>){
+            return result_type(initial);
+        }else{
+            return result_type(f(initial,*first));
+        }
+    };
+    res_type res{make_initial(std::get<I>(fs),std::get<I>(initials))...};
+    auto next = first;
+    ++next;
+    reduce_multi_accumulate(first,next,last,res,fs,initials,std::index_sequence<I...>{});
+    reduce_multi_fold(next,last,res,fs,std::index_sequence<I...>{});
+    return res;
+}
+
+//reduce part of range in parallel task, part must contain at least two elements
+template<typename ResT, typename It, typename...Fs, std::size_t...I>
+ResT reduce_multi_range_part(It first, It last, std::tuple<Fs...>& fs, std::index_sequence<I...>){
+    const auto& e0 = *first;
+    ++first;
+    const auto& e1 = *first;
+    ResT res{std::tuple_element_t<I,ResT>(std::get<I>(fs)(e0,e1))...};
+    ++first;
+    reduce_multi_accumulate(first,first,last,res,fs,std::tuple<indexed_no_value<I>...>{},std::index_sequence<I...>{});
+    reduce_multi_fold(first,last,res,fs,std::index_sequence<I...>{});
+    return res;
+}
+
+template<typename ResT, typename...Fs, typename...Initials, std::size_t...I>
+ResT reduce_multi_merge_initial(const ResT& r, std::tuple<Fs...>& fs, const std::tuple<Initials...>& initials, std::index_sequence<I...>){
+    auto merge_initial = [](auto& f, const auto& initial, const auto& r_){
+        if constexpr (std::is_same_v<std::decay_t<decltype(initial)>,no_value>){
+            detail::unused_args{f};
+            return r_;
+        }else{
+            return std::decay_t<decltype(r_)>(f(initial,r_));
+        }
+    };
+    return ResT{merge_initial(std::get<I>(fs),std::get<I>(initials),std::get<I>(r))...};
+}
+
+template<typename ResT, typename...Fs, std::size_t...I>
+void reduce_multi_merge(ResT& r1, const ResT& r2, std::tuple<Fs...>& fs, std::index_sequence<I...>){
+    ((std::get<I>(r1) = std::get<I>(fs)(std::get<I>(r1),std::get<I>(r2))),...);
+}
+
+//reduce range using several binary functors in single traversal, range is split between parallel tasks according to policy
+template<typename Policy, typename It, typename...Fs, typename...Initials>
+auto reduce_multi_flatten(Policy policy, It first, It last, std::tuple<Fs...> fs, const std::tuple<Initials...>& initials){
+    using seq_type = std::index_sequence_for<Fs...>;
+    if constexpr (std::is_convertible_v<typename std::iterator_traits<It>::iterator_category,std::random_access_iterator_tag> && !multithreading::exec_policy_traits<Policy>::is_seq::value){ //parallelize
+        using res_type = decltype(reduce_multi_range(first,last,fs,initials,seq_type{}));
+        static constexpr std::size_t min_tasks_per_par_task = 2;
+        auto par_sizes = multithreading::make_par_task_size(policy,last-first,min_tasks_per_par_task);
+        if (par_sizes.size()<2){
+            return reduce_multi_range(first,last,fs,initials,seq_type{});
+        }
+        auto body = [](auto first_, auto last_, auto fs_){ //last-fist>=2 guaranteed by min_tasks_per_par_task = 2
+            return reduce_multi_range_part<res_type>(first_,last_,fs_,seq_type{});
+        };
+        using future_type = decltype(multithreading::get_pool().push(body,first,last,fs));
+        auto futures = multithreading::make_futures<future_type>(policy,par_sizes.size());
+        for (std::size_t i=0; i!=par_sizes.size(); ++i){
+            const auto par_task_size = par_sizes[i];
+            futures[i] = multithreading::get_pool().push(body,first,first+par_task_size,fs);
+            first+=par_task_size;
+        }
+        auto res = reduce_multi_merge_initial(futures[0].get(),fs,initials,seq_type{});
+        for (std::size_t i=1; i!=par_sizes.size(); ++i){
+            reduce_multi_merge(res,futures[i].get(),fs,seq_type{});
+        }
+        return res;
+    }else{
+        detail::unused_args{policy};
+        return reduce_multi_range(first,last,fs,initials,seq_type{});
+    }
+}
+
 }   //end of namespace detail
 
 class reducer
@@ -531,7 +682,7 @@ class reducer
 
     //expected axes_ not no_value
     template<typename Policy, typename RangeF, typename Axes, typename...Ts, typename...Args>
-    static auto reduce_range_helper(Policy, const basic_tensor<Ts...>& parent, const Axes& axes_, RangeF reduce_f, bool keep_dims, bool any_order, const Args&...args){
+    static auto reduce_range_helper(Policy policy, const basic_tensor<Ts...>& parent, const Axes& axes_, RangeF reduce_f, bool keep_dims, bool any_order, const Args&...args){
         using parent_type = basic_tensor<Ts...>;
         using order = typename parent_type::order;
         using config_type = typename parent_type::config_type;
@@ -563,7 +714,7 @@ class reducer
                 return res;
             }
             auto axes_iterator_maker = detail::make_axes_iterator_maker<config_type>(pshape,axes,traverse_order{});
-            auto reduce_helper = [&reduce_f,&res_size,&axes_iterator_maker](auto walker, auto res_it, const auto&...args_){
+            auto reduce_helper = [&policy,&reduce_f,&res_size,&axes_iterator_maker](auto walker, auto res_it, const auto&...args_){
                 auto body = [&axes_iterator_maker](auto f, auto res_first, auto res_last, auto traverser, const auto&...args__){
                     for (;res_first!=res_last; ++res_first,traverser.next()){
                         *res_first = f(
@@ -575,11 +726,14 @@ class reducer
                 };
                 auto traverser = axes_iterator_maker.create_random_access_traverser(walker,std::true_type{});
                 if constexpr (multithreading::exec_policy_traits<Policy>::is_seq::value){
+                    detail::unused_args{policy};
                     body(reduce_f,res_it,res_it+res_size,traverser,args_...);
                 }else{  //parallelize
-                    constexpr std::size_t max_par_tasks = multithreading::exec_policy_traits<Policy>::par_tasks::value;
-                    constexpr std::size_t min_tasks_per_par_task = 1;
-                    multithreading::par_task_size<index_type> par_sizes{res_size,max_par_tasks,min_tasks_per_par_task};
+                    const auto par_sizes = multithreading::make_par_task_size(policy,res_size);
+                    if (par_sizes.size()<2){
+                        body(reduce_f,res_it,res_it+res_size,traverser,args_...);
+                        return;
+                    }
                     multithreading::task_group group{};
                     index_type pos{0};
                     for (std::size_t i{0}; i!=par_sizes.size(); ++i){
@@ -617,6 +771,64 @@ class reducer
         }
     }
 
+    //reduce along axes using several binary functors in single traversal
+    //result is tuple of tensors
+    template<typename Policy, typename...Ts, typename Axes, typename...Fs, typename...Initials>
+    static auto reduce_multi_(Policy policy, const basic_tensor<Ts...>& parent, const Axes& axes, const std::tuple<Fs...>& fs, bool keep_dims, const std::tuple<Initials...>& initials){
+        using parent_type = basic_tensor<Ts...>;
+        using order = typename parent_type::order;
+        using config_type = typename parent_type::config_type;
+        using index_type = typename config_type::index_type;
+        using seq_type = std::index_sequence_for<Fs...>;
+        static_assert(sizeof...(Fs) == sizeof...(Initials),"number of initials must be equal to number of functors");
+
+        auto reduce_flatten = [&policy,&parent,&fs,&initials](){
+            auto a = parent.traverse_order_adapter(order{});
+            if (parent.is_trivial()){
+                return detail::reduce_multi_flatten(policy,a.begin_trivial(),a.end_trivial(),fs,initials);
+            }else{
+                return detail::reduce_multi_flatten(policy,a.begin(),a.end(),fs,initials);
+            }
+        };
+        using tuple_type = decltype(reduce_flatten());
+        using tmp_type = tensor<tuple_type,order,config::extend_config_t<config_type,tuple_type>>;
+
+        auto reduce_ = [&](){
+            if constexpr (std::is_same_v<Axes,detail::no_value>){
+                return tmp_type(detail::make_reduce_shape(parent.shape(),keep_dims),reduce_flatten());
+            }else{
+                auto axes_ = detail::make_axes<config_type>(parent.dim(),axes);
+                detail::check_reduce_args(parent.shape(),axes_);
+                auto res_shape = detail::make_reduce_shape(parent.shape(),axes_,keep_dims);
+                //like tensor-scalar result, parallelize over elements
+                if (!parent.empty() && detail::make_size<index_type>(res_shape) == index_type{1}){
+                    return tmp_type(std::move(res_shape),reduce_flatten());
+                }
+                auto reduce_range_f = [&fs,&initials](auto first, auto last){
+                    auto fs_ = fs;
+                    return detail::reduce_multi_range(first,last,fs_,initials,seq_type{});
+                };
+                return reduce_range_(policy,parent,axes,reduce_range_f,keep_dims,true);
+            }
+        };
+        return reduce_multi_split(policy,reduce_(),parent,seq_type{});
+    }
+
+    //make tuple of tensors from tensor of tuples
+    template<typename Policy, typename...Ts, typename...Us, std::size_t...I>
+    static auto reduce_multi_split(Policy policy, const basic_tensor<Ts...>& tmp, const basic_tensor<Us...>&, std::index_sequence<I...>){
+        using order = typename basic_tensor<Us...>::order;
+        using config_type = typename basic_tensor<Us...>::config_type;
+        using tuple_type = typename basic_tensor<Ts...>::value_type;
+        auto split = [&policy,&tmp](auto i){
+            using res_type = detail::tensor_copy_type_t<std::tuple_element_t<decltype(i)::value,tuple_type>,order,config_type>;
+            res_type res(tmp.shape());
+            multithreading::transform(policy,tmp.begin(),tmp.end(),res.begin(),[](const auto& e){return std::get<decltype(i)::value>(e);});
+            return res;
+        };
+        return std::make_tuple(split(std::integral_constant<std::size_t,I>{})...);
+    }
+
     template<typename ResultT, typename...Ts, typename F, typename IdxT, typename...Args>
     static auto slide_flatten_(const basic_tensor<Ts...>& parent, F slide_f, const IdxT& window_size_, const IdxT& window_step_, const Args&...args)
     {
@@ -657,7 +869,7 @@ class reducer
     }
 
     template<typename ResultT, typename Policy, typename...Ts, typename Axis, typename F, typename IdxT, typename...Args>
-    static auto slide_helper(Policy, const basic_tensor<Ts...>& parent, const Axis& axis_, F slide_f, const IdxT& window_size_, const IdxT& window_step_, const Args&...args)
+    static auto slide_helper(Policy policy, const basic_tensor<Ts...>& parent, const Axis& axis_, F slide_f, const IdxT& window_size_, const IdxT& window_step_, const Args&...args)
     {
         using parent_type = basic_tensor<Ts...>;
         using order = typename parent_type::order;
@@ -676,7 +888,7 @@ class reducer
         auto res = tensor<res_value_type,order,res_config_type>{detail::make_slide_shape(psize, pshape, axis, window_size, window_step)};
         if (!res.empty()){
 
-            auto slide_helper = [&parent,&slide_f,&pshape,&psize,&axis,&res](auto walker_maker, auto begin_maker, auto end_maker, const auto&...args){
+            auto slide_helper = [&policy,&parent,&slide_f,&pshape,&psize,&axis,&res](auto walker_maker, auto begin_maker, auto end_maker, const auto&...args){
                 const auto pdim = parent.dim();
                 if (pdim == dim_type{1}){
                     auto parent_a = parent.traverse_order_adapter(order{});
@@ -702,11 +914,14 @@ class reducer
                     const auto axis_size = pshape[axis];
                     const auto tasks_number = psize/axis_size;
                     if constexpr (multithreading::exec_policy_traits<Policy>::is_seq::value){
+                        detail::unused_args{policy};
                         body(slide_f,parent_traverser,res_traverser,tasks_number,args...);
                     }else{  //parallelize
-                        constexpr std::size_t max_par_tasks = multithreading::exec_policy_traits<Policy>::par_tasks::value;
-                        constexpr std::size_t min_tasks_per_par_task = 1;
-                        multithreading::par_task_size<index_type> par_sizes{tasks_number,max_par_tasks,min_tasks_per_par_task};
+                        const auto par_sizes = multithreading::make_par_task_size(policy,tasks_number);
+                        if (par_sizes.size()<2){
+                            body(slide_f,parent_traverser,res_traverser,tasks_number,args...);
+                            return;
+                        }
                         multithreading::task_group group{};
                         index_type pos{0};
                         for (std::size_t i{0}; i!=par_sizes.size(); ++i){
@@ -739,7 +954,7 @@ class reducer
     }
 
     template<typename Policy, typename F, typename DimT, typename...Ts, typename...Args>
-    static void transform_(Policy, basic_tensor<Ts...>& parent, const DimT& axis_, F transform_f, const Args&...args){
+    static void transform_(Policy policy, basic_tensor<Ts...>& parent, const DimT& axis_, F transform_f, const Args&...args){
         using parent_type = basic_tensor<Ts...>;
         using order = typename parent_type::order;
         using config_type = typename parent_type::config_type;
@@ -771,11 +986,14 @@ class reducer
             const auto axis_size = pshape[axis];
             const auto tasks_number = parent.size()/axis_size;
             if constexpr (multithreading::exec_policy_traits<Policy>::is_seq::value){
+                detail::unused_args{policy};
                 body(transform_f,traverser,tasks_number,args...);
             }else{  //parallelize
-                constexpr std::size_t max_par_tasks = multithreading::exec_policy_traits<Policy>::par_tasks::value;
-                constexpr std::size_t min_tasks_per_par_task = 1;
-                multithreading::par_task_size<index_type> par_sizes{tasks_number,max_par_tasks,min_tasks_per_par_task};
+                const auto par_sizes = multithreading::make_par_task_size(policy,tasks_number);
+                if (par_sizes.size()<2){
+                    body(transform_f,traverser,tasks_number,args...);
+                    return;
+                }
                 using future_type = decltype(
                     std::declval<decltype(multithreading::get_pool())>().push(
                         body,
@@ -785,7 +1003,7 @@ class reducer
                         std::cref(args)...
                     )
                 );
-                std::array<future_type,max_par_tasks> futures{};
+                auto futures = multithreading::make_futures<future_type>(policy,par_sizes.size());
                 index_type pos{0};
                 for (std::size_t i{0}; i!=par_sizes.size(); ++i){
                     const auto par_task_size = par_sizes[i];
@@ -821,6 +1039,15 @@ public:
         return reduce_range_(multithreading::exec_pol<1>{},t,axes,f,keep_dims,any_order,args...);
     }
 
+    template<typename Policy, typename...Fs, typename Axes, typename...Ts, typename...Initials>
+    static auto reduce_multi(Policy policy, const basic_tensor<Ts...>& t, const Axes& axes, const std::tuple<Fs...>& fs, bool keep_dims, const std::tuple<Initials...>& initials){
+        return reduce_multi_(policy,t,axes,fs,keep_dims,initials);
+    }
+    template<typename...Fs, typename Axes, typename...Ts, typename...Initials>
+    static auto reduce_multi(const basic_tensor<Ts...>& t, const Axes& axes, const std::tuple<Fs...>& fs, bool keep_dims, const std::tuple<Initials...>& initials){
+        return reduce_multi_(multithreading::exec_pol<1>{},t,axes,fs,keep_dims,initials);
+    }
+
     template<typename ResultT, typename Policy, typename...Ts, typename Axis, typename F, typename IdxT, typename...Args>
     static auto slide(Policy policy, const basic_tensor<Ts...>& t, const Axis& axis, F f, const IdxT& window_size, const IdxT& window_step, const Args&...args){
         return slide_<ResultT>(policy,t,axis,f,window_size,window_step,args...);
@@ -873,6 +1100,30 @@ auto reduce_range(const basic_tensor<Ts...>& t, const Axes& axes, F f, bool keep
     return reducer_selector_t<config_type>::reduce_range(t, axes, f, keep_dims, any_order, args...);
 }
 
+//make several tensor reductions along axes in single traversal, axes can be scalar or container
+//fs is tuple of binary reduce functors that operate on tensor's elements, functors must be copyable
+//initials is tuple of initial values, its size must be equal to fs size, element of initials may be no_value
+//result is tuple of tensors, each tensor is the same as result of reduce_binary with corresponding functor and initial
+//policy is specialization of multithreading::exec_pol
+template<typename Policy, typename...Fs, typename Axes, typename...Ts, typename...Initials>
+auto reduce_multi(Policy policy, const basic_tensor<Ts...>& t, const Axes& axes, const std::tuple<Fs...>& fs, bool keep_dims, const std::tuple<Initials...>& initials){
+    using config_type = typename basic_tensor<Ts...>::config_type;
+    return reducer_selector_t<config_type>::reduce_multi(policy, t, axes, fs, keep_dims, initials);
+}
+template<typename Policy, typename...Fs, typename Axes, typename...Ts, std::enable_if_t<multithreading::is_policy_v<Policy>,int> =0>
+auto reduce_multi(Policy policy, const basic_tensor<Ts...>& t, const Axes& axes, const std::tuple<Fs...>& fs, bool keep_dims){
+    return reduce_multi(policy, t, axes, fs, keep_dims, std::tuple<std::conditional_t<true,detail::no_value,Fs>...>{});
+}
+template<typename...Fs, typename Axes, typename...Ts, typename...Initials>
+auto reduce_multi(const basic_tensor<Ts...>& t, const Axes& axes, const std::tuple<Fs...>& fs, bool keep_dims, const std::tuple<Initials...>& initials){
+    using config_type = typename basic_tensor<Ts...>::config_type;
+    return reducer_selector_t<config_type>::reduce_multi(t, axes, fs, keep_dims, initials);
+}
+template<typename...Fs, typename Axes, typename...Ts>
+auto reduce_multi(const basic_tensor<Ts...>& t, const Axes& axes, const std::tuple<Fs...>& fs, bool keep_dims){
+    return reduce_multi(t, axes, fs, keep_dims, std::tuple<std::conditional_t<true,detail::no_value,Fs>...>{});
+}
+
 //make tensor that is result of applying F to sliding window over axis, axis is scalar
 //F is slide functor that takes iterators range of data to be slided, dst iterators range, optional parameters
 //F call operator must be defined like this: template<typename It,typename DstIt,typename...Args> void operator()(It first, It last, DstIt dfirst, DstIt dlast, Args...){...}
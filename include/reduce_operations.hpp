@@ -163,9 +163,156 @@ struct nan_ignoring_operation : Operation
 template<typename T> struct plus : public std::plus<T>{template<typename U> inline static constexpr U value(){return U(0);}};
 template<typename T> struct multiplies : public std::multiplies<T>{template<typename U> inline static constexpr U value(){return U(1);}};
 
-using sum = accumulate_nanaccumulate<nan_propagate_operation<plus<void>>>;
+//summation algorithm selected by SumMode is used for floating point and complex accumulators, other types are summed by left fold
+template<typename T> constexpr bool is_accurate_summation_v = gtensor::math::numeric_traits<T>::is_floating_point() || gtensor::math::is_complex_v<T>;
+
+//second order Kahan-Babuska (Neumaier, Klein) compensated sum, error doesn't grow with number of elements
+//rounding error of each addition is accumulated compensated too, otherwise compensation itself loses digits when all elements are of the same sign
+template<typename T>
+class compensated_sum
+{
+public:
+    explicit compensated_sum(const T& initial):
+        s_{initial}
+    {}
+    ALWAYS_INLINE void add(const T& e){
+        const T c = two_sum(s_,e);
+        ccs_+=two_sum(cs_,c);
+    }
+    //compensation is not used if sum is not finite
+    T value()const{
+        return gtensor::math::isfinite(s_) ? s_+(cs_+ccs_) : s_;
+    }
+private:
+    //a+=b, rounding error is returned
+    ALWAYS_INLINE static T two_sum(T& a, const T& b){
+        const T t = a+b;
+        const T err = gtensor::math::abs(a)>=gtensor::math::abs(b) ? (a-t)+b : (b-t)+a;
+        a = t;
+        return err;
+    }
+    T s_;
+    T cs_{0};
+    T ccs_{0};
+};
+
+template<typename T>
+class compensated_sum<std::complex<T>>
+{
+public:
+    explicit compensated_sum(const std::complex<T>& initial):
+        re_{initial.real()},
+        im_{initial.imag()}
+    {}
+    ALWAYS_INLINE void add(const std::complex<T>& e){
+        re_.add(e.real());
+        im_.add(e.imag());
+    }
+    std::complex<T> value()const{
+        return std::complex<T>(re_.value(),im_.value());
+    }
+private:
+    compensated_sum<T> re_;
+    compensated_sum<T> im_;
+};
+
+//blocked pairwise summation of f(e) of n elements starting from first, first is advanced
+//error grows as O(log(n)), blocks are summed using independent accumulators that compiler may keep in simd registers
+inline constexpr std::size_t pairwise_block_size = 128;
+inline constexpr std::size_t pairwise_accumulators_n = 8;
+template<typename R, typename It, typename F>
+R pairwise_sum(It& first, std::size_t n, F& f){
+    constexpr std::size_t k = pairwise_accumulators_n;
+    if (n<k){
+        R res{0};
+        for (;n!=0; --n,++first){
+            res+=f(*first);
+        }
+        return res;
+    }else if (n<=pairwise_block_size){
+        R r[k];
+        for (std::size_t j=0; j!=k; ++j,++first){
+            r[j] = f(*first);
+        }
+        std::size_t i=k;
+        for (; i+k<=n; i+=k){
+            for (std::size_t j=0; j!=k; ++j,++first){
+                r[j]+=f(*first);
+            }
+        }
+        R res = ((r[0]+r[1])+(r[2]+r[3]))+((r[4]+r[5])+(r[6]+r[7]));
+        for (; i!=n; ++i,++first){
+            res+=f(*first);
+        }
+        return res;
+    }else{
+        auto n1 = n/2;
+        n1-=n1%k;
+        const R res = pairwise_sum<R>(first,n1,f);
+        return res+pairwise_sum<R>(first,n-n1,f);
+    }
+}
+
+//sum of f(e) of elements in range added to initial, summation algorithm is selected by SumMode
+template<typename SumMode, typename It, typename R, typename F>
+R accumulate_sum(It first, It last, R initial, F f){
+    if constexpr (is_accurate_summation_v<R> && std::is_same_v<SumMode,config::mode_sum_pairwise>){
+        return initial+pairwise_sum<R>(first,static_cast<std::size_t>(std::distance(first,last)),f);
+    }else if constexpr (is_accurate_summation_v<R> && std::is_same_v<SumMode,config::mode_sum_kahan>){
+        compensated_sum<R> res{initial};
+        for (;first!=last; ++first){
+            res.add(f(*first));
+        }
+        return res.value();
+    }else{
+        for (;first!=last; ++first){
+            initial = initial+f(*first);
+        }
+        return initial;
+    }
+}
+
+//plus that sums contiguous ranges of elements according to SumMode, nan elements are skipped if IgnoreNan is true
+//accumulate is used instead of left fold by reduce_binary and multithreading::reduce
+template<typename SumMode, bool IgnoreNan>
+struct summation_operation : std::conditional_t<IgnoreNan,nan_ignoring_operation<plus<void>>,nan_propagate_operation<plus<void>>>
+{
+    using operation_type = std::conditional_t<IgnoreNan,nan_ignoring_operation<plus<void>>,nan_propagate_operation<plus<void>>>;
+    template<typename It, typename Initial>
+    Initial accumulate(It first, It last, const Initial& initial){
+        if constexpr (is_accurate_summation_v<Initial> && !std::is_same_v<SumMode,config::mode_sum_naive>){
+            if constexpr (IgnoreNan){
+                const Initial initial_ = gtensor::math::isnan(initial) ? Initial{0} : initial;
+                return accumulate_sum<SumMode>(first,last,initial_,[](const auto& e){return gtensor::math::isnan(e) ? Initial{0} : static_cast<Initial>(e);});
+            }else{
+                return accumulate_sum<SumMode>(first,last,initial,[](const auto& e){return static_cast<Initial>(e);});
+            }
+        }else{
+            return std::accumulate(first,last,initial,static_cast<operation_type&>(*this));
+        }
+    }
+};
+
+template<typename SumMode, bool IgnoreNan>
+struct summation_nansummation
+{
+    using operation_type = summation_operation<SumMode,IgnoreNan>;
+    template<typename It, typename Initial = gtensor::detail::no_value>
+    auto operator()(It first, It last, const Initial& initial = Initial{}){
+        if (first == last){
+            return reduce_empty<operation_type,It>(initial);
+        }
+        auto init = make_initial<operation_type>(first,initial);
+        return operation_type{}.accumulate(first,last,init);
+    }
+};
+
+template<typename SumMode> using sum_operation = summation_operation<SumMode,false>;
+template<typename SumMode> using nansum_operation = summation_operation<SumMode,true>;
+
+template<typename SumMode> using sum = summation_nansummation<SumMode,false>;
 using prod = accumulate_nanaccumulate<nan_propagate_operation<multiplies<void>>>;
-using nansum = accumulate_nanaccumulate<nan_ignoring_operation<plus<void>>>;
+template<typename SumMode> using nansum = summation_nansummation<SumMode,true>;
 using nanprod = accumulate_nanaccumulate<nan_ignoring_operation<multiplies<void>>>;
 
 template<typename Operation>
@@ -184,9 +331,49 @@ struct cumulate_nancumulate
     }
 };
 
-using cumsum = cumulate_nancumulate<nan_propagate_operation<plus<void>>>;
+//pairwise summation is not applicable to prefix sums
+//pairwise mode: elements of block are summed by left fold and added to compensated sum of previous blocks, so error doesn't grow with n and speed is as of naive cumsum
+//kahan mode: running sum is compensated
+template<typename SumMode, bool IgnoreNan>
+struct cumsum_nancumsum
+{
+    using operation_type = std::conditional_t<IgnoreNan,nan_ignoring_operation<plus<void>>,nan_propagate_operation<plus<void>>>;
+    template<typename It, typename DstIt>
+    void operator()(It first, It last, DstIt dfirst, DstIt dlast){
+        using res_value_type = typename std::iterator_traits<DstIt>::value_type;
+        auto f = [](const auto& e){
+            if constexpr (IgnoreNan){
+                return gtensor::math::isnan(e) ? res_value_type{0} : static_cast<res_value_type>(e);
+            }else{
+                return static_cast<res_value_type>(e);
+            }
+        };
+        if constexpr (is_accurate_summation_v<res_value_type> && std::is_same_v<SumMode,config::mode_sum_pairwise>){
+            compensated_sum<res_value_type> res{res_value_type{0}};
+            while(first!=last){
+                const auto base = res.value();
+                res_value_type block_res{0};
+                for (std::size_t i=0; i!=pairwise_block_size && first!=last; ++i,++first,++dfirst){
+                    block_res+=f(*first);
+                    *dfirst = base+block_res;
+                }
+                res.add(block_res);
+            }
+        }else if constexpr (is_accurate_summation_v<res_value_type> && std::is_same_v<SumMode,config::mode_sum_kahan>){
+            compensated_sum<res_value_type> res{res_value_type{0}};
+            for (;first!=last; ++first,++dfirst){
+                res.add(f(*first));
+                *dfirst = res.value();
+            }
+        }else{
+            cumulate_nancumulate<operation_type>{}(first,last,dfirst,dlast);
+        }
+    }
+};
+
+template<typename SumMode> using cumsum = cumsum_nancumsum<SumMode,false>;
 using cumprod = cumulate_nancumulate<nan_propagate_operation<multiplies<void>>>;
-using nancumsum = cumulate_nancumulate<nan_ignoring_operation<plus<void>>>;
+template<typename SumMode> using nancumsum = cumsum_nancumsum<SumMode,true>;
 using nancumprod = cumulate_nancumulate<nan_ignoring_operation<multiplies<void>>>;
 
 //first finite difference
@@ -381,6 +568,7 @@ struct nan_ignoring_counting_operation : Operation
     }
 };
 
+template<typename SumMode = config::default_config::sum_mode>
 struct mean
 {
     template<typename It>
@@ -394,7 +582,7 @@ struct mean
             return reduce_empty<res_type>();
         }
         const auto n = static_cast<fp_type>(last-first);
-        auto res = std::accumulate(first,last,res_type{0},std::plus<void>{});
+        auto res = math_reduce_operations::sum_operation<SumMode>{}.accumulate(first,last,res_type{0});
         res/=n;
         return res;
     }
@@ -457,73 +645,215 @@ auto squared_diff(const T& e, const U& m){
     }
 }
 
+//moments of single pass variance: number of elements, mean and sum of squared deviations from mean
+//moments of disjoint ranges are merged using Chan's formula, so that ranges may be reduced in any order and in parallel
+template<typename M, typename V>
+struct moments
+{
+    using mean_type = M;
+    using var_type = V;
+    std::size_t n{0};
+    M mean{0};
+    V m2{0};
+    //Welford's update
+    template<typename E>
+    ALWAYS_INLINE void add(const E& e){
+        ++n;
+        const V d = squared_diff(e,mean);
+        mean+=(static_cast<M>(e)-mean)/static_cast<V>(n);
+        m2+=d*(static_cast<V>(n-1)/static_cast<V>(n));
+    }
+    void merge(const moments& other){
+        if (other.n==0){
+            return;
+        }
+        if (n==0){
+            *this = other;
+            return;
+        }
+        const auto n_ = n+other.n;
+        const V d = squared_diff(other.mean,mean);
+        const V w = static_cast<V>(other.n)/static_cast<V>(n_);
+        mean+=(other.mean-mean)*w;
+        m2+=other.m2+d*static_cast<V>(n)*w;
+        n = n_;
+    }
+    //nan if there are no elements or mean is not finite
+    V var()const{
+        return gtensor::math::isnan(mean-mean) ? gtensor::math::numeric_traits<V>::nan() : m2/static_cast<V>(n);
+    }
+};
+
+template<typename T> using moments_t = moments<gtensor::math::make_floating_point_like_t<T>,gtensor::math::make_floating_point_t<T>>;
+
+//moments of n elements starting from first, first is advanced, nan elements are skipped if IgnoreNan is true
+//block is summed to get its mean and summed again to get squared deviations while it is in cache, so elements are read from memory once
+//moments of blocks are merged pairwise
+template<typename Moments, bool IgnoreNan, typename It>
+Moments pairwise_moments(It& first, std::size_t n){
+    using mean_type = typename Moments::mean_type;
+    using var_type = typename Moments::var_type;
+    if (n<=math_reduce_operations::pairwise_block_size){
+        Moments res{};
+        if constexpr (IgnoreNan){
+            auto it = first;
+            mean_type s{0};
+            for (std::size_t i=0; i!=n; ++i,++it){
+                if (!gtensor::math::isnan(*it)){
+                    s+=static_cast<mean_type>(*it);
+                    ++res.n;
+                }
+            }
+            if (res.n!=0){
+                res.mean = s/static_cast<var_type>(res.n);
+                for (;first!=it; ++first){
+                    if (!gtensor::math::isnan(*first)){
+                        res.m2+=squared_diff(*first,res.mean);
+                    }
+                }
+            }
+            first = it;
+        }else{
+            if (n!=0){
+                auto it = first;
+                auto to_mean_type = [](const auto& e){return static_cast<mean_type>(e);};
+                res.n = n;
+                res.mean = math_reduce_operations::pairwise_sum<mean_type>(it,n,to_mean_type)/static_cast<var_type>(n);
+                auto squared_diff_ = [&res](const auto& e){return squared_diff(e,res.mean);};
+                res.m2 = math_reduce_operations::pairwise_sum<var_type>(first,n,squared_diff_);
+            }
+        }
+        return res;
+    }else{
+        auto n1 = n/2;
+        n1-=n1%math_reduce_operations::pairwise_accumulators_n;
+        auto res = pairwise_moments<Moments,IgnoreNan>(first,n1);
+        res.merge(pairwise_moments<Moments,IgnoreNan>(first,n-n1));
+        return res;
+    }
+}
+
+//moments of elements in range merged to initial
+//naive mode: Welford's update of each element, other modes: pairwise merge of blocks moments
+template<typename SumMode, bool IgnoreNan, typename It, typename Moments>
+Moments accumulate_moments(It first, It last, Moments initial){
+    if constexpr (std::is_same_v<SumMode,config::mode_sum_naive>){
+        for (;first!=last; ++first){
+            if constexpr (IgnoreNan){
+                if (gtensor::math::isnan(*first)){
+                    continue;
+                }
+            }
+            initial.add(*first);
+        }
+    }else{
+        initial.merge(pairwise_moments<Moments,IgnoreNan>(first,static_cast<std::size_t>(std::distance(first,last))));
+    }
+    return initial;
+}
+
+//binary reduce functor, result of reduction is moments, nan elements are skipped if IgnoreNan is true
+//accumulate is used instead of left fold by reduce_binary and multithreading::reduce
+template<typename SumMode, bool IgnoreNan, typename Moments>
+struct moments_operation
+{
+    template<typename E>
+    ALWAYS_INLINE Moments operator()(Moments r, const E& e){
+        if constexpr (IgnoreNan){
+            if (gtensor::math::isnan(e)){
+                return r;
+            }
+        }
+        r.add(e);
+        return r;
+    }
+    template<typename E>
+    ALWAYS_INLINE Moments operator()(const E& e, const Moments& r){
+        return this->operator()(r,e);
+    }
+    template<typename E1, typename E2>
+    Moments operator()(const E1& e1, const E2& e2){
+        return this->operator()(this->operator()(Moments{},e1),e2);
+    }
+    Moments operator()(Moments r1, const Moments& r2){
+        r1.merge(r2);
+        return r1;
+    }
+    template<typename It>
+    Moments accumulate(It first, It last, const Moments& initial){
+        return accumulate_moments<SumMode,IgnoreNan>(first,last,initial);
+    }
+};
+
+//range reduce functor, result of reduction is moments
+template<typename SumMode, bool IgnoreNan>
+struct moments_maker
+{
+    template<typename It>
+    auto operator()(It first, It last){
+        using value_type = typename std::iterator_traits<It>::value_type;
+        return accumulate_moments<SumMode,IgnoreNan>(first,last,moments_t<value_type>{});
+    }
+};
+
+template<typename SumMode = config::default_config::sum_mode>
 struct var
 {
     template<typename It>
     auto operator()(It first, It last){
         using value_type = typename std::iterator_traits<It>::value_type;
-        using mean_type = decltype(mean{}(first,last));
+        using mean_type = decltype(mean<SumMode>{}(first,last));
         using res_type = detail::copy_type_t<decltype(squared_diff(std::declval<value_type>(),std::declval<mean_type>()))>;
 
         if (first == last){
             return reduce_empty<res_type>();
         }
-        const auto n = last-first;
-        const auto mean_ = mean{}(first,last);
-        auto res = std::accumulate(first,last,res_type{0},
-            [mean_](const auto& r, const auto& e){
-                return r+squared_diff(e,mean_);
-            }
-        );
-        res/=n;
-        return res;
+        if constexpr (gtensor::detail::is_tensor_v<value_type>){
+            //two pass for tensor elements
+            const auto n = last-first;
+            const auto mean_ = mean<SumMode>{}(first,last);
+            auto res = math_reduce_operations::accumulate_sum<SumMode>(first,last,res_type{0},
+                [&mean_](const auto& e){
+                    return squared_diff(e,mean_);
+                }
+            );
+            res/=n;
+            return res;
+        }else{
+            return static_cast<res_type>(moments_maker<SumMode,false>{}(first,last).var());
+        }
     }
 };
 
+template<typename SumMode = config::default_config::sum_mode>
 struct nanvar
 {
     template<typename It>
     auto operator()(It first, It last){
         using value_type = typename std::iterator_traits<It>::value_type;
-        using difference_type = typename std::iterator_traits<It>::difference_type;
-        using mean_type = decltype(nanmean{}(first,last));
-        using res_type = decltype(squared_diff(std::declval<value_type>(),std::declval<mean_type>()));
-
+        using res_type = gtensor::math::make_floating_point_t<value_type>;
         if (first == last){
             return reduce_empty<res_type>();
         }
-        const auto nanmean_ = nanmean{}(first,last);
-        auto res = std::accumulate(first,last,std::make_pair(res_type{0},difference_type{0}),
-            [nanmean_](const auto& r, const auto& e)
-            {
-                if (gtensor::math::isnan(e)){
-                    return r;
-                }else{
-                    return std::make_pair(r.first+squared_diff(e,nanmean_),r.second+1);
-                }
-            }
-        );
-        if (res.second==0){
-            return gtensor::math::numeric_traits<res_type>::nan();
-        }else{
-            return res.first/res.second;
-        }
+        return moments_maker<SumMode,true>{}(first,last).var();
     }
 };
 
+template<typename SumMode = config::default_config::sum_mode>
 struct stdev
 {
     template<typename It>
     auto operator()(It first, It last){
-        return sqrt_helper(var{}(first,last));
+        return sqrt_helper(var<SumMode>{}(first,last));
     }
 };
 
+template<typename SumMode = config::default_config::sum_mode>
 struct nanstdev
 {
     template<typename It>
     auto operator()(It first, It last){
-        return sqrt_helper(nanvar{}(first,last));
+        return sqrt_helper(nanvar<SumMode>{}(first,last));
     }
 };
 
@@ -545,7 +875,7 @@ struct quantile_nanquantile
     auto operator()(It first, It last, const Q& quantile, Config){
         using value_type = typename std::iterator_traits<It>::value_type;
         using difference_type = typename std::iterator_traits<It>::difference_type;
-        using container_type = typename Config::template container<value_type>;
+        using container_type = typename Config::template scratch_container<value_type>;
         using container_difference_type = typename container_type::difference_type;
         using res_type = gtensor::math::make_floating_point_like_t<value_type>;
         if (first == last){
@@ -779,7 +1109,7 @@ struct argsort
     template<typename It, typename DstIt, typename Comparator, typename Config>
     void operator()(It first, It last, DstIt dfirst, DstIt dlast, const Comparator& comparator, Config){
         using value_type = typename std::iterator_traits<It>::value_type;
-        using container_type = typename Config::template container<value_type>;
+        using container_type = typename Config::template scratch_container<value_type>;
         using container_size_type = typename container_type::size_type;
         container_type elements(first,last);
         std::iota(dfirst,dlast,0);
@@ -838,7 +1168,7 @@ struct nth_element_partition
         const auto n = last-first;
         std::copy(first,last,dfirst);
         if constexpr (is_nth_container){
-            using nth_container_type = typename Config::template container<difference_type>;
+            using nth_container_type = typename Config::template scratch_container<difference_type>;
             check_nth(n,nth);
             nth_container_type nth_{nth.begin(),nth.end()};
             std::sort(nth_.begin(),nth_.end());
@@ -884,14 +1214,14 @@ struct nth_element_argpartition
     void operator()(It first, It last, DstIt dfirst, DstIt dlast, const Nth& nth, const Comparator& comparator, Config){
         using difference_type = typename std::iterator_traits<It>::difference_type;
         using value_type = typename std::iterator_traits<It>::value_type;
-        using elements_container_type = typename Config::template container<value_type>;
+        using elements_container_type = typename Config::template scratch_container<value_type>;
         static constexpr bool is_nth_container = detail::is_container_of_type_v<Nth,difference_type>;
         static_assert(is_nth_container || detail::is_static_castable_v<Nth,difference_type>,"invalid nth argument");
         const auto n = last-first;
         elements_container_type elements(first,last);
         std::iota(dfirst,dlast,0);
         if constexpr (is_nth_container){
-            using nth_container_type = typename Config::template container<difference_type>;
+            using nth_container_type = typename Config::template scratch_container<difference_type>;
             check_nth(n,nth);
             nth_container_type nth_{nth.begin(),nth.end()};
             std::sort(nth_.begin(),nth_.end());
@@ -305,7 +305,7 @@ struct sort_search
         using shape_type = typename tensor_type::shape_type;
         using res_tensor_type = tensor<value_type,order,config_type>;
         using index_tensor_type = tensor<index_type,order,config_type>;
-        using index_container_type = typename config_type::template container<index_type>;
+        using index_container_type = typename config_type::template scratch_container<index_type>;
         using index_container_difference_type = typename index_container_type::difference_type;
 
         detail::check_unique_args(t.dim(),axis_);
@@ -369,7 +369,7 @@ struct sort_search
                 }
             };
 
-            typename config_type::template container<range> chunks{};
+            typename config_type::template scratch_container<range> chunks{};
             index_type i{0};
             if (chunk_size!=0){
                 detail::reserve(chunks,axis_size);
@@ -465,7 +465,7 @@ private:
         };
         static constexpr bool need_index = return_index.value || return_inverse.value;
         using element_type = std::conditional_t<need_index,element,value_type>;;
-        using container_type = typename config_type::template container<element_type>;
+        using container_type = typename config_type::template scratch_container<element_type>;
         container_type tmp{};
         index_type i{0};
         if constexpr (need_index){
@@ -478,7 +478,7 @@ private:
         }
         std::sort(tmp.begin(),tmp.end());
 
-        using index_container_type = typename config_type::template container<index_type>;
+        using index_container_type = typename config_type::template scratch_container<index_type>;
         using container_difference_type = typename index_container_type::difference_type;
         index_container_type inverse{};
         index_container_type counts{};
@@ -117,7 +117,8 @@ private:
             using fp_type = gtensor::math::make_floating_point_t<element_type>;
             using fp_like_type = gtensor::math::make_floating_point_like_t<element_type>;
             using res_value_type = typename detail::copy_type_t<basic_tensor<Ts...>,fp_like_type>::value_type;
-            using f_type = gtensor::math_reduce_operations::nan_propagate_operation<gtensor::math_reduce_operations::plus<void>>;
+            using config_type = typename basic_tensor<Ts...>::config_type;
+            using f_type = gtensor::math_reduce_operations::sum_operation<typename config_type::sum_mode>;
             auto tmp = reduce_binary(policy,t,axes,f_type{},keep_dims,res_value_type(0));
             if (!tmp.empty()){
                 if (t.empty()){ //reduce zero size dimension
@@ -171,15 +172,42 @@ private:
             return this->operator()(policy,t,detail::no_value{},keep_dims);
         }
     };
+    //reduce to moments of single pass variance, nan elements are skipped if IgnoreNan is true
+    template<bool IgnoreNan, typename Policy, typename...Ts, typename Axes>
+    static auto make_moments(Policy policy, const basic_tensor<Ts...>& t, const Axes& axes, bool keep_dims){
+        using value_type = typename basic_tensor<Ts...>::value_type;
+        using sum_mode = typename basic_tensor<Ts...>::config_type::sum_mode;
+        using moments_type = statistic_reduce_operations::moments_t<value_type>;
+        if constexpr (multithreading::exec_policy_traits<Policy>::is_seq::value || std::is_same_v<Axes,detail::no_value>){
+            using f_type = statistic_reduce_operations::moments_operation<sum_mode,IgnoreNan,moments_type>;
+            return reduce_binary(policy,t,axes,f_type{},keep_dims,moments_type{});
+        }else{
+            return reduce_range(policy,t,axes,statistic_reduce_operations::moments_maker<sum_mode,IgnoreNan>{},keep_dims,true);
+        }
+    }
+    template<typename Policy, typename...Ts, typename F>
+    static auto transform_moments(Policy policy, const basic_tensor<Ts...>& moments_, F f){
+        using order = typename basic_tensor<Ts...>::order;
+        using config_type = typename basic_tensor<Ts...>::config_type;
+        using res_value_type = decltype(f(std::declval<typename basic_tensor<Ts...>::value_type>()));
+        tensor<res_value_type,order,config::extend_config_t<config_type,res_value_type>> res(moments_.shape());
+        multithreading::transform(policy,moments_.begin(),moments_.end(),res.begin(),f);
+        return res;
+    }
     struct var_binary{
         template<typename Policy, typename...Ts,typename Axes>
         auto operator()(Policy policy, const basic_tensor<Ts...>& t, const Axes& axes, bool keep_dims){
-            auto squared_diff = [](const auto& e, const auto& m){
-                return statistic_reduce_operations::squared_diff(e,m);
-            };
-            auto mean_ = mean_binary{}(policy,t,axes,true);
-            auto tmp = gtensor::n_operator(squared_diff,t,std::move(mean_));
-            return mean_binary{}(policy,tmp,axes,keep_dims);
+            using value_type = typename basic_tensor<Ts...>::value_type;
+            if constexpr (detail::is_tensor_v<value_type>){ //two pass for tensor elements
+                auto squared_diff = [](const auto& e, const auto& m){
+                    return statistic_reduce_operations::squared_diff(e,m);
+                };
+                auto mean_ = mean_binary{}(policy,t,axes,true);
+                auto tmp = gtensor::n_operator(squared_diff,t,std::move(mean_));
+                return mean_binary{}(policy,tmp,axes,keep_dims);
+            }else{
+                return transform_moments(policy,make_moments<false>(policy,t,axes,keep_dims),[](const auto& m){return m.var();});
+            }
         }
         template<typename Policy, typename...Ts>
         auto operator()(Policy policy, const basic_tensor<Ts...>& t, bool keep_dims){
@@ -187,67 +215,9 @@ private:
         }
     };
     struct nanvar_binary{
-        template<typename Size>
-        struct nan_ignoring_counting_plus
-        {
-            template<typename T, typename R>
-            auto operator()(const std::tuple<T,R>& e1, const std::tuple<T,R>& e2){
-                const auto e1_nan = gtensor::math::isnan(std::get<0>(e1));
-                const auto e2_nan = gtensor::math::isnan(std::get<0>(e2));
-                if (e1_nan && e2_nan){
-                    return std::make_pair(R(0),Size{0});
-                }else if (e1_nan){
-                    return std::make_pair(std::get<1>(e2),Size{1});
-                }else if (e2_nan){
-                    return std::make_pair(std::get<1>(e1),Size{1});
-                }else{
-                    return std::make_pair(std::get<1>(e1)+std::get<1>(e2),Size{2});
-                }
-            }
-            template<typename R>
-            auto operator()(const std::pair<R,Size>& r1, const std::pair<R,Size>& r2){
-                return std::make_pair(r1.first+r2.first,r1.second+r2.second);
-            }
-            template<typename R, typename T>
-            auto operator()(const std::pair<R,Size>& r, const std::tuple<T,R>& e){
-                return gtensor::math::isnan(std::get<0>(e)) ? r : std::make_pair(r.first+std::get<1>(e),r.second+Size{1});
-            }
-            template<typename R, typename T>
-            auto operator()(const std::tuple<T,R>& e, const std::pair<R,Size>& r){
-                return this->operator()(r,e);
-            }
-        };
-
         template<typename Policy, typename...Ts,typename Axes>
         auto operator()(Policy policy, const basic_tensor<Ts...>& t, const Axes& axes, bool keep_dims){
-            using order = typename basic_tensor<Ts...>::order;
-            using element_type = typename basic_tensor<Ts...>::element_type;
-            using config_type = typename basic_tensor<Ts...>::config_type;
-            using integral_type = gtensor::math::make_integral_t<element_type>;
-            auto mean_ = nanmean_binary{}(policy,t,axes,true);
-            auto squared_diff = [](const auto& e, const auto& m){
-                return statistic_reduce_operations::squared_diff(e,m);
-            };
-            auto make_tuple = [](const auto& e1,const auto& e2){return std::make_tuple(e1,e2);};
-            auto tmp = gtensor::n_operator(make_tuple,t,gtensor::n_operator(squared_diff,t,std::move(mean_)));
-            using res_value_type = std::tuple_element_t<1,typename decltype(tmp)::value_type>;
-            using f_type = nan_ignoring_counting_plus<integral_type>;
-            auto sum = reduce_binary(policy,tmp,axes,f_type{},keep_dims,std::make_pair(res_value_type{0},integral_type{0}));
-            tensor<res_value_type,order,config_type> res(sum.shape());
-            multithreading::transform(policy,sum.begin(),sum.end(),res.begin(),
-                [](const auto& r){
-                    if constexpr (gtensor::math::numeric_traits<res_value_type>::has_nan()){
-                        return r.first/static_cast<const res_value_type&>(r.second);
-                    }else{
-                        if (r.second==0){
-                            throw value_error("cant reduce zero size dimension without initial value");
-                        }else{
-                            return r.first/static_cast<const res_value_type&>(r.second);
-                        }
-                    }
-                }
-            );
-            return res;
+            return transform_moments(policy,make_moments<true>(policy,t,axes,keep_dims),[](const auto& m){return m.var();});
         }
         template<typename Policy, typename...Ts>
         auto operator()(Policy policy, const basic_tensor<Ts...>& t, bool keep_dims){
@@ -286,15 +256,47 @@ public:
 
     //mean of elements along given axes
     //axes may be scalar or container
-    GTENSOR_TENSOR_STATISTIC_REDUCE_FUNCTION(mean,statistic_reduce_operations::mean,mean_binary);
+    GTENSOR_TENSOR_STATISTIC_REDUCE_FUNCTION(mean,statistic_reduce_operations::mean<typename basic_tensor<Ts...>::config_type::sum_mode>,mean_binary);
 
     //variance of elements along given axes
     //axes may be scalar or container
-    GTENSOR_TENSOR_STATISTIC_REDUCE_FUNCTION(var,statistic_reduce_operations::var,var_binary);
+    GTENSOR_TENSOR_STATISTIC_REDUCE_FUNCTION(var,statistic_reduce_operations::var<typename basic_tensor<Ts...>::config_type::sum_mode>,var_binary);
 
     //standart deviation of elements along given axes
     //axes may be scalar or container
-    GTENSOR_TENSOR_STATISTIC_REDUCE_FUNCTION(stdev,statistic_reduce_operations::stdev,stdev_binary);
+    GTENSOR_TENSOR_STATISTIC_REDUCE_FUNCTION(stdev,statistic_reduce_operations::stdev<typename basic_tensor<Ts...>::config_type::sum_mode>,stdev_binary);
+
+    //mean and variance of elements along given axes computed in single pass
+    //axes may be scalar or container
+    //returns pair of mean and variance
+    template<typename Policy, typename...Ts, typename Axes>
+    static auto mean_var(Policy policy, const basic_tensor<Ts...>& t, const Axes& axes, bool keep_dims = false){
+        using value_type = typename basic_tensor<Ts...>::value_type;
+        if constexpr (detail::is_tensor_v<value_type>){
+            return std::make_pair(mean(policy,t,axes,keep_dims),var(policy,t,axes,keep_dims));
+        }else{
+            const auto moments_ = make_moments<false>(policy,t,axes,keep_dims);
+            return std::make_pair(
+                transform_moments(policy,moments_,[](const auto& m){
+                    using mean_type = std::remove_cv_t<decltype(m.mean)>;
+                    return m.n==0 ? gtensor::math::numeric_traits<mean_type>::nan() : m.mean;
+                }),
+                transform_moments(policy,moments_,[](const auto& m){return m.var();})
+            );
+        }
+    }
+    template<typename Policy, typename...Ts>
+    static auto mean_var(Policy policy, const basic_tensor<Ts...>& t, bool keep_dims = false){
+        return mean_var(policy,t,detail::no_value{},keep_dims);
+    }
+    template<typename...Ts, typename Axes>
+    static auto mean_var(const basic_tensor<Ts...>& t, const Axes& axes, bool keep_dims = false){
+        return mean_var(multithreading::exec_pol<1>{},t,axes,keep_dims);
+    }
+    template<typename...Ts>
+    static auto mean_var(const basic_tensor<Ts...>& t, bool keep_dims = false){
+        return mean_var(multithreading::exec_pol<1>{},t,keep_dims);
+    }
 
     //quantile of elements along given axes
     //axes may be scalar or container
@@ -312,11 +314,11 @@ public:
 
     //variance of elements along given axes, ignoring nan
     //axes may be scalar or container
-    GTENSOR_TENSOR_STATISTIC_REDUCE_FUNCTION(nanvar,statistic_reduce_operations::nanvar,nanvar_binary);
+    GTENSOR_TENSOR_STATISTIC_REDUCE_FUNCTION(nanvar,statistic_reduce_operations::nanvar<typename basic_tensor<Ts...>::config_type::sum_mode>,nanvar_binary);
 
     //standart deviation of elements along given axes, ignoring nan
     //axes may be scalar or container
-    GTENSOR_TENSOR_STATISTIC_REDUCE_FUNCTION(nanstdev,statistic_reduce_operations::nanstdev,nanstdev_binary);
+    GTENSOR_TENSOR_STATISTIC_REDUCE_FUNCTION(nanstdev,statistic_reduce_operations::nanstdev<typename basic_tensor<Ts...>::config_type::sum_mode>,nanstdev_binary);
 
     //quantile of elements along given axes, ignoring nan
     //axes may be scalar or container
@@ -828,7 +830,7 @@ private:
                 return make_fd();
             case histogram_algorithm::scott:
             {
-                statistic_reduce_operations::stdev stdev_maker{};
+                statistic_reduce_operations::stdev<typename Config::sum_mode> stdev_maker{};
                 const auto stddev = stdev_maker(first,last);
                 return stddev*gtensor::math::cbrt(24*gtensor::math::sqrt(gtensor::math::numeric_constants<fp_type>::pi())/n);
             }
@@ -928,6 +930,11 @@ GTENSOR_TENSOR_STATISTIC_REDUCE_ROUTINE(var,var);
 //axes may be scalar or container
 GTENSOR_TENSOR_STATISTIC_REDUCE_ROUTINE(stdev,stdev);
 
+//mean and variance of elements along given axes computed in single pass
+//axes may be scalar or container
+//returns pair of mean and variance
+GTENSOR_TENSOR_STATISTIC_REDUCE_ROUTINE(mean_var,mean_var);
+
 //median of elements along given axes
 //axes may be scalar or container
 GTENSOR_TENSOR_STATISTIC_REDUCE_ROUTINE(median,median);
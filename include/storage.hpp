@@ -16,6 +16,13 @@
 
 namespace gtensor{
 
+//tag to construct storage or tensor without initialization of elements
+//elements are default initialized: trivial types are left uninitialized, non-trivial types are default constructed instead of copy constructed from value_type{}
+struct no_init_t{
+    explicit no_init_t() = default;
+};
+inline constexpr no_init_t no_init{};
+
 namespace detail{
 
 template<typename T, typename... Args>
@@ -49,6 +56,27 @@ void uninitialized_fill(It first, It last, const T& v, Alloc& alloc){
     }
 }
 
+template<typename It>
+void uninitialized_default_construct(It first, It last){
+    using value_type = typename std::iterator_traits<It>::value_type;
+    if constexpr (!std::is_trivially_default_constructible_v<value_type>){
+        auto it=first;
+        try
+        {
+            for (;it!=last; ++it){
+                ::new (static_cast<void*>(std::addressof(*it))) value_type;
+            }
+        }
+        catch (...)
+        {
+            for (;first!=it; ++first){
+                std::addressof(*first)->~value_type();
+            }
+            throw;
+        }
+    }
+}
+
 template<typename It, typename DstIt, typename Alloc>
 auto uninitialized_copy(It first, It last, DstIt dfirst, Alloc& alloc){
     auto it=dfirst;
@@ -270,6 +298,15 @@ public:
     {
         init(n,v,true);
     }
+    //construct storage of n default initialized elements
+    basic_storage(const size_type& n, no_init_t, const allocator_type& alloc = allocator_type()):
+        allocator_{alloc}
+    {
+        auto new_buffer = allocate_buffer(n);
+        detail::uninitialized_default_construct(new_buffer.get(),new_buffer.get()+n);
+        begin_=new_buffer.release();
+        end_=begin_+n;
+    }
 
     template<typename, typename = void> struct is_input_iterator : std::false_type{};
     template<typename U> struct is_input_iterator<U,std::void_t<typename std::iterator_traits<U>::iterator_category>> : std::is_convertible<typename std::iterator_traits<U>::iterator_category,std::input_iterator_tag>{};
@@ -14,6 +14,8 @@
 #include "tensor_factory.hpp"
 #include "view_factory.hpp"
 #include "tensor_operators.hpp"
+#include "expression_template_engine/expression_template_simd.hpp"
+#include "transpose_copy.hpp"
 #include "multithreading.hpp"
 
 #define GTENSOR_TENSOR_REDUCE_METHOD(NAME,F)\
@@ -191,9 +193,11 @@ void copy_tensors(Policy policy, Order order, const basic_tensor<Ts...>& src, ba
     auto a_src = src.traverse_order_adapter(order);
     auto a_dst = dst.traverse_order_adapter(order);
     if (src.is_trivial()){
-        multithreading::copy(policy,a_src.begin_trivial(),a_src.end_trivial(),a_dst.begin());
-    }else{
-        multithreading::copy(policy,a_src.begin(),a_src.end(),a_dst.begin());
+        if (!simd_copy_tensors(policy,order,src,dst) && !transpose_copy_tensors(policy,src,dst)){
+            multithreading::copy(policy,a_src.begin_trivial(),a_src.end_trivial(),a_dst.begin());
+        }
+    }else if (!transpose_copy_tensors(policy,src,dst)){
+        detail::walk_coalesced_tensor<Order>(policy,src,[&a_dst](const auto& pos){return [it=a_dst.begin()+pos](const auto& w)mutable{*it=*w; ++it;};});
     }
 }
 
@@ -520,6 +524,10 @@ public:
     bool is_trivial()const{
         return impl().is_trivial();
     }
+    //implementation's core, gives access to expression tree
+    const auto& core()const{
+        return impl().core();
+    }
 
     //reduce_slide_transform methods to perform along axes using custom functor
     //reduce along axes using range functor, axes may be container or scalar
@@ -839,6 +847,7 @@ public:
     using difference_type = typename basic_tensor_base::difference_type;
     using element_type = typename basic_tensor_base::element_type;
     using order = typename basic_tensor_base::order;
+    using storage_type = typename config_type::template storage<value_type>;
 
     tensor(const tensor&) = default;
     tensor(tensor&&) = default;
@@ -956,6 +965,27 @@ public:
     tensor(Shape&& shape__, It begin__, It end__):
         tensor(forward_tag::tag(), std::forward<Shape>(shape__), begin__, end__)
     {}
+    //shape and no_init constructor
+    //construct tensor of shape with default initialized elements, if storage supports it, non-trivial elements are not value initialized
+    template<typename IdxT>
+    tensor(std::initializer_list<IdxT> shape__, no_init_t):
+        tensor(forward_tag::tag(), shape__, no_init_t{})
+    {}
+    template<typename Shape>
+    tensor(Shape&& shape__, no_init_t):
+        tensor(forward_tag::tag(), std::forward<Shape>(shape__), no_init_t{})
+    {}
+    //shape and storage constructor
+    //construct tensor of shape that takes ownership of storage elements, elements are considered to be in tensor's layout
+    //storage size must be equal to tensor size
+    template<typename IdxT>
+    tensor(std::initializer_list<IdxT> shape__, storage_type&& storage__):
+        tensor(forward_tag::tag(), shape__, std::move(storage__))
+    {}
+    template<typename Shape>
+    tensor(Shape&& shape__, storage_type&& storage__):
+        tensor(forward_tag::tag(), std::forward<Shape>(shape__), std::move(storage__))
+    {}
 
     //converting constructor
     template<typename...Ts>
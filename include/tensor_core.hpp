@@ -125,6 +125,12 @@ public:
         elements_(descriptor_.size())
     {}
 
+    //elements are default initialized if storage_type supports no_init construction, otherwise it is the same as shape constructor
+    template<typename ShT>
+    storage_core(ShT&& shape, no_init_t):
+        storage_core(std::forward<ShT>(shape), no_init_t{}, std::is_constructible<storage_type,index_type,no_init_t>{})
+    {}
+
     template<typename ShT>
     storage_core(ShT&& shape, const value_type& v):
         storage_core(std::forward<ShT>(shape), v, std::is_constructible<storage_type,index_type,value_type>{})
@@ -143,6 +149,19 @@ public:
         storage_core(std::forward<ShT>(shape), first, last, std::conjunction<std::is_constructible<storage_type,It,It>, std::is_move_constructible<storage_type> >{})
     {}
 
+    //takes ownership of elements, storage must have size of shape, if it can report it
+    template<typename ShT>
+    storage_core(ShT&& shape, storage_type&& elements):
+        descriptor_(std::forward<ShT>(shape)),
+        elements_(std::move(elements))
+    {
+        if constexpr (detail::has_callable_size<const storage_type>::value){
+            if (static_cast<index_type>(elements_.size()) != descriptor_.size()){
+                throw value_error("storage size must be equal to shape size");
+            }
+        }
+    }
+
     const descriptor_type& descriptor()const{return descriptor_;}
 
     template<typename Storage_ = storage_type, std::enable_if_t<detail::has_callable_iterator<Storage_>::value,int> =0>
@@ -200,6 +219,17 @@ private:
     {
         std::fill(begin_(),end_(),v);
     }
+    //no_init constructors
+    template<typename ShT>
+    storage_core(ShT&& shape, no_init_t, std::true_type):
+        descriptor_(std::forward<ShT>(shape)),
+        elements_(descriptor_.size(),no_init_t{})
+    {}
+    template<typename ShT>
+    storage_core(ShT&& shape, no_init_t, std::false_type):
+        descriptor_(std::forward<ShT>(shape)),
+        elements_(descriptor_.size())
+    {}
     //from range constructors
     //try to construct directly from range and move
     template<typename ShT, typename It>
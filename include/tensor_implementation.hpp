@@ -560,6 +560,10 @@ public:
         return std::make_shared<tensor_implementation>(core_);
     }
 
+    const core_type& core()const{
+        return core_;
+    }
+
     //meta-data interface
     const auto& descriptor()const{
         return core_.descriptor();
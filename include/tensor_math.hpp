@@ -8,11 +8,15 @@
 
 #ifndef TENSOR_MATH_HPP_
 #define TENSOR_MATH_HPP_
+#include <array>
+#include <vector>
+#include <string>
 #include <functional>
 #include <algorithm>
 #include <numeric>
 #include "allocation.hpp"
-#include "avx_helper.hpp"
+#include "matmul_kernel.hpp"
+#include "expression_template_engine/expression_template_simd.hpp"
 #include "tensor_operators.hpp"
 #include "reduce.hpp"
 #include "reduce_operations.hpp"
@@ -60,6 +64,93 @@ constexpr std::size_t nearest_multiple(std::size_t n){
 template<typename> inline constexpr bool is_complex_of_arithmetic_v = false;
 template<typename T> inline constexpr bool is_complex_of_arithmetic_v<std::complex<T>> = std::is_arithmetic_v<T>;
 
+//einsum subscripts, labels of operands and output are letters
+struct einsum_subscripts
+{
+    std::vector<std::string> inputs;
+    std::string output;
+};
+
+inline bool is_einsum_label(char c){
+    return (c>='a' && c<='z') || (c>='A' && c<='Z');
+}
+
+inline bool has_repeated_labels(const std::string& labels){
+    for (std::size_t i=0; i!=labels.size(); ++i){
+        if (labels.find(labels[i],i+1)!=std::string::npos){
+            return true;
+        }
+    }
+    return false;
+}
+
+//parse subscripts like "ij,jk->ik", spaces are ignored
+//if output is not specified it consists of labels that appear once, in alphabetical order
+inline einsum_subscripts parse_einsum_subscripts(const std::string& subscripts, std::size_t n_operands){
+    std::string s{};
+    std::copy_if(subscripts.begin(),subscripts.end(),std::back_inserter(s),[](char c){return c!=' ';});
+    einsum_subscripts res{};
+    const auto arrow = s.find("->");
+    const std::string inputs = s.substr(0,arrow);
+    for (std::size_t first{0};;){
+        const auto last = inputs.find(',',first);
+        res.inputs.push_back(inputs.substr(first,last==std::string::npos ? last : last-first));
+        if (last==std::string::npos){
+            break;
+        }
+        first = last+1;
+    }
+    if (res.inputs.size()!=n_operands){
+        throw value_error("einsum: number of subscripts must be equal to number of operands");
+    }
+    std::string labels{};
+    for (const auto& input : res.inputs){
+        if (!std::all_of(input.begin(),input.end(),is_einsum_label)){
+            throw value_error("einsum: invalid subscripts");
+        }
+        labels+=input;
+    }
+    if (arrow==std::string::npos){
+        std::string sorted_labels{labels};
+        std::sort(sorted_labels.begin(),sorted_labels.end());
+        for (auto it=sorted_labels.begin(); it!=sorted_labels.end();){
+            const auto next = std::upper_bound(it,sorted_labels.end(),*it);
+            if (next-it==1){
+                res.output.push_back(*it);
+            }
+            it = next;
+        }
+    }else{
+        res.output = s.substr(arrow+2);
+        if (!std::all_of(res.output.begin(),res.output.end(),is_einsum_label) || has_repeated_labels(res.output)){
+            throw value_error("einsum: invalid output subscripts");
+        }
+        for (const auto& c : res.output){
+            if (labels.find(c)==std::string::npos){
+                throw value_error("einsum: output label is not in operands subscripts");
+            }
+        }
+    }
+    return res;
+}
+
+//add labels of operand to unique labels and their extents, extents of the same label must be equal
+template<typename ShT>
+void make_einsum_extents(const std::string& input, const ShT& shape, std::string& labels, ShT& extents){
+    if (input.size()!=shape.size()){
+        throw value_error("einsum: number of labels must be equal to operand dimension");
+    }
+    for (std::size_t i=0; i!=input.size(); ++i){
+        const auto pos = labels.find(input[i]);
+        if (pos==std::string::npos){
+            labels.push_back(input[i]);
+            extents.push_back(shape[i]);
+        }else if (extents[pos]!=shape[i]){
+            throw value_error("einsum: operands shapes not compatible");
+        }
+    }
+}
+
 }   //end of namespace detail
 
 //tensor math implementation
@@ -243,7 +334,7 @@ struct tensor_math
 
     //sum elements along given axes
     //axes may be scalar or container
-    GTENSOR_TENSOR_MATH_REDUCE_INITIAL_FUNCTION(sum,math_reduce_operations::nan_propagate_operation<std::plus<void>>,math_reduce_operations::sum,detail::tensor_copy_value_type_t<basic_tensor<Ts...>>(0));
+    GTENSOR_TENSOR_MATH_REDUCE_INITIAL_FUNCTION(sum,math_reduce_operations::sum_operation<typename basic_tensor<Ts...>::config_type::sum_mode>,math_reduce_operations::sum<typename basic_tensor<Ts...>::config_type::sum_mode>,detail::tensor_copy_value_type_t<basic_tensor<Ts...>>(0));
 
     //multiply elements along given axes
     //axes may be scalar or container
@@ -251,7 +342,7 @@ struct tensor_math
 
     //cumulative sum along given axis
     //axis is scalar
-    GTENSOR_TENSOR_MATH_CUMULATE_FUNCTION(cumsum,math_reduce_operations::cumsum);
+    GTENSOR_TENSOR_MATH_CUMULATE_FUNCTION(cumsum,math_reduce_operations::cumsum<typename basic_tensor<Ts...>::config_type::sum_mode>);
 
     //cumulative product along given axis
     //axis is scalar
@@ -268,7 +359,7 @@ struct tensor_math
 
     //sum elements along given axes, treating nan as zero
     //axes may be scalar or container
-    GTENSOR_TENSOR_MATH_REDUCE_INITIAL_FUNCTION(nansum,math_reduce_operations::nan_ignoring_operation<std::plus<void>>,math_reduce_operations::nansum,detail::tensor_copy_value_type_t<basic_tensor<Ts...>>(0));
+    GTENSOR_TENSOR_MATH_REDUCE_INITIAL_FUNCTION(nansum,math_reduce_operations::nansum_operation<typename basic_tensor<Ts...>::config_type::sum_mode>,math_reduce_operations::nansum<typename basic_tensor<Ts...>::config_type::sum_mode>,detail::tensor_copy_value_type_t<basic_tensor<Ts...>>(0));
 
     //multiply elements along given axes, treating nan as one
     //axes may be scalar or container
@@ -276,7 +367,7 @@ struct tensor_math
 
     //cumulative sum along given axis, treating nan as zero
     //axis is scalar
-    GTENSOR_TENSOR_MATH_CUMULATE_FUNCTION(nancumsum,math_reduce_operations::nancumsum);
+    GTENSOR_TENSOR_MATH_CUMULATE_FUNCTION(nancumsum,math_reduce_operations::nancumsum<typename basic_tensor<Ts...>::config_type::sum_mode>);
 
     //cumulative product along given axis, treating nan as one
     //axis is scalar
@@ -351,9 +442,13 @@ struct tensor_math
         const auto dim2 = detail::make_dim(shape2);
         if (dim1==1){
             if (dim2==1){   //(n,) x (n,)
-                auto a1 = t1.traverse_order_adapter(order1{});
-                auto a2 = t2.traverse_order_adapter(order2{});
-                return res_type(multithreading::inner_product(policy,a1.begin(),a1.end(),a2.begin(),res_value_type{0}));
+                if constexpr (detail::is_simd_storage_tensor<tensor_type1>::value && detail::is_simd_storage_tensor<tensor_type2>::value){
+                    return res_type(dot_helper<res_value_type>(policy,t1.data(),t2.data(),t1.size()));
+                }else{
+                    auto a1 = t1.traverse_order_adapter(order1{});
+                    auto a2 = t2.traverse_order_adapter(order2{});
+                    return res_type(multithreading::inner_product(policy,a1.begin(),a1.end(),a2.begin(),res_value_type{0}));
+                }
             }else{  //(n,) x (...,n,m)
                 return matmul_1d_helper<res_type>(policy,t1,t2,true);
             }
@@ -370,6 +465,144 @@ struct tensor_math
     static auto matmul(const basic_tensor<Ts...>& t1, const basic_tensor<Us...>& t2){
         return matmul(multithreading::exec_pol<1>{},t1,t2);
     }
+
+    //tensordot
+    //axes are containers of the same size or scalars
+    template<typename Policy, typename...Ts, typename...Us, typename Axes1, typename Axes2>
+    static auto tensordot(Policy policy, const basic_tensor<Ts...>& t1, const basic_tensor<Us...>& t2, const Axes1& axes1, const Axes2& axes2){
+        using config_type = typename basic_tensor<Ts...>::config_type;
+        using dim_type = typename config_type::dim_type;
+        using axes_type = typename config_type::template shape<dim_type>;
+        auto make_axes = [](const auto& dim, const auto& axes){
+            if constexpr (detail::is_container_v<std::remove_cv_t<std::remove_reference_t<decltype(axes)>>>){
+                return detail::make_axes<config_type>(dim,axes);
+            }else{
+                return axes_type{detail::make_axes<config_type>(dim,axes)};
+            }
+        };
+        const auto axes1_ = make_axes(t1.dim(),axes1);
+        const auto axes2_ = make_axes(t2.dim(),axes2);
+        check_tensordot_args(t1.shape(),t2.shape(),axes1_,axes2_);
+        return tensordot_helper(policy,t1,t2,axes1_,axes2_);
+    }
+    //last n axes of t1 are contracted with first n axes of t2
+    template<typename Policy, typename...Ts, typename...Us, typename DimT>
+    static auto tensordot(Policy policy, const basic_tensor<Ts...>& t1, const basic_tensor<Us...>& t2, const DimT& n){
+        using config_type = typename basic_tensor<Ts...>::config_type;
+        using dim_type = typename config_type::dim_type;
+        using axes_type = typename config_type::template shape<dim_type>;
+        const auto n_ = static_cast<dim_type>(n);
+        const auto dim1 = t1.dim();
+        if (n_<dim_type{0} || n_>dim1 || n_>t2.dim()){
+            throw value_error("tensordot: invalid number of axes");
+        }
+        axes_type axes1(n_);
+        axes_type axes2(n_);
+        std::iota(axes1.begin(),axes1.end(),dim1-n_);
+        std::iota(axes2.begin(),axes2.end(),dim_type{0});
+        return tensordot(policy,t1,t2,axes1,axes2);
+    }
+    template<typename...Ts, typename...Us, typename Axes1, typename Axes2>
+    static auto tensordot(const basic_tensor<Ts...>& t1, const basic_tensor<Us...>& t2, const Axes1& axes1, const Axes2& axes2){
+        return tensordot(multithreading::exec_pol<1>{},t1,t2,axes1,axes2);
+    }
+    template<typename...Ts, typename...Us, typename DimT>
+    static auto tensordot(const basic_tensor<Ts...>& t1, const basic_tensor<Us...>& t2, const DimT& n){
+        return tensordot(multithreading::exec_pol<1>{},t1,t2,n);
+    }
+
+    //einsum
+    //contraction that is matrix product, possibly batched, uses matmul, other patterns use fused product and sum
+    template<typename Policy, typename...Ts, typename...Us>
+    static auto einsum(Policy policy, const std::string& subscripts, const basic_tensor<Ts...>& t1, const basic_tensor<Us...>& t2){
+        using tensor_type1 = basic_tensor<Ts...>;
+        using tensor_type2 = basic_tensor<Us...>;
+        using value_type1 = typename tensor_type1::value_type;
+        using value_type2 = typename tensor_type2::value_type;
+        using order1 = typename tensor_type1::order;
+        using order2 = typename tensor_type2::order;
+        using res_order = std::conditional_t<std::is_same_v<order1,order2>,order1,gtensor::config::c_order>;
+        using config_type = typename tensor_type1::config_type;
+        using common_value_type = std::decay_t<decltype(std::declval<value_type1>()*std::declval<value_type2>())>;
+        using res_type = detail::tensor_copy_type_t<common_value_type,res_order,config_type>;
+        using shape_type = typename res_type::shape_type;
+        using dim_type = typename config_type::dim_type;
+        using axes_type = typename config_type::template shape<dim_type>;
+
+        const auto subs = detail::parse_einsum_subscripts(subscripts,2);
+        const auto& input1 = subs.inputs[0];
+        const auto& input2 = subs.inputs[1];
+        const auto& output = subs.output;
+        std::string labels{};
+        shape_type extents{};
+        detail::make_einsum_extents(input1,t1.shape(),labels,extents);
+        detail::make_einsum_extents(input2,t2.shape(),labels,extents);
+
+        //batch labels are in both operands and output, contracted labels are in both operands only
+        //free labels are in single operand and output, summed labels are in single operand only
+        std::string batch{};
+        std::string contracted{};
+        std::string free1{};
+        std::string free2{};
+        bool has_summed{false};
+        for (const auto& c : labels){
+            const bool in1 = input1.find(c)!=std::string::npos;
+            const bool in2 = input2.find(c)!=std::string::npos;
+            const bool in_output = output.find(c)!=std::string::npos;
+            if (in1 && in2){
+                (in_output ? batch : contracted).push_back(c);
+            }else if (in_output){
+                (in1 ? free1 : free2).push_back(c);
+            }else{
+                has_summed = true;
+            }
+        }
+        auto axes_of = [](const std::string& input, const std::string& labels_){
+            axes_type res{};
+            for (const auto& c : labels_){
+                res.push_back(static_cast<dim_type>(input.find(c)));
+            }
+            return res;
+        };
+        if (!detail::has_repeated_labels(input1) && !detail::has_repeated_labels(input2) && !has_summed){
+            if (batch.empty()){ //tensordot, result labels are free labels of t1 followed by free labels of t2
+                auto res = tensordot_helper(policy,t1,t2,axes_of(input1,contracted),axes_of(input2,contracted));
+                return einsum_permute(policy,std::move(res),free1+free2,output);
+            }
+            if (contracted.size()==1 && free1.size()==1 && free2.size()==1){   //batch of matrix products, operands are strided views
+                auto res = matmul(policy,t1.transpose(axes_of(input1,batch+free1+contracted)),t2.transpose(axes_of(input2,batch+contracted+free2)));
+                return einsum_permute(policy,std::move(res),batch+free1+free2,output);
+            }
+        }
+        return einsum_fused<res_type>(policy,output,labels,extents,std::array<std::string,2>{input1,input2},t1,t2);
+    }
+    template<typename Policy, typename...Ts>
+    static auto einsum(Policy policy, const std::string& subscripts, const basic_tensor<Ts...>& t){
+        using tensor_type = basic_tensor<Ts...>;
+        using order = typename tensor_type::order;
+        using config_type = typename tensor_type::config_type;
+        using value_type = detail::copy_type_t<typename tensor_type::value_type>;
+        using res_type = detail::tensor_copy_type_t<value_type,order,config_type>;
+        using shape_type = typename res_type::shape_type;
+
+        const auto subs = detail::parse_einsum_subscripts(subscripts,1);
+        const auto& input = subs.inputs[0];
+        std::string labels{};
+        shape_type extents{};
+        detail::make_einsum_extents(input,t.shape(),labels,extents);
+        if (input.size()==subs.output.size()){  //permutation
+            return einsum_permute(policy,t,input,subs.output);
+        }
+        return einsum_fused<res_type>(policy,subs.output,labels,extents,std::array<std::string,1>{input},t);
+    }
+    template<typename...Ts, typename...Us>
+    static auto einsum(const std::string& subscripts, const basic_tensor<Ts...>& t1, const basic_tensor<Us...>& t2){
+        return einsum(multithreading::exec_pol<1>{},subscripts,t1,t2);
+    }
+    template<typename...Ts>
+    static auto einsum(const std::string& subscripts, const basic_tensor<Ts...>& t){
+        return einsum(multithreading::exec_pol<1>{},subscripts,t);
+    }
 private:
 
     template<typename ShT>
@@ -386,8 +619,87 @@ private:
         }
     }
 
+    //dot product of dense vectors, chunks of vectors are multiplied by parallel tasks according to policy
+    template<typename T, typename Policy, typename T1, typename T2, typename IdxT>
+    static T dot_helper(Policy policy, const T1* a, const T2* x, const IdxT& n){
+        //min elements per parallel task
+        static constexpr std::size_t min_task_size = 4096;
+        T res{0};
+        detail::gemv_dispatch<T,T1,T2>([&](auto kernel){
+            using kernel_type = decltype(kernel);
+            const auto n_ = static_cast<std::size_t>(n);
+            if constexpr (multithreading::exec_policy_traits<Policy>::is_seq::value){
+                detail::unused_args{policy};
+                res = kernel_type::dot(a,x,n_);
+            }else{  //parallelize
+                const auto par_sizes = multithreading::make_par_task_size(policy,n_,min_task_size);
+                if (par_sizes.size()<2){
+                    res = kernel_type::dot(a,x,n_);
+                }else{
+                    std::vector<T> partial(par_sizes.size(),T{0});
+                    auto body = [&partial,a,x](std::size_t i, std::size_t first, std::size_t last){
+                        partial[i] = kernel_type::dot(a+first,x+first,last-first);
+                    };
+                    multithreading::task_group group{};
+                    std::size_t first{0};
+                    for (std::size_t i{0}; i!=par_sizes.size(); ++i){
+                        const std::size_t last = first+par_sizes[i];
+                        multithreading::get_pool().push_group(group,body,i,first,last);
+                        first = last;
+                    }
+                    group.wait();
+                    for (const auto& e : partial){
+                        res = res+e;
+                    }
+                }
+            }
+        });
+        return res;
+    }
+
+    //product of batch of dense matrices and dense vector, each matrix is m rows of n elements
+    //dot form: result of matrix is m elements, r-th is dot product of r-th row and x
+    //axpy form: result of matrix is n elements, sum of rows scaled by elements of x
+    //rows of dot form or columns of axpy form are split between parallel tasks according to policy
+    template<typename Policy, typename T, typename T1, typename T2, typename IdxT>
+    static void gemv_helper(Policy policy, T* res, const T1* a, const T2* x, const IdxT& batch_size, const IdxT& m, const IdxT& n, const bool dot_form){
+        detail::gemv_dispatch<T,T1,T2>([&](auto kernel){
+            using kernel_type = decltype(kernel);
+            const auto m_ = static_cast<std::size_t>(m);
+            const auto n_ = static_cast<std::size_t>(n);
+            const std::size_t res_size = dot_form ? m_ : n_;
+            auto body = [dot_form,m_,n_](T* res_, const T1* a_, const T2* x_, std::size_t first, std::size_t last){
+                if (dot_form){
+                    kernel_type::gemv_dot(res_+first,a_+first*n_,n_,x_,last-first,n_);
+                }else{
+                    kernel_type::gemv_axpy(res_+first,a_+first,n_,x_,m_,last-first);
+                }
+            };
+            for (IdxT i=0; i!=batch_size; ++i,res+=res_size,a+=m_*n_){
+                if constexpr (multithreading::exec_policy_traits<Policy>::is_seq::value){
+                    detail::unused_args{policy};
+                    body(res,a,x,0,res_size);
+                }else{  //parallelize
+                    const auto par_sizes = multithreading::make_par_task_size(policy,res_size);
+                    if (par_sizes.size()<2){
+                        body(res,a,x,0,res_size);
+                    }else{
+                        multithreading::task_group group{};
+                        std::size_t first{0};
+                        for (std::size_t j{0}; j!=par_sizes.size(); ++j){
+                            const std::size_t last = first+par_sizes[j];
+                            multithreading::get_pool().push_group(group,body,res,a,x,first,last);
+                            first = last;
+                        }
+                        group.wait();
+                    }
+                }
+            }
+        });
+    }
+
     template<typename ResT, typename Policy, typename...Ts, typename...Us>
-    static auto matmul_1d_helper(Policy, const basic_tensor<Ts...>& t_1d, const basic_tensor<Us...>& t_nd, const bool is_1d_left){
+    static auto matmul_1d_helper(Policy policy, const basic_tensor<Ts...>& t_1d, const basic_tensor<Us...>& t_nd, const bool is_1d_left){
         using res_type = ResT;
         using order = typename ResT::order;
         using config_type = typename ResT::config_type;
@@ -413,7 +725,28 @@ private:
         const auto k = t_nd_shape[i_axis];
         const auto n = t_nd_shape[j_axis];
 
-        auto matmul_outer = [res_axis](auto& res_tr, auto& nd_tr, auto& w_1d, const auto& inner_axis, const auto& outer_axis, const auto& inner_size, const auto& outer_size)
+        //result is zeros or empty
+        if (k==0 || n==0){
+            return res;
+        }
+        //dense operands, vectorized kernels, matrices of f_order operand are dense only if it is 2d
+        if constexpr (detail::is_simd_storage_tensor<basic_tensor<Ts...>>::value && detail::is_simd_storage_tensor<basic_tensor<Us...>>::value &&
+            detail::has_pointer_data_v<typename config_type::template storage<typename res_type::value_type>>)
+        {
+            static constexpr bool is_c_order = std::is_same_v<order_nd,gtensor::config::c_order>;
+            if (is_c_order || t_nd_dim==2){
+                const auto batch_size = t_nd.size()/(k*n);
+                const auto dot_form = is_1d_left != is_c_order;
+                if constexpr (is_c_order){
+                    gemv_helper(policy,res.data(),t_nd.data(),t_1d.data(),batch_size,k,n,dot_form);
+                }else{
+                    gemv_helper(policy,res.data(),t_nd.data(),t_1d.data(),batch_size,n,k,dot_form);
+                }
+                return res;
+            }
+        }
+
+        auto matmul_outer = [&policy,res_axis](auto& res_tr, auto& nd_tr, auto& w_1d, const auto& inner_axis, const auto& outer_axis, const auto& inner_size, const auto& outer_size)
         {
             auto body = [res_axis,inner_axis,outer_axis,outer_size](auto w_res, auto w_nd, auto w_1d, auto inner_size){
                 for (auto i=outer_size;;--i){
@@ -437,25 +770,28 @@ private:
                 auto w_nd = nd_tr.walker();
                 auto w_res = res_tr.walker();
                 if constexpr (multithreading::exec_policy_traits<Policy>::is_seq::value){
+                    detail::unused_args{policy};
                     body(w_res,w_nd,w_1d,inner_size);
                 }else{  //parallelize
-                    constexpr std::size_t max_par_tasks = multithreading::exec_policy_traits<Policy>::par_tasks::value;
-                    constexpr std::size_t min_tasks_per_par_task = 1;
-                    multithreading::par_task_size<index_type> par_sizes{inner_size,max_par_tasks,min_tasks_per_par_task};
-                    multithreading::task_group group{};
-                    for (std::size_t i{0}; i!=par_sizes.size(); ++i){
-                        const auto par_task_size = par_sizes[i];
-                        multithreading::get_pool().push_group(group, body, w_res, w_nd, w_1d, par_task_size);
-                        w_res.walk(res_axis,par_task_size);
-                        w_nd.walk(inner_axis,par_task_size);
+                    const auto par_sizes = multithreading::make_par_task_size(policy,static_cast<index_type>(inner_size));
+                    if (par_sizes.size()<2){
+                        body(w_res,w_nd,w_1d,inner_size);
+                    }else{
+                        multithreading::task_group group{};
+                        for (std::size_t i{0}; i!=par_sizes.size(); ++i){
+                            const auto par_task_size = par_sizes[i];
+                            multithreading::get_pool().push_group(group, body, w_res, w_nd, w_1d, par_task_size);
+                            w_res.walk(res_axis,par_task_size);
+                            w_nd.walk(inner_axis,par_task_size);
+                        }
+                        group.wait();
                     }
-                    group.wait();
                 }
                 nd_tr.template next<order>();
             }while(res_tr.template next<order>());
         };
 
-        auto matmul_dot = [res_axis](auto& res_tr, auto& nd_tr, auto& w_1d, const auto& inner_axis, const auto& outer_axis, const auto& inner_size, const auto& outer_size)
+        auto matmul_dot = [&policy,res_axis](auto& res_tr, auto& nd_tr, auto& w_1d, const auto& inner_axis, const auto& outer_axis, const auto& inner_size, const auto& outer_size)
         {
             auto body = [res_axis,inner_axis,outer_axis,inner_size](auto w_res, auto w_nd, auto w_1d, auto outer_size){
                 for (auto i=outer_size;; --i){
@@ -478,19 +814,22 @@ private:
                 auto w_nd = nd_tr.walker();
                 auto w_res = res_tr.walker();
                 if constexpr (multithreading::exec_policy_traits<Policy>::is_seq::value){
+                    detail::unused_args{policy};
                     body(w_res,w_nd,w_1d,outer_size);
                 }else{  //parallelize
-                    constexpr std::size_t max_par_tasks = multithreading::exec_policy_traits<Policy>::par_tasks::value;
-                    constexpr std::size_t min_tasks_per_par_task = 1;
-                    multithreading::par_task_size<index_type> par_sizes{outer_size,max_par_tasks,min_tasks_per_par_task};
-                    multithreading::task_group group{};
-                    for (std::size_t i{0}; i!=par_sizes.size(); ++i){
-                        const auto par_task_size = par_sizes[i];
-                        multithreading::get_pool().push_group(group, body, w_res, w_nd, w_1d, par_task_size);
-                        w_res.walk(res_axis,par_task_size);
-                        w_nd.walk(outer_axis,par_task_size);
+                    const auto par_sizes = multithreading::make_par_task_size(policy,static_cast<index_type>(outer_size));
+                    if (par_sizes.size()<2){
+                        body(w_res,w_nd,w_1d,outer_size);
+                    }else{
+                        multithreading::task_group group{};
+                        for (std::size_t i{0}; i!=par_sizes.size(); ++i){
+                            const auto par_task_size = par_sizes[i];
+                            multithreading::get_pool().push_group(group, body, w_res, w_nd, w_1d, par_task_size);
+                            w_res.walk(res_axis,par_task_size);
+                            w_nd.walk(outer_axis,par_task_size);
+                        }
+                        group.wait();
                     }
-                    group.wait();
                 }
                 nd_tr.template next<order>();
             }while(res_tr.template next<order>());
@@ -523,25 +862,68 @@ private:
 
         static constexpr bool use_common_type = std::is_arithmetic_v<T> && std::is_arithmetic_v<T1> && std::is_arithmetic_v<T2> ||
             detail::is_complex_of_arithmetic_v<T> && detail::is_complex_of_arithmetic_v<T1> && detail::is_complex_of_arithmetic_v<T2>;
-        using value_type1 = std::conditional_t<use_common_type,T,T1>;
-        using value_type2 = std::conditional_t<use_common_type,T,T2>;
+        //int8, int16 operands of int32 result are packed as int16, not converted to result type
+        static constexpr bool use_int_kernel = detail::is_matmul_int_v<T,T1,T2>;
+        using int_packed_type = detail::matmul_int_packed_t<T1,T2>;
+        using value_type1 = std::conditional_t<use_int_kernel,int_packed_type,std::conditional_t<use_common_type,T,T1>>;
+        using value_type2 = std::conditional_t<use_int_kernel,int_packed_type,std::conditional_t<use_common_type,T,T2>>;
         using res_value_type = T;
 
-        static constexpr bool is_buffer_on_stack = false;
-        static constexpr std::size_t alignment = 32;
-        static constexpr std::size_t L1_size = 32768;
-        static constexpr std::size_t L2_size = 262144;
+        //kernels, vectorized kernels are compiled for extended instruction sets and selected at runtime
+        static constexpr bool has_float_kernel = std::is_same_v<res_value_type,value_type1> && std::is_same_v<res_value_type,value_type2> &&
+            detail::is_matmul_simd_type_v<res_value_type>;
+        static constexpr bool has_simd_kernel = (has_float_kernel || use_int_kernel) && detail::compile_isa()>=isa::avx2;
+        using generic_kernel = detail::matmul_kernel_generic<res_value_type,value_type1,value_type2>;
+        template<template<typename> typename FloatKernel, template<typename> typename IntKernel>
+        using simd_kernel = std::conditional_t<has_simd_kernel,
+            std::conditional_t<use_int_kernel,IntKernel<int_packed_type>,FloatKernel<res_value_type>>,
+            generic_kernel
+        >;
+        using avx2_kernel = simd_kernel<detail::matmul_kernel_avx2,detail::matmul_kernel_int_avx2>;
+        using avx512_kernel = simd_kernel<detail::matmul_kernel_avx512,detail::matmul_kernel_int_avx512>;
+
+        //cache blocking of kernel
+        //Mr x Kc panel of a and Kc x Nr panel of b fit L1, Mc x Kc block of a fits half of L2, Kc x Nc block of b fits half of L3, that is shared
+        struct blocking
+        {
+            std::size_t mr;
+            std::size_t nr;
+            std::size_t kc;
+            std::size_t mc;
+            std::size_t nc;
+        };
+
+        template<typename Kernel>
+        static blocking make_blocking(const cache_sizes& caches){
+            const std::size_t mr = Kernel::Mr;
+            const std::size_t nr = Kernel::Nr;
+            const std::size_t kr = Kernel::Kr;
+            const std::size_t kc = std::max(std::size_t{1},caches.l1d/(mr*sizeof(value_type1) + nr*sizeof(value_type2))/kr)*kr;
+            const std::size_t mc = std::max(std::size_t{1},caches.l2/(2*kc*sizeof(value_type1)*mr))*mr;
+            const std::size_t nc = std::max(std::size_t{1},caches.l3/(2*kc*sizeof(value_type2)*nr))*nr;
+            return blocking{mr,nr,kc,mc,nc};
+        }
+
+        static blocking make_blocking(const isa& isa__){
+            const auto caches = kernel_cache_sizes();
+            switch (isa__){
+                case isa::avx512:
+                    return make_blocking<avx512_kernel>(caches);
+                case isa::avx2:
+                    return make_blocking<avx2_kernel>(caches);
+                default:
+                    return make_blocking<generic_kernel>(caches);
+            }
+        }
 
-        static constexpr std::size_t Nr = 6;
-        static constexpr std::size_t Mr = 2*alignment/sizeof(value_type1);
-        static constexpr std::size_t Kc = L1_size/(Mr*sizeof(value_type1) + Nr*sizeof(value_type2));
-        static constexpr std::size_t Mc = L2_size/(Kc*sizeof(value_type1));
-        static constexpr std::size_t Nc = Mc;
-        //static_assert(Mr*sizeof(value_type1)%alignment==0);
+        //packing buffers are allocated from scratch arena of thread that uses them, so they are reused across calls
+        template<typename U, std::size_t Alignment> using buffer_type = gtensor::basic_storage<U,allocation::scratch_allocator<U,Alignment>>;
 
         const index_type k;
         const dim_type i_axis;
         const dim_type j_axis;
+        const isa isa_;
+        const blocking blocking_;
 
         ALWAYS_INLINE auto adjust_block_size(const index_type& idx, const index_type& block_size, const index_type& max){
             return idx+block_size>max ? max-idx : block_size;
@@ -576,6 +958,48 @@ private:
             w.walk_back(inner_axis,inner_size);
         }
 
+        //fill buffer with panels interleaved along outer axis by Kr, outer size is padded with zeros
+        template<std::size_t Kr, typename W, typename U, typename DimT>
+        ALWAYS_INLINE void fill_buf_interleaved(W& w, U* dst, const DimT& inner_axis, const DimT& outer_axis, const index_type& inner_size, const index_type& outer_size, const index_type& block_size){
+            const auto kr = static_cast<index_type>(Kr);
+            for (index_type ii=0; ii<inner_size; ii+=block_size){
+                const auto block_size_ = adjust_block_size(ii,block_size,inner_size);
+                for (index_type kk=0; kk<outer_size; kk+=kr){
+                    const auto kr_ = adjust_block_size(kk,kr,outer_size);
+                    for (auto i=block_size_; i!=0; --i,w.step(inner_axis)){
+                        for (auto r=kr_; r!=0; --r,++dst,w.step(outer_axis)){
+                            *dst = static_cast<U>(*w);
+                        }
+                        for (auto r=kr_; r!=kr; ++r,++dst){
+                            *dst = U{0};
+                        }
+                        w.walk_back(outer_axis,kr_);
+                    }
+                    w.walk_back(inner_axis,block_size_);
+                    w.walk(outer_axis,kr_);
+                }
+                w.walk_back(outer_axis,outer_size);
+                w.walk(inner_axis,block_size_);
+            }
+            w.walk_back(inner_axis,inner_size);
+        }
+
+        template<typename Kernel, typename W, typename U, typename DimT>
+        ALWAYS_INLINE void pack(W& w, U* dst, const DimT& inner_axis, const DimT& outer_axis, const index_type& inner_size, const index_type& outer_size, const index_type& block_size){
+            if constexpr (Kernel::Kr==1){
+                fill_buf(w,dst,inner_axis,outer_axis,inner_size,outer_size,block_size);
+            }else{
+                fill_buf_interleaved<Kernel::Kr>(w,dst,inner_axis,outer_axis,inner_size,outer_size,block_size);
+            }
+        }
+
+        //size of k dimension of packed panels
+        template<typename Kernel, typename U>
+        ALWAYS_INLINE static U pad_k(const U& kc_){
+            const auto kr = static_cast<U>(Kernel::Kr);
+            return (kc_+kr-1)/kr*kr;
+        }
+
         template<typename ResW>
         ALWAYS_INLINE void fill_res_helper(const res_value_type* const buf, ResW& res_w){
             *res_w = *res_w + *buf;
@@ -586,7 +1010,7 @@ private:
             (fill_res_helper(buf+I,res_w),...);
         }
 
-        template<typename ResW>
+        template<std::size_t Mr, typename ResW>
         ALWAYS_INLINE void fill_res(const res_value_type* buf, ResW& res_w, const index_type& mr_, const index_type& nr_){
             static constexpr std::size_t unroll_factor = 4;
             if (mr_==static_cast<index_type>(Mr)){
@@ -619,341 +1043,242 @@ private:
             }
         }
 
-        template<typename T_, typename T1_, typename T2_>
-        ALWAYS_INLINE void micro_kernel(T_* res_buf, const T1_* const a_buf, const T2_* b_buf, const std::size_t& mr_, const std::size_t& nr_, const std::size_t& kc_){
-            micro_kernel_generic_unrolled(res_buf,a_buf,b_buf,mr_,nr_,kc_);
-        }
-
-        template<typename U=T, std::enable_if_t<std::is_same_v<U,U> && HAS_AVX && sizeof(double)==8, int> =0>
-        ALWAYS_INLINE void micro_kernel(double* res_buf, const double* const a_buf, const double* b_buf, const std::size_t& mr_, const std::size_t& nr_, const std::size_t& kc_){
-            micro_kernel_sd(res_buf,a_buf,b_buf,mr_,nr_,kc_);
-        }
-
-        template<typename U=T, std::enable_if_t<std::is_same_v<U,U> && HAS_AVX && sizeof(float)==4, int> =0>
-        ALWAYS_INLINE void micro_kernel(float* res_buf, const float* const a_buf, const float* b_buf, const std::size_t& mr_, const std::size_t& nr_, const std::size_t& kc_){
-            micro_kernel_sd(res_buf,a_buf,b_buf,mr_,nr_,kc_);
-        }
-
-        template<typename U=T, std::enable_if_t<std::is_same_v<U,U> && HAS_AVX && sizeof(double)==8, int> =0>
-        ALWAYS_INLINE void micro_kernel(std::complex<double>* res_buf, const std::complex<double>* const a_buf, const std::complex<double>* b_buf, const std::size_t& mr_, const std::size_t& nr_, const std::size_t& kc_){
-            micro_kernel_sd(res_buf,a_buf,b_buf,mr_,nr_,kc_);
-        }
-
-        template<typename U=T, std::enable_if_t<std::is_same_v<U,U> && HAS_AVX && sizeof(float)==4, int> =0>
-        ALWAYS_INLINE void micro_kernel(std::complex<float>* res_buf, const std::complex<float>* const a_buf, const std::complex<float>* b_buf, const std::size_t& mr_, const std::size_t& nr_, const std::size_t& kc_){
-            micro_kernel_sd(res_buf,a_buf,b_buf,mr_,nr_,kc_);
-        }
-
-        template<typename ResW, typename T_, typename T1_, typename T2_>
-        ALWAYS_INLINE void macro_kernel(ResW& res_w, T_* res_buf, const T1_* const a_buf, const T2_* b_buf, const std::size_t& mc_, const std::size_t& nc_, const std::size_t& kc_){
-            const std::size_t mr{Mr};
-            const std::size_t nr{Nr};
+        template<typename Kernel, typename ResW>
+        ALWAYS_INLINE void macro_kernel(ResW& res_w, res_value_type* res_buf, const value_type1* const a_buf, const value_type2* b_buf, const std::size_t& mc_, const std::size_t& nc_, const std::size_t& kc_){
+            const std::size_t mr{Kernel::Mr};
+            const std::size_t nr{Kernel::Nr};
+            const auto kc_padded = pad_k<Kernel>(kc_);
             for (std::size_t i=0; i<nc_; i+=nr){
                 const auto nr_ = adjust_block_size(i,nr,nc_);
                 auto a_buf_ = a_buf;
                 for (std::size_t j=0; j<mc_; j+=mr){
                     const auto mr_ = adjust_block_size(j,mr,mc_);
-                    micro_kernel(res_buf,a_buf_,b_buf,mr_,nr_,kc_);
-                    fill_res(res_buf,res_w,mr_,nr_);
-                    a_buf_+=mr_*kc_;
+                    Kernel::micro_kernel(res_buf,a_buf_,b_buf,mr_,nr_,kc_padded);
+                    fill_res<Kernel::Mr>(res_buf,res_w,mr_,nr_);
+                    a_buf_+=mr_*kc_padded;
                     res_w.walk(i_axis,mr_);
                 }
-                b_buf+=kc_*nr_;
+                b_buf+=kc_padded*nr_;
                 res_w.walk(j_axis,nr_);
                 res_w.walk_back(i_axis,mc_);
             }
             res_w.walk_back(j_axis,nc_);
         }
 
-        //generic kernel
-        template<typename T_, typename T1_, typename T2_>
-        ALWAYS_INLINE void micro_kernel_generic(T_* res_buf, const T1_* const a_buf, const T2_* b_buf, const std::size_t& mr_, const std::size_t& nr_, const std::size_t& kc_){
-            auto res_buf_ = res_buf;
-            for (const auto b_last=b_buf+nr_; b_buf!=b_last; ++b_buf){
-                const auto& b_e = *b_buf;
-                for (std::size_t ir=0; ir!=mr_; ++ir,++res_buf_){
-                    *res_buf_=a_buf[ir]*b_e;
-                }
-            }
-            for (std::size_t kk=1; kk!=kc_; ++kk){
-                const auto a_buf_ = a_buf+kk*mr_;
-                res_buf_ = res_buf;
-                for (const auto b_last=b_buf+nr_; b_buf!=b_last; ++b_buf){
-                    const auto& b_e = *b_buf;
-                    for (std::size_t ir=0; ir!=mr_; ++ir,++res_buf_){
-                        *res_buf_=*res_buf_+a_buf_[ir]*b_e;
+        template<typename Kernel, typename ResW, typename W1, typename W2>
+        ALWAYS_INLINE void run(ResW res_w, W1 w1, W2 w2, const index_type& ic_min, const index_type& ic_max, const index_type& jc_min, const index_type& jc_max, res_value_type* res_buf, value_type1* a_buf, value_type2* b_buf){
+            const auto mc = static_cast<index_type>(blocking_.mc);
+            const auto nc = std::min(static_cast<index_type>(blocking_.nc),jc_max-jc_min);
+            const auto kc = static_cast<index_type>(blocking_.kc);
+            const auto mr = static_cast<index_type>(Kernel::Mr);
+            const auto nr = static_cast<index_type>(Kernel::Nr);
+            res_w.walk(j_axis,jc_min);
+            res_w.walk(i_axis,ic_min);
+            w1.walk(i_axis,ic_min);
+            w2.walk(j_axis,jc_min);
+            for (index_type jc=jc_min; jc<jc_max; jc+=nc){
+                const auto nc_ = adjust_block_size(jc,nc,jc_max);
+                for (index_type pc=0; pc<k; pc+=kc){
+                    const auto kc_ = adjust_block_size(pc,kc,k);
+                    pack<Kernel>(w2,b_buf,j_axis,i_axis,nc_,kc_,nr);
+                    for (index_type ic=ic_min; ic<ic_max; ic+=mc){
+                        const auto mc_ = adjust_block_size(ic,mc,ic_max);
+                        pack<Kernel>(w1,a_buf,i_axis,j_axis,mc_,kc_,mr);
+                        macro_kernel<Kernel>(res_w,res_buf,a_buf,b_buf,static_cast<std::size_t>(mc_),static_cast<std::size_t>(nc_),static_cast<std::size_t>(kc_));
+                        w1.walk(i_axis,mc_);
+                        res_w.walk(i_axis,mc_);
                     }
+                    w1.walk_back(i_axis,ic_max-ic_min);
+                    res_w.walk_back(i_axis,ic_max-ic_min);
+                    w1.walk(j_axis,kc_);
+                    w2.walk(i_axis,kc_);
                 }
+                w1.walk_back(j_axis,k);
+                w2.walk_back(i_axis,k);
+                w2.walk(j_axis,nc_);
+                res_w.walk(j_axis,nc_);
             }
         }
 
-        //generic unrolled kernel helpers
-        template<typename U, typename P, typename V>
-        ALWAYS_INLINE void generic_load_mul_store(U* const res_buf, const P* const a_buf, const V& b_e){
-            *(res_buf) = *(a_buf)*b_e;
-        }
-        template<typename U, typename P, typename V>
-        ALWAYS_INLINE void generic_load_madd_store(U* const res_buf, const P* const a_buf, const V& b_e){
-            *(res_buf) = *(res_buf) + *(a_buf)*b_e;
-        }
-        template<std::size_t...I, typename U, typename P, typename V>
-        ALWAYS_INLINE void generic_load_mul_store_n(std::index_sequence<I...>, U* const res_buf, const P* const a_buf, const V& b_e){
-            (generic_load_mul_store(res_buf+I,a_buf+I,b_e),...);
-        }
-        template<std::size_t...I, typename U, typename P, typename V>
-        ALWAYS_INLINE void generic_load_madd_store_n(std::index_sequence<I...>, U* const res_buf, const P* const a_buf, const V& b_e){
-            (generic_load_madd_store(res_buf+I,a_buf+I,b_e),...);
+        template<typename Kernel, typename ResW, typename W1, typename W2>
+        ALWAYS_INLINE void run(ResW res_w, W1 w1, W2 w2, const index_type& ic_min, const index_type& ic_max, const index_type& jc_min, const index_type& jc_max){
+            static constexpr std::size_t alignment = Kernel::alignment;
+            auto make_buf_size = [](auto i_size, auto j_size, auto t_size){
+                return alignment*(i_size*j_size*t_size/alignment+1);
+            };
+            const auto res_buf_size = make_buf_size(Kernel::Mr,Kernel::Nr,sizeof(res_value_type));
+            const auto a_buf_size = make_buf_size(blocking_.mc,blocking_.kc,sizeof(value_type1));
+            const auto b_buf_size = make_buf_size(blocking_.kc,std::min(blocking_.nc,static_cast<std::size_t>(jc_max-jc_min)),sizeof(value_type2));
+            buffer_type<res_value_type,alignment> res_buf(res_buf_size);
+            buffer_type<value_type1,alignment> a_buf(a_buf_size);
+            buffer_type<value_type2,alignment> b_buf(b_buf_size);
+            run<Kernel>(res_w,w1,w2,ic_min,ic_max,jc_min,jc_max,res_buf.data(),a_buf.data(),b_buf.data());
         }
 
-        //generic unrolled kernel
-        template<typename T_, typename T1_, typename T2_>
-        ALWAYS_INLINE void micro_kernel_generic_unrolled(T_* res_buf, const T1_* const a_buf, const T2_* b_buf, const std::size_t& mr_, const std::size_t& nr_, const std::size_t& kc_){
-            static constexpr std::size_t unroll_factor = 4;
-            if (mr_==Mr){
-                auto res_buf_ = res_buf;
-                for (const auto b_last=b_buf+nr_; b_buf!=b_last; ++b_buf){
-                    const auto& b_e = *b_buf;
-                    generic_load_mul_store_n(std::make_index_sequence<Mr>{},res_buf_,a_buf,b_e);
-                    res_buf_+=Mr;
-                }
-                for (std::size_t kk=1; kk!=kc_; ++kk){
-                    const auto a_buf_ = a_buf+kk*mr_;
-                    res_buf_ = res_buf;
-                    for (const auto b_last=b_buf+nr_; b_buf!=b_last; ++b_buf){
-                        const auto& b_e = *b_buf;
-                        generic_load_madd_store_n(std::make_index_sequence<Mr>{},res_buf_,a_buf_,b_e);
-                        res_buf_+=Mr;
-                    }
+        //shared packing parallel product of m x n result, each task computes rows range of result
+        //for each kc x nc block of b: tasks pack parts of block into shared buffer, wait, then each task packs its own blocks of a and runs macro kernel
+        template<typename Kernel, typename ResW, typename W1, typename W2>
+        void run_par(ResW res_w, W1 w1, W2 w2, const index_type& m, const index_type& n, const std::size_t& n_tasks){
+            static constexpr std::size_t alignment = Kernel::alignment;
+            auto make_buf_size = [](auto i_size, auto j_size, auto t_size){
+                return alignment*(i_size*j_size*t_size/alignment+1);
+            };
+            const auto mc = static_cast<index_type>(blocking_.mc);
+            const auto nc = std::min(static_cast<index_type>(blocking_.nc),n);
+            const auto kc = static_cast<index_type>(blocking_.kc);
+            const auto mr = static_cast<index_type>(Kernel::Mr);
+            const auto nr = static_cast<index_type>(Kernel::Nr);
+            const auto res_buf_size = make_buf_size(Kernel::Mr,Kernel::Nr,sizeof(res_value_type));
+            const auto a_buf_size = make_buf_size(blocking_.mc,blocking_.kc,sizeof(value_type1));
+            const auto b_buf_size = make_buf_size(blocking_.kc,static_cast<std::size_t>(nc),sizeof(value_type2));
+            //b buffer is allocated on calling thread, a and res buffers are allocated by tasks
+            buffer_type<value_type2,alignment> b_buf(b_buf_size);
+            //rows of result are split by Mr
+            multithreading::par_task_size<index_type> i_par_sizes{(m+mr-1)/mr,static_cast<index_type>(n_tasks)};
+
+            auto pack_b = [this,&w2,&b_buf](const index_type& jc, const index_type& pc, const index_type& j_first, const index_type& j_last, const index_type& kc_, const index_type& nr_){
+                auto w = w2;
+                w.walk(j_axis,jc+j_first);
+                w.walk(i_axis,pc);
+                pack<Kernel>(w,b_buf.data()+static_cast<std::size_t>(j_first*pad_k<Kernel>(kc_)),j_axis,i_axis,j_last-j_first,kc_,nr_);
+            };
+            auto multiply = [this,&res_w,&w1,&b_buf,res_buf_size,a_buf_size,mc,mr](const index_type& jc, const index_type& pc, const index_type& i_first, const index_type& i_last, const index_type& kc_, const index_type& nc_){
+                auto w = w1;
+                auto r = res_w;
+                w.walk(i_axis,i_first);
+                w.walk(j_axis,pc);
+                r.walk(i_axis,i_first);
+                r.walk(j_axis,jc);
+                buffer_type<res_value_type,alignment> res_buf(res_buf_size);
+                buffer_type<value_type1,alignment> a_buf(a_buf_size);
+                auto res_buf_ = res_buf.data();
+                auto a_buf_ = a_buf.data();
+                for (index_type ic=i_first; ic<i_last; ic+=mc){
+                    const auto mc_ = adjust_block_size(ic,mc,i_last);
+                    pack<Kernel>(w,a_buf_,i_axis,j_axis,mc_,kc_,mr);
+                    macro_kernel<Kernel>(r,res_buf_,a_buf_,b_buf.data(),static_cast<std::size_t>(mc_),static_cast<std::size_t>(nc_),static_cast<std::size_t>(kc_));
+                    w.walk(i_axis,mc_);
+                    r.walk(i_axis,mc_);
                 }
-            }else if (mr_>unroll_factor-1){
-                auto res_buf_ = res_buf;
-                for (const auto b_last=b_buf+nr_; b_buf!=b_last; ++b_buf){
-                    const auto& b_e = *b_buf;
-                    auto a_buf_=a_buf;
-                    const auto a_last = a_buf_+mr_;
-                    for (const auto a_last_=a_last-(unroll_factor-1); a_buf_<a_last_; a_buf_+=unroll_factor,res_buf_+=unroll_factor){
-                        generic_load_mul_store_n(std::make_index_sequence<unroll_factor>{},res_buf_,a_buf_,b_e);
-                    }
-                    for (;a_buf_!=a_last; ++a_buf_,++res_buf_){
-                        generic_load_mul_store(res_buf_,a_buf_,b_e);
+            };
+
+            multithreading::task_group group{};
+            for (index_type jc=0; jc<n; jc+=nc){
+                const auto nc_ = adjust_block_size(jc,nc,n);
+                //columns of b block are split by Nr
+                multithreading::par_task_size<index_type> j_par_sizes{(nc_+nr-1)/nr,static_cast<index_type>(n_tasks)};
+                for (index_type pc=0; pc<k; pc+=kc){
+                    const auto kc_ = adjust_block_size(pc,kc,k);
+                    index_type j_first{0};
+                    for (std::size_t j=0; j!=j_par_sizes.size(); ++j){
+                        const auto j_last = std::min(j_first+j_par_sizes[j]*nr,nc_);
+                        multithreading::get_pool().push_group(group,pack_b,jc,pc,j_first,j_last,kc_,nr);
+                        j_first = j_last;
                     }
-                }
-                for (std::size_t kk=1; kk!=kc_; ++kk){
-                    const auto a_buf_ = a_buf+kk*mr_;
-                    res_buf_ = res_buf;
-                    for (const auto b_last=b_buf+nr_; b_buf!=b_last; ++b_buf){
-                        const auto& b_e = *b_buf;
-                        auto a_buf__=a_buf_;
-                        const auto a_last = a_buf_+mr_;
-                        for (const auto a_last__=a_last-(unroll_factor-1); a_buf__<a_last__; a_buf__+=unroll_factor,res_buf_+=unroll_factor){
-                            generic_load_madd_store_n(std::make_index_sequence<unroll_factor>{},res_buf_,a_buf__,b_e);
-                        }
-                        for (;a_buf__!=a_last; ++a_buf__,++res_buf_){
-                            generic_load_madd_store(res_buf_,a_buf__,b_e);
-                        }
+                    group.wait();
+                    index_type i_first{0};
+                    for (std::size_t i=0; i!=i_par_sizes.size(); ++i){
+                        const auto i_last = std::min(i_first+i_par_sizes[i]*mr,m);
+                        multithreading::get_pool().push_group(group,multiply,jc,pc,i_first,i_last,kc_,nc_);
+                        i_first = i_last;
                     }
+                    group.wait();
                 }
-            }else{
-                micro_kernel_generic(res_buf,a_buf,b_buf,mr_,nr_,kc_);
-            }
-        }
-
-        //2rx6 floating point, complex kernel
-        template<typename U>
-        ALWAYS_INLINE void avx_micro_kernel_2rx6(U* const res_buf, const U* a_buf, const U* b_buf, const std::size_t& kc_){
-            static_assert(sizeof(U)==4 || sizeof(U)==8 || sizeof(U)==16);
-            static_assert(Nr==6);
-            static_assert(Mr==2*alignment/sizeof(U));
-            static constexpr std::size_t n_packed = alignment/sizeof(U);
-            using inner_value_type = detail::inner_value_type_t<U>;
-            using gtensor::detail::avx_zero;
-            using gtensor::detail::avx_load;
-            using gtensor::detail::avx_store;
-            using gtensor::detail::avx_madd;
-            using gtensor::detail::avx_broadcast;
-            auto y4 = avx_zero<inner_value_type>();
-            auto y5 = avx_zero<inner_value_type>();
-            auto y6 = avx_zero<inner_value_type>();
-            auto y7 = avx_zero<inner_value_type>();
-            auto y8 = avx_zero<inner_value_type>();
-            auto y9 = avx_zero<inner_value_type>();
-            auto y10 = avx_zero<inner_value_type>();
-            auto y11 = avx_zero<inner_value_type>();
-            auto y12 = avx_zero<inner_value_type>();
-            auto y13 = avx_zero<inner_value_type>();
-            auto y14 = avx_zero<inner_value_type>();
-            auto y15 = avx_zero<inner_value_type>();
-            for (const auto a_last=a_buf+kc_*Mr; a_buf!=a_last; a_buf+=Mr,b_buf+=Nr){
-                const auto y0 = avx_load(a_buf);
-                const auto y1 = avx_load(a_buf+n_packed);
-                auto y2 = avx_broadcast(b_buf);
-                auto y3 = avx_broadcast(b_buf+1);
-                y4 = avx_madd<U>(y0,y2,y4);
-                y5 = avx_madd<U>(y1,y2,y5);
-                y6 = avx_madd<U>(y0,y3,y6);
-                y7 = avx_madd<U>(y1,y3,y7);
-                y2 = avx_broadcast(b_buf+2);
-                y3 = avx_broadcast(b_buf+3);
-                y8 = avx_madd<U>(y0,y2,y8);
-                y9 = avx_madd<U>(y1,y2,y9);
-                y10 = avx_madd<U>(y0,y3,y10);
-                y11 = avx_madd<U>(y1,y3,y11);
-                y2 = avx_broadcast(b_buf+4);
-                y3 = avx_broadcast(b_buf+5);
-                y12 = avx_madd<U>(y0,y2,y12);
-                y13 = avx_madd<U>(y1,y2,y13);
-                y14 = avx_madd<U>(y0,y3,y14);
-                y15 = avx_madd<U>(y1,y3,y15);
             }
-            avx_store(res_buf,y4);
-            avx_store(res_buf+1*n_packed,y5);
-            avx_store(res_buf+2*n_packed,y6);
-            avx_store(res_buf+3*n_packed,y7);
-            avx_store(res_buf+4*n_packed,y8);
-            avx_store(res_buf+5*n_packed,y9);
-            avx_store(res_buf+6*n_packed,y10);
-            avx_store(res_buf+7*n_packed,y11);
-            avx_store(res_buf+8*n_packed,y12);
-            avx_store(res_buf+9*n_packed,y13);
-            avx_store(res_buf+10*n_packed,y14);
-            avx_store(res_buf+11*n_packed,y15);
         }
 
-        //floating point, complex kernel
-        template<typename U>
-        ALWAYS_INLINE void micro_kernel_sd(U* res_buf, const U* a_buf, const U* b_buf, const std::size_t& mr_, const std::size_t& nr_, const std::size_t& kc_){
-            static_assert(sizeof(U)==4 || sizeof(U)==8 || sizeof(U)==16);
-            static constexpr std::size_t n_packed = alignment/sizeof(U);
-            using gtensor::detail::avx_broadcast;
-            using gtensor::detail::avx_load;
-            using gtensor::detail::avx_loadu;
-            using gtensor::detail::avx_store;
-            using gtensor::detail::avx_madd;
-            using gtensor::detail::avx_mul;
-            if (mr_==Mr && nr_==Nr){
-                avx_micro_kernel_2rx6(res_buf,a_buf,b_buf,kc_);
-            }else if (mr_>n_packed-1){
-                std::size_t mm{0};
-                auto res_buf_ = res_buf;
-                for (const auto b_last=b_buf+nr_; b_buf!=b_last; ++b_buf){
-                    auto a_buf_=a_buf;
-                    const auto a_last = a_buf_+mr_;
-                    const auto& b_e = *b_buf;
-                    const auto b_y = avx_broadcast(b_buf);
-                    for (;mm!=0; --mm,++a_buf_,++res_buf_){
-                        *res_buf_=*a_buf_*b_e;
-                    }
-                    for (const auto a_last_=a_last-(n_packed-1); a_buf_<a_last_; a_buf_+=n_packed,res_buf_+=n_packed){
-                        avx_store(res_buf_,avx_mul<U>(avx_loadu(a_buf_),b_y));
-                    }
-                    for (mm=n_packed; a_buf_!=a_last; ++a_buf_,++res_buf_,--mm){
-                        *res_buf_=*a_buf_*b_e;
-                    }
+        //call f with kernel selected by isa_
+        template<typename F>
+        ALWAYS_INLINE void dispatch(F&& f){
+            if constexpr (has_simd_kernel && detail::compile_isa()>=isa::avx512){
+                if (isa_==isa::avx512){
+                    f(avx512_kernel{});
+                    return;
                 }
-                for (std::size_t kk=1; kk!=kc_; ++kk){
-                    const auto a_buf_ = a_buf+kk*mr_;
-                    res_buf_ = res_buf;
-                    mm = 0;
-                    for (const auto b_last=b_buf+nr_; b_buf!=b_last; ++b_buf){
-                        auto a_buf__=a_buf_;
-                        const auto a_last = a_buf_+mr_;
-                        const auto& b_e = *b_buf;
-                        const auto b_y = avx_broadcast(b_buf);
-                        for (;mm!=0; --mm,++a_buf__,++res_buf_){
-                            *res_buf_+=*a_buf__*b_e;
-                        }
-                        for (const auto a_last__=a_last-(n_packed-1); a_buf__<a_last__; a_buf__+=n_packed,res_buf_+=n_packed){
-                            avx_store(res_buf_,avx_madd<U>(avx_loadu(a_buf__),b_y,avx_load(res_buf_)));
-                        }
-                        for (mm=n_packed; a_buf__!=a_last; ++a_buf__,++res_buf_,--mm){
-                            *res_buf_+=*a_buf__*b_e;
-                        }
-                    }
+            }
+            if constexpr (has_simd_kernel){
+                if (isa_>=isa::avx2){
+                    f(avx2_kernel{});
+                    return;
                 }
-            }else{
-                micro_kernel_generic(res_buf,a_buf,b_buf,mr_,nr_,kc_);
             }
+            f(generic_kernel{});
         }
 
     public:
 
+        //kernel is selected once, according to kernel_isa(), blocking is computed using kernel_cache_sizes()
         matmul_2d(const index_type& k_, const dim_type& i_axis_, const dim_type& j_axis_):
             k{k_},
             i_axis{i_axis_},
-            j_axis{j_axis_}
+            j_axis{j_axis_},
+            isa_{has_simd_kernel ? kernel_isa() : isa::generic},
+            blocking_{make_blocking(isa_)}
         {}
 
-        template<typename ResW, typename W1, typename W2>
-        ALWAYS_INLINE void operator()(ResW res_w, W1 w1, W2 w2, const index_type& ic_min, const index_type& ic_max, const index_type& jc_min, const index_type& jc_max, res_value_type* res_buf, value_type1* a_buf, value_type2* b_buf){
-            const auto mc = static_cast<index_type>(Mc);
-            const auto nc = static_cast<index_type>(is_buffer_on_stack ? Nc : jc_max-jc_min);
-            const auto kc = static_cast<index_type>(Kc);
-            const auto mr = static_cast<index_type>(Mr);
-            const auto nr = static_cast<index_type>(Nr);
-            res_w.walk(j_axis,jc_min);
-            res_w.walk(i_axis,ic_min);
-            w1.walk(i_axis,ic_min);
-            w2.walk(j_axis,jc_min);
-            for (index_type jc=jc_min; jc<jc_max; jc+=nc){
-                const auto nc_ = adjust_block_size(jc,nc,jc_max);
-                for (index_type pc=0; pc<k; pc+=kc){
-                    const auto kc_ = adjust_block_size(pc,kc,k);
-                    fill_buf(w2,b_buf,j_axis,i_axis,nc_,kc_,nr);
-                    for (index_type ic=ic_min; ic<ic_max; ic+=mc){
-                        const auto mc_ = adjust_block_size(ic,mc,ic_max);
-                        fill_buf(w1,a_buf,i_axis,j_axis,mc_,kc_,mr);
-                        macro_kernel(res_w,res_buf,a_buf,b_buf,static_cast<std::size_t>(mc_),static_cast<std::size_t>(nc_),static_cast<std::size_t>(kc_));
-                        w1.walk(i_axis,mc_);
-                        res_w.walk(i_axis,mc_);
-                    }
-                    w1.walk_back(i_axis,ic_max-ic_min);
-                    res_w.walk_back(i_axis,ic_max-ic_min);
-                    w1.walk(j_axis,kc_);
-                    w2.walk(i_axis,kc_);
-                }
-                w1.walk_back(j_axis,k);
-                w2.walk_back(i_axis,k);
-                w2.walk(j_axis,nc_);
-                res_w.walk(j_axis,nc_);
-            }
+        //instruction set of selected kernel
+        isa kernel()const{
+            return has_simd_kernel ? isa_ : isa::generic;
+        }
+
+        //min number of result rows per task of shared packing parallel product
+        std::size_t rows_per_task()const{
+            return blocking_.mr;
         }
 
+        //product of ic_min,ic_max x jc_min,jc_max part of result, packs its own blocks of a and b
         template<typename ResW, typename W1, typename W2>
         ALWAYS_INLINE void operator()(ResW res_w, W1 w1, W2 w2, const index_type& ic_min, const index_type& ic_max, const index_type& jc_min, const index_type& jc_max){
-            if constexpr (is_buffer_on_stack){
-                alignas(alignment) std::array<res_value_type,Mr*Nr> res_buf;
-                alignas(alignment) std::array<value_type1,Mc*Kc> a_buf;
-                alignas(alignment) std::array<value_type2,Kc*Nc> b_buf;
-                this->operator()(res_w,w1,w2,ic_min,ic_max,jc_min,jc_max,res_buf.data(),a_buf.data(),b_buf.data());
-            }else{
-                auto make_buf_size = [](auto i_size, auto j_size, auto t_size){
-                    return alignment*(i_size*j_size*t_size/alignment+1);
-                };
-                const auto res_buf_size = make_buf_size(Mr,Nr,sizeof(res_value_type));
-                const auto a_buf_size = make_buf_size(Mc,Kc,sizeof(value_type1));
-                const auto b_buf_size = make_buf_size(Kc,jc_max-jc_min,sizeof(value_type2));
-                if constexpr (std::is_same_v<res_value_type,value_type1> && std::is_same_v<res_value_type,value_type2>){
-                    gtensor::basic_storage<res_value_type,allocation::aligned_allocator<res_value_type,alignment>> buf(res_buf_size+a_buf_size+b_buf_size);
-                    this->operator()(res_w,w1,w2,ic_min,ic_max,jc_min,jc_max,buf.data(),buf.data()+res_buf_size,buf.data()+res_buf_size+a_buf_size);
+            dispatch([&,this](auto kernel){
+                this->template run<decltype(kernel)>(res_w,w1,w2,ic_min,ic_max,jc_min,jc_max);
+            });
+        }
 
-                }else{
-                    gtensor::basic_storage<res_value_type,allocation::aligned_allocator<res_value_type,alignment>> res_buf(res_buf_size);
-                    gtensor::basic_storage<value_type1,allocation::aligned_allocator<value_type1,alignment>> a_buf(a_buf_size);
-                    gtensor::basic_storage<value_type2,allocation::aligned_allocator<value_type2,alignment>> b_buf(b_buf_size);
-                    this->operator()(res_w,w1,w2,ic_min,ic_max,jc_min,jc_max,res_buf.data(),a_buf.data(),b_buf.data());
-                }
-            }
+        //shared packing parallel product of m x n result using n_tasks tasks, m should be not less than n_tasks*rows_per_task()
+        template<typename ResW, typename W1, typename W2>
+        void operator()(ResW res_w, W1 w1, W2 w2, const index_type& m, const index_type& n, const std::size_t& n_tasks){
+            dispatch([&,this](auto kernel){
+                this->template run_par<decltype(kernel)>(res_w,w1,w2,m,n,n_tasks);
+            });
         }
 
         friend std::ostream& operator<<(std::ostream& os, const matmul_2d& mm){
-            return os<<"Mr "<<Mr<<" Nr "<<Nr<<" Kc "<<Kc<<" Mc "<<Mc<<" Nc "<<Nc;
+            const auto& b = mm.blocking_;
+            return os<<"Mr "<<b.mr<<" Nr "<<b.nr<<" Kc "<<b.kc<<" Mc "<<b.mc<<" Nc "<<b.nc;
         }
 
     };  //end of class matmul_2d
 
+    //product of small matrices, operands are copied to dense arrays of result value type and multiplied by unpacked kernel
+    template<typename T, typename ResW, typename W1, typename W2, typename IdxT, typename DimT>
+    static void matmul_small_2d(ResW res_w, W1 w1, W2 w2, const IdxT& m, const IdxT& n, const IdxT& k, const DimT& i_axis, const DimT& j_axis){
+        static constexpr std::size_t max_size = detail::matmul_small_max*detail::matmul_small_max;
+        std::array<T,max_size> a;
+        std::array<T,max_size> b;
+        std::array<T,max_size> res;
+        auto load = [&i_axis,&j_axis](auto& w, T* dst, const IdxT& rows, const IdxT& cols){
+            for (auto i=rows; i!=0; --i,w.step(i_axis)){
+                for (auto j=cols; j!=0; --j,++dst,w.step(j_axis)){
+                    *dst = static_cast<T>(*w);
+                }
+                w.walk_back(j_axis,cols);
+            }
+        };
+        load(w1,a.data(),m,k);
+        load(w2,b.data(),k,n);
+        detail::matmul_small(res.data(),a.data(),b.data(),static_cast<std::size_t>(m),static_cast<std::size_t>(n),static_cast<std::size_t>(k));
+        auto src = res.data();
+        for (auto i=m; i!=0; --i,res_w.step(i_axis)){
+            for (auto j=n; j!=0; --j,++src,res_w.step(j_axis)){
+                *res_w = *src;
+            }
+            res_w.walk_back(j_axis,n);
+        }
+    }
+
     //t1,t2,res are at least 2d
     template<typename ResT, typename Policy, typename...Ts, typename...Us>
-    static auto matmul_nd_helper(Policy, const basic_tensor<Ts...>& t1, const basic_tensor<Us...>& t2){
+    static auto matmul_nd_helper(Policy policy, const basic_tensor<Ts...>& t1, const basic_tensor<Us...>& t2){
         using res_type = ResT;
         using order = typename res_type::order;
         using value_type = typename res_type::value_type;
@@ -989,19 +1314,72 @@ private:
         const auto n = res_shape[j_axis];
         const auto k = *(shape1.end()-1);
 
+        //small matrices of arithmetic or complex types are multiplied without packing, batch is split between tasks
+        static constexpr bool has_small_path = std::is_arithmetic_v<value_type> && std::is_arithmetic_v<value_type1> && std::is_arithmetic_v<value_type2> ||
+            detail::is_complex_of_arithmetic_v<value_type> && detail::is_complex_of_arithmetic_v<value_type1> && detail::is_complex_of_arithmetic_v<value_type2>;
+        if constexpr (has_small_path){
+            const auto small_max = static_cast<index_type>(detail::matmul_small_max);
+            if (m<=small_max && n<=small_max && k<=small_max){
+                auto body = [&i_axis,&j_axis,&m,&n,&k](auto res_tr_, auto tr1_, auto tr2_, std::size_t batch_size){
+                    for (;batch_size!=0; --batch_size){
+                        matmul_small_2d<value_type>(res_tr_.walker(),tr1_.walker(),tr2_.walker(),m,n,k,i_axis,j_axis);
+                        tr1_.template next<order>();
+                        tr2_.template next<order>();
+                        res_tr_.template next<order>();
+                    }
+                };
+                const auto batch_size = static_cast<std::size_t>(res.size()/(m*n));
+                if constexpr (multithreading::exec_policy_traits<Policy>::is_seq::value){
+                    detail::unused_args{policy};
+                    body(res_tr,tr1,tr2,batch_size);
+                }else{
+                    //each task computes at least grain size elements of result
+                    const auto min_batch = std::max(std::size_t{1},multithreading::grain_size(policy,1)/static_cast<std::size_t>(m*n));
+                    const auto par_sizes = multithreading::make_par_task_size(policy,batch_size,min_batch);
+                    if (par_sizes.size()<2){
+                        body(res_tr,tr1,tr2,batch_size);
+                    }else{
+                        multithreading::task_group group{};
+                        for (std::size_t i=0; i!=par_sizes.size(); ++i){
+                            multithreading::get_pool().push_group(group,body,res_tr,tr1,tr2,par_sizes[i]);
+                            for (auto j=par_sizes[i]; j!=0; --j){
+                                tr1.template next<order>();
+                                tr2.template next<order>();
+                                res_tr.template next<order>();
+                            }
+                        }
+                        group.wait();
+                    }
+                }
+                return res;
+            }
+        }
+
         using matmul_type = matmul_2d<value_type,value_type1,value_type2,config_type>;
         matmul_type mm(k,i_axis,j_axis);
 
         if constexpr (multithreading::exec_policy_traits<Policy>::is_seq::value){
+            detail::unused_args{policy};
             do{
                 mm(res_tr.walker(),tr1.walker(),tr2.walker(),0,m,0,n);
                 tr1.template next<order>();
                 tr2.template next<order>();
             }while(res_tr.template next<order>());
         }else{
-            const auto n_tasks = multithreading::exec_policy_traits<Policy>::par_tasks::value;
             const auto m_size = static_cast<std::size_t>(m);
             const auto n_size = static_cast<std::size_t>(n);
+            //each task computes at least grain size elements of result matrix
+            const auto n_tasks = std::max(std::size_t{1},std::min(multithreading::par_tasks_n(policy), m_size*n_size/multithreading::grain_size(policy,1)));
+            //if rows of result can be split between tasks, tasks share packed blocks of b
+            if (n_tasks>1 && m_size>=n_tasks*mm.rows_per_task()){
+                do{
+                    mm(res_tr.walker(),tr1.walker(),tr2.walker(),m,n,n_tasks);
+                    tr1.template next<order>();
+                    tr2.template next<order>();
+                }while(res_tr.template next<order>());
+                return res;
+            }
+            //otherwise result is split into rect parts, each task packs its own blocks of a and b
             auto ti = static_cast<std::size_t>(std::round(std::sqrt(n_tasks*m_size/static_cast<double>(n_size))));
             auto tj = static_cast<std::size_t>(std::round(std::sqrt(n_tasks*n_size/static_cast<double>(m_size))));
 
@@ -1049,6 +1427,268 @@ private:
         return res;
     }
 
+    template<typename ShT, typename Axes>
+    static void check_tensordot_args(const ShT& shape1, const ShT& shape2, const Axes& axes1, const Axes& axes2){
+        if (axes1.size()!=axes2.size()){
+            throw value_error("tensordot: number of axes must be equal");
+        }
+        auto check_axes = [](const auto& axes, const auto& dim){
+            for (auto it=axes.begin(); it!=axes.end(); ++it){
+                if (*it>=dim || std::find(axes.begin(),it,*it)!=it){
+                    throw axis_error("tensordot: invalid axes");
+                }
+            }
+        };
+        check_axes(axes1,detail::make_dim(shape1));
+        check_axes(axes2,detail::make_dim(shape2));
+        for (std::size_t i=0; i!=axes1.size(); ++i){
+            if (shape1[axes1[i]]!=shape2[axes2[i]]){
+                throw value_error("tensordot: tensors shapes not compatible");
+            }
+        }
+    }
+
+    //contraction is product of (m,k) and (k,n) matrices, m is size of free axes of t1, n is size of free axes of t2, k is size of contracted axes
+    //if there is single axis of each kind, matmul packs operands directly from transpose views, otherwise operands with several axes of the same kind are copied
+    template<typename Policy, typename...Ts, typename...Us, typename Axes>
+    static auto tensordot_helper(Policy policy, const basic_tensor<Ts...>& t1, const basic_tensor<Us...>& t2, const Axes& axes1, const Axes& axes2){
+        using tensor_type1 = basic_tensor<Ts...>;
+        using tensor_type2 = basic_tensor<Us...>;
+        using value_type1 = typename tensor_type1::value_type;
+        using value_type2 = typename tensor_type2::value_type;
+        using order1 = typename tensor_type1::order;
+        using order2 = typename tensor_type2::order;
+        using res_order = std::conditional_t<std::is_same_v<order1,order2>,order1,gtensor::config::c_order>;
+        using config_type = typename tensor_type1::config_type;
+        using common_value_type = std::decay_t<decltype(std::declval<value_type1>()*std::declval<value_type2>())>;
+        using res_type = detail::tensor_copy_type_t<common_value_type,res_order,config_type>;
+        using shape_type = typename res_type::shape_type;
+        using index_type = typename res_type::index_type;
+        using dim_type = typename res_type::dim_type;
+
+        const auto& shape1 = t1.shape();
+        const auto& shape2 = t2.shape();
+        const auto dim1 = t1.dim();
+        const auto dim2 = t2.dim();
+        auto free_axes = [](const dim_type& dim, const Axes& axes){
+            Axes res{};
+            for (dim_type axis=0; axis!=dim; ++axis){
+                if (std::find(axes.begin(),axes.end(),axis)==axes.end()){
+                    res.push_back(axis);
+                }
+            }
+            return res;
+        };
+        const auto free1 = free_axes(dim1,axes1);
+        const auto free2 = free_axes(dim2,axes2);
+        if (axes1.empty()){ //outer product, t1 is broadcast along axes of t2
+            shape_type shape1_(dim1+dim2,index_type{1});
+            std::copy(shape1.begin(),shape1.end(),shape1_.begin());
+            return (t1.reshape(shape1_)*t2).template copy<common_value_type,config_type>(policy,res_order{});
+        }
+        Axes perm1{free1};
+        std::copy(axes1.begin(),axes1.end(),std::back_inserter(perm1));
+        Axes perm2{axes2};
+        std::copy(free2.begin(),free2.end(),std::back_inserter(perm2));
+        if (free1.size()<2 && free2.size()<2 && axes1.size()==1){
+            return matmul(policy,t1.transpose(perm1),t2.transpose(perm2));
+        }
+        shape_type res_shape{};
+        detail::reserve(res_shape,free1.size()+free2.size());
+        index_type m{1};
+        index_type n{1};
+        index_type k{1};
+        for (const auto& axis : free1){
+            res_shape.push_back(shape1[axis]);
+            m*=shape1[axis];
+        }
+        for (const auto& axis : free2){
+            res_shape.push_back(shape2[axis]);
+            n*=shape2[axis];
+        }
+        for (const auto& axis : axes1){
+            k*=shape1[axis];
+        }
+        return tensordot_matrix(policy,t1,perm1,m,k,[&](const auto& a){
+            return tensordot_matrix(policy,t2,perm2,k,n,[&](const auto& b){
+                const auto res = matmul(policy,a,b);
+                if (res_shape.empty()){ //all axes are contracted
+                    return res_type(*res.begin());
+                }
+                return res.reshape(res_shape).template copy<common_value_type,config_type>(policy,res_order{});
+            });
+        });
+    }
+
+    //calls f with (rows,cols) matrix of t elements permuted by perm
+    //matrix is reshape view of t if it is c_order storage tensor and perm is identity, otherwise it is reshape view of permuted copy of t
+    template<typename Policy, typename...Ts, typename Axes, typename IdxT, typename F>
+    static auto tensordot_matrix(Policy policy, const basic_tensor<Ts...>& t, const Axes& perm, const IdxT& rows, const IdxT& cols, F&& f){
+        using tensor_type = basic_tensor<Ts...>;
+        using gtensor::config::c_order;
+        if constexpr (detail::is_simd_storage_tensor<tensor_type>::value && std::is_same_v<typename tensor_type::order,c_order>){
+            if (std::is_sorted(perm.begin(),perm.end())){
+                return f(t.reshape(rows,cols));
+            }
+        }
+        return f(t.transpose(perm).copy(policy,c_order{}).reshape(rows,cols));
+    }
+
+    //copy of t, which axes are labeled by input, with axes permuted to order of output labels
+    template<typename Policy, typename T>
+    static auto einsum_permute(Policy policy, T&& t, const std::string& input, const std::string& output){
+        using tensor_type = std::remove_cv_t<std::remove_reference_t<T>>;
+        using order = typename tensor_type::order;
+        using config_type = typename tensor_type::config_type;
+        using value_type = detail::copy_type_t<typename tensor_type::value_type>;
+        using res_type = detail::tensor_copy_type_t<value_type,order,config_type>;
+        using dim_type = typename config_type::dim_type;
+        using axes_type = typename config_type::template shape<dim_type>;
+        if (input==output){
+            if constexpr (std::is_same_v<tensor_type,res_type> && !std::is_lvalue_reference_v<T>){
+                return res_type(std::forward<T>(t));
+            }else{
+                return t.template copy<value_type,config_type>(policy,order{});
+            }
+        }
+        axes_type perm{};
+        detail::reserve(perm,output.size());
+        for (const auto& c : output){
+            perm.push_back(static_cast<dim_type>(input.find(c)));
+        }
+        return t.transpose(perm).template copy<value_type,config_type>(policy,order{});
+    }
+
+    //fused product of operands elements and sum over labels that are not in output, it is used for patterns that are not matrix products,
+    //e.g. diagonals, traces, labels summed in single operand
+    //walkers are moved along label by stepping all axes that have this label, so repeated label is walked along diagonal
+    //labels of the first output axis are split between parallel tasks according to policy
+    template<typename ResT, typename Policy, typename ShT, std::size_t N, typename...Ts>
+    static ResT einsum_fused(Policy policy, const std::string& output, const std::string& labels_, const ShT& extents_, const std::array<std::string,N>& inputs, const Ts&...ts){
+        using res_type = ResT;
+        using value_type = typename res_type::value_type;
+        using config_type = typename res_type::config_type;
+        using index_type = typename res_type::index_type;
+        using dim_type = typename res_type::dim_type;
+        using shape_type = typename res_type::shape_type;
+        using axes_type = typename config_type::template shape<dim_type>;
+
+        //output labels are outer, summed labels are inner
+        std::string labels{output};
+        shape_type extents{};
+        detail::reserve(extents,labels_.size());
+        for (const auto& c : output){
+            extents.push_back(extents_[labels_.find(c)]);
+        }
+        for (std::size_t i=0; i!=labels_.size(); ++i){
+            if (output.find(labels_[i])==std::string::npos){
+                labels.push_back(labels_[i]);
+                extents.push_back(extents_[i]);
+            }
+        }
+        const auto n_output = output.size();
+        const auto n_labels = labels.size();
+        res_type res(shape_type(extents.begin(),extents.begin()+n_output),value_type{0});
+        if (res.empty() || std::find(extents.begin()+n_output,extents.end(),index_type{0})!=extents.end()){
+            return res;
+        }
+        //axes of result and operands along labels, result has axes of output labels only
+        std::array<std::vector<axes_type>,N+1> label_axes{};
+        label_axes[0].resize(n_labels);
+        for (std::size_t l=0; l!=n_output; ++l){
+            label_axes[0][l].push_back(static_cast<dim_type>(l));
+        }
+        for (std::size_t i=0; i!=N; ++i){
+            label_axes[i+1].resize(n_labels);
+            for (std::size_t j=0; j!=inputs[i].size(); ++j){
+                label_axes[i+1][labels.find(inputs[i][j])].push_back(static_cast<dim_type>(j));
+            }
+        }
+        auto body = [&label_axes,&extents,n_output,n_labels](auto walkers, const index_type& outer_size){
+            shape_type extents_{extents};
+            shape_type counters(n_labels,index_type{0});
+            if (n_output!=0){
+                extents_[0] = outer_size;
+            }
+            einsum_walk(walkers,label_axes,extents_,counters,0,n_output,[&](){
+                value_type acc{0};
+                einsum_walk(walkers,label_axes,extents_,counters,n_output,n_labels,[&](){
+                    acc+=einsum_product<value_type>(walkers,std::make_index_sequence<N>{});
+                });
+                *std::get<0>(walkers) = acc;
+            });
+        };
+        auto walkers = std::make_tuple(res.create_walker(),ts.create_walker()...);
+        const auto outer_size = n_output==0 ? index_type{1} : extents[0];
+        if constexpr (multithreading::exec_policy_traits<Policy>::is_seq::value){
+            detail::unused_args{policy};
+            body(walkers,outer_size);
+        }else{
+            //each task computes at least grain size products
+            const auto outer_products = static_cast<std::size_t>(std::accumulate(extents.begin(),extents.end(),index_type{1},std::multiplies<index_type>{})/outer_size);
+            const auto min_outer_size = std::max(std::size_t{1},multithreading::grain_size(policy,1)/outer_products);
+            const auto par_sizes = multithreading::make_par_task_size(policy,outer_size,min_outer_size);
+            if (par_sizes.size()<2){
+                body(walkers,outer_size);
+            }else{
+                multithreading::task_group group{};
+                for (std::size_t i=0; i!=par_sizes.size(); ++i){
+                    multithreading::get_pool().push_group(group,body,walkers,par_sizes[i]);
+                    einsum_move<false>(walkers,label_axes,0,par_sizes[i],std::make_index_sequence<N+1>{});
+                }
+                group.wait();
+            }
+        }
+        return res;
+    }
+
+    //calls f at every position of labels in range [first,last), last label is innermost
+    //walkers are returned to initial position, counters of labels in range must be zero
+    template<typename Walkers, typename LabelAxes, typename ShT, typename F>
+    static void einsum_walk(Walkers& walkers, const LabelAxes& label_axes, const ShT& extents, ShT& counters, std::size_t first, std::size_t last, F&& f){
+        static constexpr auto seq = std::make_index_sequence<std::tuple_size_v<Walkers>>{};
+        if (first==last){
+            f();
+            return;
+        }
+        for (;;){
+            f();
+            auto l = last;
+            for (;;){
+                --l;
+                if (++counters[l]!=extents[l]){
+                    einsum_move<false>(walkers,label_axes,l,1,seq);
+                    break;
+                }
+                counters[l] = 0;
+                einsum_move<true>(walkers,label_axes,l,extents[l]-1,seq);
+                if (l==first){
+                    return;
+                }
+            }
+        }
+    }
+
+    template<bool Back, typename Walkers, typename LabelAxes, typename IdxT, std::size_t...I>
+    ALWAYS_INLINE static void einsum_move(Walkers& walkers, const LabelAxes& label_axes, std::size_t label, const IdxT& steps, std::index_sequence<I...>){
+        auto move = [&steps](auto& walker, const auto& axes){
+            for (const auto& axis : axes){
+                if constexpr (Back){
+                    walker.walk_back(axis,steps);
+                }else{
+                    walker.walk(axis,steps);
+                }
+            }
+        };
+        (move(std::get<I>(walkers),label_axes[I][label]),...);
+    }
+
+    //product of operands elements, walker of result is the first
+    template<typename T, typename Walkers, std::size_t...I>
+    ALWAYS_INLINE static T einsum_product(Walkers& walkers, std::index_sequence<I...>){
+        return (static_cast<T>(*std::get<I+1>(walkers))*...);
+    }
+
 };   //end of struct tensor_math
 
 //tensor math frontend
@@ -1358,6 +1998,63 @@ auto matmul(const basic_tensor<Ts...>& a, const basic_tensor<Us...>& b){
     return tensor_math_selector_t<config_type>::matmul(a,b);
 }
 
+//tensordot
+//sum of products of a and b elements over axes_a of a and axes_b of b, axes are containers of the same size or scalars, sizes along paired axes must be equal
+//if n is given, last n axes of a are contracted with first n axes of b
+//result shape is not contracted axes of a followed by not contracted axes of b
+template<typename Policy, typename...Ts, typename...Us, typename AxesA, typename AxesB>
+auto tensordot(Policy policy, const basic_tensor<Ts...>& a, const basic_tensor<Us...>& b, const AxesA& axes_a, const AxesB& axes_b){
+    using config_type = typename basic_tensor<Ts...>::config_type;
+    return tensor_math_selector_t<config_type>::tensordot(policy,a,b,axes_a,axes_b);
+}
+template<typename Policy, typename...Ts, typename...Us, typename DimT>
+auto tensordot(Policy policy, const basic_tensor<Ts...>& a, const basic_tensor<Us...>& b, std::initializer_list<DimT> axes_a, std::initializer_list<DimT> axes_b){
+    using config_type = typename basic_tensor<Ts...>::config_type;
+    using dim_type = typename config_type::dim_type;
+    return tensor_math_selector_t<config_type>::tensordot(policy,a,b,detail::make_shape_of_type<typename config_type::template shape<dim_type>>(axes_a),
+        detail::make_shape_of_type<typename config_type::template shape<dim_type>>(axes_b));
+}
+template<typename Policy, typename...Ts, typename...Us, typename DimT=int>
+auto tensordot(Policy policy, const basic_tensor<Ts...>& a, const basic_tensor<Us...>& b, const DimT& n = 2){
+    using config_type = typename basic_tensor<Ts...>::config_type;
+    return tensor_math_selector_t<config_type>::tensordot(policy,a,b,n);
+}
+template<typename...Ts, typename...Us, typename AxesA, typename AxesB>
+auto tensordot(const basic_tensor<Ts...>& a, const basic_tensor<Us...>& b, const AxesA& axes_a, const AxesB& axes_b){
+    return tensordot(multithreading::exec_pol<1>{},a,b,axes_a,axes_b);
+}
+template<typename...Ts, typename...Us, typename DimT>
+auto tensordot(const basic_tensor<Ts...>& a, const basic_tensor<Us...>& b, std::initializer_list<DimT> axes_a, std::initializer_list<DimT> axes_b){
+    return tensordot(multithreading::exec_pol<1>{},a,b,axes_a,axes_b);
+}
+template<typename...Ts, typename...Us, typename DimT=int>
+auto tensordot(const basic_tensor<Ts...>& a, const basic_tensor<Us...>& b, const DimT& n = 2){
+    return tensordot(multithreading::exec_pol<1>{},a,b,n);
+}
+
+//einsum
+//Einstein summation over one or two operands, subscripts is like "ij,jk->ik", labels are letters, spaces are ignored
+//label repeated in single operand means its diagonal, labels that are not in output are summed
+//if output is not specified it consists of labels that appear once, in alphabetical order
+template<typename Policy, typename...Ts, typename...Us>
+auto einsum(Policy policy, const std::string& subscripts, const basic_tensor<Ts...>& a, const basic_tensor<Us...>& b){
+    using config_type = typename basic_tensor<Ts...>::config_type;
+    return tensor_math_selector_t<config_type>::einsum(policy,subscripts,a,b);
+}
+template<typename Policy, typename...Ts>
+auto einsum(Policy policy, const std::string& subscripts, const basic_tensor<Ts...>& t){
+    using config_type = typename basic_tensor<Ts...>::config_type;
+    return tensor_math_selector_t<config_type>::einsum(policy,subscripts,t);
+}
+template<typename...Ts, typename...Us>
+auto einsum(const std::string& subscripts, const basic_tensor<Ts...>& a, const basic_tensor<Us...>& b){
+    return einsum(multithreading::exec_pol<1>{},subscripts,a,b);
+}
+template<typename...Ts>
+auto einsum(const std::string& subscripts, const basic_tensor<Ts...>& t){
+    return einsum(multithreading::exec_pol<1>{},subscripts,t);
+}
+
 #undef GTENSOR_TENSOR_MATH_FUNCTION
 #undef GTENSOR_TENSOR_MATH_REDUCE_FUNCTION
 #undef GTENSOR_TENSOR_MATH_REDUCE_INITIAL_FUNCTION
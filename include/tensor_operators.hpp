@@ -107,6 +107,14 @@ inline std::decay_t<Tensor>& a_operator(F&& f, Tensor&& lhs, Rhs&& rhs){
     generalized_operator_selector_t<config_type>::a_operator(std::forward<F>(f),std::forward<Tensor>(lhs),std::forward<Rhs>(rhs));
     return lhs;
 }
+//policy is specialization of multithreading::exec_pol or multithreading::exec_pol_rt
+template<typename Policy, typename F, typename Tensor, typename Rhs, std::enable_if_t<multithreading::is_policy_v<Policy>,int> =0>
+inline std::decay_t<Tensor>& a_operator(Policy policy, F&& f, Tensor&& lhs, Rhs&& rhs){
+    using Tensor_ = std::decay_t<Tensor>;
+    using config_type = typename Tensor_::config_type;
+    generalized_operator_selector_t<config_type>::a_operator(policy,std::forward<F>(f),std::forward<Tensor>(lhs),std::forward<Rhs>(rhs));
+    return lhs;
+}
 
 //tensor operators and related functions implementation
 
@@ -118,11 +126,15 @@ static auto NAME(Args&&...args){\
 }
 
 #define GTENSOR_TENSOR_OPERATOR_COMPOUND_ASSIGNMENT_FUNCTION(NAME,F)\
-template<typename Tensor, typename Rhs>\
-static std::decay_t<Tensor>& NAME(Tensor&& lhs, Rhs&& rhs){\
+template<typename Policy, typename Tensor, typename Rhs>\
+static std::decay_t<Tensor>& NAME(Policy policy, Tensor&& lhs, Rhs&& rhs){\
     static_assert(detail::is_tensor_v<std::decay_t<Tensor>>,"lhs must be tensor");\
-    a_operator(F{},std::forward<Tensor>(lhs),std::forward<Rhs>(rhs));\
+    a_operator(policy,F{},std::forward<Tensor>(lhs),std::forward<Rhs>(rhs));\
     return lhs;\
+}\
+template<typename Tensor, typename Rhs>\
+static std::decay_t<Tensor>& NAME(Tensor&& lhs, Rhs&& rhs){\
+    return NAME(multithreading::exec_pol<1>{},std::forward<Tensor>(lhs),std::forward<Rhs>(rhs));\
 }
 
 struct tensor_operators
@@ -269,20 +281,28 @@ struct tensor_operators
     GTENSOR_TENSOR_OPERATOR_FUNCTION(logic_or,operations::logic_or);
 
     //elementwise assignment
-    template<typename...Ts, typename Rhs>
-    static basic_tensor<Ts...>& assign(basic_tensor<Ts...>& lhs, Rhs&& rhs){
+    template<typename Policy, typename...Ts, typename Rhs>
+    static basic_tensor<Ts...>& assign(Policy policy, basic_tensor<Ts...>& lhs, Rhs&& rhs){
         using RhsT = std::remove_cv_t<std::remove_reference_t<Rhs>>;
         static_assert(detail::is_tensor_v<RhsT>||std::is_convertible_v<RhsT,typename basic_tensor<Ts...>::element_type>);
         if (lhs.is_same(rhs)){
             return lhs;
         }
-        a_operator(operations::assign{},lhs,std::forward<Rhs>(rhs));
+        a_operator(policy,operations::assign{},lhs,std::forward<Rhs>(rhs));
+        return lhs;
+    }
+    template<typename Policy, typename...Ts, typename Rhs>
+    static tensor<Ts...>& assign(Policy policy, tensor<Ts...>& lhs, Rhs&& rhs){
+        assign(policy,detail::as_basic_tensor(lhs),std::forward<Rhs>(rhs));
         return lhs;
     }
     template<typename...Ts, typename Rhs>
+    static basic_tensor<Ts...>& assign(basic_tensor<Ts...>& lhs, Rhs&& rhs){
+        return assign(multithreading::exec_pol<1>{},lhs,std::forward<Rhs>(rhs));
+    }
+    template<typename...Ts, typename Rhs>
     static tensor<Ts...>& assign(tensor<Ts...>& lhs, Rhs&& rhs){
-        assign(detail::as_basic_tensor(lhs),std::forward<Rhs>(rhs));
-        return lhs;
+        return assign(multithreading::exec_pol<1>{},lhs,std::forward<Rhs>(rhs));
     }
 
     //elementwise compound assignment
@@ -415,6 +435,14 @@ tensor<Ts...>& NAME(tensor<Ts...>&& lhs, Rhs&& rhs){\
     return gtensor::tensor_operators_selector_t<config_type>::F(std::move(lhs),std::forward<Rhs>(rhs));\
 }
 
+//policy is specialization of multithreading::exec_pol or multithreading::exec_pol_rt
+#define GTENSOR_COMPOUND_ASSIGNMENT_TENSOR_FUNCTION(NAME,F)\
+template<typename Policy, typename Tensor, typename Rhs, std::enable_if_t<multithreading::is_policy_v<Policy>,int> =0>\
+std::decay_t<Tensor>& NAME(Policy policy, Tensor&& lhs, Rhs&& rhs){\
+    using config_type = typename std::decay_t<Tensor>::config_type;\
+    return gtensor::tensor_operators_selector_t<config_type>::F(policy,std::forward<Tensor>(lhs),std::forward<Rhs>(rhs));\
+}
+
 //cast
 template<typename To, typename Tensor>
 auto cast(Tensor&& t){
@@ -491,8 +519,31 @@ inline tensor<Ts...>& assign(tensor<Ts...>& lhs, Rhs&& rhs){
     using config_type = typename tensor<Ts...>::config_type;
     return gtensor::tensor_operators_selector_t<config_type>::assign(lhs,std::forward<Rhs>(rhs));
 }
+//policy is specialization of multithreading::exec_pol or multithreading::exec_pol_rt
+template<typename Policy, typename...Ts, typename Rhs, std::enable_if_t<multithreading::is_policy_v<Policy>,int> =0>
+inline basic_tensor<Ts...>& assign(Policy policy, basic_tensor<Ts...>& lhs, Rhs&& rhs){
+    using config_type = typename basic_tensor<Ts...>::config_type;
+    return gtensor::tensor_operators_selector_t<config_type>::assign(policy,lhs,std::forward<Rhs>(rhs));
+}
+template<typename Policy, typename...Ts, typename Rhs, std::enable_if_t<multithreading::is_policy_v<Policy>,int> =0>
+inline tensor<Ts...>& assign(Policy policy, tensor<Ts...>& lhs, Rhs&& rhs){
+    using config_type = typename tensor<Ts...>::config_type;
+    return gtensor::tensor_operators_selector_t<config_type>::assign(policy,lhs,std::forward<Rhs>(rhs));
+}
 
 //elementwise compound assignment
+//policy overloads of compound assignment operators
+GTENSOR_COMPOUND_ASSIGNMENT_TENSOR_FUNCTION(assign_add,assign_add);
+GTENSOR_COMPOUND_ASSIGNMENT_TENSOR_FUNCTION(assign_sub,assign_sub);
+GTENSOR_COMPOUND_ASSIGNMENT_TENSOR_FUNCTION(assign_mul,assign_mul);
+GTENSOR_COMPOUND_ASSIGNMENT_TENSOR_FUNCTION(assign_div,assign_div);
+GTENSOR_COMPOUND_ASSIGNMENT_TENSOR_FUNCTION(assign_mod,assign_mod);
+GTENSOR_COMPOUND_ASSIGNMENT_TENSOR_FUNCTION(assign_bitwise_and,assign_bitwise_and);
+GTENSOR_COMPOUND_ASSIGNMENT_TENSOR_FUNCTION(assign_bitwise_or,assign_bitwise_or);
+GTENSOR_COMPOUND_ASSIGNMENT_TENSOR_FUNCTION(assign_bitwise_xor,assign_bitwise_xor);
+GTENSOR_COMPOUND_ASSIGNMENT_TENSOR_FUNCTION(assign_bitwise_lshift,assign_bitwise_lshift);
+GTENSOR_COMPOUND_ASSIGNMENT_TENSOR_FUNCTION(assign_bitwise_rshift,assign_bitwise_rshift);
+
 GTENSOR_COMPOUND_ASSIGNMENT_TENSOR_OPERATOR(operator+=,assign_add);
 GTENSOR_COMPOUND_ASSIGNMENT_TENSOR_OPERATOR(operator-=,assign_sub);
 GTENSOR_COMPOUND_ASSIGNMENT_TENSOR_OPERATOR(operator*=,assign_mul);
@@ -506,6 +557,7 @@ GTENSOR_COMPOUND_ASSIGNMENT_TENSOR_OPERATOR(operator>>=,assign_bitwise_rshift);
 
 #undef GTENSOR_TENSOR_OPERATOR_FUNCTION
 #undef GTENSOR_TENSOR_OPERATOR_COMPOUND_ASSIGNMENT_FUNCTION
+#undef GTENSOR_COMPOUND_ASSIGNMENT_TENSOR_FUNCTION
 #undef GTENSOR_UNARY_TENSOR_OPERATOR
 #undef GTENSOR_BINARY_TENSOR_OPERATOR
 #undef GTENSOR_COMPOUND_ASSIGNMENT_TENSOR_OPERATOR
@@ -0,0 +1,161 @@
+/*
+* GTensor - computation library
+* Copyright (c) 2022 Ivan Malezhyk <ivanmzk@gmail.com>
+*
+* Distributed under the Boost Software License, Version 1.0.
+* The full license is in the file LICENSE.txt, distributed with this software.
+*/
+
+#ifndef TRANSPOSE_COPY_HPP_
+#define TRANSPOSE_COPY_HPP_
+
+#include <algorithm>
+#include "common.hpp"
+#include "avx_helper.hpp"
+#include "multithreading.hpp"
+#include "descriptor.hpp"
+#include "tensor_core.hpp"
+#include "tensor_implementation.hpp"
+#include "expression_template_engine/expression_template_simd.hpp"
+
+namespace gtensor{
+
+namespace detail{
+
+//blocked copy for the case when source and destination have different contiguous axes
+//e.g. copy of transpose view or copy of tensor to other layout
+//elements are copied by tiles of transpose_copy_block x transpose_copy_block, so both reads and writes of tile stay in cache
+//float and double tiles are transposed in registers when avx is available
+inline constexpr std::size_t transpose_copy_block = 64;
+//if extent of contiguous axis of source or destination is less, elementwise copy is used
+inline constexpr std::size_t transpose_copy_min_extent = 8;
+
+//tensor which elements are in contiguous buffer and its walker can report strides
+template<typename Tensor> struct is_transpose_copy_source : is_simd_storage_tensor<Tensor>{};
+template<typename Parent> struct is_transpose_copy_source<basic_tensor<tensor_implementation<transpose_view_core<Parent>>>> :
+    is_simd_storage_tensor<std::remove_cv_t<Parent>>
+{};
+
+//copy tile [i_first,i_last)x[j_first,j_last), i is contiguous in src, j is contiguous in dst
+//src element (i,j) is src[i+j*src_stride], dst element (i,j) is dst[i*dst_stride+j]
+template<typename T, typename U, typename IdxT>
+ALWAYS_INLINE void transpose_copy_tile(const T* src, const IdxT& src_stride, U* dst, const IdxT& dst_stride, const IdxT& i_first, const IdxT& i_last, const IdxT& j_first, const IdxT& j_last){
+    IdxT i = i_first;
+    if constexpr (std::is_same_v<T,U> && avx_transpose_width_v<T> != 0){
+        constexpr IdxT width = avx_transpose_width_v<T>;
+        for (; i_last-i >= width; i+=width){
+            IdxT j = j_first;
+            for (; j_last-j >= width; j+=width){
+                avx_transpose_block(src+i+j*src_stride,src_stride,dst+i*dst_stride+j,dst_stride);
+            }
+            for (IdxT ii=i, ii_last=i+width; ii!=ii_last; ++ii){
+                for (IdxT jj=j; jj!=j_last; ++jj){
+                    dst[ii*dst_stride+jj] = static_cast<U>(src[ii+jj*src_stride]);
+                }
+            }
+        }
+    }
+    for (; i!=i_last; ++i){
+        for (IdxT j=j_first; j!=j_last; ++j){
+            dst[i*dst_stride+j] = static_cast<U>(src[i+j*src_stride]);
+        }
+    }
+}
+
+//copy src to storage tensor dst of the same shape by tiles if their contiguous axes differ
+//returns false if it is not the case or tensors can't be copied this way, dst is not changed in this case
+template<typename Policy, typename...Ts, typename...Us>
+bool transpose_copy_tensors(Policy policy, const basic_tensor<Ts...>& src, basic_tensor<Us...>& dst){
+    using src_type = basic_tensor<Ts...>;
+    using dst_type = basic_tensor<Us...>;
+    if constexpr (is_transpose_copy_source<src_type>::value && is_simd_storage_tensor<dst_type>::value){
+        using index_type = typename src_type::index_type;
+        using dim_type = typename src_type::dim_type;
+        using shape_type = typename src_type::shape_type;
+        const auto& shape = src.shape();
+        const dim_type dim = src.dim();
+        if (dim < dim_type{2} || src.empty()){
+            return false;
+        }
+        const auto walker = src.create_walker();
+        const auto dst_strides = detail::make_strides(shape,typename dst_type::order{});
+        //b is contiguous axis of src, a is contiguous axis of dst
+        const dim_type a = std::is_same_v<typename dst_type::order,gtensor::config::c_order> ? dim-1 : dim_type{0};
+        dim_type b = dim;
+        for (dim_type axis=0; axis!=dim; ++axis){
+            if (walker.stride(axis) == index_type{1} && shape[axis] > index_type{1}){
+                b = axis;
+                break;
+            }
+        }
+        const index_type min_extent = static_cast<index_type>(transpose_copy_min_extent);
+        if (b == dim || b == a || shape[a] < min_extent || shape[b] < min_extent){
+            return false;
+        }
+        const index_type src_stride = walker.stride(a);
+        const index_type dst_stride = dst_strides[b];
+        const index_type n_i = shape[b];
+        const index_type n_j = shape[a];
+        //outer axes are all except a and b, every outer index is independent 2d copy
+        shape_type outer_axes{};
+        detail::reserve(outer_axes,dim);
+        index_type outer_size{1};
+        for (dim_type axis=0; axis!=dim; ++axis){
+            if (axis!=a && axis!=b && shape[axis]>index_type{1}){
+                outer_axes.push_back(axis);
+                outer_size*=shape[axis];
+            }
+        }
+        const index_type block = static_cast<index_type>(transpose_copy_block);
+        const index_type i_blocks = (n_i+block-1)/block;
+        const auto src_data = &*walker;
+        const auto dst_data = dst.data();
+        //task is strip of block rows along b for single outer index
+        auto body = [&,src_data,dst_data](index_type first, index_type last){
+            for (; first!=last; ++first){
+                index_type outer = first/i_blocks;
+                const index_type i_first = (first%i_blocks)*block;
+                const index_type i_last = std::min(i_first+block,n_i);
+                index_type src_offset{0};
+                index_type dst_offset{0};
+                for (auto it=outer_axes.end(); it!=outer_axes.begin();){
+                    --it;
+                    const dim_type axis = static_cast<dim_type>(*it);
+                    const index_type idx = outer%shape[axis];
+                    outer/=shape[axis];
+                    src_offset+=idx*walker.stride(axis);
+                    dst_offset+=idx*dst_strides[axis];
+                }
+                for (index_type j_first=0; j_first<n_j; j_first+=block){
+                    transpose_copy_tile(src_data+src_offset,src_stride,dst_data+dst_offset,dst_stride,i_first,i_last,j_first,std::min(j_first+block,n_j));
+                }
+            }
+        };
+        const index_type tasks_number = outer_size*i_blocks;
+        if constexpr (multithreading::exec_policy_traits<Policy>::is_seq::value){
+            body(index_type{0},tasks_number);
+        }else{  //parallelize
+            const auto par_sizes = multithreading::make_par_task_size(policy,tasks_number);
+            if (par_sizes.size()<2){
+                body(index_type{0},tasks_number);
+            }else{
+                multithreading::task_group group{};
+                index_type first{0};
+                for (std::size_t i{0}; i!=par_sizes.size(); ++i){
+                    const index_type last = first+par_sizes[i];
+                    multithreading::get_pool().push_group(group,body,first,last);
+                    first = last;
+                }
+                group.wait();
+            }
+        }
+        return true;
+    }else{
+        detail::unused_args{policy,src,dst};
+        return false;
+    }
+}
+
+}   //end of namespace detail
+}   //end of namespace gtensor
+#endif
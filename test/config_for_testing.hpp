@@ -26,6 +26,12 @@ struct config_div_mode_selector : test_default_config{
 };
 template<typename Div> using config_div_mode_selector_t = config_div_mode_selector<Div>;
 
+template<typename SumMode>
+struct config_sum_mode_selector : test_default_config{
+    using sum_mode = SumMode;
+};
+template<typename SumMode> using config_sum_mode_selector_t = config_sum_mode_selector<SumMode>;
+
 template<typename Order>
 struct config_order_selector : test_default_config{
     using order = Order;
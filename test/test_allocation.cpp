@@ -0,0 +1,213 @@
+/*
+* GTensor - computation library
+* Copyright (c) 2022 Ivan Malezhyk <ivanmzk@gmail.com>
+*
+* Distributed under the Boost Software License, Version 1.0.
+* The full license is in the file LICENSE.txt, distributed with this software.
+*/
+
+#include <vector>
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+#include "catch.hpp"
+#include "helpers_for_testing.hpp"
+#include "allocation.hpp"
+#include "huge_page_allocator.hpp"
+#include "statistic.hpp"
+#include "sort_search.hpp"
+#include "tensor_math.hpp"
+#include "tensor.hpp"
+
+TEST_CASE("test_scratch_arena","[test_allocation]")
+{
+    using allocation::scratch_arena;
+    scratch_arena arena{};
+    REQUIRE(arena.stats().capacity == 0);
+
+    SECTION("lifo_deallocation")
+    {
+        auto p0 = arena.allocate(100,8);
+        auto p1 = arena.allocate(200,16);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(p1)%16 == 0);
+        REQUIRE(arena.stats().in_use == 2);
+        REQUIRE(arena.stats().heap_allocations == 1);
+        arena.deallocate(p1,200);
+        auto p2 = arena.allocate(200,16);
+        REQUIRE(p2 == p1);
+        arena.deallocate(p2,200);
+        arena.deallocate(p0,100);
+        REQUIRE(arena.stats().in_use == 0);
+        REQUIRE(arena.allocate(100,8) == p0);
+    }
+    SECTION("blocks_merged_on_reset")
+    {
+        const auto n = scratch_arena::min_block_size;
+        auto p0 = arena.allocate(n/2,8);
+        auto p1 = arena.allocate(n,8);
+        REQUIRE(arena.stats().heap_allocations == 2);
+        arena.deallocate(p0,n/2);
+        arena.deallocate(p1,n);
+        //merged into one block
+        REQUIRE(arena.stats().heap_allocations == 3);
+        const auto capacity = arena.stats().capacity;
+        for (int i=0; i!=10; ++i){
+            auto q0 = arena.allocate(n/2,8);
+            auto q1 = arena.allocate(n,8);
+            arena.deallocate(q1,n);
+            arena.deallocate(q0,n/2);
+        }
+        REQUIRE(arena.stats().heap_allocations == 3);
+        REQUIRE(arena.stats().capacity == capacity);
+        arena.release();
+        REQUIRE(arena.stats().capacity == 0);
+    }
+}
+
+TEST_CASE("test_scratch_allocator","[test_allocation]")
+{
+    using allocation::scratch_allocator;
+    using container_type = std::vector<double,scratch_allocator<double>>;
+    const auto heap_allocations = allocation::scratch_statistics().heap_allocations;
+    {
+        container_type v(100,1.0);
+        container_type u(v);
+        u.resize(1000);
+        REQUIRE(std::accumulate(u.begin(),u.end(),0.0) == 100.0);
+        REQUIRE(allocation::scratch_statistics().in_use == 2);
+    }
+    REQUIRE(allocation::scratch_statistics().in_use == 0);
+    const auto warm_heap_allocations = allocation::scratch_statistics().heap_allocations;
+    REQUIRE(warm_heap_allocations-heap_allocations <= 1);
+    for (int i=0; i!=10; ++i){
+        container_type v(100,1.0);
+        container_type u(v);
+        u.resize(1000);
+    }
+    REQUIRE(allocation::scratch_statistics().heap_allocations == warm_heap_allocations);
+}
+
+//routines that use scratch_container don't allocate temporary buffers from heap in steady state
+TEST_CASE("test_scratch_routines_steady_state","[test_allocation]")
+{
+    using value_type = double;
+    using tensor_type = gtensor::tensor<value_type>;
+    using shape_type = typename tensor_type::shape_type;
+    tensor_type t(shape_type{20,30,40});
+    int i{0};
+    std::generate(t.begin(),t.end(),[&i](){return static_cast<value_type>(i++*7%101);});
+
+    auto routines = [&t](){
+        auto q = gtensor::quantile(t,std::vector<int>{0,2},0.3);
+        auto nq = gtensor::nanmedian(t,1);
+        auto s = gtensor::argsort(t,1);
+        auto p = gtensor::argpartition(t,std::vector<int>{3,10},2);
+        auto u = gtensor::unique(t,std::true_type{},std::true_type{},std::true_type{});
+        auto ua = gtensor::unique(t,std::false_type{},std::true_type{},std::true_type{},0);
+        return std::make_tuple(q,nq,s,p,u,ua);
+    };
+    const auto expected = routines();
+    const auto heap_allocations = allocation::scratch_heap_allocations();
+    const auto allocations = allocation::scratch_statistics().allocations;
+    for (int i=0; i!=3; ++i){
+        REQUIRE(routines() == expected);
+    }
+    REQUIRE(allocation::scratch_heap_allocations() == heap_allocations);
+    REQUIRE(allocation::scratch_statistics().allocations > allocations);
+    REQUIRE(allocation::scratch_statistics().in_use == 0);
+}
+
+TEST_CASE("test_scratch_allocator_alignment_release","[test_allocation]")
+{
+    using allocation::scratch_allocator;
+    {
+        std::vector<char,scratch_allocator<char>> c(3);
+        std::vector<double,scratch_allocator<double,64>> v(10);
+        std::vector<float,scratch_allocator<float,32>> u(10);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(v.data())%64 == 0);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(u.data())%32 == 0);
+        //release is deferred while arena is in use
+        allocation::release_scratch_arenas();
+        REQUIRE(allocation::scratch_statistics().capacity > 0);
+    }
+    REQUIRE(allocation::scratch_statistics().in_use == 0);
+    REQUIRE(allocation::scratch_statistics().capacity == 0);
+    {
+        std::vector<double,scratch_allocator<double,64>> v(10);
+        REQUIRE(allocation::scratch_statistics().capacity > 0);
+    }
+    allocation::release_scratch_arenas();
+    REQUIRE(allocation::scratch_statistics().capacity == 0);
+}
+
+//matmul packing buffers are reused across calls
+TEMPLATE_TEST_CASE("test_scratch_matmul_steady_state","[test_allocation]",
+    double,
+    float,
+    std::int64_t
+)
+{
+    using value_type = TestType;
+    using tensor_type = gtensor::tensor<value_type>;
+    using shape_type = typename tensor_type::shape_type;
+    tensor_type a(shape_type{70,50});
+    tensor_type b(shape_type{50,30});
+    std::iota(a.begin(),a.end(),value_type{0});
+    std::iota(b.begin(),b.end(),value_type{0});
+    const auto expected = gtensor::matmul(a,b);
+    const auto heap_allocations = allocation::scratch_heap_allocations();
+    for (int i=0; i!=3; ++i){
+        REQUIRE(gtensor::matmul(a,b) == expected);
+    }
+    REQUIRE(allocation::scratch_heap_allocations() == heap_allocations);
+    REQUIRE(allocation::scratch_statistics().in_use == 0);
+}
+
+TEMPLATE_TEST_CASE("test_huge_page_allocator","[test_allocation]",
+    (allocation::huge_page_allocator<double>),
+    (allocation::huge_page_allocator<double,multithreading::exec_pol<1>>),
+    (allocation::huge_page_allocator<double,multithreading::exec_pol<4>,allocation::numa_policy::interleave>),
+    (allocation::huge_page_allocator<double,multithreading::exec_pol<4>,allocation::numa_policy::first_touch,true>)
+)
+{
+    using allocator_type = TestType;
+    allocator_type alloc{};
+    //0n
+    auto test_data = std::make_tuple(
+        std::size_t{1},
+        std::size_t{1000},
+        allocation::detail::huge_page_threshold/sizeof(double),
+        std::size_t{3}*allocation::detail::huge_page_threshold/sizeof(double)+1
+    );
+    auto test = [&alloc](const auto& n){
+        auto p = alloc.allocate(n);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(p)%allocator_type::alignment == 0);
+        std::fill(p,p+n,1.0);
+        REQUIRE(std::accumulate(p,p+n,0.0) == static_cast<double>(n));
+        alloc.deallocate(p,n);
+    };
+    helpers_for_testing::apply_by_element(test,test_data);
+}
+
+TEMPLATE_TEST_CASE("test_huge_page_config","[test_allocation]",
+    gtensor::config::c_order,
+    gtensor::config::f_order
+)
+{
+    using value_type = double;
+    using order = TestType;
+    using policy = multithreading::exec_pol<4>;
+    using config_type = gtensor::config::extend_config_t<gtensor::config::huge_page_config<gtensor::config::default_config,policy>,value_type>;
+    using tensor_type = gtensor::tensor<value_type,order,config_type>;
+    using shape_type = typename tensor_type::shape_type;
+    using expected_tensor_type = gtensor::tensor<value_type,order>;
+    const shape_type shape{300,200,10};
+    tensor_type t(shape,value_type{0});
+    expected_tensor_type expected(shape,value_type{0});
+    REQUIRE(t.size()*static_cast<std::ptrdiff_t>(sizeof(value_type)) >= static_cast<std::ptrdiff_t>(allocation::detail::huge_page_threshold));
+    std::iota(t.begin(),t.end(),value_type{0});
+    std::iota(expected.begin(),expected.end(),value_type{0});
+    REQUIRE(t == expected);
+    REQUIRE(t.sum(policy{},std::vector<int>{0,2}) == expected.sum(std::vector<int>{0,2}));
+    REQUIRE((t+t).copy(policy{}) == expected+expected);
+}
@@ -8,6 +8,7 @@
 
 #include <vector>
 #include <array>
+#include <string>
 #include "catch.hpp"
 #include "builder.hpp"
 #include "tensor.hpp"
@@ -830,4 +831,60 @@ TEST_CASE("test_builder_diag_exception","[test_builder]")
     REQUIRE_THROWS_AS(diag(tensor_type(1)), value_error);
     REQUIRE_THROWS_AS(diag(tensor_type{{{1}}}), value_error);
     REQUIRE_THROWS_AS(diag(tensor_type{}.reshape(0,2,2)), value_error);
-}
\ No newline at end of file
+}
+TEMPLATE_TEST_CASE("test_builder_policy","[test_builder]",
+    multithreading::exec_pol<1>,
+    multithreading::exec_pol<4>,
+    multithreading::exec_pol<0>
+)
+{
+    using policy = TestType;
+    using value_type = double;
+    using gtensor::config::c_order;
+    using gtensor::config::f_order;
+    using gtensor::tensor;
+    using gtensor::tensor_close;
+    using helpers_for_testing::apply_by_element;
+
+    //0result,1expected
+    auto test_data = std::make_tuple(
+        //empty
+        std::make_tuple(gtensor::empty<value_type>(policy{},{0}).shape(),tensor<value_type>(std::vector<int>{0}).shape()),
+        std::make_tuple(gtensor::empty<value_type,f_order>(policy{},std::vector<int>{10,20,30}).shape(),tensor<value_type,f_order>(std::vector<int>{10,20,30}).shape()),
+        //full,zeros,ones
+        std::make_tuple(gtensor::full<value_type>(policy{},{0},1),gtensor::full<value_type>({0},1)),
+        std::make_tuple(gtensor::full<value_type>(policy{},{3},2),gtensor::full<value_type>({3},2)),
+        std::make_tuple(gtensor::full<value_type,f_order>(policy{},std::vector<int>{10,20,30},3),gtensor::full<value_type,f_order>(std::vector<int>{10,20,30},3)),
+        std::make_tuple(gtensor::full<std::string>(policy{},{10,20},"a"),gtensor::full<std::string>({10,20},"a")),
+        std::make_tuple(gtensor::zeros<value_type>(policy{},{10,20,30}),gtensor::zeros<value_type>({10,20,30})),
+        std::make_tuple(gtensor::ones<int,f_order>(policy{},{10,20,30}),gtensor::ones<int,f_order>({10,20,30})),
+        //eye
+        std::make_tuple(gtensor::eye<value_type>(policy{},0,0),gtensor::eye<value_type>(0,0)),
+        std::make_tuple(gtensor::eye<value_type>(policy{},100,50,-3),gtensor::eye<value_type>(100,50,-3)),
+        std::make_tuple(gtensor::eye<int,f_order>(policy{},50,100,2),gtensor::eye<int,f_order>(50,100,2)),
+        //arange
+        std::make_tuple(gtensor::arange(policy{},0),gtensor::arange(0)),
+        std::make_tuple(gtensor::arange(policy{},1000),gtensor::arange(1000)),
+        std::make_tuple(gtensor::arange(policy{},3,1000,7),gtensor::arange(3,1000,7)),
+        std::make_tuple(gtensor::arange<int>(policy{},2.2,5.0,0.5),gtensor::arange<int>(2.2,5.0,0.5)),
+        std::make_tuple(gtensor::arange(policy{},0.5,1000.0,0.25),gtensor::arange(0.5,1000.0,0.25))
+    );
+    auto test = [](const auto& t){
+        auto result = std::get<0>(t);
+        auto expected = std::get<1>(t);
+        REQUIRE(result == expected);
+    };
+    apply_by_element(test,test_data);
+
+    //linspace, elements are calculated as start+i*step
+    REQUIRE(gtensor::linspace(policy{},0,1,0) == gtensor::linspace(0,1,0));
+    REQUIRE(gtensor::linspace(policy{},3,8,1) == tensor<value_type>{3});
+    REQUIRE(tensor_close(gtensor::linspace(policy{},3,8,11),tensor<value_type>{3.0,3.5,4.0,4.5,5.0,5.5,6.0,6.5,7.0,7.5,8.0}));
+    REQUIRE(tensor_close(gtensor::linspace(policy{},0,1,4,false),tensor<value_type>{0.0,0.25,0.5,0.75}));
+    //sequential linspace accumulates step, so results differ in last digits
+    REQUIRE(tensor_close(gtensor::linspace(policy{},-1.0,1.0,1001),gtensor::linspace(-1.0,1.0,1001),1E-10,1E-10));
+    REQUIRE(tensor_close(gtensor::linspace<float>(policy{},-1,1,1000,false),gtensor::linspace<float>(-1,1,1000,false),1E-4f,1E-4f));
+    //tensor interval
+    REQUIRE(tensor_close(gtensor::linspace(policy{},tensor<value_type>{0,1},tensor<value_type>{1,2},5,true,1),gtensor::linspace(tensor<value_type>{0,1},tensor<value_type>{1,2},5,true,1)));
+    REQUIRE_THROWS_AS(gtensor::linspace(policy{},0,1,-1),gtensor::value_error);
+}
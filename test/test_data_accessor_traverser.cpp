@@ -320,6 +320,83 @@ TEST_CASE("test_walker_forward_traverser","test_data_accessor")
     apply_by_element(test, test_data);
 }
 
+TEST_CASE("test_walk_coalesced","test_data_accessor")
+{
+    using value_type = int;
+    using config_type = gtensor::config::extend_config_t<test_config::config_storage_selector_t<std::vector>,value_type>;
+    using shape_type = typename config_type::shape_type;
+    using dim_type = typename config_type::dim_type;
+    using index_type = typename config_type::index_type;
+    using storage_type = typename config_type::template storage<value_type>;
+    using indexer_type = gtensor::basic_indexer<storage_type&>;
+    using gtensor::config::c_order;
+    using gtensor::config::f_order;
+    using walker_type = gtensor::indexer_walker<config_type, indexer_type, c_order>;
+    using gtensor::detail::make_strides;
+    using gtensor::detail::make_adapted_strides;
+    using gtensor::detail::make_reset_strides;
+    using gtensor::detail::walk_coalesced;
+    using gtensor::detail::can_coalesce;
+    using helpers_for_testing::apply_by_element;
+
+    const auto storage_c = storage_type{1,2,3,4,5,6,7,8,9,10,11,12};
+    const auto storage_f = storage_type{1,7,3,9,5,11,2,8,4,10,6,12};
+    const auto expected_c = std::vector<value_type>{1,2,3,4,5,6,7,8,9,10,11,12};
+    const auto expected_f = std::vector<value_type>{1,7,3,9,5,11,2,8,4,10,6,12};
+
+    //0elements_order,1storage,2shape,3traverse_order,4expected
+    auto test_data = std::make_tuple(
+        std::make_tuple(c_order{}, storage_c, shape_type{}, c_order{}, std::vector<value_type>{1}),
+        std::make_tuple(c_order{}, storage_c, shape_type{0}, c_order{}, std::vector<value_type>{}),
+        std::make_tuple(c_order{}, storage_c, shape_type{2,0,3}, f_order{}, std::vector<value_type>{}),
+        std::make_tuple(c_order{}, storage_c, shape_type{1}, c_order{}, std::vector<value_type>{1}),
+        std::make_tuple(c_order{}, storage_c, shape_type{1,1,1}, f_order{}, std::vector<value_type>{1}),
+        std::make_tuple(c_order{}, storage_c, shape_type{12}, c_order{}, expected_c),
+        std::make_tuple(c_order{}, storage_c, shape_type{12}, f_order{}, expected_c),
+        std::make_tuple(c_order{}, storage_c, shape_type{2,3,2}, c_order{}, expected_c),
+        std::make_tuple(c_order{}, storage_c, shape_type{1,2,1,3,2,1}, c_order{}, expected_c),
+        std::make_tuple(c_order{}, storage_c, shape_type{2,3,2}, f_order{}, expected_f),
+        std::make_tuple(c_order{}, storage_c, shape_type{2,1,3,2}, f_order{}, expected_f),
+        std::make_tuple(f_order{}, storage_f, shape_type{2,3,2}, f_order{}, expected_f),
+        std::make_tuple(f_order{}, storage_f, shape_type{2,3,1,2}, c_order{}, expected_c),
+        std::make_tuple(f_order{}, storage_f, shape_type{2,3,2}, c_order{}, expected_c)
+    );
+    auto test = [](const auto& t){
+        auto elements_order = std::get<0>(t);
+        auto storage = std::get<1>(t);
+        auto shape = std::get<2>(t);
+        auto traverse_order = std::get<3>(t);
+        auto expected = std::get<4>(t);
+        using traverse_order_type = decltype(traverse_order);
+        auto indexer = indexer_type{storage};
+        auto strides = make_strides(shape, elements_order);
+        auto adapted_strides = make_adapted_strides(shape,strides);
+        auto reset_strides = make_reset_strides(shape,strides);
+        auto walker =  walker_type{adapted_strides, reset_strides, index_type{0}, indexer};
+        std::vector<value_type> result{};
+        walk_coalesced<traverse_order_type>(shape,walker,[&result](const auto& w){result.push_back(*w);});
+        REQUIRE(result == expected);
+        //walker is reset
+        REQUIRE(*walker == storage.front());
+    };
+    apply_by_element(test, test_data);
+
+    SECTION("test_can_coalesce")
+    {
+        auto storage = storage_c;
+        auto indexer = indexer_type{storage};
+        const auto shape = shape_type{2,3,2};
+        auto strides = make_strides(shape, c_order{});
+        auto adapted_strides = make_adapted_strides(shape,strides);
+        auto reset_strides = make_reset_strides(shape,strides);
+        auto walker =  walker_type{adapted_strides, reset_strides, index_type{0}, indexer};
+        REQUIRE(can_coalesce(walker,dim_type{1},dim_type{2},index_type{2}));
+        REQUIRE(can_coalesce(walker,dim_type{0},dim_type{1},index_type{3}));
+        REQUIRE(!can_coalesce(walker,dim_type{1},dim_type{0},index_type{2}));
+        REQUIRE(!can_coalesce(walker,dim_type{0},dim_type{2},index_type{2}));
+    }
+}
+
 TEST_CASE("test_walker_bidirectional_traverser","test_data_accessor")
 {
     using value_type = int;
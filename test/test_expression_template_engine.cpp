@@ -11,6 +11,7 @@
 #include "helpers_for_testing.hpp"
 #include "expression_template_operator.hpp"
 #include "tensor.hpp"
+#include "tensor_math.hpp"
 
 namespace test_expression_template_engine_{
 
@@ -509,3 +510,293 @@ TEMPLATE_TEST_CASE("test_expression_template_operator_a_operator","[test_express
     apply_by_element(test, test_data);
 }
 
+
+TEMPLATE_TEST_CASE("test_expression_template_simd_eval","[test_expression_template_engine]",
+    double,
+    float,
+    std::int32_t,
+    std::int64_t
+)
+{
+    using value_type = TestType;
+    using gtensor::config::c_order;
+    using gtensor::config::f_order;
+    using tensor_type = gtensor::tensor<value_type,c_order>;
+    using shape_type = typename tensor_type::shape_type;
+    using gtensor::detail::simd_root;
+    using gtensor::detail::simd_width_v;
+    using helpers_for_testing::generate_lehmer;
+    using helpers_for_testing::apply_by_element;
+    using gtensor::tensor_equal;
+    //expected is made by walker traverse, that is never vectorized
+    auto make_expected = [](const auto& e){
+        using res_value_type = typename std::decay_t<decltype(e)>::value_type;
+        return gtensor::tensor<res_value_type>(e.shape(),e.begin(),e.end());
+    };
+    auto test_shape = [&make_expected](const auto& shape, auto order){
+        using order_type = decltype(order);
+        using tensor_type_ = gtensor::tensor<value_type,order_type>;
+        tensor_type_ a(shape);
+        tensor_type_ b(shape);
+        tensor_type_ c(shape);
+        generate_lehmer(a.begin(),a.end(),[](const auto& e){return e%20-10;},1);
+        generate_lehmer(b.begin(),b.end(),[](const auto& e){return e%21+1;},2);
+        generate_lehmer(c.begin(),c.end(),[](const auto& e){return e%19-9;},3);
+        auto test_expression = [&make_expected](const auto& e){
+            const auto expected = make_expected(e);
+            REQUIRE(e.copy() == expected);
+            REQUIRE(e.eval(multithreading::exec_pol<4>{}) == expected);
+            REQUIRE(e.eval(multithreading::exec_pol_rt{3}) == expected);
+        };
+        test_expression(a+b);
+        test_expression(a-b+c);
+        test_expression(a*b-c);
+        test_expression(a*3+b*2-c);
+        test_expression(2-a*b);
+        test_expression(a+1.0f);
+        test_expression(a+1L);
+        test_expression(a/b);
+        if constexpr (std::is_integral_v<value_type>){
+            test_expression(a%b);
+        }
+        test_expression(gtensor::fmax(a,b));
+        test_expression(gtensor::fmin(a*b,c));
+        test_expression(gtensor::fma(a,b,c));
+        test_expression(gtensor::equal(a,c));
+        test_expression(gtensor::not_equal(a,c));
+        test_expression(a>c+b);
+        test_expression(a>=c);
+        test_expression(a<c);
+        test_expression(a<=c);
+        test_expression(a<0);
+        test_expression(0<=a);
+        //operands of different layouts
+        test_expression(a+b.copy(c_order{})*c.copy(f_order{}));
+    };
+    //0shape
+    auto test_data = std::make_tuple(
+        shape_type{0},
+        shape_type{1},
+        shape_type{7},
+        shape_type{33},
+        shape_type{3,5},
+        shape_type{17,31,9},
+        shape_type{2,3,4,5,6}
+    );
+    auto test = [&test_shape](const auto& shape){
+        test_shape(shape,c_order{});
+        test_shape(shape,f_order{});
+    };
+    apply_by_element(test,test_data);
+
+    //vectorized if register exists for value_type
+    if constexpr (simd_width_v<value_type> != 0){
+        REQUIRE(simd_root<decltype(std::declval<tensor_type>()+std::declval<tensor_type>())>::value);
+        REQUIRE(simd_root<decltype(std::declval<tensor_type>()-std::declval<tensor_type>()+value_type{2})>::value);
+        REQUIRE(simd_root<decltype(std::declval<tensor_type>()-std::declval<tensor_type>()*value_type{2})>::value == gtensor::detail::simd_has_mul_v<value_type>);
+        REQUIRE(simd_root<decltype(std::declval<tensor_type>()<std::declval<tensor_type>()+std::declval<tensor_type>())>::value);
+    }
+    REQUIRE(!simd_root<decltype(std::declval<tensor_type>().transpose()+std::declval<tensor_type>())>::value);
+    REQUIRE(!simd_root<decltype(gtensor::equal(std::declval<tensor_type>()<std::declval<tensor_type>(),std::declval<gtensor::tensor<bool>>()))>::value);
+    //storage without pointer data access, e.g. std::vector<bool>
+    {
+        using config_type = gtensor::config::extend_config_t<test_config::config_storage_selector_t<std::vector>,value_type>;
+        using vector_tensor_type = gtensor::tensor<value_type,c_order,config_type>;
+        vector_tensor_type a{1,2,3,4,5,6,7,8,9,10,11};
+        vector_tensor_type b{11,10,9,8,7,6,5,4,3,2,1};
+        REQUIRE((a+b).copy() == make_expected(a+b));
+        REQUIRE((a<b).copy() == make_expected(a<b));
+    }
+    //NaN
+    if constexpr (std::is_floating_point_v<value_type>){
+        const auto nan = std::numeric_limits<value_type>::quiet_NaN();
+        const std::vector<value_type> a_elements{1,nan,3,nan,5,6,nan,8,9,10,nan,12,13,14,15,16,17,nan,19};
+        const std::vector<value_type> b_elements{nan,2,nan,nan,4,7,1,nan,10,9,nan,11,14,13,nan,17,16,nan,18};
+        tensor_type a(shape_type{19},a_elements.begin(),a_elements.end());
+        tensor_type b(shape_type{19},b_elements.begin(),b_elements.end());
+        REQUIRE(tensor_equal(gtensor::fmax(a,b).copy(),make_expected(gtensor::fmax(a,b)),true));
+        REQUIRE(tensor_equal(gtensor::fmin(a,b).copy(),make_expected(gtensor::fmin(a,b)),true));
+        REQUIRE(gtensor::equal(a,b).copy() == make_expected(gtensor::equal(a,b)));
+        REQUIRE(gtensor::not_equal(a,b).copy() == make_expected(gtensor::not_equal(a,b)));
+        REQUIRE((a<b).copy() == make_expected(a<b));
+        REQUIRE((a>=b).copy() == make_expected(a>=b));
+    }
+}
+
+TEMPLATE_TEST_CASE("test_expression_template_simd_assign","[test_expression_template_engine]",
+    double,
+    float,
+    std::int32_t,
+    std::int64_t
+)
+{
+    using value_type = TestType;
+    using gtensor::config::c_order;
+    using gtensor::config::f_order;
+    using tensor_type = gtensor::tensor<value_type,c_order>;
+    using shape_type = typename tensor_type::shape_type;
+    using gtensor::detail::simd_assign_tensors;
+    using gtensor::detail::simd_width_v;
+    using helpers_for_testing::generate_lehmer;
+    using helpers_for_testing::apply_by_element;
+    //expected is made by elementwise loop over walker iterators, that is never vectorized
+    auto make_expected = [](const auto& lhs, const auto& rhs, auto f){
+        gtensor::tensor<value_type> res(lhs.shape(),lhs.begin(),lhs.end());
+        if constexpr (gtensor::detail::is_tensor_v<std::decay_t<decltype(rhs)>>){
+            auto it = res.begin();
+            for (auto rhs_it=rhs.begin(); rhs_it!=rhs.end(); ++rhs_it,++it){
+                f(*it,*rhs_it);
+            }
+        }else{
+            for (auto it=res.begin(); it!=res.end(); ++it){
+                f(*it,rhs);
+            }
+        }
+        return res;
+    };
+    auto test_shape = [&make_expected](const auto& shape, auto order){
+        using order_type = decltype(order);
+        using tensor_type_ = gtensor::tensor<value_type,order_type>;
+        tensor_type_ a(shape);
+        tensor_type_ b(shape);
+        tensor_type_ c(shape);
+        generate_lehmer(a.begin(),a.end(),[](const auto& e){return e%20-10;},1);
+        generate_lehmer(b.begin(),b.end(),[](const auto& e){return e%21+1;},2);
+        generate_lehmer(c.begin(),c.end(),[](const auto& e){return e%19-9;},3);
+        auto test_assign = [&make_expected,&a](const auto& rhs){
+            auto test_policy = [&make_expected,&a,&rhs](auto policy){
+                auto test_f = [&a,&rhs,&make_expected](auto f, auto apply){
+                    auto lhs = a.copy();
+                    const auto expected = make_expected(a,rhs,f);
+                    apply(lhs);
+                    REQUIRE(lhs == expected);
+                };
+                test_f(gtensor::operations::assign{},[&](auto& lhs){gtensor::assign(policy,lhs,rhs);});
+                test_f(gtensor::operations::assign_add{},[&](auto& lhs){gtensor::assign_add(policy,lhs,rhs);});
+                test_f(gtensor::operations::assign_sub{},[&](auto& lhs){gtensor::assign_sub(policy,lhs,rhs);});
+                test_f(gtensor::operations::assign_mul{},[&](auto& lhs){gtensor::assign_mul(policy,lhs,rhs);});
+                if constexpr (std::is_floating_point_v<value_type>){
+                    test_f(gtensor::operations::assign_div{},[&](auto& lhs){gtensor::assign_div(policy,lhs,rhs);});
+                }
+            };
+            test_policy(multithreading::exec_pol<1>{});
+            test_policy(multithreading::exec_pol<4>{});
+            test_policy(multithreading::exec_pol_rt{3});
+        };
+        test_assign(b);
+        test_assign(b*c-a);
+        test_assign(a+b);
+        test_assign(value_type{3});
+        test_assign(2);
+        test_assign(1.5);
+        //operands of different layouts
+        test_assign(b.copy(c_order{})*c.copy(f_order{}));
+        //lhs is operand of rhs
+        {
+            auto lhs = a.copy();
+            lhs+=lhs*b;
+            REQUIRE(lhs == a+a*b);
+        }
+    };
+    auto test_data = std::make_tuple(
+        shape_type{0},
+        shape_type{1},
+        shape_type{7},
+        shape_type{33},
+        shape_type{3,5},
+        shape_type{17,31,9},
+        shape_type{2,3,4,5,6}
+    );
+    auto test = [&test_shape](const auto& shape){
+        test_shape(shape,c_order{});
+        test_shape(shape,f_order{});
+    };
+    apply_by_element(test,test_data);
+
+    //vectorized if register exists for value_type, rhs must have the same shape and layout as lhs
+    tensor_type a(shape_type{4,5},1);
+    tensor_type b(shape_type{4,5},2);
+    const auto policy = multithreading::exec_pol<1>{};
+    if constexpr (simd_width_v<value_type> != 0){
+        REQUIRE(simd_assign_tensors(policy,gtensor::operations::assign_add{},a,b));
+        REQUIRE(simd_assign_tensors(policy,gtensor::operations::assign_sub{},a,b+b));
+        REQUIRE(simd_assign_tensors(policy,gtensor::operations::assign{},a,value_type{2}));
+        REQUIRE(simd_assign_tensors(policy,gtensor::operations::assign_mul{},a,b) == gtensor::detail::simd_has_mul_v<value_type>);
+    }
+    REQUIRE(!simd_assign_tensors(policy,gtensor::operations::assign_add{},a,tensor_type(shape_type{5},1)));
+    REQUIRE(!simd_assign_tensors(policy,gtensor::operations::assign_add{},a,b.transpose().transpose()));
+    REQUIRE(!simd_assign_tensors(policy,gtensor::operations::assign_add{},a,b.copy(f_order{})));
+    REQUIRE(!simd_assign_tensors(policy,gtensor::operations::assign_mod{},a,b));
+    if constexpr (std::is_integral_v<value_type>){
+        REQUIRE(!simd_assign_tensors(policy,gtensor::operations::assign_add{},a,1.5));
+        REQUIRE(!simd_assign_tensors(policy,gtensor::operations::assign_div{},a,b));
+    }
+    //broadcast rhs is evaluated by scalar path
+    tensor_type c(shape_type{4,5},1);
+    c+=tensor_type{1,2,3,4,5};
+    REQUIRE(c == tensor_type{{2,3,4,5,6},{2,3,4,5,6},{2,3,4,5,6},{2,3,4,5,6}});
+}
+
+TEMPLATE_TEST_CASE("test_expression_template_coalesced_eval","[test_expression_template_engine]",
+    gtensor::config::c_order,
+    gtensor::config::f_order
+)
+{
+    using value_type = int;
+    using order = TestType;
+    using gtensor::config::c_order;
+    using gtensor::config::f_order;
+    using tensor_type = gtensor::tensor<value_type,order>;
+    using shape_type = typename tensor_type::shape_type;
+    using slice_type = typename tensor_type::slice_type;
+    using helpers_for_testing::generate_lehmer;
+    //expected is made by walker iterator traverse, that never coalesces axes
+    auto make_expected = [](const auto& e){
+        using res_value_type = typename std::decay_t<decltype(e)>::value_type;
+        return gtensor::tensor<res_value_type>(e.shape(),e.begin(),e.end());
+    };
+    tensor_type a(shape_type{4,6,5});
+    tensor_type b(shape_type{1,6,5});
+    tensor_type c(shape_type{4,1,5});
+    tensor_type d(shape_type{5});
+    generate_lehmer(a.begin(),a.end(),[](const auto& e){return e%20-10;},1);
+    generate_lehmer(b.begin(),b.end(),[](const auto& e){return e%21+1;},2);
+    generate_lehmer(c.begin(),c.end(),[](const auto& e){return e%19-9;},3);
+    generate_lehmer(d.begin(),d.end(),[](const auto& e){return e%17-8;},4);
+    auto test_expression = [&make_expected](const auto& e){
+        const auto expected = make_expected(e);
+        REQUIRE(e.copy() == expected);
+        REQUIRE(e.copy(f_order{}) == expected);
+        REQUIRE(e.eval(multithreading::exec_pol<4>{}) == expected);
+        REQUIRE(e.eval(multithreading::exec_pol_rt{3}) == expected);
+    };
+    //broadcast operands
+    test_expression(a+b);
+    test_expression(a*c-b);
+    test_expression(a+d);
+    test_expression(b+c);
+    test_expression(b-d*c);
+    //views
+    test_expression(a.transpose());
+    test_expression(a.transpose()+a.transpose());
+    test_expression(a(1));
+    test_expression(a(slice_type{},slice_type{1,5}));
+    test_expression(a(slice_type{},slice_type{},slice_type{{},{},2})+d(slice_type{{},{},2}));
+    test_expression(a(slice_type{1,3})*b);
+    test_expression(a.reshape(-1)+1);
+    test_expression(d.reshape(5,1)+d);
+    //assign to view
+    {
+        auto lhs = a.copy();
+        auto expected = a.copy();
+        auto lhs_view = lhs.transpose();
+        auto expected_view = expected.transpose();
+        const auto rhs = (b+c).transpose();
+        auto it = expected_view.begin();
+        for (auto rhs_it = rhs.begin(), rhs_last = rhs.end(); rhs_it!=rhs_last; ++rhs_it,++it){
+            *it+=*rhs_it;
+        }
+        gtensor::assign_add(multithreading::exec_pol<4>{},lhs_view,rhs);
+        REQUIRE(lhs == expected);
+    }
+}
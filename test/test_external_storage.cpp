@@ -0,0 +1,140 @@
+/*
+* GTensor - computation library
+* Copyright (c) 2022 Ivan Malezhyk <ivanmzk@gmail.com>
+*
+* Distributed under the Boost Software License, Version 1.0.
+* The full license is in the file LICENSE.txt, distributed with this software.
+*/
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include "catch.hpp"
+#include "external_storage.hpp"
+#include "tensor_math.hpp"
+#include "tensor.hpp"
+#include "helpers_for_testing.hpp"
+
+TEMPLATE_TEST_CASE("test_external_storage","[test_external_storage]",
+    double,
+    int
+)
+{
+    using value_type = TestType;
+    using storage_type = gtensor::external_storage<value_type>;
+    using size_type = typename storage_type::size_type;
+
+    SECTION("own_buffer")
+    {
+        storage_type s0{};
+        REQUIRE(s0.empty());
+        REQUIRE(s0.owner() == nullptr);
+        storage_type s1(size_type{4},value_type{2});
+        REQUIRE(std::vector<value_type>(s1.begin(),s1.end()) == std::vector<value_type>(4,value_type{2}));
+        REQUIRE(s1.owner() != nullptr);
+        const storage_type s2{1,2,3};
+        REQUIRE(std::vector<value_type>(s2.begin(),s2.end()) == std::vector<value_type>{1,2,3});
+        storage_type s3{s2};
+        REQUIRE(s3.data() != s2.data());
+        REQUIRE(std::vector<value_type>(s3.begin(),s3.end()) == std::vector<value_type>{1,2,3});
+    }
+    SECTION("not_owning")
+    {
+        std::vector<value_type> buffer{1,2,3,4,5};
+        storage_type s(buffer.data(),buffer.size());
+        REQUIRE(s.data() == buffer.data());
+        REQUIRE(s.size() == buffer.size());
+        REQUIRE(s.owner() == nullptr);
+        s[0] = value_type{10};
+        REQUIRE(buffer[0] == value_type{10});
+        //copy owns its buffer
+        const storage_type c{s};
+        REQUIRE(c.data() != buffer.data());
+        REQUIRE(c.owner() != nullptr);
+        REQUIRE(std::vector<value_type>(c.begin(),c.end()) == buffer);
+        //move steals buffer
+        const storage_type m{std::move(s)};
+        REQUIRE(m.data() == buffer.data());
+        REQUIRE(s.empty());
+    }
+    SECTION("deleter")
+    {
+        int deleter_calls{0};
+        auto buffer = new value_type[3]{1,2,3};
+        {
+            storage_type s(buffer,3,[&deleter_calls](value_type* p){++deleter_calls; delete[] p;});
+            storage_type m{std::move(s)};
+            REQUIRE(m.data() == buffer);
+            REQUIRE(deleter_calls == 0);
+        }
+        REQUIRE(deleter_calls == 1);
+    }
+    SECTION("shared_owner")
+    {
+        auto segment = std::make_shared<std::vector<value_type>>(std::vector<value_type>{1,2,3});
+        std::weak_ptr<std::vector<value_type>> observer{segment};
+        {
+            storage_type s(segment->data(),segment->size(),segment);
+            segment.reset();
+            REQUIRE(!observer.expired());
+            REQUIRE(std::vector<value_type>(s.begin(),s.end()) == std::vector<value_type>{1,2,3});
+        }
+        REQUIRE(observer.expired());
+    }
+}
+
+TEMPLATE_TEST_CASE("test_external_storage_from_buffer","[test_external_storage]",
+    gtensor::config::c_order,
+    gtensor::config::f_order
+)
+{
+    using value_type = double;
+    using order = TestType;
+    using tensor_type = gtensor::tensor<value_type,order>;
+    using gtensor::from_buffer;
+
+    std::vector<value_type> buffer{1,2,3,4,5,6};
+    const auto expected = std::is_same_v<order,gtensor::config::c_order> ?
+        tensor_type{{1,2,3},{4,5,6}} :
+        tensor_type{{1,3,5},{2,4,6}};
+
+    SECTION("view_buffer")
+    {
+        auto t = from_buffer<order>(buffer.data(),{2,3});
+        REQUIRE(std::is_same_v<typename decltype(t)::storage_type,gtensor::external_storage<value_type>>);
+        REQUIRE(t.data() == buffer.data());
+        REQUIRE(t == expected);
+        REQUIRE(t.sum(0) == expected.sum(0));
+        REQUIRE((t+t.transpose().transpose()) == expected+expected);
+        REQUIRE(t.transpose().copy() == expected.transpose());
+        //operations write to buffer
+        t+=value_type{1};
+        REQUIRE(buffer == std::vector<value_type>{2,3,4,5,6,7});
+        t(1).assign(value_type{0});
+        REQUIRE(t(1) == tensor_type{0,0,0});
+        REQUIRE(std::count(buffer.begin(),buffer.end(),value_type{0}) == 3);
+        //deep copy doesn't alias buffer
+        auto c = t.copy();
+        c.assign(value_type{-1});
+        REQUIRE(buffer != std::vector<value_type>(6,value_type{-1}));
+    }
+    SECTION("shape_container_and_scalar")
+    {
+        auto t = from_buffer<order>(buffer.data(),std::vector<int>{3,2});
+        REQUIRE(t.shape() == typename decltype(t)::shape_type{3,2});
+        auto t1 = from_buffer<order>(buffer.data(),4);
+        REQUIRE(t1 == tensor_type{1,2,3,4});
+    }
+    SECTION("shared_owner")
+    {
+        auto segment = std::make_shared<std::vector<value_type>>(buffer);
+        std::weak_ptr<std::vector<value_type>> observer{segment};
+        {
+            auto t = from_buffer<order>(segment->data(),{2,3},segment);
+            segment.reset();
+            REQUIRE(!observer.expired());
+            REQUIRE(t == expected);
+        }
+        REQUIRE(observer.expired());
+    }
+}
@@ -10,6 +10,7 @@
 #include <iomanip>
 #include "catch.hpp"
 #include "helpers_for_testing.hpp"
+#include "config_for_testing.hpp"
 #include "tensor_math.hpp"
 #include "tensor.hpp"
 
@@ -231,6 +232,55 @@ TEMPLATE_TEST_CASE("test_math_cumsum_nancumsum_nan_values_policy","test_math",
     apply_by_element(test,test_data);
 }
 
+TEMPLATE_TEST_CASE("test_math_cumsum_nancumsum_accuracy","test_math",
+    (std::tuple<gtensor::config::mode_sum_pairwise,multithreading::exec_pol<1>>),
+    (std::tuple<gtensor::config::mode_sum_pairwise,multithreading::exec_pol<4>>),
+    (std::tuple<gtensor::config::mode_sum_kahan,multithreading::exec_pol<1>>),
+    (std::tuple<gtensor::config::mode_sum_kahan,multithreading::exec_pol<4>>)
+)
+{
+    using sum_mode = std::tuple_element_t<0,TestType>;
+    using policy = std::tuple_element_t<1,TestType>;
+    using value_type = float;
+    using config_type = gtensor::config::extend_config_t<test_config::config_sum_mode_selector_t<sum_mode>,value_type>;
+    using tensor_type = gtensor::tensor<value_type,gtensor::config::c_order,config_type>;
+    using gtensor::cumsum;
+    using gtensor::nancumsum;
+    static constexpr value_type nan = std::numeric_limits<value_type>::quiet_NaN();
+    //float running sum of such number of elements loses several digits
+    const int rows = 2;
+    const int n = 1<<20;
+    tensor_type t(std::vector<int>{rows,n});
+    std::vector<double> expected(rows*n,0.0);
+    auto it = t.begin();
+    for (int i=0; i!=rows; ++i){
+        double s{0};
+        for (int j=0; j!=n; ++j,++it){
+            const auto e = static_cast<value_type>(0.1+0.01*(j%7)+i);
+            *it = e;
+            s+=static_cast<double>(e);
+            expected[i*n+j] = s;
+        }
+    }
+    auto near = [](double result, double expected_){
+        return std::abs(result-expected_) <= 1E-6*std::abs(expected_);
+    };
+    auto check = [&near](const auto& result, const std::vector<double>& expected_){
+        auto res_it = result.begin();
+        for (auto exp_it=expected_.begin(); exp_it!=expected_.end(); ++exp_it,++res_it){
+            if (!near(*res_it,*exp_it)){
+                return false;
+            }
+        }
+        return true;
+    };
+    REQUIRE(check(cumsum(policy{},t,1),expected));
+    t.element(0,0) = nan;
+    auto result_nan = nancumsum(policy{},t,1);
+    REQUIRE(result_nan.element(0,0) == value_type{0});
+    REQUIRE(near(result_nan.element(0,n-1),expected[n-1]-static_cast<double>(static_cast<value_type>(0.1))));
+}
+
 //cumprod,nancumprod
 TEMPLATE_TEST_CASE("test_math_cumprod_nancumprod","test_math",
     double,
@@ -7,6 +7,8 @@
 */
 
 #include <limits>
+#include <cstdint>
+#include <complex>
 #include <iomanip>
 #include "catch.hpp"
 #include "helpers_for_testing.hpp"
@@ -119,6 +121,12 @@ TEMPLATE_TEST_CASE("test_math_matmul","test_math",
     {
         test_matmul(multithreading::exec_pol<16>{});
     }
+    SECTION("test_matmul_exec_pol_rt")
+    {
+        test_matmul(multithreading::exec_pol_rt{});
+        test_matmul(multithreading::exec_pol_rt{3});
+        test_matmul(multithreading::exec_pol_rt{4,8});
+    }
 }
 
 TEST_CASE("test_math_matmul_exception","test_math")
@@ -234,6 +242,8 @@ TEMPLATE_TEST_CASE("test_math_matmul_nd_nd_big","test_math",
     REQUIRE(res==matmul(multithreading::exec_pol<5>{},a,b));
     REQUIRE(res==matmul(multithreading::exec_pol<10>{},a,b));
     REQUIRE(res==matmul(multithreading::exec_pol<16>{},a,b));
+    REQUIRE(res==matmul(multithreading::exec_pol_rt{4},a,b));
+    REQUIRE(res==matmul(multithreading::exec_pol_rt{16,64},a,b));
 }
 
 TEMPLATE_TEST_CASE("test_math_matmul_1d_nd_big","test_math",
@@ -274,6 +284,7 @@ TEMPLATE_TEST_CASE("test_math_matmul_1d_nd_big","test_math",
         REQUIRE(expected==matmul(multithreading::exec_pol<5>{},a,b));
         REQUIRE(expected==matmul(multithreading::exec_pol<10>{},a,b));
         REQUIRE(expected==matmul(multithreading::exec_pol<16>{},a,b));
+        REQUIRE(expected==matmul(multithreading::exec_pol_rt{4,2},a,b));
     }
 
     SECTION("nd_right_(k)x(k,n)")
@@ -295,6 +306,391 @@ TEMPLATE_TEST_CASE("test_math_matmul_1d_nd_big","test_math",
         REQUIRE(expected==matmul(multithreading::exec_pol<5>{},a,b));
         REQUIRE(expected==matmul(multithreading::exec_pol<10>{},a,b));
         REQUIRE(expected==matmul(multithreading::exec_pol<16>{},a,b));
+        REQUIRE(expected==matmul(multithreading::exec_pol_rt{4,2},a,b));
+    }
+}
+
+
+TEST_CASE("test_cpu_features","test_math")
+{
+    using gtensor::isa;
+    const auto max_isa = gtensor::max_isa();
+    REQUIRE(gtensor::cpu_isa()<=gtensor::detail::compile_isa());
+    REQUIRE(gtensor::kernel_isa()<=gtensor::cpu_isa());
+    gtensor::set_max_isa(isa::generic);
+    REQUIRE(gtensor::max_isa()==isa::generic);
+    REQUIRE(gtensor::kernel_isa()==isa::generic);
+    gtensor::set_max_isa(isa::avx512);
+    REQUIRE(gtensor::kernel_isa()==gtensor::cpu_isa());
+    gtensor::set_max_isa(max_isa);
+
+    const auto caches = gtensor::cpu_cache_sizes();
+    REQUIRE(caches.l1d>0);
+    REQUIRE(caches.l2>0);
+    REQUIRE(caches.l3>0);
+    gtensor::set_cache_sizes(gtensor::cache_sizes{1024,0,65536});
+    REQUIRE(gtensor::kernel_cache_sizes().l1d==1024);
+    REQUIRE(gtensor::kernel_cache_sizes().l2==caches.l2);
+    REQUIRE(gtensor::kernel_cache_sizes().l3==65536);
+    gtensor::set_cache_sizes(gtensor::cache_sizes{0,0,0});
+    REQUIRE(gtensor::kernel_cache_sizes().l1d==caches.l1d);
+    REQUIRE(gtensor::kernel_cache_sizes().l3==caches.l3);
+}
+
+TEMPLATE_TEST_CASE("test_math_matmul_isa","test_math",
+    (std::tuple<gtensor::config::c_order,double>),
+    (std::tuple<gtensor::config::f_order,double>),
+    (std::tuple<gtensor::config::c_order,float>),
+    (std::tuple<gtensor::config::f_order,float>),
+    (std::tuple<gtensor::config::c_order,std::complex<double>>),
+    (std::tuple<gtensor::config::c_order,std::complex<float>>)
+)
+{
+    using layout = std::tuple_element_t<0,TestType>;
+    using value_type = std::tuple_element_t<1,TestType>;
+    using tensor_type = gtensor::tensor<value_type,layout>;
+    using gtensor::matmul;
+    using gtensor::isa;
+
+    const auto m{259};
+    const auto n{131};
+    const auto k{517};
+    tensor_type a({m,k},0);
+    tensor_type b({k,n},0);
+    tensor_type expected({m,n},0);
+    helpers_for_testing::generate_lehmer(a.begin(),a.end(),[](auto e){return e%3;},123);
+    helpers_for_testing::generate_lehmer(b.begin(),b.end(),[](auto e){return e%3;},456);
+    for (auto i=0; i!=m; ++i){
+        for (auto j=0; j!=n; ++j){
+            for (auto r=0; r!=k; ++r){
+                expected.element(i,j)+=a.element(i,r)*b.element(r,j);
+            }
+        }
+    }
+    const auto max_isa = gtensor::max_isa();
+    //every kernel up to widest supported by cpu
+    for (const auto level : {isa::generic,isa::avx2,isa::avx512}){
+        gtensor::set_max_isa(level);
+        REQUIRE(expected==matmul(a,b));
+        REQUIRE(expected==matmul(multithreading::exec_pol<4>{},a,b));
+        REQUIRE(expected==matmul(a.transpose().transpose(),b));
+        //small caches, many blocks in each dimension
+        gtensor::set_cache_sizes(gtensor::cache_sizes{2048,16384,65536});
+        REQUIRE(expected==matmul(a,b));
+        REQUIRE(expected==matmul(multithreading::exec_pol<4>{},a,b));
+        gtensor::set_cache_sizes(gtensor::cache_sizes{0,0,0});
     }
+    gtensor::set_max_isa(max_isa);
 }
 
+//shared packing of b blocks is used when rows of result can be split between tasks: m >= n_tasks*Mr
+TEMPLATE_TEST_CASE("test_math_matmul_shared_packing","test_math",
+    gtensor::config::c_order,
+    gtensor::config::f_order
+)
+{
+    using layout = TestType;
+    using value_type = double;
+    using tensor_type = gtensor::tensor<value_type,layout>;
+    using gtensor::matmul;
+    using gtensor::isa;
+    using helpers_for_testing::apply_by_element;
+
+    //generic and avx2 kernels of double have Mr=8, Nr=6, Kr=1
+    //cache sizes are set to make Kc=32, Mc=32, Nc=24
+    const std::size_t mr = 8;
+    const std::size_t nr = 6;
+    const std::size_t kc = 32;
+    const gtensor::cache_sizes caches{kc*(mr+nr)*sizeof(value_type), 2*kc*sizeof(value_type)*mr*4, 2*kc*sizeof(value_type)*nr*4};
+    static constexpr std::size_t n_tasks = 4;
+    const int m_min = static_cast<int>(n_tasks*mr);
+
+    //m,n,k
+    auto test_data = std::make_tuple(
+        //m around n_tasks*Mr
+        std::make_tuple(m_min-1,50,103),
+        std::make_tuple(m_min,50,103),
+        std::make_tuple(m_min+1,50,103),
+        std::make_tuple(2*m_min+3,50,103),
+        //n less than one Nr panel per task
+        std::make_tuple(m_min+1,2,103),
+        std::make_tuple(m_min+1,5,103),
+        std::make_tuple(m_min+1,static_cast<int>(n_tasks*nr)-1,103),
+        //k is less than, multiple of, not multiple of Kc
+        std::make_tuple(100,50,20),
+        std::make_tuple(100,50,static_cast<int>(3*kc)),
+        std::make_tuple(100,50,static_cast<int>(3*kc+1)),
+        std::make_tuple(100,29,static_cast<int>(2*kc-1))
+    );
+    auto test = [](const auto& t){
+        const auto m = std::get<0>(t);
+        const auto n = std::get<1>(t);
+        const auto k = std::get<2>(t);
+        tensor_type a({m,k},0);
+        tensor_type b({k,n},0);
+        helpers_for_testing::generate_lehmer(a.begin(),a.end(),[](auto e){return e%5;},123);
+        helpers_for_testing::generate_lehmer(b.begin(),b.end(),[](auto e){return e%5;},456);
+        const auto expected = matmul(multithreading::exec_pol<1>{},a,b);
+        REQUIRE(expected==matmul(multithreading::exec_pol<n_tasks>{},a,b));
+        REQUIRE(expected==matmul(multithreading::exec_pol<3>{},a,b));
+        REQUIRE(expected==matmul(multithreading::exec_pol_rt{n_tasks},a,b));
+        //grain size decreases number of tasks
+        REQUIRE(expected==matmul(multithreading::exec_pol_rt{n_tasks,2},a,b));
+        REQUIRE(expected==matmul(multithreading::exec_pol_rt{n_tasks,static_cast<std::size_t>(m*n/3)},a,b));
+        REQUIRE(expected==matmul(multithreading::exec_pol_rt{n_tasks,static_cast<std::size_t>(m*n/2)},a,b));
+        REQUIRE(expected==matmul(multithreading::exec_pol_rt{n_tasks,static_cast<std::size_t>(m*n)},a,b));
+        REQUIRE(expected.transpose()==matmul(multithreading::exec_pol<n_tasks>{},b.transpose(),a.transpose()));
+    };
+    const auto max_isa = gtensor::max_isa();
+    gtensor::set_cache_sizes(caches);
+    for (const auto level : {isa::generic,isa::avx2}){
+        gtensor::set_max_isa(level);
+        apply_by_element(test,test_data);
+    }
+    gtensor::set_cache_sizes(gtensor::cache_sizes{0,0,0});
+    gtensor::set_max_isa(max_isa);
+}
+
+TEMPLATE_TEST_CASE("test_math_matmul_small_batch","test_math",
+    (std::tuple<gtensor::config::c_order,double,double>),
+    (std::tuple<gtensor::config::f_order,double,double>),
+    (std::tuple<gtensor::config::c_order,float,float>),
+    (std::tuple<gtensor::config::c_order,int,double>),
+    (std::tuple<gtensor::config::f_order,std::int64_t,std::int64_t>),
+    (std::tuple<gtensor::config::c_order,std::complex<double>,std::complex<double>>)
+)
+{
+    using layout = std::tuple_element_t<0,TestType>;
+    using value_type1 = std::tuple_element_t<1,TestType>;
+    using value_type2 = std::tuple_element_t<2,TestType>;
+    using tensor_type1 = gtensor::tensor<value_type1,layout>;
+    using tensor_type2 = gtensor::tensor<value_type2,layout>;
+    using gtensor::matmul;
+    using helpers_for_testing::apply_by_element;
+
+    //batch,m,n,k,broadcast batch of b
+    auto test_data = std::make_tuple(
+        std::make_tuple(1000,4,4,4,false),
+        std::make_tuple(1000,4,4,4,true),
+        std::make_tuple(777,3,3,3,false),
+        std::make_tuple(100,8,8,8,false),
+        std::make_tuple(100,2,2,2,true),
+        std::make_tuple(50,5,7,3,false),
+        std::make_tuple(20,16,16,16,false),
+        std::make_tuple(10,1,16,9,true),
+        std::make_tuple(10,16,1,16,false)
+    );
+    auto test = [](const auto& t){
+        const auto batch = std::get<0>(t);
+        const auto m = std::get<1>(t);
+        const auto n = std::get<2>(t);
+        const auto k = std::get<3>(t);
+        const auto broadcast = std::get<4>(t);
+        tensor_type1 a({batch,m,k},0);
+        tensor_type2 b({broadcast ? 1 : batch,k,n},0);
+        helpers_for_testing::generate_lehmer(a.begin(),a.end(),[](auto e){return e%5;},123);
+        helpers_for_testing::generate_lehmer(b.begin(),b.end(),[](auto e){return e%5;},456);
+        using tensor_type = decltype(matmul(a,b));
+        tensor_type expected({batch,m,n},0);
+        for (auto p=0; p!=batch; ++p){
+            for (auto i=0; i!=m; ++i){
+                for (auto j=0; j!=n; ++j){
+                    for (auto r=0; r!=k; ++r){
+                        expected.element(p,i,j)+=a.element(p,i,r)*b.element(broadcast ? 0 : p,r,j);
+                    }
+                }
+            }
+        }
+        REQUIRE(expected==matmul(a,b));
+        REQUIRE(expected==matmul(multithreading::exec_pol<4>{},a,b));
+        REQUIRE(expected==matmul(multithreading::exec_pol<16>{},a,b));
+        REQUIRE(expected==matmul(multithreading::exec_pol_rt{4,64},a,b));
+        REQUIRE(expected.transpose(0,2,1)==matmul(multithreading::exec_pol<4>{},b.transpose(0,2,1),a.transpose(0,2,1)));
+    };
+    apply_by_element(test,test_data);
+}
+
+TEMPLATE_TEST_CASE("test_math_matmul_int","test_math",
+    (std::tuple<gtensor::config::c_order,std::int8_t,std::int8_t>),
+    (std::tuple<gtensor::config::f_order,std::int8_t,std::int8_t>),
+    (std::tuple<gtensor::config::c_order,std::int16_t,std::int16_t>),
+    (std::tuple<gtensor::config::f_order,std::int16_t,std::int8_t>),
+    (std::tuple<gtensor::config::c_order,std::int32_t,std::int32_t>),
+    (std::tuple<gtensor::config::c_order,std::int8_t,std::int32_t>)
+)
+{
+    using layout = std::tuple_element_t<0,TestType>;
+    using value_type1 = std::tuple_element_t<1,TestType>;
+    using value_type2 = std::tuple_element_t<2,TestType>;
+    using tensor_type1 = gtensor::tensor<value_type1,layout>;
+    using tensor_type2 = gtensor::tensor<value_type2,layout>;
+    using gtensor::matmul;
+    using gtensor::isa;
+    //result is int32 as product of operands promoted to int, it is exact while it fits int32
+    REQUIRE(std::is_same_v<typename decltype(matmul(std::declval<tensor_type1>(),std::declval<tensor_type2>()))::value_type,std::int32_t>);
+
+    //odd k, interleaved panels are padded
+    const auto m{67};
+    const auto n{45};
+    const auto k{301};
+    tensor_type1 a({m,k},0);
+    tensor_type2 b({k,n},0);
+    //full range of int8, int16 and int32 are limited to keep result in int32
+    helpers_for_testing::generate_lehmer(a.begin(),a.end(),[](auto e){return static_cast<int>(e%256)-128;},123);
+    helpers_for_testing::generate_lehmer(b.begin(),b.end(),[](auto e){return static_cast<int>(e%256)-128;},456);
+    gtensor::tensor<std::int64_t,layout> expected({m,n},0);
+    for (auto i=0; i!=m; ++i){
+        for (auto j=0; j!=n; ++j){
+            for (auto r=0; r!=k; ++r){
+                expected.element(i,j)+=std::int64_t{a.element(i,r)}*std::int64_t{b.element(r,j)};
+            }
+        }
+    }
+    const auto max_isa = gtensor::max_isa();
+    for (const auto level : {isa::generic,isa::avx2,isa::avx512}){
+        gtensor::set_max_isa(level);
+        REQUIRE(expected==matmul(a,b));
+        REQUIRE(expected==matmul(multithreading::exec_pol<4>{},a,b));
+        REQUIRE(expected.transpose()==matmul(b.transpose(),a.transpose()));
+        gtensor::set_cache_sizes(gtensor::cache_sizes{1024,8192,65536});
+        REQUIRE(expected==matmul(a,b));
+        REQUIRE(expected==matmul(multithreading::exec_pol<4>{},a,b));
+        gtensor::set_cache_sizes(gtensor::cache_sizes{0,0,0});
+    }
+    gtensor::set_max_isa(max_isa);
+}
+
+TEST_CASE("test_math_matmul_int_range","test_math")
+{
+    using gtensor::tensor;
+    using gtensor::matmul;
+    using gtensor::isa;
+    const auto max_isa = gtensor::max_isa();
+    for (const auto level : {isa::generic,isa::avx2,isa::avx512}){
+        gtensor::set_max_isa(level);
+        //int8 products are accumulated in int32, no overflow up to k of 2^17
+        const tensor<std::int8_t> a8({40,1000},std::int8_t{-128});
+        const tensor<std::int8_t> b8({1000,20},std::int8_t{-128});
+        REQUIRE(matmul(a8,b8)==tensor<std::int32_t>({40,20},1000*128*128));
+        //sum of two maximal int16 products fits int32
+        const tensor<std::int16_t> a16({40,2},std::int16_t{32767});
+        const tensor<std::int16_t> b16({2,20},std::int16_t{32767});
+        REQUIRE(matmul(a16,b16)==tensor<std::int32_t>({40,20},2*32767*32767));
+        const tensor<std::int16_t> a16_({40,3},std::int16_t{-32768});
+        const tensor<std::int16_t> b16_({3,20},std::int16_t{16384});
+        REQUIRE(matmul(a16_,b16_)==tensor<std::int32_t>({40,20},-3*32768*16384));
+    }
+    gtensor::set_max_isa(max_isa);
+}
+
+TEMPLATE_TEST_CASE("test_math_matmul_gemv","test_math",
+    (std::tuple<gtensor::config::c_order,double,double>),
+    (std::tuple<gtensor::config::f_order,double,double>),
+    (std::tuple<gtensor::config::c_order,float,float>),
+    (std::tuple<gtensor::config::f_order,float,float>),
+    (std::tuple<gtensor::config::c_order,std::complex<double>,std::complex<double>>),
+    (std::tuple<gtensor::config::f_order,std::complex<float>,std::complex<float>>),
+    (std::tuple<gtensor::config::c_order,int,double>),
+    (std::tuple<gtensor::config::f_order,std::int64_t,std::int64_t>)
+)
+{
+    using layout = std::tuple_element_t<0,TestType>;
+    using value_type1 = std::tuple_element_t<1,TestType>;
+    using value_type2 = std::tuple_element_t<2,TestType>;
+    using tensor_type1 = gtensor::tensor<value_type1,layout>;
+    using tensor_type2 = gtensor::tensor<value_type2,layout>;
+    using gtensor::matmul;
+    using gtensor::isa;
+    using helpers_for_testing::apply_by_element;
+
+    //batch,m,k, vector sizes cover tails of vectorized kernels
+    auto test_data = std::make_tuple(
+        std::make_tuple(1,1,1),
+        std::make_tuple(1,3,37),
+        std::make_tuple(1,37,3),
+        std::make_tuple(1,131,67),
+        std::make_tuple(1,8,64),
+        std::make_tuple(3,21,17),
+        std::make_tuple(2,5,0)
+    );
+    auto test = [](const auto& t){
+        const auto batch = std::get<0>(t);
+        const auto m = std::get<1>(t);
+        const auto k = std::get<2>(t);
+        tensor_type1 a({batch,m,k},0);
+        tensor_type2 x({k},0);
+        tensor_type2 y({m},0);
+        helpers_for_testing::generate_lehmer(a.begin(),a.end(),[](auto e){return e%7;},123);
+        helpers_for_testing::generate_lehmer(x.begin(),x.end(),[](auto e){return e%7;},456);
+        helpers_for_testing::generate_lehmer(y.begin(),y.end(),[](auto e){return e%7;},789);
+        using tensor_type = decltype(matmul(a,x));
+        tensor_type expected_right({batch,m},0);
+        tensor_type expected_left({batch,k},0);
+        for (auto p=0; p!=batch; ++p){
+            for (auto i=0; i!=m; ++i){
+                for (auto r=0; r!=k; ++r){
+                    expected_right.element(p,i)+=a.element(p,i,r)*x.element(r);
+                    expected_left.element(p,r)+=y.element(i)*a.element(p,i,r);
+                }
+            }
+        }
+        //batch of f_order tensor is not dense, 2d matrix is
+        const tensor_type1 a_2d(a(0));
+        const auto max_isa = gtensor::max_isa();
+        for (const auto level : {isa::generic,isa::avx2,isa::avx512}){
+            gtensor::set_max_isa(level);
+            REQUIRE(expected_right==matmul(a,x));
+            REQUIRE(expected_left==matmul(y,a));
+            REQUIRE(expected_right(0)==matmul(a_2d,x));
+            REQUIRE(expected_left(0)==matmul(y,a_2d));
+            REQUIRE(expected_right(0)==matmul(multithreading::exec_pol<4>{},a_2d,x));
+            REQUIRE(expected_left(0)==matmul(multithreading::exec_pol<4>{},y,a_2d));
+            REQUIRE(expected_right==matmul(multithreading::exec_pol_rt{3,1},a,x));
+            REQUIRE(expected_left==matmul(multithreading::exec_pol_rt{3,1},y,a));
+            //not dense operand, walkers are used
+            REQUIRE(expected_left(0)==matmul(a_2d.transpose(),y));
+            REQUIRE(expected_right(0)==matmul(x,a_2d.transpose()));
+        }
+        gtensor::set_max_isa(max_isa);
+    };
+    apply_by_element(test,test_data);
+}
+
+TEMPLATE_TEST_CASE("test_math_matmul_dot","test_math",
+    (std::tuple<double,double>),
+    (std::tuple<float,float>),
+    (std::tuple<std::complex<double>,std::complex<double>>),
+    (std::tuple<std::complex<float>,std::complex<float>>),
+    (std::tuple<int,double>),
+    (std::tuple<std::int64_t,std::int64_t>)
+)
+{
+    using value_type1 = std::tuple_element_t<0,TestType>;
+    using value_type2 = std::tuple_element_t<1,TestType>;
+    using tensor_type1 = gtensor::tensor<value_type1>;
+    using tensor_type2 = gtensor::tensor<value_type2>;
+    using gtensor::matmul;
+    using gtensor::isa;
+
+    const auto max_isa = gtensor::max_isa();
+    for (const auto n : {0,1,3,16,17,63,1000,20011}){
+        tensor_type1 a({n},0);
+        tensor_type2 b({n},0);
+        helpers_for_testing::generate_lehmer(a.begin(),a.end(),[](auto e){return e%5;},123);
+        helpers_for_testing::generate_lehmer(b.begin(),b.end(),[](auto e){return e%5;},456);
+        using tensor_type = decltype(matmul(a,b));
+        using value_type = typename tensor_type::value_type;
+        value_type expected{0};
+        for (auto i=0; i!=n; ++i){
+            expected+=a.element(i)*b.element(i);
+        }
+        for (const auto level : {isa::generic,isa::avx2,isa::avx512}){
+            gtensor::set_max_isa(level);
+            REQUIRE(tensor_type(expected)==matmul(a,b));
+            REQUIRE(tensor_type(expected)==matmul(multithreading::exec_pol<4>{},a,b));
+            REQUIRE(tensor_type(expected)==matmul(multithreading::exec_pol_rt{3,1},a,b));
+            REQUIRE(tensor_type(expected)==matmul(a+value_type1{0},b));
+        }
+    }
+    gtensor::set_max_isa(max_isa);
+}
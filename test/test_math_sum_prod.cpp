@@ -10,6 +10,7 @@
 #include <iomanip>
 #include "catch.hpp"
 #include "helpers_for_testing.hpp"
+#include "config_for_testing.hpp"
 #include "tensor_math.hpp"
 #include "tensor.hpp"
 
@@ -291,6 +292,93 @@ TEMPLATE_TEST_CASE("test_math_sum_nansum_nan_values_policy","test_math",
     apply_by_element(test,test_data);
 }
 
+TEMPLATE_TEST_CASE("test_math_sum_nansum_sum_modes","test_math",
+    (std::tuple<gtensor::config::mode_sum_naive,multithreading::exec_pol<1>>),
+    (std::tuple<gtensor::config::mode_sum_pairwise,multithreading::exec_pol<1>>),
+    (std::tuple<gtensor::config::mode_sum_pairwise,multithreading::exec_pol<4>>),
+    (std::tuple<gtensor::config::mode_sum_kahan,multithreading::exec_pol<1>>),
+    (std::tuple<gtensor::config::mode_sum_kahan,multithreading::exec_pol<4>>)
+)
+{
+    using sum_mode = std::tuple_element_t<0,TestType>;
+    using policy = std::tuple_element_t<1,TestType>;
+    using value_type = double;
+    using config_type = gtensor::config::extend_config_t<test_config::config_sum_mode_selector_t<sum_mode>,value_type>;
+    using tensor_type = gtensor::tensor<value_type,gtensor::config::c_order,config_type>;
+    using gtensor::sum;
+    using gtensor::nansum;
+    using gtensor::tensor_equal;
+    using helpers_for_testing::apply_by_element;
+    static constexpr value_type nan = std::numeric_limits<value_type>::quiet_NaN();
+    static constexpr value_type pos_inf = std::numeric_limits<value_type>::infinity();
+    static constexpr value_type neg_inf = -std::numeric_limits<value_type>::infinity();
+    //0result,1expected
+    auto test_data = std::make_tuple(
+        //sum
+        std::make_tuple(sum(policy{},tensor_type{1.0,0.5,2.0,4.0,3.0,pos_inf}), tensor_type(pos_inf)),
+        std::make_tuple(sum(policy{},tensor_type{1.0,0.5,2.0,neg_inf,3.0,pos_inf}), tensor_type(nan)),
+        std::make_tuple(sum(policy{},tensor_type{1.0,nan,2.0,neg_inf,3.0,pos_inf}), tensor_type(nan)),
+        std::make_tuple(sum(policy{},tensor_type{{nan,nan,nan,1.0},{nan,1.5,nan,2.0},{0.5,2.0,nan,3.0},{0.5,2.0,nan,4.0}},0), tensor_type{nan,nan,nan,10.0}),
+        std::make_tuple(sum(policy{},tensor_type{{1.0,2.0,3.0,4.0},{5.0,6.0,7.0,8.0}},1), tensor_type{10.0,26.0}),
+        std::make_tuple(sum(policy{},tensor_type{{1.0,2.0,3.0,4.0},{5.0,6.0,7.0,8.0}},std::vector<int>{0,1},false,value_type{0.5}), tensor_type(36.5)),
+        //nansum
+        std::make_tuple(nansum(policy{},tensor_type{1.0,nan,2.0,neg_inf,3.0,4.0}), tensor_type(neg_inf)),
+        std::make_tuple(nansum(policy{},tensor_type{1.0,nan,2.0,neg_inf,3.0,pos_inf}), tensor_type(nan)),
+        std::make_tuple(nansum(policy{},tensor_type{{nan,nan,nan},{nan,nan,nan},{nan,nan,nan}}), tensor_type(0.0)),
+        std::make_tuple(nansum(policy{},tensor_type{{nan,nan,nan,1.0},{nan,1.5,nan,2.0},{0.5,2.0,nan,3.0},{0.5,2.0,nan,4.0}},0), tensor_type{1.0,5.5,0.0,10.0}),
+        std::make_tuple(nansum(policy{},tensor_type{{nan,nan,nan,1.0},{nan,1.5,nan,2.0},{0.5,2.0,nan,3.0},{0.5,2.0,nan,4.0}},1), tensor_type{1.0,3.5,5.5,6.5})
+    );
+    auto test = [](const auto& t){
+        auto result = std::get<0>(t);
+        auto expected = std::get<1>(t);
+        REQUIRE(tensor_equal(result,expected,true));
+    };
+    apply_by_element(test,test_data);
+}
+
+TEMPLATE_TEST_CASE("test_math_sum_nansum_accuracy","test_math",
+    (std::tuple<gtensor::config::mode_sum_pairwise,multithreading::exec_pol<1>>),
+    (std::tuple<gtensor::config::mode_sum_pairwise,multithreading::exec_pol<4>>),
+    (std::tuple<gtensor::config::mode_sum_kahan,multithreading::exec_pol<1>>),
+    (std::tuple<gtensor::config::mode_sum_kahan,multithreading::exec_pol<4>>)
+)
+{
+    using sum_mode = std::tuple_element_t<0,TestType>;
+    using policy = std::tuple_element_t<1,TestType>;
+    using value_type = float;
+    using config_type = gtensor::config::extend_config_t<test_config::config_sum_mode_selector_t<sum_mode>,value_type>;
+    using tensor_type = gtensor::tensor<value_type,gtensor::config::c_order,config_type>;
+    using gtensor::sum;
+    using gtensor::nansum;
+    static constexpr value_type nan = std::numeric_limits<value_type>::quiet_NaN();
+    //float left fold of such number of elements loses several digits
+    const int rows = 4;
+    const int n = 1<<20;
+    tensor_type t(std::vector<int>{rows,n});
+    std::vector<double> expected(rows,0.0);
+    auto it = t.begin();
+    for (int i=0; i!=rows; ++i){
+        for (int j=0; j!=n; ++j,++it){
+            const auto e = static_cast<value_type>(0.1+0.01*(j%7)+i);
+            *it = e;
+            expected[i]+=static_cast<double>(e);
+        }
+    }
+    const double expected_total = expected[0]+expected[1]+expected[2]+expected[3];
+    auto near = [](double result, double expected_){
+        return std::abs(result-expected_) <= 1E-5*std::abs(expected_);
+    };
+    auto total = sum(policy{},t);
+    REQUIRE(near(*total.begin(),expected_total));
+    auto rows_sum = sum(policy{},t,1);
+    for (int i=0; i!=rows; ++i){
+        REQUIRE(near(rows_sum.element(i),expected[i]));
+    }
+    t.element(0,0) = nan;
+    auto total_nan = nansum(policy{},t);
+    REQUIRE(near(*total_nan.begin(),expected_total-0.1));
+}
+
 //prod,nanprod
 TEMPLATE_TEST_CASE("test_math_prod_nanprod","test_math",
     double,
@@ -0,0 +1,215 @@
+/*
+* GTensor - computation library
+* Copyright (c) 2022 Ivan Malezhyk <ivanmzk@gmail.com>
+*
+* Distributed under the Boost Software License, Version 1.0.
+* The full license is in the file LICENSE.txt, distributed with this software.
+*/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <numeric>
+#include "catch.hpp"
+#include "helpers_for_testing.hpp"
+#include "tensor_math.hpp"
+#include "tensor.hpp"
+
+namespace test_math_tensordot_einsum{
+
+template<typename Tensor, typename IdxT>
+auto arange(std::initializer_list<IdxT> shape, typename Tensor::value_type start = 0){
+    Tensor res{std::vector<IdxT>(shape)};
+    std::iota(res.begin(),res.end(),start);
+    return res;
+}
+
+}   //end of namespace test_math_tensordot_einsum
+
+TEMPLATE_TEST_CASE("test_math_tensordot","test_math",
+    (std::tuple<gtensor::config::c_order,gtensor::config::c_order>),
+    (std::tuple<gtensor::config::f_order,gtensor::config::f_order>),
+    (std::tuple<gtensor::config::c_order,gtensor::config::f_order>),
+    (std::tuple<gtensor::config::f_order,gtensor::config::c_order>)
+)
+{
+    using layout1 = std::tuple_element_t<0,TestType>;
+    using layout2 = std::tuple_element_t<1,TestType>;
+    using value_type = double;
+    using tensor_type1 = gtensor::tensor<value_type,layout1>;
+    using tensor_type2 = gtensor::tensor<value_type,layout2>;
+    using tensor_type = gtensor::tensor<value_type>;
+    using gtensor::tensordot;
+    using test_math_tensordot_einsum::arange;
+    using helpers_for_testing::apply_by_element;
+
+    const auto a = arange<tensor_type1>({2,3,4});
+    //0result,1expected
+    auto test_data = std::make_tuple(
+        //n axes
+        std::make_tuple(tensordot(tensor_type1{{1,2,3},{4,5,6}},tensor_type2{{1,2},{3,4},{5,6}},1),tensor_type{{22,28},{49,64}}),
+        std::make_tuple(tensordot(tensor_type1{{1,2},{3,4}},tensor_type2{{5,6},{7,8}}),tensor_type(70)),
+        std::make_tuple(tensordot(tensor_type1{1,2},tensor_type2{3,4,5},0),tensor_type{{3,4,5},{6,8,10}}),
+        std::make_tuple(tensordot(tensor_type1(value_type{2}),tensor_type2{3,4,5},0),tensor_type{6,8,10}),
+        std::make_tuple(tensordot(a,arange<tensor_type2>({3,4,2}),2),tensor_type{{1012,1078},{2596,2806}}),
+        std::make_tuple(tensordot(tensor_type1(std::vector<int>{0,3}),tensor_type2{{1,2},{3,4},{5,6}},1),tensor_type(std::vector<int>{0,2})),
+        std::make_tuple(tensordot(tensor_type1(std::vector<int>{2,0}),tensor_type2(std::vector<int>{0,3}),1),tensor_type({2,3},0)),
+        //axes
+        std::make_tuple(tensordot(arange<tensor_type1>({3,2}),arange<tensor_type2>({3,4}),0,0),tensor_type{{40,46,52,58},{52,61,70,79}}),
+        std::make_tuple(tensordot(a,arange<tensor_type2>({4,3}),std::vector<int>{2,1},std::vector<int>{0,1}),tensor_type{440,1232}),
+        std::make_tuple(tensordot(a,arange<tensor_type2>({4,3}),{-1,1},{0,-1}),tensor_type{440,1232}),
+        std::make_tuple(tensordot(a,arange<tensor_type2>({3,2}),{1},{0}),
+            tensor_type{{{40,52},{46,61},{52,70},{58,79}},{{112,160},{118,169},{124,178},{130,187}}}
+        ),
+        std::make_tuple(tensordot(a,arange<tensor_type2>({3,2,2}),{1,0},{0,1}),tensor_type{{400,460},{430,496},{460,532},{490,568}}),
+        //views
+        std::make_tuple(tensordot(a.transpose(),arange<tensor_type2>({3,2,2}),{1,2},{0,1}),tensor_type{{400,460},{430,496},{460,532},{490,568}}),
+        std::make_tuple(tensordot(a+value_type{0},arange<tensor_type2>({3,4,2}).transpose(1,2,0),{1,2},{2,0}),tensor_type{{1012,1078},{2596,2806}})
+    );
+    auto test = [](const auto& t){
+        auto result = std::get<0>(t);
+        auto expected = std::get<1>(t);
+        REQUIRE(result == expected);
+    };
+    apply_by_element(test,test_data);
+}
+
+TEST_CASE("test_math_tensordot_policy","test_math")
+{
+    using value_type = std::int64_t;
+    using tensor_type = gtensor::tensor<value_type>;
+    using gtensor::tensordot;
+    using gtensor::matmul;
+
+    tensor_type a({7,9,11,5},0);
+    tensor_type b({5,11,13},0);
+    helpers_for_testing::generate_lehmer(a.begin(),a.end(),[](auto e){return e%7;},123);
+    helpers_for_testing::generate_lehmer(b.begin(),b.end(),[](auto e){return e%7;},456);
+    const auto expected = matmul(a.reshape(63,55).copy(),b.transpose(1,0,2).copy().reshape(55,13).copy()).reshape(7,9,13).copy();
+    REQUIRE(tensordot(a,b.transpose(1,0,2),2) == expected);
+    REQUIRE(tensordot(multithreading::exec_pol<4>{},a,b,{2,3},{1,0}) == expected);
+    REQUIRE(tensordot(multithreading::exec_pol_rt{3,1},a,b,{3,2},{0,1}) == expected);
+}
+
+TEST_CASE("test_math_tensordot_exception","test_math")
+{
+    using value_type = double;
+    using tensor_type = gtensor::tensor<value_type>;
+    using gtensor::tensordot;
+    using gtensor::value_error;
+    using gtensor::axis_error;
+
+    const tensor_type a({2,3,4},0);
+    const tensor_type b({4,3},0);
+    REQUIRE_THROWS_AS(tensordot(a,b,3),value_error);
+    REQUIRE_THROWS_AS(tensordot(a,b,-1),value_error);
+    REQUIRE_THROWS_AS(tensordot(a,b,1,0),value_error);
+    REQUIRE_THROWS_AS(tensordot(a,b,{1,2},{1}),value_error);
+    REQUIRE_THROWS_AS(tensordot(a,b,{2,2},{0,1}),axis_error);
+    REQUIRE_THROWS_AS(tensordot(a,b,{3},{0}),axis_error);
+    REQUIRE_THROWS_AS(tensordot(a,b,{-4},{0}),axis_error);
+}
+
+TEMPLATE_TEST_CASE("test_math_einsum","test_math",
+    (std::tuple<gtensor::config::c_order,gtensor::config::c_order>),
+    (std::tuple<gtensor::config::f_order,gtensor::config::f_order>),
+    (std::tuple<gtensor::config::c_order,gtensor::config::f_order>),
+    (std::tuple<gtensor::config::f_order,gtensor::config::c_order>)
+)
+{
+    using layout1 = std::tuple_element_t<0,TestType>;
+    using layout2 = std::tuple_element_t<1,TestType>;
+    using value_type = double;
+    using tensor_type1 = gtensor::tensor<value_type,layout1>;
+    using tensor_type2 = gtensor::tensor<value_type,layout2>;
+    using tensor_type = gtensor::tensor<value_type>;
+    using gtensor::einsum;
+    using test_math_tensordot_einsum::arange;
+    using helpers_for_testing::apply_by_element;
+
+    const tensor_type1 a{{0,1,2},{3,4,5}};
+    const tensor_type2 b{{0,1},{2,3},{4,5}};
+    //0result,1expected
+    auto test_data = std::make_tuple(
+        //matrix products
+        std::make_tuple(einsum("ij,jk->ik",a,b),tensor_type{{10,13},{28,40}}),
+        std::make_tuple(einsum("ij,jk",a,b),tensor_type{{10,13},{28,40}}),
+        std::make_tuple(einsum(" ij , jk -> ki ",a,b),tensor_type{{10,28},{13,40}}),
+        std::make_tuple(einsum("ij,kj->ik",a,b.transpose()),tensor_type{{10,13},{28,40}}),
+        std::make_tuple(einsum("i,i->",tensor_type1{1,2,3},tensor_type2{4,5,6}),tensor_type(32)),
+        std::make_tuple(einsum("i,j",tensor_type1{1,2},tensor_type2{3,4,5}),tensor_type{{3,4,5},{6,8,10}}),
+        std::make_tuple(einsum("i,j->ji",tensor_type1{1,2},tensor_type2{3,4,5}),tensor_type{{3,6},{4,8},{5,10}}),
+        std::make_tuple(einsum("ij,ij->",a,arange<tensor_type2>({2,3},1)),tensor_type(70)),
+        std::make_tuple(einsum("ijk,jkl->il",arange<tensor_type1>({2,3,4}),arange<tensor_type2>({3,4,2})),tensor_type{{1012,1078},{2596,2806}}),
+        std::make_tuple(einsum("ijk,jil->kl",arange<tensor_type1>({2,3,4}),arange<tensor_type2>({3,2,2})),tensor_type{{400,460},{430,496},{460,532},{490,568}}),
+        //batch matrix products
+        std::make_tuple(einsum("bij,bjk->bik",arange<tensor_type1>({2,2,3}),arange<tensor_type2>({2,3,2})),tensor_type{{{10,13},{28,40}},{{172,193},{244,274}}}),
+        std::make_tuple(einsum("bij,bjk->kbi",arange<tensor_type1>({2,2,3}),arange<tensor_type2>({2,3,2})),tensor_type{{{10,28},{172,244}},{{13,40},{193,274}}}),
+        std::make_tuple(einsum("ibj,bjk->bik",arange<tensor_type1>({2,2,3}).transpose(1,0,2),arange<tensor_type2>({2,3,2})),tensor_type{{{10,13},{28,40}},{{172,193},{244,274}}}),
+        //fused
+        std::make_tuple(einsum("ij,ij->ij",a,arange<tensor_type2>({2,3},1)),tensor_type{{0,2,6},{12,20,30}}),
+        std::make_tuple(einsum("iij,jk->ik",arange<tensor_type1>({2,2,3}),b),tensor_type{{10,13},{64,94}}),
+        std::make_tuple(einsum("ij,jk->i",a,b),tensor_type{23,68}),
+        std::make_tuple(einsum("ij,jk->i",a,tensor_type2(std::vector<int>{3,0})),tensor_type{0,0}),
+        std::make_tuple(einsum("ij,jk->ik",a,tensor_type2(std::vector<int>{3,0})),tensor_type(std::vector<int>{2,0})),
+        //single operand
+        std::make_tuple(einsum("ii",arange<tensor_type1>({3,3})),tensor_type(12)),
+        std::make_tuple(einsum("ii->i",arange<tensor_type1>({3,3})),tensor_type{0,4,8}),
+        std::make_tuple(einsum("ij->j",a),tensor_type{3,5,7}),
+        std::make_tuple(einsum("ij->",a),tensor_type(15)),
+        std::make_tuple(einsum("ij->ij",a),tensor_type{{0,1,2},{3,4,5}}),
+        std::make_tuple(einsum("ji",a),tensor_type{{0,3},{1,4},{2,5}}),
+        std::make_tuple(einsum("ijk->kj",arange<tensor_type1>({2,3,4})),tensor_type{{12,20,28},{14,22,30},{16,24,32},{18,26,34}}),
+        std::make_tuple(einsum("iji->j",arange<tensor_type1>({2,3,2})),tensor_type{7,11,15}),
+        std::make_tuple(einsum("ij->j",a+a),tensor_type{6,10,14})
+    );
+    auto test = [](const auto& t){
+        auto result = std::get<0>(t);
+        auto expected = std::get<1>(t);
+        REQUIRE(result == expected);
+    };
+    apply_by_element(test,test_data);
+}
+
+TEST_CASE("test_math_einsum_policy","test_math")
+{
+    using value_type = std::int64_t;
+    using tensor_type = gtensor::tensor<value_type>;
+    using gtensor::einsum;
+    using gtensor::matmul;
+    using gtensor::sum;
+
+    tensor_type a({4,37,41},0);
+    tensor_type b({4,41,29},0);
+    helpers_for_testing::generate_lehmer(a.begin(),a.end(),[](auto e){return e%7;},123);
+    helpers_for_testing::generate_lehmer(b.begin(),b.end(),[](auto e){return e%7;},456);
+    const auto expected_matmul = matmul(a,b);
+    const auto expected_sum = sum(a,{0,1});
+    REQUIRE(einsum("bij,bjk->bik",a,b) == expected_matmul);
+    REQUIRE(einsum(multithreading::exec_pol<4>{},"bij,bjk->bik",a,b) == expected_matmul);
+    REQUIRE(einsum(multithreading::exec_pol_rt{3,1},"bij,bjk->bik",a,b) == expected_matmul);
+    REQUIRE(einsum("bij->j",a) == expected_sum);
+    REQUIRE(einsum(multithreading::exec_pol<4>{},"bij->j",a) == expected_sum);
+    REQUIRE(einsum(multithreading::exec_pol_rt{3,1},"bij->j",a) == expected_sum);
+    REQUIRE(einsum(multithreading::exec_pol<4>{},"bij,bik->ik",a,a) == einsum("bij,bik->ik",a,a));
+}
+
+TEST_CASE("test_math_einsum_exception","test_math")
+{
+    using value_type = double;
+    using tensor_type = gtensor::tensor<value_type>;
+    using gtensor::einsum;
+    using gtensor::value_error;
+
+    const tensor_type a({2,3},0);
+    const tensor_type b({4,3},0);
+    REQUIRE_THROWS_AS(einsum("ij,jk->ik",a,b),value_error);
+    REQUIRE_THROWS_AS(einsum("ijk,jk->ik",a,b),value_error);
+    REQUIRE_THROWS_AS(einsum("ij,kj->il",a,b),value_error);
+    REQUIRE_THROWS_AS(einsum("ij,kj->ii",a,b),value_error);
+    REQUIRE_THROWS_AS(einsum("ij,k1->ik",a,b),value_error);
+    REQUIRE_THROWS_AS(einsum("ij->i",a,b),value_error);
+    REQUIRE_THROWS_AS(einsum("ij,jk,kl->il",a,b),value_error);
+    REQUIRE_THROWS_AS(einsum("ij",a,b),value_error);
+    REQUIRE_THROWS_AS(einsum("ii",a),value_error);
+}
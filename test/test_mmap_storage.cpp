@@ -0,0 +1,238 @@
+/*
+* GTensor - computation library
+* Copyright (c) 2022 Ivan Malezhyk <ivanmzk@gmail.com>
+*
+* Distributed under the Boost Software License, Version 1.0.
+* The full license is in the file LICENSE.txt, distributed with this software.
+*/
+
+#include "mmap_storage.hpp"
+
+#if GTENSOR_HAS_MMAP
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdio>
+#include <filesystem>
+#include "catch.hpp"
+#include "tensor_math.hpp"
+#include "tensor.hpp"
+#include "helpers_for_testing.hpp"
+
+namespace test_mmap_storage{
+
+//temporary file that is removed in destructor
+class temp_file
+{
+    std::string name_;
+public:
+    explicit temp_file(const std::string& name):
+        name_{(std::filesystem::temp_directory_path()/name).string()}
+    {
+        std::remove(name_.c_str());
+    }
+    ~temp_file(){
+        std::remove(name_.c_str());
+    }
+    const std::string& name()const{return name_;}
+};
+
+template<typename T>
+void write_file(const std::string& name, const std::vector<T>& elements, std::size_t offset = 0){
+    std::ofstream f(name, std::ios::binary);
+    std::vector<char> pad(offset,0);
+    f.write(pad.data(),pad.size());
+    f.write(reinterpret_cast<const char*>(elements.data()),elements.size()*sizeof(T));
+}
+
+template<typename T>
+std::vector<T> read_file(const std::string& name, std::size_t offset = 0){
+    std::ifstream f(name, std::ios::binary|std::ios::ate);
+    const auto size = static_cast<std::size_t>(f.tellg());
+    std::vector<T> res((size-offset)/sizeof(T));
+    f.seekg(offset);
+    f.read(reinterpret_cast<char*>(res.data()),res.size()*sizeof(T));
+    return res;
+}
+
+}   //end of namespace test_mmap_storage
+
+TEMPLATE_TEST_CASE("test_mmap_storage_heap_constructors","[test_mmap_storage]",
+    double,
+    int
+)
+{
+    using value_type = TestType;
+    using storage_type = gtensor::mmap_storage<value_type>;
+    using size_type = typename storage_type::size_type;
+    REQUIRE(std::is_nothrow_move_constructible_v<storage_type>);
+    REQUIRE(std::is_nothrow_move_assignable_v<storage_type>);
+
+    storage_type s0{};
+    REQUIRE(s0.empty());
+    REQUIRE(s0.begin() == s0.end());
+    REQUIRE(!s0.is_mapped());
+
+    storage_type s1(size_type{5},value_type{3});
+    REQUIRE(s1.size() == 5);
+    REQUIRE(!s1.is_mapped());
+    REQUIRE(std::vector<value_type>(s1.begin(),s1.end()) == std::vector<value_type>(5,value_type{3}));
+
+    storage_type s2{1,2,3,4};
+    REQUIRE(std::vector<value_type>(s2.begin(),s2.end()) == std::vector<value_type>{1,2,3,4});
+
+    std::vector<value_type> v{5,6,7};
+    storage_type s3(v.begin(),v.end());
+    REQUIRE(std::vector<value_type>(s3.begin(),s3.end()) == v);
+
+    storage_type s4{s3};
+    REQUIRE(std::vector<value_type>(s4.begin(),s4.end()) == v);
+    REQUIRE(s4.data() != s3.data());
+
+    auto data = s4.data();
+    storage_type s5{std::move(s4)};
+    REQUIRE(s5.data() == data);
+    REQUIRE(s4.empty());
+
+    s0 = s2;
+    REQUIRE(std::vector<value_type>(s0.begin(),s0.end()) == std::vector<value_type>{1,2,3,4});
+    s0 = std::move(s5);
+    REQUIRE(s0.data() == data);
+}
+
+TEMPLATE_TEST_CASE("test_mmap_storage_file_modes","[test_mmap_storage]",
+    double,
+    int
+)
+{
+    using value_type = TestType;
+    using storage_type = gtensor::mmap_storage<value_type>;
+    using gtensor::mmap_mode;
+    using test_mmap_storage::temp_file;
+    using test_mmap_storage::write_file;
+    using test_mmap_storage::read_file;
+
+    temp_file file{"gtensor_test_mmap_storage.bin"};
+    const std::vector<value_type> elements{1,2,3,4,5,6,7,8,9,10};
+    //offset is not page aligned
+    const std::size_t offset = 3*sizeof(value_type);
+    write_file(file.name(),elements,offset);
+
+    SECTION("read_only")
+    {
+        const storage_type s(file.name(),mmap_mode::read_only,elements.size(),offset);
+        REQUIRE(s.is_mapped());
+        REQUIRE(s.mode() == mmap_mode::read_only);
+        REQUIRE(std::vector<value_type>(s.begin(),s.end()) == elements);
+        //copy is on heap
+        const storage_type c{s};
+        REQUIRE(!c.is_mapped());
+        REQUIRE(std::vector<value_type>(c.begin(),c.end()) == elements);
+    }
+    SECTION("read_only_part")
+    {
+        const storage_type s(file.name(),mmap_mode::read_only,4,offset+2*sizeof(value_type));
+        REQUIRE(std::vector<value_type>(s.begin(),s.end()) == std::vector<value_type>{3,4,5,6});
+    }
+    SECTION("copy_on_write")
+    {
+        {
+            storage_type s(file.name(),mmap_mode::copy_on_write,elements.size(),offset);
+            s[0] = value_type{100};
+            REQUIRE(s[0] == value_type{100});
+        }
+        REQUIRE(read_file<value_type>(file.name(),offset) == elements);
+    }
+    SECTION("read_write")
+    {
+        {
+            storage_type s(file.name(),mmap_mode::read_write,elements.size(),offset);
+            s[0] = value_type{100};
+            s[9] = value_type{200};
+            s.flush();
+        }
+        REQUIRE(read_file<value_type>(file.name(),offset) == std::vector<value_type>{100,2,3,4,5,6,7,8,9,200});
+    }
+    SECTION("create_extend")
+    {
+        {
+            storage_type s(file.name(),mmap_mode::create,elements.size()+2,offset);
+            REQUIRE(s.mode() == mmap_mode::create);
+            REQUIRE(s.size() == elements.size()+2);
+            s[10] = value_type{11};
+            s[11] = value_type{12};
+        }
+        REQUIRE(read_file<value_type>(file.name(),offset) == std::vector<value_type>{1,2,3,4,5,6,7,8,9,10,11,12});
+    }
+    SECTION("create_new_file")
+    {
+        temp_file new_file{"gtensor_test_mmap_storage_new.bin"};
+        {
+            storage_type s(new_file.name(),mmap_mode::create,3);
+            s[0] = value_type{1};
+            s[1] = value_type{2};
+            s[2] = value_type{3};
+        }
+        REQUIRE(read_file<value_type>(new_file.name(),0) == std::vector<value_type>{1,2,3});
+    }
+    SECTION("exception")
+    {
+        REQUIRE_THROWS_AS(storage_type(file.name(),mmap_mode::read_only,elements.size()+1,offset),gtensor::value_error);
+        REQUIRE_THROWS_AS(storage_type(file.name(),mmap_mode::read_only,1,1),gtensor::value_error);
+        REQUIRE_THROWS_AS(storage_type(file.name()+".not_exist",mmap_mode::read_only,1),gtensor::io_error);
+        //only create mode extends file
+        REQUIRE_THROWS_AS(storage_type(file.name(),mmap_mode::read_write,elements.size()+1,offset),gtensor::value_error);
+        REQUIRE_THROWS_AS(storage_type(file.name(),mmap_mode::copy_on_write,elements.size()+1,offset),gtensor::value_error);
+        REQUIRE_THROWS_AS(storage_type(file.name()+".not_exist",mmap_mode::read_write,1),gtensor::io_error);
+        REQUIRE(read_file<value_type>(file.name(),offset) == elements);
+    }
+}
+
+TEMPLATE_TEST_CASE("test_mmap_storage_tensor","[test_mmap_storage]",
+    gtensor::config::c_order,
+    gtensor::config::f_order
+)
+{
+    using value_type = double;
+    using order = TestType;
+    using config_type = gtensor::config::extend_config_t<gtensor::config::mmap_config<>,value_type>;
+    using tensor_type = gtensor::tensor<value_type,order,config_type>;
+    using storage_type = typename tensor_type::storage_type;
+    using gtensor::mmap_mode;
+    using test_mmap_storage::temp_file;
+    using test_mmap_storage::write_file;
+    using test_mmap_storage::read_file;
+
+    REQUIRE(std::is_same_v<storage_type,gtensor::mmap_storage<value_type>>);
+    temp_file file{"gtensor_test_mmap_storage_tensor.bin"};
+    const std::vector<value_type> elements{1,2,3,4,5,6};
+    write_file(file.name(),elements);
+    const auto expected = std::is_same_v<order,gtensor::config::c_order> ?
+        tensor_type{{1,2,3},{4,5,6}} :
+        tensor_type{{1,3,5},{2,4,6}};
+
+    SECTION("read_only")
+    {
+        const tensor_type t({2,3},storage_type(file.name(),mmap_mode::read_only,elements.size()));
+        REQUIRE(t == expected);
+        REQUIRE(t.sum() == tensor_type(21));
+        REQUIRE(t.sum(0) == expected.sum(0));
+        REQUIRE(t(1).copy() == expected(1));
+        REQUIRE((t+t) == (expected+expected));
+    }
+    SECTION("read_write")
+    {
+        {
+            tensor_type t(std::vector<int>{2,3},storage_type(file.name(),mmap_mode::read_write,elements.size()));
+            t+=value_type{1};
+        }
+        REQUIRE(read_file<value_type>(file.name()) == std::vector<value_type>{2,3,4,5,6,7});
+    }
+    SECTION("exception")
+    {
+        REQUIRE_THROWS_AS(tensor_type({2,2},storage_type(file.name(),mmap_mode::read_only,elements.size())),gtensor::value_error);
+    }
+}
+
+#endif
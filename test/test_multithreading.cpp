@@ -9,6 +9,7 @@
 #include <vector>
 #include <numeric>
 #include <functional>
+#include <string>
 #include "catch.hpp"
 #include "multithreading.hpp"
 #include "helpers_for_testing.hpp"
@@ -65,12 +66,41 @@ TEST_CASE("test_multithreading_par_task_size","[test_multithreading]")
     apply_by_element(test,test_data);
 }
 
+TEST_CASE("test_multithreading_make_par_task_size","[test_multithreading]")
+{
+    using multithreading::make_par_task_size;
+    using multithreading::exec_pol;
+    using multithreading::exec_pol_rt;
+    using size_type = std::ptrdiff_t;
+    auto elements = [](const auto& par_sizes){
+        std::vector<size_type> res{};
+        for(std::size_t i=0; i!=par_sizes.size(); ++i){
+            res.push_back(par_sizes[i]);
+        }
+        return res;
+    };
+    using elements_type = std::vector<size_type>;
+    REQUIRE(multithreading::par_tasks_n(exec_pol<4>{}) == 4);
+    REQUIRE(multithreading::par_tasks_n(exec_pol<0>{}) == multithreading::get_pool().size());
+    REQUIRE(multithreading::par_tasks_n(exec_pol_rt{5}) == 5);
+    REQUIRE(multithreading::par_tasks_n(exec_pol_rt{}) == multithreading::get_pool().size());
+    REQUIRE(elements(make_par_task_size(exec_pol<4>{},size_type{10})) == elements_type{3,3,2,2});
+    REQUIRE(elements(make_par_task_size(exec_pol<4>{},size_type{10},3)) == elements_type{4,3,3});
+    REQUIRE(elements(make_par_task_size(exec_pol_rt{4},size_type{10})) == elements_type{3,3,2,2});
+    REQUIRE(elements(make_par_task_size(exec_pol_rt{4,5},size_type{10})) == elements_type{5,5});
+    REQUIRE(elements(make_par_task_size(exec_pol_rt{4,5},size_type{10},3)) == elements_type{5,5});
+    REQUIRE(elements(make_par_task_size(exec_pol_rt{4,1},size_type{10},3)) == elements_type{4,3,3});
+    REQUIRE(elements(make_par_task_size(exec_pol_rt{4,20},size_type{10})) == elements_type{});
+    REQUIRE(elements(make_par_task_size(exec_pol_rt{1},size_type{10})) == elements_type{10});
+}
+
 TEMPLATE_TEST_CASE("test_multithreading_reduce","[test_multithreading]",
     (multithreading::exec_pol<1>),
     (multithreading::exec_pol<2>),
     (multithreading::exec_pol<4>),
     (multithreading::exec_pol<8>),
-    (multithreading::exec_pol<0>)
+    (multithreading::exec_pol<0>),
+    (multithreading::exec_pol_rt)
 )
 {
     using policy = TestType;
@@ -118,7 +148,8 @@ TEMPLATE_TEST_CASE("test_multithreading_transform","[test_multithreading]",
     (multithreading::exec_pol<2>),
     (multithreading::exec_pol<4>),
     (multithreading::exec_pol<8>),
-    (multithreading::exec_pol<0>)
+    (multithreading::exec_pol<0>),
+    (multithreading::exec_pol_rt)
 )
 {
     using policy = TestType;
@@ -168,7 +199,8 @@ TEMPLATE_TEST_CASE("test_multithreading_transform_first1","[test_multithreading]
     (multithreading::exec_pol<2>),
     (multithreading::exec_pol<4>),
     (multithreading::exec_pol<8>),
-    (multithreading::exec_pol<0>)
+    (multithreading::exec_pol<0>),
+    (multithreading::exec_pol_rt)
 )
 {
     using policy = TestType;
@@ -217,7 +249,8 @@ TEMPLATE_TEST_CASE("test_multithreading_transform_unary","[test_multithreading]"
     (multithreading::exec_pol<2>),
     (multithreading::exec_pol<4>),
     (multithreading::exec_pol<8>),
-    (multithreading::exec_pol<0>)
+    (multithreading::exec_pol<0>),
+    (multithreading::exec_pol_rt)
 )
 {
     using policy = TestType;
@@ -263,7 +296,8 @@ TEMPLATE_TEST_CASE("test_multithreading_copy","[test_multithreading]",
     (multithreading::exec_pol<2>),
     (multithreading::exec_pol<4>),
     (multithreading::exec_pol<8>),
-    (multithreading::exec_pol<0>)
+    (multithreading::exec_pol<0>),
+    (multithreading::exec_pol_rt)
 )
 {
     using policy = TestType;
@@ -299,7 +333,8 @@ TEMPLATE_TEST_CASE("test_multithreading_inner_product","[test_multithreading]",
     (multithreading::exec_pol<2>),
     (multithreading::exec_pol<4>),
     (multithreading::exec_pol<8>),
-    (multithreading::exec_pol<0>)
+    (multithreading::exec_pol<0>),
+    (multithreading::exec_pol_rt)
 )
 {
     using policy = TestType;
@@ -337,3 +372,329 @@ TEMPLATE_TEST_CASE("test_multithreading_inner_product","[test_multithreading]",
     };
     apply_by_element(test,test_data);
 }
+
+TEST_CASE("test_multithreading_mpmc_bounded_queue","[test_multithreading]")
+{
+    using multithreading::mpmc_bounded_queue;
+    using value_type = int;
+
+    REQUIRE_THROWS_AS(mpmc_bounded_queue<value_type>(0), std::invalid_argument);
+    REQUIRE(mpmc_bounded_queue<value_type>(1).capacity() == 2);
+    REQUIRE(mpmc_bounded_queue<value_type>(5).capacity() == 8);
+    REQUIRE(mpmc_bounded_queue<value_type>(8).capacity() == 8);
+
+    mpmc_bounded_queue<value_type> queue(4);
+    value_type v{0};
+    REQUIRE(!queue.try_pop(v));
+    REQUIRE(queue.try_push(1));
+    REQUIRE(queue.try_push(2));
+    REQUIRE(queue.try_push(3));
+    REQUIRE(queue.try_push(4));
+    REQUIRE(!queue.try_push(5));
+    REQUIRE(queue.try_pop(v));
+    REQUIRE(v == 1);
+    REQUIRE(queue.try_push(5));
+    std::vector<value_type> result{};
+    while(queue.try_pop(v)){
+        result.push_back(v);
+    }
+    REQUIRE(result == std::vector<value_type>{2,3,4,5});
+}
+
+TEST_CASE("test_multithreading_mpmc_bounded_queue_concurrent","[test_multithreading]")
+{
+    using multithreading::mpmc_bounded_queue;
+    using value_type = std::size_t;
+    static constexpr std::size_t n_producers = 4;
+    static constexpr std::size_t n_consumers = 4;
+    static constexpr std::size_t n = 100000;
+
+    mpmc_bounded_queue<value_type> queue(64);
+    std::atomic<std::size_t> consumed{0};
+    std::atomic<value_type> sum{0};
+    std::vector<std::thread> threads{};
+    for (std::size_t i=0; i!=n_producers; ++i){
+        threads.emplace_back([&queue]{
+            for (value_type e=1; e!=n+1; ++e){
+                while(!queue.try_push(e)){
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (std::size_t i=0; i!=n_consumers; ++i){
+        threads.emplace_back([&queue,&consumed,&sum]{
+            value_type e{0};
+            while(consumed.load()!=n*n_producers){
+                if (queue.try_pop(e)){
+                    sum.fetch_add(e);
+                    consumed.fetch_add(1);
+                }else{
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    std::for_each(threads.begin(),threads.end(),[](auto& t){t.join();});
+    REQUIRE(sum.load() == n_producers*(n*(n+1))/2);
+}
+
+TEST_CASE("test_multithreading_ws_deque","[test_multithreading]")
+{
+    using multithreading::ws_deque;
+    using value_type = int;
+
+    REQUIRE_THROWS_AS(ws_deque<value_type>(0), std::invalid_argument);
+    REQUIRE(ws_deque<value_type>(3).capacity() == 4);
+
+    std::vector<value_type> elements{1,2,3,4,5};
+    ws_deque<value_type> deque(4);
+    REQUIRE(deque.pop_bottom() == nullptr);
+    REQUIRE(deque.steal() == nullptr);
+    REQUIRE(deque.push_bottom(&elements[0]));
+    REQUIRE(deque.push_bottom(&elements[1]));
+    REQUIRE(deque.push_bottom(&elements[2]));
+    REQUIRE(deque.push_bottom(&elements[3]));
+    REQUIRE(!deque.push_bottom(&elements[4]));
+    //steal from top, pop from bottom
+    REQUIRE(deque.steal() == &elements[0]);
+    REQUIRE(deque.pop_bottom() == &elements[3]);
+    REQUIRE(deque.push_bottom(&elements[4]));
+    REQUIRE(deque.pop_bottom() == &elements[4]);
+    REQUIRE(deque.steal() == &elements[1]);
+    REQUIRE(deque.pop_bottom() == &elements[2]);
+    REQUIRE(deque.pop_bottom() == nullptr);
+    REQUIRE(deque.steal() == nullptr);
+}
+
+TEST_CASE("test_multithreading_ws_deque_concurrent","[test_multithreading]")
+{
+    using multithreading::ws_deque;
+    using value_type = std::size_t;
+    static constexpr std::size_t n_thieves = 4;
+    static constexpr std::size_t n = 100000;
+
+    std::vector<value_type> elements(n);
+    std::iota(elements.begin(),elements.end(),1);
+    ws_deque<value_type> deque(256);
+    std::atomic<std::size_t> consumed{0};
+    std::atomic<value_type> sum{0};
+    std::vector<std::thread> thieves{};
+    for (std::size_t i=0; i!=n_thieves; ++i){
+        thieves.emplace_back([&deque,&consumed,&sum]{
+            while(consumed.load()!=n){
+                if (auto p = deque.steal()){
+                    sum.fetch_add(*p);
+                    consumed.fetch_add(1);
+                }else{
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    //owner
+    for (auto it=elements.begin(); it!=elements.end();){
+        if (deque.push_bottom(&*it)){
+            ++it;
+        }else if (auto p = deque.pop_bottom()){
+            sum.fetch_add(*p);
+            consumed.fetch_add(1);
+        }
+    }
+    while(auto p = deque.pop_bottom()){
+        sum.fetch_add(*p);
+        consumed.fetch_add(1);
+    }
+    std::for_each(thieves.begin(),thieves.end(),[](auto& t){t.join();});
+    REQUIRE(consumed.load() == n);
+    REQUIRE(sum.load() == (n*(n+1))/2);
+}
+
+TEMPLATE_TEST_CASE("test_multithreading_thread_pool","[test_multithreading]",
+    multithreading::thread_pool_v3,
+    multithreading::thread_pool_v4
+)
+{
+    using pool_type = TestType;
+    using value_type = std::size_t;
+
+    SECTION("push")
+    {
+        pool_type pool(4,8);
+        std::vector<multithreading::detail::task_future<value_type>> futures{};
+        for (value_type i=0; i!=100; ++i){
+            futures.push_back(pool.push([](auto a, auto b){return a*b;},i,value_type{2}));
+        }
+        value_type result{0};
+        for (auto& f : futures){
+            result+=f.get();
+        }
+        REQUIRE(result == 9900);
+    }
+    SECTION("push_async_ref_arg")
+    {
+        pool_type pool(2,2);
+        value_type e{0};
+        auto f = pool.push_async([](value_type& e_){e_=42;},std::ref(e));
+        f.wait();
+        REQUIRE(e == 42);
+    }
+    SECTION("push_group")
+    {
+        pool_type pool(4,4);
+        static constexpr std::size_t n = 1000;
+        std::vector<value_type> result(n,0);
+        multithreading::task_group group{};
+        for (std::size_t i=0; i!=n; ++i){
+            pool.push_group(group,[](value_type& e, value_type v){e=v*v;},std::ref(result[i]),i);
+        }
+        group.wait();
+        std::vector<value_type> expected(n);
+        for (std::size_t i=0; i!=n; ++i){
+            expected[i] = i*i;
+        }
+        REQUIRE(result == expected);
+    }
+    SECTION("push_group_concurrent_producers")
+    {
+        pool_type pool(4,16);
+        static constexpr std::size_t n_producers = 4;
+        static constexpr std::size_t n_groups = 100;
+        static constexpr std::size_t group_size = 8;
+        std::atomic<value_type> sum{0};
+        std::vector<std::thread> producers{};
+        for (std::size_t i=0; i!=n_producers; ++i){
+            producers.emplace_back([&pool,&sum]{
+                for (std::size_t j=0; j!=n_groups; ++j){
+                    multithreading::task_group group{};
+                    for (std::size_t k=0; k!=group_size; ++k){
+                        pool.push_group(group,[&sum](value_type v){sum.fetch_add(v);},k);
+                    }
+                    group.wait();
+                }
+            });
+        }
+        std::for_each(producers.begin(),producers.end(),[](auto& t){t.join();});
+        REQUIRE(sum.load() == n_producers*n_groups*(group_size*(group_size-1))/2);
+    }
+}
+
+TEST_CASE("test_multithreading_thread_pool_v4_nested_push","[test_multithreading]")
+{
+    using value_type = std::size_t;
+    static constexpr std::size_t n_outer = 2;
+    static constexpr std::size_t n_inner = 100;
+    multithreading::thread_pool_v4 pool(4,4);
+    std::atomic<value_type> sum{0};
+    multithreading::task_group outer{};
+    for (std::size_t i=0; i!=n_outer; ++i){
+        pool.push_group(outer,
+            [&pool,&sum]{
+                //tasks pushed from worker go to its own deque and may be stolen by other workers
+                std::vector<multithreading::detail::task_future<void>> futures{};
+                for (std::size_t j=0; j!=n_inner; ++j){
+                    futures.push_back(pool.push_async([&sum](value_type v){sum.fetch_add(v);},j));
+                }
+                for (auto& f : futures){
+                    f.wait();
+                }
+            }
+        );
+    }
+    outer.wait();
+    REQUIRE(sum.load() == n_outer*(n_inner*(n_inner-1))/2);
+}
+
+TEST_CASE("test_multithreading_pool_config_parse","[test_multithreading]")
+{
+    using multithreading::detail::parse_pool_size;
+    using multithreading::detail::parse_cpu_list;
+    using multithreading::detail::make_pool_config;
+    using multithreading::default_pool_workers_n;
+    using multithreading::pool_queue_size;
+    using cpus_type = std::vector<std::size_t>;
+
+    std::size_t size{0};
+    REQUIRE(parse_pool_size("12",size));
+    REQUIRE(size == 12);
+    REQUIRE(!parse_pool_size(nullptr,size));
+    REQUIRE(!parse_pool_size("",size));
+    REQUIRE(!parse_pool_size("0",size));
+    REQUIRE(!parse_pool_size("-1",size));
+    REQUIRE(!parse_pool_size("4x",size));
+    REQUIRE(size == 12);
+
+    cpus_type cpus{};
+    REQUIRE(parse_cpu_list("3",cpus));
+    REQUIRE(cpus == cpus_type{3});
+    REQUIRE(parse_cpu_list("0,2,4-7,1",cpus));
+    REQUIRE(cpus == cpus_type{0,2,4,5,6,7,1});
+    REQUIRE(!parse_cpu_list(nullptr,cpus));
+    REQUIRE(!parse_cpu_list("",cpus));
+    REQUIRE(!parse_cpu_list("1,",cpus));
+    REQUIRE(!parse_cpu_list("1,,2",cpus));
+    REQUIRE(!parse_cpu_list("3-1",cpus));
+    REQUIRE(!parse_cpu_list("a",cpus));
+    REQUIRE(!parse_cpu_list("0-18446744073709551615",cpus));
+    REQUIRE(!parse_cpu_list("99999999999999999999",cpus));
+    REQUIRE(!parse_cpu_list(std::to_string(multithreading::detail::max_cpu_id+1).c_str(),cpus));
+    REQUIRE(parse_cpu_list(std::to_string(multithreading::detail::max_cpu_id).c_str(),cpus));
+    REQUIRE(cpus == cpus_type{multithreading::detail::max_cpu_id});
+    REQUIRE(parse_cpu_list("0,2,4-7,1",cpus));
+    REQUIRE(cpus == cpus_type{0,2,4,5,6,7,1});
+
+    auto config = make_pool_config(nullptr,nullptr,nullptr);
+    REQUIRE(config.workers_n == default_pool_workers_n());
+    REQUIRE(config.queue_size == pool_queue_size);
+    REQUIRE(config.affinity.empty());
+    config = make_pool_config("3","64","0-1");
+    REQUIRE(config.workers_n == 3);
+    REQUIRE(config.queue_size == 64);
+    REQUIRE(config.affinity == cpus_type{0,1});
+    config = make_pool_config("x","0","1-");
+    REQUIRE(config.workers_n == default_pool_workers_n());
+    REQUIRE(config.queue_size == pool_queue_size);
+    REQUIRE(config.affinity.empty());
+}
+
+TEST_CASE("test_multithreading_global_pool_reset","[test_multithreading]")
+{
+    using value_type = std::size_t;
+    using multithreading::get_pool;
+    using multithreading::reset_pool;
+    using multithreading::pool_config;
+    static constexpr std::size_t n_tasks = 100;
+
+    auto run_tasks = []{
+        std::atomic<value_type> sum{0};
+        multithreading::task_group group{};
+        for (std::size_t i=0; i!=n_tasks; ++i){
+            get_pool().push_group(group,[&sum](value_type v){sum.fetch_add(v);},i);
+        }
+        group.wait();
+        return sum.load();
+    };
+    const auto initial_config = multithreading::get_pool_config();
+    static constexpr value_type expected = (n_tasks*(n_tasks-1))/2;
+
+    REQUIRE_THROWS_AS(multithreading::set_pool_config(pool_config{0,4,{}}), std::invalid_argument);
+    REQUIRE_THROWS_AS(multithreading::set_pool_config(pool_config{4,0,{}}), std::invalid_argument);
+
+    reset_pool(pool_config{3,8,{}});
+    REQUIRE(get_pool().size() == 3);
+    REQUIRE(run_tasks() == expected);
+    //config change takes effect after reset
+    multithreading::set_pool_config(pool_config{2,8,{}});
+    REQUIRE(get_pool().size() == 3);
+    reset_pool();
+    REQUIRE(get_pool().size() == 2);
+    REQUIRE(run_tasks() == expected);
+    //pinned workers
+    reset_pool(pool_config{2,8,{0}});
+    REQUIRE(get_pool().size() == 2);
+    REQUIRE(run_tasks() == expected);
+
+    reset_pool(initial_config);
+    REQUIRE(get_pool().size() == initial_config.workers_n);
+    REQUIRE(run_tasks() == expected);
+}
@@ -0,0 +1,291 @@
+/*
+* GTensor - computation library
+* Copyright (c) 2022 Ivan Malezhyk <ivanmzk@gmail.com>
+*
+* Distributed under the Boost Software License, Version 1.0.
+* The full license is in the file LICENSE.txt, distributed with this software.
+*/
+
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdint>
+#include <complex>
+#include <filesystem>
+#include "catch.hpp"
+#include "npy.hpp"
+#include "tensor_math.hpp"
+#include "tensor.hpp"
+#include "helpers_for_testing.hpp"
+
+namespace test_npy{
+
+//temporary file that is removed in destructor
+class temp_file
+{
+    std::string name_;
+public:
+    explicit temp_file(const std::string& name):
+        name_{(std::filesystem::temp_directory_path()/name).string()}
+    {
+        std::remove(name_.c_str());
+    }
+    ~temp_file(){
+        std::remove(name_.c_str());
+    }
+    const std::string& name()const{return name_;}
+};
+
+inline std::string read_file(const std::string& name){
+    std::ifstream f(name, std::ios::binary);
+    std::ostringstream ss{};
+    ss<<f.rdbuf();
+    return ss.str();
+}
+
+inline std::string npy_header_string(const std::string& dict){
+    std::string header = dict;
+    header.append(128-10-dict.size()-1,' ');
+    header+="\n";
+    return std::string{"\x93NUMPY\x01\x00\x76\x00",10}+header;
+}
+
+}   //end of namespace test_npy
+
+TEST_CASE("test_npy_header","[test_npy]")
+{
+    using gtensor::tensor;
+    using gtensor::config::c_order;
+    using gtensor::config::f_order;
+    using test_npy::temp_file;
+    using test_npy::read_file;
+    using test_npy::npy_header_string;
+    temp_file file{"gtensor_test_npy_header.npy"};
+
+    SECTION("c_order")
+    {
+        const tensor<double,c_order> t{{1,2,3},{4,5,6}};
+        gtensor::save_npy(file.name(),t);
+        const auto content = read_file(file.name());
+        REQUIRE(content.size() == 128+6*sizeof(double));
+        REQUIRE(content.substr(0,128) == npy_header_string("{'descr': '<f8', 'fortran_order': False, 'shape': (2, 3), }"));
+        REQUIRE(std::equal(t.data(),t.data()+6,reinterpret_cast<const double*>(content.data()+128)));
+    }
+    SECTION("f_order_1d")
+    {
+        const tensor<std::int32_t,f_order> t{1,2,3};
+        gtensor::save_npy(file.name(),t);
+        REQUIRE(read_file(file.name()).substr(0,128) == npy_header_string("{'descr': '<i4', 'fortran_order': True, 'shape': (3,), }"));
+    }
+    SECTION("0-dim")
+    {
+        const tensor<bool> t(true);
+        gtensor::save_npy(file.name(),t);
+        REQUIRE(read_file(file.name()) == npy_header_string("{'descr': '|b1', 'fortran_order': False, 'shape': (), }")+std::string{"\x01",1});
+    }
+}
+
+TEMPLATE_TEST_CASE("test_npy_save_load","[test_npy]",
+    double,
+    float,
+    std::int64_t,
+    std::int32_t,
+    std::uint8_t,
+    bool,
+    std::complex<double>
+)
+{
+    using value_type = TestType;
+    using gtensor::tensor;
+    using gtensor::config::c_order;
+    using gtensor::config::f_order;
+    using test_npy::temp_file;
+    using helpers_for_testing::apply_by_element;
+
+    temp_file file{"gtensor_test_npy_save_load.npy"};
+    //0tensor
+    auto test_data = std::make_tuple(
+        std::make_tuple(tensor<value_type,c_order>(value_type{1})),
+        std::make_tuple(tensor<value_type,c_order>{}),
+        std::make_tuple(tensor<value_type,c_order>(std::vector<int>{0,3})),
+        std::make_tuple(tensor<value_type,c_order>{value_type{1},value_type{0},value_type{1}}),
+        std::make_tuple(tensor<value_type,c_order>{{{1,0},{1,1},{0,0}},{{0,1},{1,0},{1,1}}}),
+        std::make_tuple(tensor<value_type,f_order>{{{1,0},{1,1},{0,0}},{{0,1},{1,0},{1,1}}}),
+        std::make_tuple(tensor<value_type,f_order>{{1,0,1,0,1},{0,1,1,0,0}})
+    );
+    auto test = [&file](const auto& t){
+        auto ten = std::get<0>(t);
+        gtensor::save_npy(file.name(),ten);
+        const auto result_c = gtensor::load_npy<value_type,c_order>(file.name());
+        const auto result_f = gtensor::load_npy<value_type,f_order>(file.name());
+        REQUIRE(result_c == ten);
+        REQUIRE(result_f == ten);
+    };
+    apply_by_element(test,test_data);
+}
+
+TEMPLATE_TEST_CASE("test_npy_save_view","[test_npy]",
+    gtensor::config::c_order,
+    gtensor::config::f_order
+)
+{
+    using value_type = double;
+    using order = TestType;
+    using tensor_type = gtensor::tensor<value_type,order>;
+    using shape_type = typename tensor_type::shape_type;
+    using slice_type = typename tensor_type::slice_type;
+    using gtensor::config::c_order;
+    using gtensor::config::f_order;
+    using test_npy::temp_file;
+    using helpers_for_testing::apply_by_element;
+
+    temp_file file{"gtensor_test_npy_save_view.npy"};
+    tensor_type a(shape_type{4,5,6});
+    std::iota(a.begin(),a.end(),value_type{0});
+    const tensor_type b{1,2,3,4,5,6};
+    //0view
+    auto test_data = std::make_tuple(
+        std::make_tuple(a.transpose()),
+        std::make_tuple(a(slice_type{1,3},slice_type{},slice_type{0,6,2})),
+        std::make_tuple(a.reshape(-1,3)),
+        std::make_tuple(a+b),
+        std::make_tuple(a.transpose()+a.transpose())
+    );
+    auto test = [&file](const auto& t){
+        auto view = std::get<0>(t);
+        gtensor::save_npy(file.name(),view);
+        REQUIRE(gtensor::load_npy<value_type,c_order>(file.name()) == view);
+        REQUIRE(gtensor::load_npy<value_type,f_order>(file.name()) == view);
+    };
+    apply_by_element(test,test_data);
+}
+
+TEMPLATE_TEST_CASE("test_npy_load_mmap","[test_npy]",
+    gtensor::config::c_order,
+    gtensor::config::f_order
+)
+{
+    using value_type = float;
+    using order = TestType;
+    using other_order = std::conditional_t<std::is_same_v<order,gtensor::config::c_order>,gtensor::config::f_order,gtensor::config::c_order>;
+    using tensor_type = gtensor::tensor<value_type,order>;
+    using gtensor::mmap_mode;
+    using test_npy::temp_file;
+
+    temp_file file{"gtensor_test_npy_load_mmap.npy"};
+    const tensor_type t{{1,2,3},{4,5,6}};
+    gtensor::save_npy(file.name(),t);
+
+    SECTION("read_only")
+    {
+        const auto result = gtensor::load_npy<value_type,order>(file.name(),mmap_mode::read_only);
+        REQUIRE(result == t);
+        REQUIRE(result.sum(1) == t.sum(1));
+    }
+    SECTION("copy_on_write")
+    {
+        {
+            auto result = gtensor::load_npy<value_type,order>(file.name(),mmap_mode::copy_on_write);
+            result*=value_type{2};
+            REQUIRE(result == t*value_type{2});
+        }
+        REQUIRE(gtensor::load_npy<value_type,order>(file.name()) == t);
+    }
+    SECTION("read_write")
+    {
+        {
+            auto result = gtensor::load_npy<value_type,order>(file.name(),mmap_mode::read_write);
+            result*=value_type{2};
+        }
+        REQUIRE(gtensor::load_npy<value_type,order>(file.name()) == t*value_type{2});
+    }
+    SECTION("exception")
+    {
+        REQUIRE_THROWS_AS((gtensor::load_npy<value_type,other_order>(file.name(),mmap_mode::read_only)),gtensor::value_error);
+        REQUIRE_THROWS_AS((gtensor::load_npy<double,order>(file.name(),mmap_mode::read_only)),gtensor::value_error);
+    }
+}
+
+TEST_CASE("test_npz_save_load","[test_npy]")
+{
+    using gtensor::tensor;
+    using gtensor::config::c_order;
+    using gtensor::config::f_order;
+    using test_npy::temp_file;
+
+    temp_file file{"gtensor_test_npz_save_load.npz"};
+    const tensor<double,c_order> a{{1,2,3},{4,5,6}};
+    const tensor<std::int64_t,f_order> b{{1,2},{3,4},{5,6}};
+    const tensor<float> c{};
+    gtensor::save_npz(file.name(),"a",a,"b",b,"c",c,"at",a.transpose());
+
+    REQUIRE(gtensor::load_npz<double>(file.name(),"a") == a);
+    REQUIRE(gtensor::load_npz<double,f_order>(file.name(),"a.npy") == a);
+    REQUIRE(gtensor::load_npz<std::int64_t,f_order>(file.name(),"b") == b);
+    REQUIRE(gtensor::load_npz<float>(file.name(),"c") == c);
+    REQUIRE(gtensor::load_npz<double>(file.name(),"at") == a.transpose());
+    REQUIRE_THROWS_AS(gtensor::load_npz<double>(file.name(),"d"),gtensor::value_error);
+    REQUIRE_THROWS_AS(gtensor::load_npz<double>(file.name(),"b"),gtensor::value_error);
+}
+
+TEST_CASE("test_npz_zip64","[test_npy]")
+{
+    using gtensor::detail::zip_entry;
+    using gtensor::detail::zip_get;
+    using gtensor::detail::zip64_limit;
+    using gtensor::detail::write_zip_local_header;
+    using gtensor::detail::write_zip_crc;
+    using gtensor::detail::write_zip_directory;
+    using gtensor::detail::find_zip_entry;
+
+    SECTION("zip64_size_offset")
+    {
+        //records are checked only, entries data is not written
+        std::stringstream ss{};
+        const std::uint64_t size = zip64_limit+1;
+        auto entry = write_zip_local_header(ss,"a.npy",size);
+        entry.crc = 0x12345678;
+        write_zip_crc(ss,entry);
+        const zip_entry far_entry{"b.npy",0,4,zip64_limit+2};
+        write_zip_directory(ss,std::vector<zip_entry>{far_entry,entry});
+        const auto archive = ss.str();
+        REQUIRE(zip_get(archive.data()+14,4) == 0x12345678);
+        REQUIRE(zip_get(archive.data()+18,4) == zip64_limit);
+        REQUIRE(zip_get(archive.data()+22,4) == zip64_limit);
+        REQUIRE(zip_get(archive.data()+35,2) == 0x0001);
+        REQUIRE(zip_get(archive.data()+39,8) == size);
+        REQUIRE(zip_get(archive.data()+47,8) == size);
+        REQUIRE(find_zip_entry(ss,"a.npy") == 30+5+20);
+        REQUIRE_THROWS_AS(find_zip_entry(ss,"c.npy"),gtensor::value_error);
+    }
+    SECTION("zip64_entries_number")
+    {
+        std::stringstream ss{};
+        std::vector<zip_entry> entries{};
+        const std::size_t n = 0x10000;
+        for (std::size_t i=0; i!=n; ++i){
+            entries.push_back(write_zip_local_header(ss,std::to_string(i)+".npy",0));
+        }
+        write_zip_directory(ss,entries);
+        const auto archive = ss.str();
+        const auto eocd = archive.size()-22;
+        REQUIRE(zip_get(archive.data()+eocd,4) == 0x06054b50);
+        REQUIRE(zip_get(archive.data()+eocd+10,2) == 0xffff);
+        REQUIRE(zip_get(archive.data()+eocd-20,4) == 0x07064b50);
+        REQUIRE(find_zip_entry(ss,std::to_string(n-1)+".npy") == entries.back().offset+30+std::to_string(n-1).size()+4);
+    }
+}
+
+TEST_CASE("test_npy_exception","[test_npy]")
+{
+    using test_npy::temp_file;
+    temp_file file{"gtensor_test_npy_exception.npy"};
+    REQUIRE_THROWS_AS(gtensor::load_npy<double>(file.name()),gtensor::io_error);
+    {
+        std::ofstream f(file.name(),std::ios::binary);
+        f<<"not npy file";
+    }
+    REQUIRE_THROWS_AS(gtensor::load_npy<double>(file.name()),gtensor::value_error);
+    REQUIRE_THROWS_AS(gtensor::load_npz<double>(file.name(),"a"),gtensor::value_error);
+}
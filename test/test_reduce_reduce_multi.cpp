@@ -0,0 +1,242 @@
+/*
+* GTensor - computation library
+* Copyright (c) 2022 Ivan Malezhyk <ivanmzk@gmail.com>
+*
+* Distributed under the Boost Software License, Version 1.0.
+* The full license is in the file LICENSE.txt, distributed with this software.
+*/
+
+#include <algorithm>
+#include "catch.hpp"
+#include "builder.hpp"
+#include "reduce.hpp"
+#include "tensor.hpp"
+#include "tensor_math.hpp"
+#include "helpers_for_testing.hpp"
+#include "config_for_testing.hpp"
+
+namespace test_reduce_multi_{
+    struct max{
+        template<typename T, typename U>
+        auto operator()(const T& t, const U& u){
+            return t>u ? t:u;
+        }
+    };
+    struct min{
+        template<typename T, typename U>
+        auto operator()(const T& t, const U& u){
+            return t<u ? t:u;
+        }
+    };
+    //count of nonzero elements, reduce result is of index type
+    struct count_nonzero{
+        std::size_t operator()(const std::size_t& r, const double& e){
+            return e==0 ? r : r+1;
+        }
+        std::size_t operator()(const double& e1, const double& e2){
+            return (e1==0 ? 0 : 1)+(e2==0 ? 0 : 1);
+        }
+        std::size_t operator()(const std::size_t& r1, const std::size_t& r2){
+            return r1+r2;
+        }
+    };
+}
+
+TEMPLATE_TEST_CASE("test_reduce_multi","[test_reduce]",
+    gtensor::config::c_order,
+    gtensor::config::f_order
+)
+{
+    using value_type = double;
+    using tensor_type = gtensor::tensor<value_type,TestType>;
+    using gtensor::reduce_multi;
+    using gtensor::reduce_binary;
+    using gtensor::tensor_equal;
+    using gtensor::detail::no_value;
+    using test_reduce_multi_::max;
+    using test_reduce_multi_::min;
+    using test_reduce_multi_::count_nonzero;
+    using helpers_for_testing::apply_by_element;
+
+    const auto test_ten = tensor_type{
+        {{{7,4,6,5,7},{3,1,3,3,8},{3,5,6,7,6},{5,7,1,1,6}},{{6,4,0,3,8},{5,3,3,8,7},{0,1,7,2,3},{5,5,0,2,5}},{{8,7,7,4,5},{1,8,6,8,4},{2,7,1,6,2},{6,5,6,0,3}}},
+        {{{2,2,7,5,5},{0,0,3,7,1},{8,2,5,0,1},{0,7,7,5,8}},{{1,5,6,7,0},{6,4,1,4,2},{2,1,0,1,1},{6,6,3,6,7}},{{7,6,1,3,7},{2,3,8,0,3},{3,8,6,3,7},{5,8,4,8,5}}}
+    };  //(2,3,4,5)
+
+    //0tensor,1axes,2keep_dims
+    auto test_data = std::make_tuple(
+        std::make_tuple(test_ten,0,false),
+        std::make_tuple(test_ten,3,true),
+        std::make_tuple(test_ten,std::vector<int>{1},false),
+        std::make_tuple(test_ten,std::vector<int>{0,2},false),
+        std::make_tuple(test_ten,std::vector<int>{3,1},true),
+        std::make_tuple(test_ten,std::vector<int>{0,1,3},false),
+        std::make_tuple(test_ten,std::vector<int>{0,1,2,3},false),
+        std::make_tuple(test_ten,std::vector<int>{0,1,2,3},true),
+        std::make_tuple(test_ten,std::vector<int>{},false),
+        std::make_tuple(tensor_type{1,0,3,4,5},0,false),
+        std::make_tuple(tensor_type{5},0,true),
+        std::make_tuple(tensor_type{}.reshape(2,0,3),std::vector<int>{0,2},false)
+    );
+    auto test_reduce_multi = [&test_data](auto...policy){
+        auto test = [policy...](const auto& t){
+            auto ten = std::get<0>(t);
+            auto axes = std::get<1>(t);
+            auto keep_dims = std::get<2>(t);
+            auto fs = std::make_tuple(min{},max{},std::plus<void>{},count_nonzero{});
+            auto result = reduce_multi(policy...,ten,axes,fs,keep_dims,std::make_tuple(no_value{},value_type{3},value_type{-1},std::size_t{0}));
+            auto expected_min = reduce_binary(policy...,ten,axes,min{},keep_dims);
+            auto expected_max = reduce_binary(policy...,ten,axes,max{},keep_dims,value_type{3});
+            auto expected_sum = reduce_binary(policy...,ten,axes,std::plus<void>{},keep_dims,value_type{-1});
+            auto expected_count = reduce_binary(policy...,ten,axes,count_nonzero{},keep_dims,std::size_t{0});
+            REQUIRE(std::is_same_v<decltype(result),std::tuple<decltype(expected_min),decltype(expected_max),decltype(expected_sum),decltype(expected_count)>>);
+            REQUIRE(tensor_equal(std::get<0>(result),expected_min));
+            REQUIRE(tensor_equal(std::get<1>(result),expected_max));
+            REQUIRE(tensor_equal(std::get<2>(result),expected_sum));
+            REQUIRE(tensor_equal(std::get<3>(result),expected_count));
+        };
+        apply_by_element(test,test_data);
+    };
+    SECTION("test_reduce_multi_default_policy")
+    {
+        test_reduce_multi();
+    }
+    SECTION("test_reduce_multi_exec_pol<4>")
+    {
+        test_reduce_multi(multithreading::exec_pol<4>{});
+    }
+    SECTION("test_reduce_multi_exec_pol_rt")
+    {
+        test_reduce_multi(multithreading::exec_pol_rt{4,2});
+    }
+}
+
+TEMPLATE_TEST_CASE("test_reduce_multi_flatten","[test_reduce]",
+    (multithreading::exec_pol<1>),
+    (multithreading::exec_pol<4>),
+    (multithreading::exec_pol_rt)
+)
+{
+    using policy = TestType;
+    using value_type = double;
+    using tensor_type = gtensor::tensor<value_type>;
+    using gtensor::reduce_multi;
+    using gtensor::tensor_equal;
+    using gtensor::detail::no_value;
+    using test_reduce_multi_::max;
+    using test_reduce_multi_::min;
+    using test_reduce_multi_::count_nonzero;
+
+    auto make_policy = [](){
+        if constexpr (std::is_same_v<policy,multithreading::exec_pol_rt>){
+            return policy{4,2};
+        }else{
+            return policy{};
+        }
+    };
+    const auto fs = std::make_tuple(min{},max{},std::plus<void>{},count_nonzero{});
+    const auto initials = std::make_tuple(no_value{},no_value{},value_type{1},std::size_t{0});
+    SECTION("test_reduce_multi_flatten_small")
+    {
+        const auto ten = tensor_type{{3,0,-2,5},{1,7,0,4}};
+        const auto result = reduce_multi(make_policy(),ten,no_value{},fs,false,initials);
+        REQUIRE(tensor_equal(std::get<0>(result),tensor_type(-2)));
+        REQUIRE(tensor_equal(std::get<1>(result),tensor_type(7)));
+        REQUIRE(tensor_equal(std::get<2>(result),tensor_type(19)));
+        REQUIRE(tensor_equal(std::get<3>(result),gtensor::tensor<std::size_t>(6)));
+        const auto result_keep_dims = reduce_multi(make_policy(),ten,no_value{},fs,true,initials);
+        REQUIRE(tensor_equal(std::get<2>(result_keep_dims),tensor_type{{19}}));
+    }
+    SECTION("test_reduce_multi_flatten_big")
+    {
+        const int n = 100000;
+        auto ten = gtensor::arange<value_type>(n).reshape(100,-1).transpose().copy();
+        const auto result = reduce_multi(make_policy(),ten,no_value{},fs,false,initials);
+        REQUIRE(tensor_equal(std::get<0>(result),tensor_type(0)));
+        REQUIRE(tensor_equal(std::get<1>(result),tensor_type(n-1)));
+        REQUIRE(tensor_equal(std::get<2>(result),tensor_type(1+static_cast<value_type>(n)*(n-1)/2)));
+        REQUIRE(tensor_equal(std::get<3>(result),gtensor::tensor<std::size_t>(n-1)));
+        const auto result_view = reduce_multi(make_policy(),ten.transpose(),std::vector<int>{0,1},fs,false,initials);
+        REQUIRE(tensor_equal(std::get<2>(result_view),tensor_type(1+static_cast<value_type>(n)*(n-1)/2)));
+    }
+    SECTION("test_reduce_multi_without_initials")
+    {
+        const auto ten = tensor_type{{3,0,-2,5},{1,7,0,4}};
+        const auto result = reduce_multi(make_policy(),ten,1,std::make_tuple(min{},std::plus<void>{}),false);
+        REQUIRE(tensor_equal(std::get<0>(result),tensor_type{-2,0}));
+        REQUIRE(tensor_equal(std::get<1>(result),tensor_type{6,12}));
+    }
+}
+
+//functors with accumulate member must reduce the same way as in reduce_binary
+TEMPLATE_TEST_CASE("test_reduce_multi_accumulate","[test_reduce]",
+    (std::tuple<gtensor::config::mode_sum_naive,multithreading::exec_pol<1>>),
+    (std::tuple<gtensor::config::mode_sum_pairwise,multithreading::exec_pol<1>>),
+    (std::tuple<gtensor::config::mode_sum_pairwise,multithreading::exec_pol<4>>),
+    (std::tuple<gtensor::config::mode_sum_kahan,multithreading::exec_pol<1>>),
+    (std::tuple<gtensor::config::mode_sum_kahan,multithreading::exec_pol<4>>)
+)
+{
+    using sum_mode = std::tuple_element_t<0,TestType>;
+    using policy = std::tuple_element_t<1,TestType>;
+    using value_type = float;
+    using config_type = gtensor::config::extend_config_t<test_config::config_sum_mode_selector_t<sum_mode>,value_type>;
+    using tensor_type = gtensor::tensor<value_type,gtensor::config::c_order,config_type>;
+    using gtensor::reduce_multi;
+    using gtensor::sum;
+    using gtensor::nansum;
+    using gtensor::detail::no_value;
+    using test_reduce_multi_::max;
+    using sum_operation = gtensor::math_reduce_operations::sum_operation<sum_mode>;
+    using nansum_operation = gtensor::math_reduce_operations::nansum_operation<sum_mode>;
+
+    const auto fs = std::make_tuple(sum_operation{},max{},nansum_operation{});
+    const auto initials = std::make_tuple(value_type{0},no_value{},value_type{0});
+    //float left fold of such number of elements loses several digits
+    const int n = 1<<24;
+    const int rows = 4;
+    tensor_type t(std::vector<int>{rows,n/rows},value_type{0.1});
+    auto near = [](value_type result, value_type expected){
+        return std::abs(result-expected) <= 1E-6*std::abs(expected);
+    };
+    SECTION("test_reduce_multi_accumulate_flatten")
+    {
+        const value_type expected = *sum(policy{},t).begin();
+        const auto result = reduce_multi(policy{},t,no_value{},fs,false,initials);
+        REQUIRE(near(*std::get<0>(result).begin(),expected));
+        REQUIRE(*std::get<1>(result).begin() == value_type{0.1});
+        REQUIRE(near(*std::get<2>(result).begin(),expected));
+    }
+    SECTION("test_reduce_multi_accumulate_axis")
+    {
+        const auto expected = sum(policy{},t,1);
+        const auto result = reduce_multi(policy{},t,1,fs,false,initials);
+        for (int i=0; i!=rows; ++i){
+            REQUIRE(near(std::get<0>(result).element(i),expected.element(i)));
+            REQUIRE(near(std::get<2>(result).element(i),expected.element(i)));
+        }
+    }
+}
+
+TEST_CASE("test_reduce_multi_exception","[test_reduce]")
+{
+    using value_type = double;
+    using tensor_type = gtensor::tensor<value_type>;
+    using gtensor::reduce_multi;
+    using gtensor::detail::no_value;
+    using gtensor::value_error;
+    using test_reduce_multi_::min;
+    const auto fs = std::make_tuple(min{},std::plus<void>{});
+    //reduce zero size axes without initial
+    REQUIRE_THROWS_AS(reduce_multi(tensor_type{},0,fs,false,std::make_tuple(no_value{},value_type{0})),value_error);
+    REQUIRE_THROWS_AS(reduce_multi(tensor_type{},no_value{},fs,false,std::make_tuple(no_value{},value_type{0})),value_error);
+    REQUIRE_THROWS_AS(reduce_multi(multithreading::exec_pol<4>{},tensor_type{}.reshape(0,2,3),std::vector<int>{0},fs,false,std::make_tuple(value_type{0},no_value{})),value_error);
+    //axes out of range
+    REQUIRE_THROWS_AS(reduce_multi(tensor_type{1,2,3,4,5},1,fs,false,std::make_tuple(value_type{0},value_type{0})),value_error);
+    //repeating axes
+    REQUIRE_THROWS_AS(reduce_multi(tensor_type{{1,2,3},{4,5,6}},std::vector<int>{0,0},fs,false,std::make_tuple(value_type{0},value_type{0})),value_error);
+    //zero size with initials
+    auto result = reduce_multi(tensor_type{}.reshape(0,2),0,fs,false,std::make_tuple(value_type{1},value_type{2}));
+    REQUIRE(std::get<0>(result) == tensor_type{1,1});
+    REQUIRE(std::get<1>(result) == tensor_type{2,2});
+}
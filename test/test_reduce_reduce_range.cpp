@@ -348,6 +348,10 @@ TEMPLATE_TEST_CASE("test_reduce_range","[test_reduce]",
     {
         test_reduce_range(multithreading::exec_pol<4>{});
     }
+    SECTION("exec_pol_rt")
+    {
+        test_reduce_range(multithreading::exec_pol_rt{4,2});
+    }
 }
 
 TEST_CASE("test_reduce_range_custom_arg","[test_reduce]")
@@ -388,6 +392,10 @@ TEST_CASE("test_reduce_range_custom_arg","[test_reduce]")
     {
         test_reduce_range_custom_arg(multithreading::exec_pol<4>{});
     }
+    SECTION("exec_pol_rt")
+    {
+        test_reduce_range_custom_arg(multithreading::exec_pol_rt{4,2});
+    }
 }
 
 TEST_CASE("test_reduce_range_ecxeption","[test_reduce]")
@@ -523,12 +531,17 @@ TEMPLATE_TEST_CASE("test_reduce_range_flatten","[test_reduce]",
     {
         test_reduce_range_flatten(multithreading::exec_pol<4>{});
     }
+    SECTION("exec_pol_rt")
+    {
+        test_reduce_range_flatten(multithreading::exec_pol_rt{4,2});
+    }
 }
 
 TEMPLATE_TEST_CASE("test_reduce_range_big","[test_reduce]",
     (multithreading::exec_pol<1>),
     (multithreading::exec_pol<4>),
-    (multithreading::exec_pol<0>)
+    (multithreading::exec_pol<0>),
+    (multithreading::exec_pol_rt)
 )
 {
     using policy = TestType;
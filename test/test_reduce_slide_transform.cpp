@@ -154,6 +154,10 @@ TEST_CASE("test_slide","[test_reduce]")
     {
         test_slide(multithreading::exec_pol<4>{});
     }
+    SECTION("exec_pol_rt")
+    {
+        test_slide(multithreading::exec_pol_rt{4,2});
+    }
 }
 
 TEMPLATE_TEST_CASE("test_slide_flatten","[test_reduce]",
@@ -212,6 +216,10 @@ TEMPLATE_TEST_CASE("test_slide_flatten","[test_reduce]",
     {
         test_slide_flatten(multithreading::exec_pol<4>{});
     }
+    SECTION("exec_pol_rt")
+    {
+        test_slide_flatten(multithreading::exec_pol_rt{4,2});
+    }
 }
 
 TEST_CASE("test_slide_custom_arg","[test_reduce]")
@@ -256,6 +264,10 @@ TEST_CASE("test_slide_custom_arg","[test_reduce]")
     {
         test_slide_custom_arg(multithreading::exec_pol<4>{});
     }
+    SECTION("exec_pol_rt")
+    {
+        test_slide_custom_arg(multithreading::exec_pol_rt{4,2});
+    }
 }
 
 TEST_CASE("test_slide_exception","[test_reduce]")
@@ -358,5 +370,9 @@ TEST_CASE("test_transform","[test_reduce]")
     {
         test_transform(multithreading::exec_pol<4>{});
     }
+    SECTION("exec_pol_rt")
+    {
+        test_transform(multithreading::exec_pol_rt{4,2});
+    }
 }
 
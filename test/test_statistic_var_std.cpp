@@ -10,6 +10,7 @@
 #include <iomanip>
 #include "catch.hpp"
 #include "helpers_for_testing.hpp"
+#include "config_for_testing.hpp"
 #include "statistic.hpp"
 #include "tensor.hpp"
 
@@ -109,10 +110,18 @@ TEMPLATE_TEST_CASE("test_statistic_var_nanvar_normal_values","test_statistic",
     {
         test_var(multithreading::exec_pol<0>{});
     }
+    SECTION("test_var_exec_pol_rt")
+    {
+        test_var(multithreading::exec_pol_rt{4,2});
+    }
     SECTION("test_nanvar_exec_pol<0>")
     {
         test_nanvar(multithreading::exec_pol<0>{});
     }
+    SECTION("test_nanvar_exec_pol_rt")
+    {
+        test_nanvar(multithreading::exec_pol_rt{4,2});
+    }
 }
 
 TEMPLATE_TEST_CASE("test_statistic_var_nanvar_overload_default_policy","test_statistic",
@@ -154,7 +163,8 @@ TEMPLATE_TEST_CASE("test_statistic_var_nanvar_overload_default_policy","test_sta
 
 TEMPLATE_TEST_CASE("test_statistic_var_nanvar_overload_policy","test_statistic",
     (multithreading::exec_pol<4>),
-    (multithreading::exec_pol<0>)
+    (multithreading::exec_pol<0>),
+    (multithreading::exec_pol_rt)
 )
 {
     using policy = TestType;
@@ -240,7 +250,8 @@ TEST_CASE("test_statistic_var_nanvar_nan_values_default_policy","test_statistic"
 
 TEMPLATE_TEST_CASE("test_statistic_var_nanvar_nan_values_policy","test_statistic",
     (multithreading::exec_pol<4>),
-    (multithreading::exec_pol<0>)
+    (multithreading::exec_pol<0>),
+    (multithreading::exec_pol_rt)
 )
 {
     using policy = TestType;
@@ -386,10 +397,18 @@ TEMPLATE_TEST_CASE("test_statistic_stdev_nanstdev_normal_values","test_statistic
     {
         test_stdev(multithreading::exec_pol<0>{});
     }
+    SECTION("test_stdev_exec_pol_rt")
+    {
+        test_stdev(multithreading::exec_pol_rt{4,2});
+    }
     SECTION("test_nanstdev_exec_pol<0>")
     {
         test_nanstdev(multithreading::exec_pol<0>{});
     }
+    SECTION("test_nanstdev_exec_pol_rt")
+    {
+        test_nanstdev(multithreading::exec_pol_rt{4,2});
+    }
 }
 
 TEMPLATE_TEST_CASE("test_statistic_stdev_nanstdev_overload_default_policy","test_statistic",
@@ -431,7 +450,8 @@ TEMPLATE_TEST_CASE("test_statistic_stdev_nanstdev_overload_default_policy","test
 
 TEMPLATE_TEST_CASE("test_statistic_stdev_nanstdev_overload_policy","test_statistic",
     (multithreading::exec_pol<4>),
-    (multithreading::exec_pol<0>)
+    (multithreading::exec_pol<0>),
+    (multithreading::exec_pol_rt)
 )
 {
     using policy = TestType;
@@ -517,7 +537,8 @@ TEST_CASE("test_statistic_std_nanstd_nan_values_default_policy","test_statistic"
 
 TEMPLATE_TEST_CASE("test_statistic_std_nanstd_nan_values_policy","test_statistic",
     (multithreading::exec_pol<4>),
-    (multithreading::exec_pol<0>)
+    (multithreading::exec_pol<0>),
+    (multithreading::exec_pol_rt)
 )
 {
     using policy = TestType;
@@ -567,3 +588,162 @@ TEMPLATE_TEST_CASE("test_statistic_std_nanstd_nan_values_policy","test_statistic
     apply_by_element(test,test_data);
 }
 
+TEMPLATE_TEST_CASE("test_statistic_mean_var_stdev_accuracy","test_statistic",
+    (std::tuple<gtensor::config::mode_sum_pairwise,multithreading::exec_pol<1>>),
+    (std::tuple<gtensor::config::mode_sum_pairwise,multithreading::exec_pol<4>>),
+    (std::tuple<gtensor::config::mode_sum_kahan,multithreading::exec_pol<1>>),
+    (std::tuple<gtensor::config::mode_sum_kahan,multithreading::exec_pol<4>>)
+)
+{
+    using sum_mode = std::tuple_element_t<0,TestType>;
+    using policy = std::tuple_element_t<1,TestType>;
+    using value_type = float;
+    using config_type = gtensor::config::extend_config_t<test_config::config_sum_mode_selector_t<sum_mode>,value_type>;
+    using tensor_type = gtensor::tensor<value_type,gtensor::config::c_order,config_type>;
+    using gtensor::mean;
+    using gtensor::var;
+    using gtensor::stdev;
+    //float left fold of such number of elements loses several digits
+    const int rows = 4;
+    const int n = 1<<20;
+    tensor_type t(std::vector<int>{rows,n});
+    std::vector<double> expected_mean(rows,0.0);
+    std::vector<double> expected_var(rows,0.0);
+    auto it = t.begin();
+    for (int i=0; i!=rows; ++i){
+        for (int j=0; j!=n; ++j,++it){
+            const auto e = static_cast<value_type>(0.1+0.01*(j%7)+i);
+            *it = e;
+            expected_mean[i]+=static_cast<double>(e);
+        }
+        expected_mean[i]/=n;
+    }
+    it = t.begin();
+    for (int i=0; i!=rows; ++i){
+        for (int j=0; j!=n; ++j,++it){
+            const auto d = static_cast<double>(*it)-expected_mean[i];
+            expected_var[i]+=d*d;
+        }
+        expected_var[i]/=n;
+    }
+    auto near = [](double result, double expected_){
+        return std::abs(result-expected_) <= 1E-5*std::abs(expected_);
+    };
+    auto mean_ = mean(policy{},t,1);
+    auto var_ = var(policy{},t,1);
+    auto stdev_ = stdev(policy{},t,1);
+    for (int i=0; i!=rows; ++i){
+        REQUIRE(near(mean_.element(i),expected_mean[i]));
+        REQUIRE(near(var_.element(i),expected_var[i]));
+        REQUIRE(near(stdev_.element(i),std::sqrt(expected_var[i])));
+    }
+    const double expected_total_mean = (expected_mean[0]+expected_mean[1]+expected_mean[2]+expected_mean[3])/rows;
+    REQUIRE(near(*mean(policy{},t).begin(),expected_total_mean));
+}
+
+TEMPLATE_TEST_CASE("test_statistic_var_nanvar_sum_modes","test_statistic",
+    (std::tuple<gtensor::config::mode_sum_naive,multithreading::exec_pol<1>>),
+    (std::tuple<gtensor::config::mode_sum_naive,multithreading::exec_pol<4>>),
+    (std::tuple<gtensor::config::mode_sum_pairwise,multithreading::exec_pol<1>>),
+    (std::tuple<gtensor::config::mode_sum_pairwise,multithreading::exec_pol<4>>),
+    (std::tuple<gtensor::config::mode_sum_kahan,multithreading::exec_pol<1>>)
+)
+{
+    using sum_mode = std::tuple_element_t<0,TestType>;
+    using policy = std::tuple_element_t<1,TestType>;
+    using value_type = double;
+    using config_type = gtensor::config::extend_config_t<test_config::config_sum_mode_selector_t<sum_mode>,value_type>;
+    using tensor_type = gtensor::tensor<value_type,gtensor::config::c_order,config_type>;
+    using gtensor::var;
+    using gtensor::nanvar;
+    using gtensor::tensor_close;
+    using helpers_for_testing::apply_by_element;
+    static constexpr value_type nan = std::numeric_limits<value_type>::quiet_NaN();
+    static constexpr value_type pos_inf = std::numeric_limits<value_type>::infinity();
+    static constexpr value_type neg_inf = -std::numeric_limits<value_type>::infinity();
+    //0result,1expected
+    auto test_data = std::make_tuple(
+        //var
+        std::make_tuple(var(policy{},tensor_type{}), tensor_type(nan)),
+        std::make_tuple(var(policy{},tensor_type{1.0,0.5,2.0,4.0,3.0,pos_inf}), tensor_type(nan)),
+        std::make_tuple(var(policy{},tensor_type{neg_inf,0.5,2.0,4.0,3.0,1.0}), tensor_type(nan)),
+        std::make_tuple(var(policy{},tensor_type{{1.0,2.0,3.0,4.0},{5.0,6.0,7.0,8.0}},1), tensor_type{1.25,1.25}),
+        std::make_tuple(var(policy{},tensor_type{{1.0,2.0,3.0,4.0},{5.0,6.0,7.0,8.0}},0), tensor_type{4.0,4.0,4.0,4.0}),
+        std::make_tuple(var(policy{},tensor_type{{1.0,2.0,3.0,4.0},{5.0,6.0,7.0,8.0}}), tensor_type(5.25)),
+        //nanvar
+        std::make_tuple(nanvar(policy{},tensor_type{1.0,0.5,nan,4.0,3.0,2.0}), tensor_type(1.64)),
+        std::make_tuple(nanvar(policy{},tensor_type{1.0,nan,2.0,4.0,3.0,pos_inf}), tensor_type(nan)),
+        std::make_tuple(nanvar(policy{},tensor_type{{nan,nan,nan},{nan,nan,nan}},1), tensor_type{nan,nan}),
+        std::make_tuple(nanvar(policy{},tensor_type{{nan,2.0,3.0,4.0},{5.0,6.0,nan,8.0}},1), tensor_type{0.666,1.555}),
+        std::make_tuple(nanvar(policy{},tensor_type{{nan,2.0,3.0,4.0},{5.0,6.0,nan,8.0}}), tensor_type(3.888))
+    );
+    auto test = [](const auto& t){
+        auto result = std::get<0>(t);
+        auto expected = std::get<1>(t);
+        REQUIRE(tensor_close(result,expected,1E-2,1E-2,true));
+    };
+    apply_by_element(test,test_data);
+}
+
+//mean_var
+TEMPLATE_TEST_CASE("test_statistic_mean_var","test_statistic",
+    double,
+    int,
+    std::complex<double>
+)
+{
+    using value_type = TestType;
+    using tensor_type = gtensor::tensor<value_type>;
+    using gtensor::mean;
+    using gtensor::var;
+    using gtensor::mean_var;
+    using gtensor::tensor_close;
+    using helpers_for_testing::apply_by_element;
+    //0tensor,1axes,2keep_dims
+    auto test_data = std::make_tuple(
+        std::make_tuple(tensor_type{},0,false),
+        std::make_tuple(tensor_type{}.reshape(0,2,3),std::vector<int>{0,2},true),
+        std::make_tuple(tensor_type{5},0,false),
+        std::make_tuple(tensor_type{1,2,3,4,5},0,false),
+        std::make_tuple(tensor_type{{{1,2,3},{4,5,6}},{{7,8,9},{10,11,12}}},0,false),
+        std::make_tuple(tensor_type{{{1,2,3},{4,5,6}},{{7,8,9},{10,11,12}}},2,true),
+        std::make_tuple(tensor_type{{{1,2,3},{4,5,6}},{{7,8,9},{10,11,12}}},std::vector<int>{2,1},false),
+        std::make_tuple(tensor_type{{{1,2,3},{4,5,6}},{{7,8,9},{10,11,12}}},std::vector<int>{},false),
+        std::make_tuple(tensor_type{{{1,2,3},{4,5,6}},{{7,8,9},{10,11,12}}},std::vector<int>{0,1,2},true)
+    );
+    auto test_mean_var = [&test_data](auto...policy){
+        auto test = [policy...](const auto& t){
+            auto ten = std::get<0>(t);
+            auto axes = std::get<1>(t);
+            auto keep_dims = std::get<2>(t);
+            auto result = mean_var(policy...,ten,axes,keep_dims);
+            REQUIRE(std::is_same_v<decltype(result.first),decltype(mean(policy...,ten,axes,keep_dims))>);
+            REQUIRE(std::is_same_v<decltype(result.second),decltype(var(policy...,ten,axes,keep_dims))>);
+            REQUIRE(tensor_close(result.first,mean(policy...,ten,axes,keep_dims),1E-6,1E-6,true));
+            REQUIRE(tensor_close(result.second,var(policy...,ten,axes,keep_dims),1E-6,1E-6,true));
+        };
+        apply_by_element(test,test_data);
+    };
+    SECTION("test_mean_var_default_policy")
+    {
+        test_mean_var();
+    }
+    SECTION("test_mean_var_exec_pol<4>")
+    {
+        test_mean_var(multithreading::exec_pol<4>{});
+    }
+    SECTION("test_mean_var_exec_pol_rt")
+    {
+        test_mean_var(multithreading::exec_pol_rt{4,2});
+    }
+    SECTION("test_mean_var_flatten")
+    {
+        tensor_type t{{{1,2,3},{4,5,6}},{{7,8,9},{10,11,12}}};
+        auto result = mean_var(t);
+        REQUIRE(tensor_close(result.first,mean(t),1E-6,1E-6));
+        REQUIRE(tensor_close(result.second,var(t),1E-6,1E-6));
+        auto result_par = mean_var(multithreading::exec_pol<4>{},t,true);
+        REQUIRE(tensor_close(result_par.first,mean(t,true),1E-6,1E-6));
+        REQUIRE(tensor_close(result_par.second,var(t,true),1E-6,1E-6));
+    }
+}
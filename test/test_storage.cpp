@@ -8,6 +8,7 @@
 
 #include <vector>
 #include <list>
+#include <algorithm>
 #include <tuple>
 #include <iostream>
 #include "catch.hpp"
@@ -200,6 +201,30 @@ TEMPLATE_TEST_CASE("test_basic_storage_n_value_constructor","[test_basic_storage
     apply_by_element(test,test_data);
 }
 
+TEST_CASE("test_basic_storage_n_no_init_constructor","[test_basic_storage]")
+{
+    using value_type = test_basic_storage::not_trivial<double>;
+    using storage_type = gtensor::basic_storage<value_type>;
+    using size_type = typename storage_type::size_type;
+    value_type::reset();
+    {
+        storage_type stor(size_type{10},gtensor::no_init);
+        //elements are default constructed in place, no value_type{} copies
+        REQUIRE(value_type::ctr_counter == 10);
+        REQUIRE(stor.size() == 10);
+        REQUIRE(std::all_of(stor.begin(),stor.end(),[](const auto& e){return e.vec_t.empty();}));
+    }
+    REQUIRE(value_type::ctr_counter == value_type::dtr_counter);
+    {
+        gtensor::basic_storage<double> stor(size_type{10},gtensor::no_init);
+        REQUIRE(stor.size() == 10);
+    }
+    {
+        storage_type stor(size_type{0},gtensor::no_init);
+        REQUIRE(stor.empty());
+    }
+}
+
 TEMPLATE_TEST_CASE("test_basic_storage_iterators_range_constructor","[test_basic_storage]",
     double,
     test_basic_storage::not_trivial<double>
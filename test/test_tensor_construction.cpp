@@ -8,6 +8,7 @@
 
 #include <tuple>
 #include <vector>
+#include <string>
 #include "catch.hpp"
 #include "tensor.hpp"
 #include "helpers_for_testing.hpp"
@@ -128,6 +129,20 @@ TEST_CASE("test_tensor_constructor_shape","[test_tensor]")
     apply_by_element(test, test_data);
 }
 
+TEST_CASE("test_tensor_constructor_shape_no_init","[test_tensor]")
+{
+    using value_type = std::string;
+    using tensor_type = gtensor::tensor<value_type>;
+    using shape_type = typename tensor_type::shape_type;
+    using gtensor::no_init;
+
+    REQUIRE(tensor_type(shape_type{},no_init).shape() == shape_type{});
+    REQUIRE(tensor_type(shape_type{0},no_init).shape() == shape_type{0});
+    REQUIRE(tensor_type(std::vector<int>{2,3},no_init) == tensor_type{{"","",""},{"","",""}});
+    REQUIRE(tensor_type({3,2},no_init) == tensor_type{{"",""},{"",""},{"",""}});
+    REQUIRE(gtensor::tensor<double>({3,2,1},no_init).shape() == shape_type{3,2,1});
+}
+
 TEST_CASE("test_tensor_constructor_shape_value","[test_tensor]")
 {
     using value_type = double;
@@ -447,6 +462,72 @@ TEMPLATE_TEST_CASE("test_tensor_copy","[test_tensor]",
     {
         test_copy(multithreading::exec_pol<0>{});
     }
+    SECTION("exec_pol_rt")
+    {
+        test_copy(multithreading::exec_pol_rt{});
+        test_copy(multithreading::exec_pol_rt{3,2});
+    }
+}
+
+TEMPLATE_TEST_CASE("test_tensor_copy_transpose","[test_tensor]",
+    (std::tuple<double,gtensor::config::c_order>),
+    (std::tuple<double,gtensor::config::f_order>),
+    (std::tuple<float,gtensor::config::c_order>),
+    (std::tuple<float,gtensor::config::f_order>),
+    (std::tuple<int,gtensor::config::c_order>)
+)
+{
+    using value_type = std::tuple_element_t<0,TestType>;
+    using layout = std::tuple_element_t<1,TestType>;
+    using gtensor::config::c_order;
+    using gtensor::config::f_order;
+    using tensor_type = gtensor::tensor<value_type,layout>;
+    using shape_type = typename tensor_type::shape_type;
+    using helpers_for_testing::apply_by_element;
+    using helpers_for_testing::generate_lehmer;
+    //expected is made elementwise using iterators, t traverse order is c_order
+    auto make_expected = [](const auto& t){
+        return gtensor::tensor<value_type,c_order>(t.shape(),t.begin(),t.end());
+    };
+    auto test_copy = [&make_expected](const auto& t){
+        const auto expected = make_expected(t);
+        REQUIRE(t.copy(c_order{}) == expected);
+        REQUIRE(t.copy(f_order{}) == expected);
+        REQUIRE(t.copy(multithreading::exec_pol<4>{},c_order{}) == expected);
+        REQUIRE(t.copy(multithreading::exec_pol_rt{3},f_order{}) == expected);
+        REQUIRE(t.template copy<double>(f_order{}) == gtensor::tensor<double,c_order>(t.shape(),t.begin(),t.end()));
+    };
+    //0shape
+    auto test_data = std::make_tuple(
+        shape_type{5,5},
+        shape_type{8,8},
+        shape_type{9,13},
+        shape_type{64,64},
+        shape_type{67,131},
+        shape_type{200,9},
+        shape_type{3,70,9},
+        shape_type{9,1,70,2},
+        shape_type{2,17,3,33}
+    );
+    auto test = [&test_copy](const auto& shape){
+        tensor_type t(shape);
+        generate_lehmer(t.begin(),t.end(),[](const auto& e){return e%1000;},1);
+        //layout conversion
+        test_copy(t);
+        //transpose views
+        test_copy(t.transpose());
+        if (t.dim() == 3){
+            test_copy(t.transpose(1,0,2));
+            test_copy(t.transpose(0,2,1));
+        }
+        if (t.dim() == 4){
+            test_copy(t.transpose(0,2,1,3));
+            test_copy(t.transpose(3,1,2,0));
+        }
+        REQUIRE(t.transpose().eval() == t.transpose().copy(layout{}));
+        REQUIRE(t.transpose().eval(multithreading::exec_pol<4>{}) == t.transpose().copy(layout{}));
+    };
+    apply_by_element(test,test_data);
 }
 
 TEMPLATE_TEST_CASE("test_tensor_eval_of_view","[test_tensor]",
@@ -493,6 +574,11 @@ TEMPLATE_TEST_CASE("test_tensor_eval_of_view","[test_tensor]",
     {
         test_eval(multithreading::exec_pol<0>{});
     }
+    SECTION("exec_pol_rt")
+    {
+        test_eval(multithreading::exec_pol_rt{});
+        test_eval(multithreading::exec_pol_rt{3,2});
+    }
 }
 
 TEMPLATE_TEST_CASE("test_tensor_eval_of_tensor","[test_tensor]",
@@ -537,6 +623,11 @@ TEMPLATE_TEST_CASE("test_tensor_eval_of_tensor","[test_tensor]",
     {
         test_eval(multithreading::exec_pol<0>{});
     }
+    SECTION("exec_pol_rt")
+    {
+        test_eval(multithreading::exec_pol_rt{});
+        test_eval(multithreading::exec_pol_rt{3,2});
+    }
 }
 
 TEST_CASE("test_tensor_resize","[test_tensor]")
@@ -161,16 +161,79 @@ TEST_CASE("test_a_operator","[test_tensor_operators]")
         std::make_tuple(assign_add{},tensor_type{0},tensor_type{1,2,3,4,5},tensor_type{15}),
         std::make_tuple(assign_add{},tensor_type{-1,1},tensor_type{{1,2},{3,4},{5,6}},tensor_type{8,13})
     );
-    auto test = [](const auto& t){
-        auto f = std::get<0>(t);
-        auto lhs = std::get<1>(t);
-        auto rhs = std::get<2>(t);
-        auto expected = std::get<3>(t);
-        auto& result = a_operator(f,lhs,rhs);
-        REQUIRE(&result == &lhs);
-        REQUIRE(result == expected);
+    auto test_a_operator = [&test_data](auto...policy){
+        auto test = [policy...](const auto& t){
+            auto f = std::get<0>(t);
+            auto lhs = std::get<1>(t);
+            auto rhs = std::get<2>(t);
+            auto expected = std::get<3>(t);
+            auto& result = a_operator(policy...,f,lhs,rhs);
+            REQUIRE(&result == &lhs);
+            REQUIRE(result == expected);
+        };
+        apply_by_element(test, test_data);
     };
-    apply_by_element(test, test_data);
+    SECTION("default_policy")
+    {
+        test_a_operator();
+    }
+    SECTION("exec_pol<4>")
+    {
+        test_a_operator(multithreading::exec_pol<4>{});
+    }
+    SECTION("exec_pol_rt")
+    {
+        test_a_operator(multithreading::exec_pol_rt{3});
+    }
+}
+
+TEMPLATE_TEST_CASE("test_a_operator_policy_big","[test_tensor_operators]",
+    (multithreading::exec_pol<1>),
+    (multithreading::exec_pol<4>),
+    (multithreading::exec_pol<0>),
+    (multithreading::exec_pol_rt)
+)
+{
+    using policy = TestType;
+    using value_type = std::int64_t;
+    using tensor_type = gtensor::tensor<value_type>;
+    using shape_type = typename tensor_type::shape_type;
+    using helpers_for_testing::generate_lehmer;
+
+    tensor_type parent(shape_type{17,31,9});
+    generate_lehmer(parent.begin(),parent.end(),[](const auto& e){return e%100;},123);
+    const tensor_type rhs = (parent+1).copy();
+    //trivial
+    {
+        auto lhs = parent.copy();
+        auto expected = parent.copy();
+        for (auto it=expected.begin(),last=expected.end(); it!=last; ++it){
+            *it += 3;
+        }
+        REQUIRE(gtensor::assign_add(policy{},lhs,3) == expected);
+        REQUIRE(gtensor::assign(policy{},lhs,rhs) == rhs);
+    }
+    //not trivial lhs
+    {
+        auto lhs_parent = parent.copy();
+        auto lhs = lhs_parent.transpose();
+        auto expected = (parent.transpose()*rhs.transpose()).copy();
+        REQUIRE(gtensor::assign_mul(policy{},lhs,rhs.transpose()) == expected);
+        REQUIRE(lhs_parent == expected.transpose());
+    }
+    //not trivial rhs
+    {
+        auto lhs = parent.copy();
+        auto rhs_ = rhs.transpose().copy();
+        REQUIRE(gtensor::assign_sub(policy{},lhs,rhs_.transpose()) == tensor_type(parent.shape(),-1));
+    }
+    //broadcast rhs
+    {
+        auto lhs = parent.copy();
+        const tensor_type rhs_{1,2,3,4,5,6,7,8,9};
+        auto expected = (parent+rhs_).copy();
+        REQUIRE(gtensor::assign_add(policy{},lhs,rhs_) == expected);
+    }
 }
 
 //test operators